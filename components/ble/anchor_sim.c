@@ -0,0 +1,254 @@
+// components/ble/anchor_sim.c — UWB anchor szimulátor: GET/SET, HB/STATE/DATA
+#include <string.h>
+#include <stdint.h>
+#include "tlv.h"
+#include "uwb_frame.h"
+#include "anchor_sim.h"
+
+#define QMASK        (ASIM_OUTQ - 1u)
+#define DW_TICK_US   63898ULL            /* ~63.9 GHz DW óra, tick / µs */
+#define TS40_MASK    ((1ULL << 40) - 1)
+_Static_assert((ASIM_OUTQ & QMASK) == 0, "ASIM_OUTQ must be a power of two");
+
+/* ===== Regiszterek =====
+ * Snapshot sorrend = tábla sorrend; a VER elöl, így az első keret nem
+ * hasonlíthat HB / ACK / STATE-re. ro: SET elutasítja. */
+typedef struct { uint8_t tag; bool ro; uint32_t def; } reg_def_t;
+static const reg_def_t k_regs[] = {
+    { T_VER, true, 1 },              { T_STATUS, true, 0x01 },        { T_UPTIME_MS, true, 0 },
+    { T_SYNC_MS, true, 0 },          { T_NETWORK_ID, false, 0 },      { T_ZONE_ID, false, 0 },
+    { T_ANCHOR_ID, false, 0 },       { T_TX_ANT_DLY, false, 16385 },  { T_RX_ANT_DLY, false, 16385 },
+    { T_BIAS_TICKS, false, 0 },      { T_LOG_LEVEL, false, 2 },       { T_HB_MS, false, 0 },
+    { T_SYN_PPM_MAX, false, 50 },    { T_SYN_JUMP_PPM, false, 20 },   { T_SYN_AB_GAP_MS, false, 5 },
+    { T_SYN_MS_EWMA_DEN, false, 8 }, { T_SYN_TK_EWMA_DEN, false, 8 }, { T_SYN_TK_MIN_MS, false, 50 },
+    { T_SYN_TK_MAX_MS, false, 200 }, { T_SYN_DTTX_MIN_MS, false, 50 }, { T_SYN_DTTX_MAX_MS, false, 200 },
+    { T_SYN_LOCK_NEED, false, 3 },   { T_PHY_CH, false, 5 },          { T_PHY_PLEN, false, 128 },
+    { T_PHY_PAC, false, 8 },         { T_PHY_TX_CODE, false, 9 },     { T_PHY_RX_CODE, false, 9 },
+    { T_PHY_SFD, false, 0 },         { T_PHY_BR, false, 1 },          { T_PHY_PHRMODE, false, 0 },
+    { T_PHY_PHRRATE, false, 0 },     { T_PHY_SFDTO, false, 129 },     { T_PHY_STS_MODE, false, 0 },
+    { T_PHY_STS_LEN, false, 64 },    { T_PHY_PDOA, false, 0 },
+};
+#define NREGS (sizeof(k_regs) / sizeof(k_regs[0]))
+_Static_assert(NREGS <= ASIM_REGS, "ASIM_REGS too small");
+
+static int reg_idx(uint8_t tag)
+{
+    for (unsigned i = 0; i < NREGS; i++) if (k_regs[i].tag == tag) return (int)i;
+    return -1;
+}
+
+static inline void wr16be(uint8_t* p, uint16_t v){ p[0] = (uint8_t)(v >> 8); p[1] = (uint8_t)v; }
+static inline void wr32be(uint8_t* p, uint32_t v){ p[0] = (uint8_t)(v >> 24); p[1] = (uint8_t)(v >> 16); p[2] = (uint8_t)(v >> 8); p[3] = (uint8_t)v; }
+static inline void wr32le(uint8_t* p, uint32_t v){ p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24); }
+
+static uint32_t rnd(asim_t* a)                   /* xorshift32 */
+{
+    uint32_t x = a->rng;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    return a->rng = x;
+}
+static inline bool chance(asim_t* a, uint32_t ppm){ return ppm && rnd(a) % 1000000u < ppm; }
+
+static uint32_t up_ms(const asim_t* a, int64_t now){ return (uint32_t)((now - a->t0) / 1000); }
+static uint16_t sync_ms(const asim_t* a){ return a->c.sync_ms ? a->c.sync_ms : 100; }
+static uint8_t  sync_seq(const asim_t* a, int64_t now){ return (uint8_t)((now - a->t0) / 1000 / sync_ms(a)); }
+static uint16_t since_sync(const asim_t* a, int64_t now){ return (uint16_t)(((now - a->t0) / 1000) % sync_ms(a)); }
+
+void asim_init(asim_t* a, const asim_cfg_t* c, int64_t now_us)
+{
+    memset(a, 0, sizeof(*a));
+    a->c = *c;
+    if (a->c.tags > ASIM_MAX_TAGS) a->c.tags = ASIM_MAX_TAGS;
+    if (!a->c.frame_max || a->c.frame_max > ASIM_FRAME_MAX) a->c.frame_max = ASIM_FRAME_MAX;
+    a->t0  = now_us;
+    a->rng = c->seed ? c->seed : 0x2545F491u;
+    for (unsigned i = 0; i < NREGS; i++) a->reg[i] = k_regs[i].def;
+    a->reg[reg_idx(T_NETWORK_ID)] = c->network_id;
+    a->reg[reg_idx(T_ANCHOR_ID)]  = c->anchor_id;
+    a->reg[reg_idx(T_HB_MS)]      = c->hb_ms;
+    a->next_hb    = now_us + (int64_t)c->hb_ms * 1000;
+    a->next_state = now_us + (int64_t)c->state_ms * 1000;
+}
+
+uint32_t asim_reg(const asim_t* a, uint8_t tag)
+{
+    const int i = reg_idx(tag);
+    return i < 0 ? 0 : a->reg[i];
+}
+
+/* ===== Kimenő sor ===== */
+static asim_frame_t* q_push(asim_t* a)
+{
+    if (a->qn == ASIM_OUTQ) return NULL;
+    return &a->q[(a->qh + a->qn++) & QMASK];
+}
+static void q_flush(asim_t* a, asim_out_t out, void* ctx)
+{
+    while (a->qn) {
+        const asim_frame_t* f = &a->q[a->qh];
+        if (!out(ctx, a->c.link, f->d, f->len, f->from_cfg)) { a->st.stalls++; return; }
+        a->qh = (a->qh + 1) & QMASK;
+        a->qn--;
+    }
+}
+
+static bool put_ack(asim_t* a, uint16_t req, uint8_t status, uint8_t applied)
+{
+    asim_frame_t* f = q_push(a);
+    if (!f) { a->st.resp_drop++; return false; }
+    f->d[0] = 1; f->d[1] = 0x81; wr16be(&f->d[2], req); f->d[4] = status; f->d[5] = applied;
+    f->len = 6; f->from_cfg = true;
+    return true;
+}
+
+/* TLV snapshot, TLV határon darabolva frame_max-ra */
+static void put_snapshot(asim_t* a, int64_t now)
+{
+    asim_frame_t* f = NULL;
+    tlv_wr_t w;
+    for (unsigned i = 0; i < NREGS; i++) {
+        const uint8_t tag = k_regs[i].tag;
+        uint32_t v = a->reg[i];
+        if (tag == T_UPTIME_MS) v = up_ms(a, now);
+        if (tag == T_SYNC_MS)   v = since_sync(a, now);
+        uint8_t b[4], n = tlv_desc(tag)->width;
+        if (!n) n = v > 0xFFFFFF ? 4 : v > 0xFFFF ? 3 : v > 0xFF ? 2 : 1;    /* változó hossz: minimális */
+        for (uint8_t k = 0; k < n; k++) b[k] = (uint8_t)(v >> (8 * (n - 1 - k)));
+        if (f && !tlv_put_raw(&w, tag, b, n)) { f->len = w.len; f = NULL; }
+        if (!f) {
+            if (!(f = q_push(a))) { a->st.resp_drop++; return; }
+            f->from_cfg = true;
+            tlv_wr_init(&w, f->d, a->c.frame_max);
+            tlv_put_raw(&w, tag, b, n);
+        }
+    }
+    if (f) f->len = w.len;
+}
+
+static void on_set(asim_t* a, uint16_t req, const uint8_t* p, uint16_t n)
+{
+    tlv_cur_t cur; tlv_t t; tlv_rc_t rc;
+    uint8_t applied = 0, rejected = 0;
+    tlv_cur_init(&cur, p, n);
+    while ((rc = tlv_next(&cur, &t)) == TLV_ITEM) {
+        const int i = reg_idx(t.tag);
+        if (i < 0 || k_regs[i].ro || !tlv_width_ok(&t)) { rejected++; continue; }
+        a->reg[i] = tlv_u32(&t);
+        applied++;
+    }
+    if (rc == TLV_TRUNC) rejected++;
+    a->st.sets++;
+    a->st.applied += applied;
+    a->st.rejected += rejected;
+    put_ack(a, req, rejected ? 0x02 : 0x00, applied);
+}
+
+void asim_write(asim_t* a, const uint8_t* p, uint16_t n, int64_t now_us, asim_out_t out, void* ctx)
+{
+    if (!p || n < 4 || p[0] != 1) { a->st.bad_cmd++; return; }
+    const uint16_t req = (uint16_t)(p[2] << 8 | p[3]);
+    const uint16_t hb0 = (uint16_t)asim_reg(a, T_HB_MS);
+    switch (p[1]) {
+    case 0x02:                                           /* GET */
+        a->st.gets++;
+        if (put_ack(a, req, 0, 0)) put_snapshot(a, now_us);
+        break;
+    case 0x01:                                           /* SET; [4] = n_tlv, nem kötelező */
+        on_set(a, req, n > 5 ? p + 5 : p, n > 5 ? (uint16_t)(n - 5) : 0);
+        break;
+    default:
+        a->st.bad_cmd++;
+        put_ack(a, req, 0xFF, 0);
+        break;
+    }
+    const uint16_t hb = (uint16_t)asim_reg(a, T_HB_MS);
+    if (hb != hb0) a->next_hb = now_us + (int64_t)hb * 1000;       /* új HB periódus azonnal */
+    q_flush(a, out, ctx);
+}
+
+/* ===== Ütemezett keretek ===== */
+static int64_t data_due(const asim_t* a)
+{
+    if (!a->c.tags || !a->c.rate_mhz) return INT64_MAX;
+    /* k. esemény: k / (tags * rate) s; tagok egyenletesen elosztva */
+    return a->t0 + (int64_t)(a->k * 1000000000ULL / ((uint64_t)a->c.tags * a->c.rate_mhz));
+}
+
+int64_t asim_next_due(const asim_t* a)
+{
+    if (a->qn) return a->t0;                             /* várakozó keret: most */
+    int64_t t = data_due(a);
+    if (asim_reg(a, T_HB_MS) && a->next_hb < t) t = a->next_hb;
+    if (a->c.state_ms && a->next_state < t) t = a->next_state;
+    return t;
+}
+
+static void gen_data(asim_t* a, int64_t t)
+{
+    const uint16_t tag = (uint16_t)(a->k % a->c.tags);
+    const uint8_t seq = a->seq[tag]++;
+    const uint32_t rel_ms = (uint32_t)((t - a->t0) / 1000);
+    const bool outage = a->c.outage_every_ms && rel_ms % a->c.outage_every_ms < a->c.outage_ms;
+    if (outage || chance(a, a->c.loss_ppm)) { a->st.lost++; return; }
+
+    asim_frame_t* f = q_push(a);                         /* hely ellenőrizve a hívóban */
+    memset(f->d, 0, UWB_DATA_LEN);
+    f->d[0] = UWB_DATA_HDR;
+    f->d[1] = 1;
+    f->d[2] = sync_seq(a, t);
+    f->d[3] = seq;
+    wr32le(&f->d[4], asim_reg(a, T_ANCHOR_ID));
+    wr32le(&f->d[8], a->c.tag_base + tag);
+    const uint64_t ts40 = ((uint64_t)(t - a->t0) * DW_TICK_US) & TS40_MASK;
+    wr32le(&f->d[12], (uint32_t)ts40);
+    f->d[16] = (uint8_t)(ts40 >> 32);
+    f->len = UWB_DATA_LEN;
+    f->from_cfg = false;
+    a->st.data++;
+    if (chance(a, a->c.dup_ppm) && a->qn < ASIM_OUTQ) {
+        asim_frame_t* g = q_push(a);
+        *g = *f;
+        a->st.dups++;
+    }
+}
+
+static void gen_hb(asim_t* a, int64_t t)
+{
+    asim_frame_t* f = q_push(a);
+    const uint8_t hb[13] = { 0x01, 0x01, (uint8_t)asim_reg(a, T_STATUS), 0x02, 0x04, 0, 0, 0, 0, 0x03, 0x02, 0, 0 };
+    memcpy(f->d, hb, sizeof(hb));
+    wr32be(&f->d[5], up_ms(a, t));
+    wr16be(&f->d[11], since_sync(a, t));
+    f->len = sizeof(hb); f->from_cfg = true;
+    a->st.hb++;
+}
+
+static void gen_state(asim_t* a, int64_t t)
+{
+    asim_frame_t* f = q_push(a);
+    f->d[0] = 1; f->d[1] = 0x90;
+    f->d[2] = (uint8_t)asim_reg(a, T_STATUS);
+    wr16be(&f->d[3], since_sync(a, t));
+    wr32be(&f->d[5], up_ms(a, t));
+    wr16be(&f->d[9], (uint16_t)asim_reg(a, T_NETWORK_ID));
+    wr16be(&f->d[11], (uint16_t)asim_reg(a, T_ZONE_ID));
+    wr32be(&f->d[13], asim_reg(a, T_ANCHOR_ID));
+    f->len = 17; f->from_cfg = true;
+    a->st.state++;
+}
+
+void asim_step(asim_t* a, int64_t now_us, asim_out_t out, void* ctx)
+{
+    for (;;) {
+        q_flush(a, out, ctx);
+        if (a->qn + 2 > ASIM_OUTQ) return;               /* DATA + esetleges duplikátum */
+        const int64_t td = data_due(a);
+        const uint32_t hb = asim_reg(a, T_HB_MS);
+        const int64_t th = hb ? a->next_hb : INT64_MAX;
+        const int64_t ts = a->c.state_ms ? a->next_state : INT64_MAX;
+        if (th <= now_us && th <= td && th <= ts)  { gen_hb(a, th);    a->next_hb    = th + (int64_t)hb * 1000; }
+        else if (ts <= now_us && ts <= td)         { gen_state(a, ts); a->next_state = ts + (int64_t)a->c.state_ms * 1000; }
+        else if (td <= now_us)                     { gen_data(a, td);  a->k++; }
+        else return;
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===== UWB anchor szimulátor (CFG / DATA protokoll) =====
+ * Egy anchor a gateway felől nézve:
+ *   CFG írás:  GET  [1,0x02,req_hi,req_lo,0]        → ACK 0x81 + TLV snapshot
+ *              SET  [1,0x01,req_hi,req_lo,n,TLV...] → regiszterek, ACK (applied)
+ *   CFG notify: HB (13 B fast-path), STATE 0x90 (17 B), ACK, snapshot
+ *   DATA notify: 20 B 0xAB keret, N tag egyenletesen elosztva, tagonként
+ *              rate_mhz rátával; véletlen / periodikus (kiesés) veszteség,
+ *              duplikátum.
+ * Virtuális idő: a hívó adja a now_us-t (valós óra, gyorsított vagy
+ * "amilyen gyorsan lehet"). Kimenet az out callbackon; ha az false-t ad
+ * (tele a fogadó gyűrű), a keret a belső sorban marad és a következő
+ * hívás újrapróbálja — mint a link réteg, nem dob el.
+ * Nem allokál, OS-t nem hív: target (ble_sim.c) és host (tools/anchor_sim.c). */
+
+#define ASIM_MAX_TAGS   1024
+#define ASIM_FRAME_MAX  244             /* notify érték (ATT_MTU 247 - 3) */
+#define ASIM_OUTQ       8               /* kimenő keret sor (2 hatványa) */
+#define ASIM_REGS       40
+
+typedef bool (*asim_out_t)(void* ctx, uint8_t link, const uint8_t* data, uint16_t len, bool from_cfg);
+
+typedef struct {
+    uint8_t  link;
+    uint32_t anchor_id;                 /* ANCHOR_ID regiszter kezdőértéke */
+    uint16_t network_id;
+    uint16_t tags;                      /* 0..ASIM_MAX_TAGS */
+    uint32_t tag_base;                  /* első tag_id */
+    uint32_t rate_mhz;                  /* tagonkénti DATA ráta (mHz) */
+    uint16_t hb_ms;                     /* HB_MS kezdőérték, 0: nincs HB */
+    uint16_t state_ms;                  /* STATE periódus, 0: nincs */
+    uint16_t sync_ms;                   /* sync_seq lépésköze, 0 → 100 */
+    uint32_t loss_ppm;                  /* véletlen DATA veszteség */
+    uint32_t dup_ppm;                   /* kétszer küldött DATA */
+    uint16_t outage_ms;                 /* periodikus kiesés hossza ... */
+    uint16_t outage_every_ms;           /* ... ennyi ms-onként (0: nincs) */
+    uint16_t frame_max;                 /* snapshot keret max., 0 → ASIM_FRAME_MAX */
+    uint32_t seed;
+} asim_cfg_t;
+
+typedef struct {
+    uint32_t data, lost, dups;          /* DATA: kiküldött / elnyelt / duplikált */
+    uint32_t hb, state;
+    uint32_t gets, sets, applied, rejected, bad_cmd;
+    uint32_t resp_drop;                 /* válasz nem fért a sorba */
+    uint32_t stalls;                    /* out = false */
+} asim_stats_t;
+
+typedef struct {
+    uint16_t len;
+    bool     from_cfg;
+    uint8_t  d[ASIM_FRAME_MAX];
+} asim_frame_t;
+
+typedef struct {
+    asim_cfg_t   c;
+    int64_t      t0;
+    int64_t      next_hb, next_state;
+    uint64_t     k;                     /* következő DATA esemény sorszáma */
+    uint32_t     rng;
+    uint32_t     reg[ASIM_REGS];
+    uint8_t      seq[ASIM_MAX_TAGS];
+    asim_frame_t q[ASIM_OUTQ];
+    uint8_t      qh, qn;
+    asim_stats_t st;
+} asim_t;
+
+void    asim_init(asim_t* a, const asim_cfg_t* c, int64_t now_us);
+/* gateway → anchor CFG írás; a válasz a sorba kerül, a kiküldés most indul */
+void    asim_write(asim_t* a, const uint8_t* p, uint16_t n, int64_t now_us, asim_out_t out, void* ctx);
+/* now_us-ig esedékes HB / STATE / DATA kiküldése */
+void    asim_step(asim_t* a, int64_t now_us, asim_out_t out, void* ctx);
+/* következő esemény ideje; INT64_MAX: nincs (0 tag, HB / STATE nélkül) */
+int64_t asim_next_due(const asim_t* a);
+/* regiszter aktuális értéke (SET után is); 0: nem regiszter */
+uint32_t asim_reg(const asim_t* a, uint8_t tag);
+
+#ifdef __cplusplus
+}
+#endif
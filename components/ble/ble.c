@@ -1,35 +1,117 @@
 // components/ble/ble.c — ESP-IDF v5.4, Bluedroid GATTC kliens UWB CFG/DATA-hoz
+// Több anchor egyszerre: kapcsolatonkénti állapot a s_links[] táblában.
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <ctype.h>
 
 #include "esp_log.h"
 #include "esp_err.h"
 #include "nvs_flash.h"
+#include "nvs.h"
 #include "esp_bt.h"
 #include "esp_bt_main.h"
 #include "esp_gap_ble_api.h"
 #include "esp_gattc_api.h"
 #include "esp_gatt_common_api.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
 
 #include "ble.h"   // ble_start / ble_send_get / ble_send_set
+#include "notify_ring.h"
+#include "capture.h"
+#include "write_queue.h"
+#include "metrics.h"
 
 /* ====== Állapot ====== */
 static const char* TAG = "BLE_CLI";
 
 static esp_gatt_if_t g_gattc_if = 0xFE;
-static uint16_t      g_conn_id  = 0xFFFF;
-static esp_bd_addr_t g_peer_bda = {0};
-static esp_ble_addr_type_t g_peer_addr_type = BLE_ADDR_TYPE_PUBLIC;
-static bool          g_connected = false;
 
-static uint16_t g_start_handle=0, g_end_handle=0;
-static uint16_t g_data_h=0, g_cfg_h=0;
-static uint16_t g_data_ccc_h=0, g_cfg_ccc_h=0;
+/* Gyors újracsatlakozás: peer cím + GATT handle tábla NVS-ben, linkenként.
+ * A szűrő is benne van: más anchor lista mellett a bejegyzés nem érvényes. */
+#define BLE_CACHE_VER  1
+typedef struct {
+    uint8_t  ver, addr_type;
+    uint8_t  bda[6];
+    uint16_t start_h, end_h;
+    uint16_t data_h, cfg_h, data_ccc_h, cfg_ccc_h;
+    uint8_t  cfg_props;
+    char     filter[32];
+} ble_cache_t;
 
-static ble_notify_cb_t g_cb = NULL;
-static char g_name_filter[32] = {0};
-static bool g_connecting = false;
+/* Anchor slot = szűrő + kapcsolat. Az index a link/anchor azonosító. */
+typedef struct {
+    bool          used;
+    char          filter[32];          /* név, vagy "AA:BB:CC:DD:EE:FF" */
+    bool          by_addr;
+    esp_bd_addr_t filt_bda;
+
+    bool          connecting, connected;
+    uint16_t      conn_id;
+    esp_bd_addr_t bda;
+    esp_ble_addr_type_t addr_type;
+
+    uint16_t start_h, end_h;
+    uint16_t data_h, cfg_h;
+    uint16_t data_ccc_h, cfg_ccc_h;
+    uint8_t  cfg_props;
+    uint16_t mtu;
+    bool     congested;
+
+    wq_t     wq;                        /* írási sor (s_wq_lock alatt) */
+
+    uint32_t notifies, notify_bytes;
+    uint32_t connects;
+
+    /* hangolás: a controllertől visszakapott értékek */
+    uint16_t conn_int, conn_lat, conn_tmo;   /* 1.25 ms / event / 10 ms */
+    uint16_t tx_len, rx_len;                 /* LL payload oktett (DLE) */
+    uint8_t  tx_phy, rx_phy;                 /* 1 = 1M, 2 = 2M */
+    bool     dle_pending;
+
+    /* handle cache + újracsatlakozási idő */
+    ble_cache_t cache;
+    bool     cache_ok;
+    bool     direct;                        /* a futó open a cache-elt címre megy */
+    uint8_t  direct_fail;                   /* sikertelen direkt open → marad a scan */
+    uint8_t  validate;                      /* 1/2: data/cfg CCC olvasás fut */
+    bool     fast;                          /* ez a kapcsolat felderítés nélkül állt fel */
+    int64_t  t_down_us;                     /* bontás (ill. indulás) ideje, 0 = mért */
+    uint32_t reconnect_ms, fast_opens, discoveries;
+
+    /* notify goodput: BLE_GOODPUT_WIN_US ablakonként */
+    int64_t  up_us, gp_t_us;
+    uint32_t gp_n, gp_b;
+    uint32_t gp_mhz, gp_Bps;
+} ble_link_t;
+
+static ble_link_t s_links[BLE_MAX_LINKS];
+
+/* NOTIFY → gyűrű → rx task → feliratkozók (fan-out) */
+#define BLE_MAX_SUBSCRIBERS 4
+static ble_notify_cb_t g_subs[BLE_MAX_SUBSCRIBERS];
+static portMUX_TYPE    s_subs_lock = portMUX_INITIALIZER_UNLOCKED;   /* csak a regisztrációhoz; a lista nem fogy */
+static ble_ready_cb_t  s_ready_cb = NULL;
+static notify_ring_t   s_rx_ring;
+static TaskHandle_t    s_rx_task = NULL;
+static bool g_connecting = false;      /* Bluedroid: egyszerre egy függő open */
+static nvs_handle_t s_nvs;             /* "ble_cache" névtér, ble_start nyitja */
+
+/* írási sor: slotok a linkben, egy zár mindenre; ablak = egyszerre a stacknek átadott írás */
+static portMUX_TYPE s_wq_lock = portMUX_INITIALIZER_UNLOCKED;
+static volatile uint8_t s_wq_window = BLE_WQ_WINDOW;
+
+/* link hangolás (OPEN után): conn paraméterek, DLE, PHY */
+#define BLE_GOODPUT_WIN_US  1000000
+static portMUX_TYPE      s_par_lock = portMUX_INITIALIZER_UNLOCKED;
+static ble_link_params_t s_par = {
+    .min_int = BLE_CONN_MIN_INT, .max_int = BLE_CONN_MAX_INT,
+    .latency = BLE_CONN_LATENCY, .timeout = BLE_CONN_TIMEOUT,
+    .data_len = BLE_DATA_LEN, .phy_2m = true,
+};
 
 /* ====== UWB UUID-k ======
  * Service:  12345678-1234-5678-1234-1234567890AB
@@ -43,6 +125,17 @@ static bool g_connecting = false;
 static bool s_params_set = false, s_scan_active = false;
 static bool s_scan_pending = false;   /* ÚJ: start kérve, START_COMPLETE-re várunk */
 
+/* Újraindítás bontás / sikertelen open után: a BTC taskot nem altatjuk, egy
+ * esp_timer indítja a scant. A kapcsolat-felépítés állapotát (g_connecting,
+ * s_scan_*, link connected/connecting) így a BTC task (gap_cb, gattc_cb
+ * OPEN/CLOSE/DISCONNECT) és az esp_timer task is írja: s_conn_mx védi. */
+#define BLE_RESCAN_OPEN_FAIL_MS  200
+#define BLE_RESCAN_DOWN_MS       100
+static SemaphoreHandle_t  s_conn_mx;
+static esp_timer_handle_t s_rescan_tmr;
+#define CONN_LOCK()   xSemaphoreTake(s_conn_mx, portMAX_DELAY)
+#define CONN_UNLOCK() xSemaphoreGive(s_conn_mx)
+
 static esp_ble_scan_params_t s_scan_params = {
     .scan_type              = BLE_SCAN_TYPE_ACTIVE,
     .own_addr_type          = BLE_ADDR_TYPE_PUBLIC,
@@ -52,10 +145,6 @@ static esp_ble_scan_params_t s_scan_params = {
     .scan_duplicate         = BLE_SCAN_DUPLICATE_DISABLE
 };
 
-/* ---- SCAN/CONNECT sorosítás + védett hívások (elődeklaráció) ---- */
-static esp_err_t start_scan_safe(uint32_t dur_sec);
-static esp_err_t gattc_open_safe(esp_gatt_if_t ifx, const esp_bd_addr_t addr, esp_ble_addr_type_t type);
-
 static const uint8_t UWB_SVC_UUID_128[16]  = { 0xAB,0x90,0x78,0x56,0x34,0x12,0x34,0x12,0x78,0x56,0x34,0x12,0x78,0x56,0x34,0x12 };
 static const uint8_t UWB_SVC_UUID_128_BE[16]= { 0x12,0x34,0x56,0x78,0x12,0x34,0x56,0x78,0x12,0x34,0x12,0x34,0x56,0x78,0x90,0xAB };
 static const uint8_t UWB_DATA_UUID_128[16] = { 0xAB,0x90,0x78,0x56,0x34,0x12,0x34,0x12,0x78,0x56,0x34,0x12,0x01,0xEF,0xCD,0xAB };
@@ -64,50 +153,259 @@ static const uint8_t UWB_CFG_UUID_128[16]  = { 0xAB,0x90,0x78,0x56,0x34,0x12,0x3
 static esp_bt_uuid_t uuid16(uint16_t u){ esp_bt_uuid_t x={.len=ESP_UUID_LEN_16,.uuid.uuid16=u}; return x; }
 static esp_bt_uuid_t uuid128(const uint8_t u[16]){ esp_bt_uuid_t x={.len=ESP_UUID_LEN_128}; memcpy(x.uuid.uuid128,u,16); return x; }
 
+/* ====== Link keresők ====== */
+static ble_link_t* link_by_conn(uint16_t conn_id){
+    for (int i=0;i<BLE_MAX_LINKS;i++)
+        if (s_links[i].used && s_links[i].connected && s_links[i].conn_id == conn_id) return &s_links[i];
+    return NULL;
+}
+static ble_link_t* link_connecting(const esp_bd_addr_t bda){
+    for (int i=0;i<BLE_MAX_LINKS;i++)
+        if (s_links[i].used && s_links[i].connecting && memcmp(s_links[i].bda, bda, 6)==0) return &s_links[i];
+    return NULL;
+}
+static bool bda_in_use(const esp_bd_addr_t bda);
+static ble_link_t* link_by_bda(const esp_bd_addr_t bda){
+    for (int i=0;i<BLE_MAX_LINKS;i++)
+        if (s_links[i].used && s_links[i].connected && memcmp(s_links[i].bda, bda, 6)==0) return &s_links[i];
+    return NULL;
+}
+static bool bda_in_use(const esp_bd_addr_t bda){
+    for (int i=0;i<BLE_MAX_LINKS;i++)
+        if (s_links[i].used && (s_links[i].connected || s_links[i].connecting) && memcmp(s_links[i].bda, bda, 6)==0) return true;
+    return false;
+}
+static bool all_connected(void){
+    for (int i=0;i<BLE_MAX_LINKS;i++) if (s_links[i].used && !s_links[i].connected) return false;
+    return true;
+}
+static inline uint8_t link_idx(const ble_link_t* l){ return (uint8_t)(l - s_links); }
+
 // ---- SCAN/CONNECT sorosítás + védett hívások ----
-static esp_err_t start_scan_safe(uint32_t dur_sec);
-static esp_err_t gattc_open_safe(esp_gatt_if_t ifx, const esp_bd_addr_t addr, esp_ble_addr_type_t type);
 
-static esp_err_t start_scan_safe(uint32_t dur_sec)
+/* start_scan_safe lépései. scan_plan dönt és foglal (g_connecting / l->connecting,
+ * ill. s_scan_pending), scan_exec hívja a stacket, hibánál scan_undo enged el.
+ * A BTC task a zárat a teljes soron át fogja; az újrascan időzítő csak a
+ * döntést és a visszavonást, mert a stack hívás tele BTC sornál blokkol, a BTC
+ * pedig ekkor épp a zárra várhat. */
+typedef enum { SCAN_NONE, SCAN_BUSY, SCAN_OPEN, SCAN_PARAMS, SCAN_START } scan_act_t;
+typedef struct { scan_act_t a; ble_link_t* l; bool stop; } scan_plan_t;
+
+static scan_plan_t scan_plan(void)
 {
-    if (g_connecting) return ESP_ERR_INVALID_STATE;
+    scan_plan_t p = { SCAN_NONE, NULL, false };
+    if (g_connecting) { p.a = SCAN_BUSY; return p; }
+    if (all_connected()) return p;                   /* minden anchor megvan */
 
-    if (!s_params_set) {
-        /* Paramok még nincsenek beállítva → most kérjük be.
-           A START a SET_COMPLETE eseményben történik. */
-        return esp_ble_gap_set_scan_params(&s_scan_params);
+    /* ismert peer: scan nélkül, közvetlen open a cache-elt címre */
+    for (int i=0;i<BLE_MAX_LINKS;i++){
+        ble_link_t* l = &s_links[i];
+        if (!l->used || l->connected || l->connecting || !l->cache_ok || l->direct_fail) continue;
+        if (bda_in_use(l->cache.bda)) continue;
+        memcpy(l->bda, l->cache.bda, 6);
+        l->addr_type = l->cache.addr_type;
+        l->direct = true;
+        l->connecting = true;
+        g_connecting = true;
+        p.a = SCAN_OPEN; p.l = l; p.stop = s_scan_active;
+        return p;                                    /* a scan a következő körben */
     }
-
+    /* Paramok még nincsenek beállítva → most kérjük be. A START a SET_COMPLETE eseményben. */
+    if (!s_params_set) { p.a = SCAN_PARAMS; return p; }
     /* Már fut vagy épp indul → ne indítsuk újra. */
-    if (s_scan_active || s_scan_pending) {
+    if (s_scan_active || s_scan_pending) { p.a = SCAN_BUSY; return p; }
+    s_scan_pending = true;                           /* START kérve, még nem aktív */
+    p.a = SCAN_START;
+    return p;
+}
+
+static esp_err_t scan_exec(const scan_plan_t* p, uint32_t dur_sec)
+{
+    esp_err_t er;
+    switch (p->a) {
+    case SCAN_OPEN:
+        if (p->stop) esp_ble_gap_stop_scanning();
+        er = esp_ble_gattc_open(g_gattc_if, p->l->bda, p->l->addr_type, true);
+        if (er == ESP_OK) ESP_LOGI(TAG, "[%u] direct open (cached peer)", link_idx(p->l));
+        return er;
+    case SCAN_PARAMS:
+        return esp_ble_gap_set_scan_params(&s_scan_params);
+    case SCAN_START:
+        er = esp_ble_gap_start_scanning(dur_sec);
+        if (er == ESP_OK) metric_inc(M_BLE_SCAN_START);
+        return er;
+    case SCAN_BUSY:
         return ESP_ERR_INVALID_STATE;
+    default:
+        return ESP_OK;
     }
+}
 
-    /* Ha biztosan fut, állítsuk meg, majd indulunk. */
-    if (s_scan_active) {
-        esp_ble_gap_stop_scanning();
-        /* STOP_COMPLETE-ben s_scan_active = false lesz. Várakozás nem kell. */
+static void scan_undo(const scan_plan_t* p)
+{
+    if (p->a == SCAN_OPEN) {                         /* engedjük újrapróbálni, scannel */
+        g_connecting = false;
+        p->l->connecting = false;
+        p->l->direct = false;
+        p->l->direct_fail++;
+    } else if (p->a == SCAN_START) {
+        s_scan_pending = false;
     }
+}
 
-    esp_err_t er = esp_ble_gap_start_scanning(dur_sec);
-    if (er == ESP_OK) {
-        s_scan_pending = true;   /* START kérve, még nem aktív */
+/* hívó fogja s_conn_mx-et (BTC task) */
+static esp_err_t start_scan_safe(uint32_t dur_sec)
+{
+    for (;;) {
+        const scan_plan_t p = scan_plan();
+        const esp_err_t er = scan_exec(&p, dur_sec);
+        if (er == ESP_OK || p.a < SCAN_OPEN) return er;
+        scan_undo(&p);
+        if (p.a != SCAN_OPEN) return er;             /* sikertelen direkt open → következő / scan */
     }
-    return er;
 }
 
-static esp_err_t gattc_open_safe(esp_gatt_if_t ifx, const esp_bd_addr_t addr, esp_ble_addr_type_t type)
+static esp_err_t gattc_open_safe(ble_link_t* l)
 {
     if (s_scan_active) esp_ble_gap_stop_scanning();
     if (g_connecting)  return ESP_ERR_INVALID_STATE;
     g_connecting = true;
-    esp_err_t er = esp_ble_gattc_open(ifx, (uint8_t*)addr, type, true);
-    if (er != ESP_OK) g_connecting = false;   /* ha azonnal hibázik, engedjük újrapróbálni */
+    l->connecting = true;
+    esp_err_t er = esp_ble_gattc_open(g_gattc_if, l->bda, l->addr_type, true);
+    if (er != ESP_OK) { g_connecting = false; l->connecting = false; }  /* engedjük újrapróbálni */
     return er;
 }
 
-/* publikus cb-regisztráció */
-void ble_register_notify_cb(ble_notify_cb_t cb){ g_cb = cb; }
+/* publikus cb-regisztráció: hozzáad a fan-out listához (duplikátum nélkül) */
+void ble_register_notify_cb(ble_notify_cb_t cb)
+{
+    if (!cb) return;
+    bool full = true;
+    portENTER_CRITICAL(&s_subs_lock);
+    for (int i = 0; i < BLE_MAX_SUBSCRIBERS; i++) {
+        if (g_subs[i] == cb) { full = false; break; }
+        if (!g_subs[i]) { g_subs[i] = cb; full = false; break; }
+    }
+    portEXIT_CRITICAL(&s_subs_lock);
+    if (full) ESP_LOGW(TAG, "notify subscriber list full");
+}
+
+void ble_register_ready_cb(ble_ready_cb_t cb) { s_ready_cb = cb; }
+
+void ble_get_rx_stats(ble_rx_stats_t* out)
+{
+    if (!out) return;
+    notify_ring_stats_t st;
+    notify_ring_get_stats(&s_rx_ring, &st);
+    out->pushed     = st.pushed;
+    out->popped     = st.popped;
+    out->dropped    = st.dropped;
+    out->truncated  = st.truncated;
+    out->high_water = st.high_water;
+    out->capacity   = NOTIFY_RING_SLOTS;
+}
+
+/* ====== Anchor lista ====== */
+static bool parse_bda(const char* s, esp_bd_addr_t out){
+    unsigned b[6];
+    if (strlen(s) != 17) return false;
+    if (sscanf(s, "%2x:%2x:%2x:%2x:%2x:%2x", &b[0],&b[1],&b[2],&b[3],&b[4],&b[5]) != 6) return false;
+    for (int i=0;i<6;i++) out[i] = (uint8_t)b[i];
+    return true;
+}
+
+int ble_add_anchor(const char* name_or_addr)
+{
+    for (int i=0;i<BLE_MAX_LINKS;i++){
+        ble_link_t* l = &s_links[i];
+        if (l->used) continue;
+        memset(l, 0, sizeof(*l));
+        l->used = true;
+        if (name_or_addr) {
+            strncpy(l->filter, name_or_addr, sizeof(l->filter)-1);
+            l->by_addr = parse_bda(l->filter, l->filt_bda);
+        }
+        ESP_LOGI(TAG, "anchor[%d] filter=\"%s\"%s", i, l->filter, l->by_addr ? " (addr)" : "");
+        return i;
+    }
+    return -1;
+}
+
+uint8_t ble_link_count(void)
+{
+    uint8_t n=0;
+    for (int i=0;i<BLE_MAX_LINKS;i++) if (s_links[i].used) n++;
+    return n;
+}
+
+bool ble_link_info(uint8_t link, ble_link_info_t* out)
+{
+    if (link >= BLE_MAX_LINKS || !s_links[link].used || !out) return false;
+    const ble_link_t* l = &s_links[link];
+    memset(out, 0, sizeof(*out));
+    strncpy(out->filter, l->filter, sizeof(out->filter)-1);
+    memcpy(out->bda, l->bda, 6);
+    out->connected    = l->connected;
+    out->conn_id      = l->conn_id;
+    out->mtu          = l->mtu;
+    out->notifies     = l->notifies;
+    out->notify_bytes = l->notify_bytes;
+    out->connects     = l->connects;
+    portENTER_CRITICAL(&s_wq_lock);
+    const wq_stats_t st = l->wq.st;
+    out->wq_depth     = wq_depth(&l->wq);
+    portEXIT_CRITICAL(&s_wq_lock);
+    out->wq_high      = st.high_water;
+    out->writes       = st.done;
+    out->write_nr     = st.no_rsp;
+    out->write_long   = st.longw;
+    out->write_err    = st.failed;
+    out->wq_full      = st.full;
+
+    out->conn_int     = l->conn_int;
+    out->conn_latency = l->conn_lat;
+    out->conn_timeout = l->conn_tmo;
+    out->tx_len       = l->tx_len;
+    out->rx_len       = l->rx_len;
+    out->tx_phy       = l->tx_phy;
+    out->rx_phy       = l->rx_phy;
+    out->cached       = l->cache_ok;
+    out->fast         = l->fast;
+    out->reconnect_ms = l->reconnect_ms;
+    out->fast_opens   = l->fast_opens;
+    out->discoveries  = l->discoveries;
+    if (l->connected) {
+        const int64_t now = esp_timer_get_time();
+        out->up_us = now - l->up_us;
+        /* elnémult link: az ablakot nem zárja notify, a mostani állás számít */
+        const int64_t dt = now - l->gp_t_us;
+        if (dt >= 2 * BLE_GOODPUT_WIN_US) {
+            out->rx_mhz = (uint32_t)((uint64_t)(l->notifies - l->gp_n) * 1000000000ULL / dt);
+            out->rx_Bps = (uint32_t)((uint64_t)(l->notify_bytes - l->gp_b) * 1000000ULL / dt);
+        } else {
+            out->rx_mhz = l->gp_mhz;
+            out->rx_Bps = l->gp_Bps;
+        }
+    }
+    return true;
+}
+
+/* ====== RX fogyasztó task ======
+ * A BTC task csak bemásol a gyűrűbe; parser/log/webserver itt fut. */
+static void rx_task(void* arg)
+{
+    (void)arg;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        const notify_frame_t* f;
+        while ((f = notify_ring_peek(&s_rx_ring)) != NULL) {
+            metric_observe(H_BLE_RX_LAT_US, (uint32_t)(esp_timer_get_time() - f->ts_us));
+            for (int i = 0; i < BLE_MAX_SUBSCRIBERS && g_subs[i]; i++)
+                g_subs[i](f->link, f->data, f->len, f->from_cfg);
+            notify_ring_release(&s_rx_ring);
+        }
+    }
+}
 
 /* ====== Segédek ====== */
 static bool adv_name_match(const uint8_t* adv, uint8_t len, const char* filter){
@@ -118,38 +416,197 @@ static bool adv_name_match(const uint8_t* adv, uint8_t len, const char* filter){
     return (name && nlen && nlen == strlen(filter) && memcmp(name, filter, nlen)==0);
 }
 
-static void reset_gatt_state(void){
-    g_start_handle=g_end_handle=0;
-    g_data_h=g_cfg_h=0;
-    g_data_ccc_h=g_cfg_ccc_h=0;
+static bool link_match(const ble_link_t* l, const esp_ble_gap_cb_param_t* p){
+    if (l->by_addr) return memcmp(l->filt_bda, p->scan_rst.bda, 6)==0;
+    return adv_name_match(p->scan_rst.ble_adv, p->scan_rst.adv_data_len, l->filter);
+}
+
+static void reset_gatt_state(ble_link_t* l){
+    l->start_h=l->end_h=0;
+    l->data_h=l->cfg_h=0;
+    l->data_ccc_h=l->cfg_ccc_h=0;
+    l->cfg_props=0;
+    l->mtu=23;
+    l->congested=false;
+    l->conn_int=l->conn_lat=l->conn_tmo=0;
+    l->tx_len=l->rx_len=27;
+    l->tx_phy=l->rx_phy=1;
+    l->dle_pending=false;
+    l->gp_mhz=l->gp_Bps=0;
+}
+
+/* ====== Link hangolás ======
+ * OPEN után: connection interval / latency / supervision timeout kérés,
+ * LL data length extension, és BLE 5 controllernél 2M PHY. A ténylegesen
+ * megkapott értékek a GAP eseményekből jönnek (ble_link_info). */
+static void tune_link(ble_link_t* l)
+{
+    portENTER_CRITICAL(&s_par_lock);
+    const ble_link_params_t c = s_par;
+    portEXIT_CRITICAL(&s_par_lock);
+
+    esp_ble_conn_update_params_t cp = {
+        .min_int = c.min_int, .max_int = c.max_int,
+        .latency = c.latency, .timeout = c.timeout,
+    };
+    memcpy(cp.bda, l->bda, 6);
+    esp_err_t er = esp_ble_gap_update_conn_params(&cp);
+    if (er != ESP_OK) ESP_LOGW(TAG, "[%u] conn param update rc=0x%x", link_idx(l), er);
+
+    if (c.data_len) {
+        l->dle_pending = (esp_ble_gap_set_pkt_data_len(l->bda, c.data_len) == ESP_OK);
+        if (!l->dle_pending) ESP_LOGW(TAG, "[%u] data length req failed", link_idx(l));
+    }
+#if CONFIG_BT_BLE_50_FEATURES_SUPPORTED
+    if (c.phy_2m)
+        esp_ble_gap_set_preferred_phy(l->bda, 0, ESP_BLE_GAP_PHY_2M_PREF_MASK | ESP_BLE_GAP_PHY_1M_PREF_MASK,
+                                      ESP_BLE_GAP_PHY_2M_PREF_MASK | ESP_BLE_GAP_PHY_1M_PREF_MASK,
+                                      ESP_BLE_GAP_PHY_OPTIONS_NO_PREF);
+#endif
+}
+
+static void goodput_roll(ble_link_t* l, int64_t now)
+{
+    const int64_t dt = now - l->gp_t_us;
+    if (dt < BLE_GOODPUT_WIN_US) return;
+    l->gp_mhz  = (uint32_t)((uint64_t)(l->notifies - l->gp_n) * 1000000000ULL / dt);
+    l->gp_Bps  = (uint32_t)((uint64_t)(l->notify_bytes - l->gp_b) * 1000000ULL / dt);
+    l->gp_t_us = now;
+    l->gp_n    = l->notifies;
+    l->gp_b    = l->notify_bytes;
+}
+
+void ble_get_link_params(ble_link_params_t* out)
+{
+    portENTER_CRITICAL(&s_par_lock); *out = s_par; portEXIT_CRITICAL(&s_par_lock);
+}
+
+esp_err_t ble_set_link_params(const ble_link_params_t* c, bool apply_now)
+{
+    if (!c) return ESP_ERR_INVALID_ARG;
+    if (c->min_int < 6 || c->max_int > 3200 || c->min_int > c->max_int) return ESP_ERR_INVALID_ARG;
+    if (c->latency > 499 || c->timeout < 10 || c->timeout > 3200) return ESP_ERR_INVALID_ARG;
+    /* supervision timeout > (1 + latency) * interval * 2 */
+    if ((uint32_t)c->timeout * 4 <= (1u + c->latency) * c->max_int) return ESP_ERR_INVALID_ARG;
+    if (c->data_len && (c->data_len < 27 || c->data_len > 251)) return ESP_ERR_INVALID_ARG;
+    portENTER_CRITICAL(&s_par_lock); s_par = *c; portEXIT_CRITICAL(&s_par_lock);
+    ESP_LOGI(TAG, "link params int=%u..%u lat=%u tmo=%u dle=%u 2m=%d",
+             c->min_int, c->max_int, c->latency, c->timeout, c->data_len, c->phy_2m);
+    if (apply_now)
+        for (int i = 0; i < BLE_MAX_LINKS; i++)
+            if (s_links[i].used && s_links[i].connected) tune_link(&s_links[i]);
+    return ESP_OK;
 }
 
 /* ====== GAP ====== */
 static void gap_cb(esp_gap_ble_cb_event_t e, esp_ble_gap_cb_param_t* p);
 
 static void start_scan(void){
+    CONN_LOCK();
     esp_err_t er = start_scan_safe(0);
+    CONN_UNLOCK();
     ESP_LOGI(TAG, "scan start (safe) rc=0x%x", er);
 }
 
+/* esp_timer task: a stack hívás a záron kívül (lásd scan_plan) */
+static void rescan_tmr_cb(void* arg)
+{
+    (void)arg;
+    for (;;) {
+        CONN_LOCK();
+        const scan_plan_t p = scan_plan();
+        CONN_UNLOCK();
+        if (scan_exec(&p, 0) == ESP_OK || p.a < SCAN_OPEN) return;
+        CONN_LOCK();
+        scan_undo(&p);
+        CONN_UNLOCK();
+        if (p.a != SCAN_OPEN) return;
+    }
+}
+
+/* ms múlva start_scan_safe; a már ütemezettet újraindítja */
+static void schedule_rescan(uint32_t ms)
+{
+    esp_timer_stop(s_rescan_tmr);                 /* nem futónál ESP_ERR_INVALID_STATE: mindegy */
+    esp_timer_start_once(s_rescan_tmr, (uint64_t)ms * 1000);
+}
+
 /* ====== GATTC ====== */
 static void gattc_cb(esp_gattc_cb_event_t e, esp_gatt_if_t gattc_if, esp_ble_gattc_cb_param_t* p);
 
+/* ====== Handle cache (NVS) ====== */
+static void cache_key(const ble_link_t* l, char key[4]){ snprintf(key, 4, "l%u", link_idx(l)); }
+
+static void cache_load(ble_link_t* l)
+{
+    ble_cache_t c; size_t n = sizeof(c); char key[4];
+    cache_key(l, key);
+    l->cache_ok = false;
+    if (!s_nvs || nvs_get_blob(s_nvs, key, &c, &n) != ESP_OK || n != sizeof(c)) return;
+    if (c.ver != BLE_CACHE_VER || strncmp(c.filter, l->filter, sizeof(c.filter)) || !c.data_h || !c.cfg_h
+        || !c.data_ccc_h || !c.cfg_ccc_h) return;
+    l->cache = c;
+    l->cache_ok = true;
+    ESP_LOGI(TAG, "[%u] cached peer %02X:%02X:%02X:%02X:%02X:%02X data=0x%04X cfg=0x%04X", link_idx(l),
+             c.bda[0], c.bda[1], c.bda[2], c.bda[3], c.bda[4], c.bda[5], c.data_h, c.cfg_h);
+}
+
+/* felderítés után: csak változáskor ír (flash kímélés) */
+static void cache_store(ble_link_t* l)
+{
+    if (!l->data_h || !l->cfg_h || !l->data_ccc_h || !l->cfg_ccc_h) return;
+    ble_cache_t c;
+    memset(&c, 0, sizeof(c));
+    c.ver = BLE_CACHE_VER;
+    c.addr_type = (uint8_t)l->addr_type;
+    memcpy(c.bda, l->bda, 6);
+    c.start_h = l->start_h;  c.end_h = l->end_h;
+    c.data_h = l->data_h;    c.cfg_h = l->cfg_h;
+    c.data_ccc_h = l->data_ccc_h; c.cfg_ccc_h = l->cfg_ccc_h;
+    c.cfg_props = l->cfg_props;
+    memcpy(c.filter, l->filter, sizeof(c.filter));
+    if (l->cache_ok && !memcmp(&c, &l->cache, sizeof(c))) return;
+    l->cache = c;
+    l->cache_ok = true;
+    char key[4]; cache_key(l, key);
+    esp_err_t er = s_nvs ? nvs_set_blob(s_nvs, key, &c, sizeof(c)) : ESP_ERR_INVALID_STATE;
+    if (er == ESP_OK) er = nvs_commit(s_nvs);
+    ESP_LOGI(TAG, "[%u] handle cache stored rc=0x%x", link_idx(l), er);
+}
+
 /* ====== Publikus API ====== */
 esp_err_t ble_start(const char* name_filter, ble_notify_cb_t cb)
 {
-    if (name_filter) {
-        strncpy(g_name_filter, name_filter, sizeof(g_name_filter)-1);
-        g_name_filter[sizeof(g_name_filter)-1]=0;
-    } else {
-        g_name_filter[0]=0;
+    /* "NEV1,NEV2,AA:BB:CC:DD:EE:FF" → anchoronként egy slot; üres → bármely eszköz */
+    if (name_filter && name_filter[0]) {
+        char tmp[BLE_MAX_LINKS * 33];
+        strncpy(tmp, name_filter, sizeof(tmp)-1); tmp[sizeof(tmp)-1]=0;
+        for (char* tok = strtok(tmp, ","); tok; tok = strtok(NULL, ",")) {
+            while (isspace((unsigned char)*tok)) tok++;
+            if (*tok && ble_add_anchor(tok) < 0) ESP_LOGW(TAG, "anchor list full, \"%s\" skipped", tok);
+        }
     }
-    g_cb = cb;
+    if (!ble_link_count()) ble_add_anchor(NULL);
+    ble_register_notify_cb(cb);
 
-    esp_err_t er;
-    if ((er = nvs_flash_init()) == ESP_ERR_NVS_NO_FREE_PAGES || er == ESP_ERR_NVS_NEW_VERSION_FOUND) {
-        ESP_ERROR_CHECK(nvs_flash_erase());
-        ESP_ERROR_CHECK(nvs_flash_init());
+    notify_ring_init(&s_rx_ring);
+    if (!s_rx_task && xTaskCreate(rx_task, "ble_rx", 4096, NULL, 5, &s_rx_task) != pdPASS) {
+        ESP_LOGE(TAG, "rx task create failed");
+        return ESP_ERR_NO_MEM;
+    }
+    if (!s_conn_mx && !(s_conn_mx = xSemaphoreCreateMutex())) return ESP_ERR_NO_MEM;
+    if (!s_rescan_tmr) {
+        const esp_timer_create_args_t ta = { .callback = rescan_tmr_cb, .name = "ble_rescan" };
+        esp_err_t er = esp_timer_create(&ta, &s_rescan_tmr);
+        if (er != ESP_OK) return er;
+    }
+
+    if (nvs_open("ble_cache", NVS_READWRITE, &s_nvs) != ESP_OK) s_nvs = 0;
+    const int64_t t0 = esp_timer_get_time();
+    for (int i = 0; i < BLE_MAX_LINKS; i++) {
+        if (!s_links[i].used) continue;
+        cache_load(&s_links[i]);
+        s_links[i].t_down_us = t0;            /* első kapcsolat ideje is mérve */
     }
 
     // BLE-only mód + Classic BT memória felszabadítás
@@ -171,6 +628,7 @@ esp_err_t ble_start(const char* name_filter, ble_notify_cb_t cb)
 /* ====== GAP CB ====== */
 static void gap_cb(esp_gap_ble_cb_event_t e, esp_ble_gap_cb_param_t* p)
 {
+    CONN_LOCK();
     switch (e) {
     case ESP_GAP_BLE_SCAN_PARAM_SET_COMPLETE_EVT:
         s_params_set = (p->scan_param_cmpl.status == ESP_BT_STATUS_SUCCESS);
@@ -189,11 +647,15 @@ static void gap_cb(esp_gap_ble_cb_event_t e, esp_ble_gap_cb_param_t* p)
 
     case ESP_GAP_BLE_SCAN_RESULT_EVT: {
         const esp_ble_gap_cb_param_t* sr = p;
-        if (sr->scan_rst.search_evt == ESP_GAP_SEARCH_INQ_RES_EVT) {
-            if (!g_connecting && adv_name_match(sr->scan_rst.ble_adv, sr->scan_rst.adv_data_len, g_name_filter)) {
-                memcpy(g_peer_bda, p->scan_rst.bda, 6);
-                g_peer_addr_type = p->scan_rst.ble_addr_type;
-                gattc_open_safe(g_gattc_if, g_peer_bda, g_peer_addr_type);
+        if (sr->scan_rst.search_evt == ESP_GAP_SEARCH_INQ_RES_EVT && !g_connecting
+            && !bda_in_use(sr->scan_rst.bda)) {
+            for (int i=0;i<BLE_MAX_LINKS;i++){
+                ble_link_t* l = &s_links[i];
+                if (!l->used || l->connected || l->connecting || !link_match(l, sr)) continue;
+                memcpy(l->bda, sr->scan_rst.bda, 6);
+                l->addr_type = sr->scan_rst.ble_addr_type;
+                gattc_open_safe(l);
+                break;
             }
         }
         break;
@@ -204,18 +666,305 @@ static void gap_cb(esp_gap_ble_cb_event_t e, esp_ble_gap_cb_param_t* p)
         s_scan_pending = false;   /* biztosan nincs folyamatban indítás */
         break;
 
+    case ESP_GAP_BLE_UPDATE_CONN_PARAMS_EVT: {
+        ble_link_t* l = link_by_bda(p->update_conn_params.bda);
+        if (!l) break;
+        if (p->update_conn_params.status == ESP_BT_STATUS_SUCCESS) {
+            l->conn_int = p->update_conn_params.conn_int;
+            l->conn_lat = p->update_conn_params.latency;
+            l->conn_tmo = p->update_conn_params.timeout;
+        }
+        ESP_LOGI(TAG, "[%u] conn params st=0x%x int=%u (x1.25ms) lat=%u tmo=%u (x10ms)", link_idx(l),
+                 p->update_conn_params.status, l->conn_int, l->conn_lat, l->conn_tmo);
+        break;
+    }
+
+    case ESP_GAP_BLE_SET_PKT_LENGTH_COMPLETE_EVT: {
+        /* az esemény nem hordoz címet: a legrégebbi függő kérésé */
+        ble_link_t* l = NULL;
+        for (int i = 0; i < BLE_MAX_LINKS && !l; i++) if (s_links[i].dle_pending) l = &s_links[i];
+        if (!l) break;
+        l->dle_pending = false;
+        if (p->pkt_data_length_cmpl.status == ESP_BT_STATUS_SUCCESS) {
+            l->tx_len = p->pkt_data_length_cmpl.params.tx_len;
+            l->rx_len = p->pkt_data_length_cmpl.params.rx_len;
+        }
+        ESP_LOGI(TAG, "[%u] data length st=0x%x tx=%u rx=%u", link_idx(l),
+                 p->pkt_data_length_cmpl.status, l->tx_len, l->rx_len);
+        break;
+    }
+
+#if CONFIG_BT_BLE_50_FEATURES_SUPPORTED
+    case ESP_GAP_BLE_PHY_UPDATE_COMPLETE_EVT: {
+        ble_link_t* l = link_by_bda(p->phy_update.bda);
+        if (l && p->phy_update.status == ESP_BT_STATUS_SUCCESS) {
+            l->tx_phy = p->phy_update.tx_phy;
+            l->rx_phy = p->phy_update.rx_phy;
+        }
+        break;
+    }
+#endif
+
     default:
         break;
     }
+    CONN_UNLOCK();
+}
+
+/* ====== Írási sor ======
+ * Minden GATT írás (CCC, GET, SET) a link során megy: a hívó bemásol egy
+ * előre foglalt slotba, a kiadás FIFO sorrendben, legfeljebb s_wq_window
+ * írás van a stacknél; a WRITE_CHAR / WRITE_DESCR / EXEC esemény zárja.
+ * Egyszerre egy kiadó (wq.pumping), így a stack is sorrendben kapja. */
+/* Prepared írás: a slot mezői (off, chunk, err) s_wq_lock alatt változnak, a
+ * stack hívás a záron kívül, a zár alatt rögzített off / chunk értékkel. A
+ * buf a SENT slotban nem változik, az olvasható zár nélkül is. */
+static inline uint16_t prep_len(const ble_link_t* l, const wq_slot_t* s)
+{
+    uint16_t n = s->len - s->off;
+    return n > l->mtu - 5 ? l->mtu - 5 : n;           /* Prepare Write: 5 B fejléc */
+}
+
+static esp_err_t prep_send(ble_link_t* l, const wq_slot_t* s, uint16_t off, uint16_t n)
+{
+    return esp_ble_gattc_prepare_write(g_gattc_if, l->conn_id, s->handle, off, n,
+                                       (uint8_t*)s->buf + off, ESP_GATT_AUTH_REQ_NONE);
+}
+
+static esp_err_t wq_issue(ble_link_t* l, wq_slot_t* s)
+{
+    if (s->kind == WQ_DESCR)
+        return esp_ble_gattc_write_char_descr(g_gattc_if, l->conn_id, s->handle, s->len, s->buf,
+                                              ESP_GATT_WRITE_TYPE_RSP, ESP_GATT_AUTH_REQ_NONE);
+    if (s->is_long) return prep_send(l, s, 0, s->chunk);
+    return esp_ble_gattc_write_char(g_gattc_if, l->conn_id, s->handle, s->len, s->buf,
+                                    s->no_rsp ? ESP_GATT_WRITE_TYPE_NO_RSP : ESP_GATT_WRITE_TYPE_RSP,
+                                    ESP_GATT_AUTH_REQ_NONE);
+}
+
+static void wq_pump(ble_link_t* l)
+{
+    portENTER_CRITICAL(&s_wq_lock);
+    if (l->wq.pumping) { portEXIT_CRITICAL(&s_wq_lock); return; }
+    l->wq.pumping = true;
+    for (;;) {
+        wq_slot_t* s = (l->connected && !l->congested) ? wq_next(&l->wq, s_wq_window, l->mtu - 3) : NULL;
+        if (!s) break;
+        if (s->is_long) s->chunk = prep_len(l, s);   /* első darab; off == 0 */
+        portEXIT_CRITICAL(&s_wq_lock);
+        esp_err_t er = wq_issue(l, s);               /* a stack bemásolja az értéket */
+        portENTER_CRITICAL(&s_wq_lock);
+        if (er != ESP_OK) wq_fail(&l->wq, s);
+        if (er != ESP_OK) metric_inc(M_BLE_WRITE_ERR);
+    }
+    l->wq.pumping = false;
+    portEXIT_CRITICAL(&s_wq_lock);
+}
+
+static esp_err_t wq_submit(ble_link_t* l, uint8_t kind, bool no_rsp, uint16_t handle,
+                           const void* hdr, uint16_t hlen, const void* data, uint16_t len)
+{
+    const int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&s_wq_lock);
+    wq_slot_t* s = wq_push(&l->wq, kind, no_rsp, handle, hdr, hlen, data, len, now);
+    portEXIT_CRITICAL(&s_wq_lock);
+    if (!s) { metric_inc(M_BLE_WQ_FULL); return ESP_ERR_NO_MEM; }
+    wq_pump(l);
+    return ESP_OK;
+}
+
+/* completion (BTC task): a legrégebbi kiadott írás lezárása, utána a sor tovább */
+static void wq_done(ble_link_t* l, bool ok)
+{
+    int64_t t0 = 0;
+    portENTER_CRITICAL(&s_wq_lock);
+    bool had = wq_complete(&l->wq, ok, &t0);
+    portEXIT_CRITICAL(&s_wq_lock);
+    if (had) {
+        metric_inc(ok ? M_BLE_WRITE : M_BLE_WRITE_ERR);
+        metric_observe(H_BLE_WRITE_US, (uint32_t)(esp_timer_get_time() - t0));
+    }
+    wq_pump(l);
+}
+
+/* prepared írás: következő darab, vagy execute (hibánál cancel) */
+static void wq_prep_evt(ble_link_t* l, esp_gatt_status_t st)
+{
+    uint16_t off = 0, n = 0;
+    bool err;
+    portENTER_CRITICAL(&s_wq_lock);
+    wq_slot_t* s = wq_oldest_sent(&l->wq);
+    if (!s || !s->is_long) { portEXIT_CRITICAL(&s_wq_lock); return; }
+    if (st == ESP_GATT_OK) {
+        s->off += s->chunk;
+        if (s->off < s->len) { off = s->off; n = s->chunk = prep_len(l, s); }
+    } else {
+        s->err = true;
+    }
+    err = s->err;
+    portEXIT_CRITICAL(&s_wq_lock);
+
+    if (n) {
+        if (prep_send(l, s, off, n) == ESP_OK) return;
+        portENTER_CRITICAL(&s_wq_lock);
+        s->err = err = true;
+        portEXIT_CRITICAL(&s_wq_lock);
+    }
+    if (esp_ble_gattc_execute_write(g_gattc_if, l->conn_id, !err) != ESP_OK) wq_done(l, false);
 }
 
 /* ====== CCC write ====== */
-static void enable_ccc(uint16_t ccc_handle){
-    uint8_t val[2] = {0x01, 0x00}; // notifications
-    esp_ble_gattc_write_char_descr(g_gattc_if, g_conn_id, ccc_handle,
-                                   sizeof(val), val,
-                                   ESP_GATT_WRITE_TYPE_RSP,
-                                   ESP_GATT_AUTH_REQ_NONE);
+static void enable_ccc(ble_link_t* l, uint16_t ccc_handle){
+    static const uint8_t val[2] = {0x01, 0x00}; // notifications
+    wq_submit(l, WQ_DESCR, false, ccc_handle, val, sizeof(val), NULL, 0);
+}
+
+/* ====== Szolgáltatás/karakterisztika feloldás (SEARCH_CMPL) ====== */
+static void resolve_chars(ble_link_t* l)
+{
+    if (!l->start_h || !l->end_h){
+        // Fallback: teljes tartomány
+        l->start_h = 0x0001; l->end_h = 0xFFFF;
+        ESP_LOGW(TAG, "[%u] service not found by UUID, fallback range 0x%04X..0x%04X",
+                 link_idx(l), l->start_h, l->end_h);
+    }
+
+    bool have_data=false, have_cfg=false;
+
+    // 1) UUID alapján
+    {
+        esp_gattc_char_elem_t chr[1]; uint16_t count=1;
+        esp_bt_uuid_t cu = uuid128(UWB_DATA_UUID_128);
+        if (esp_ble_gattc_get_char_by_uuid(g_gattc_if, l->conn_id,
+                l->start_h, l->end_h, cu, chr, &count) == ESP_GATT_OK && count) {
+            l->data_h = chr[0].char_handle; have_data=true;
+            ESP_LOGI(TAG, "[%u] DATA char=0x%04X", link_idx(l), l->data_h);
+        }
+    }
+    {
+        esp_gattc_char_elem_t chr[1]; uint16_t count=1;
+        esp_bt_uuid_t cu = uuid128(UWB_CFG_UUID_128);
+        if (esp_ble_gattc_get_char_by_uuid(g_gattc_if, l->conn_id,
+                l->start_h, l->end_h, cu, chr, &count) == ESP_GATT_OK && count) {
+            l->cfg_h = chr[0].char_handle; l->cfg_props = chr[0].properties; have_cfg=true;
+        }
+    }
+
+    // 2) Fallback: összes char, tulajdonság alapján
+    if (!have_data || !have_cfg){
+        uint16_t count=0;
+        if (esp_ble_gattc_get_attr_count(g_gattc_if, l->conn_id, ESP_GATT_DB_CHARACTERISTIC,
+                l->start_h, l->end_h, 0, &count)==ESP_GATT_OK && count){
+            esp_gattc_char_elem_t* list = calloc(count, sizeof(*list));
+            if (list && esp_ble_gattc_get_all_char(g_gattc_if, l->conn_id,
+                    l->start_h, l->end_h, list, &count, 0)==ESP_GATT_OK){
+                for (int i=0;i<count;i++){
+                    uint8_t pr = list[i].properties;
+                    if (pr & ESP_GATT_CHAR_PROP_BIT_NOTIFY){
+                        if (!have_data && (pr & ESP_GATT_CHAR_PROP_BIT_READ)){
+                            l->data_h = list[i].char_handle; have_data=true;
+                            ESP_LOGI(TAG,"[%u] DATA char(enum)=0x%04X", link_idx(l), l->data_h);
+                        } else if (!have_cfg && ((pr & ESP_GATT_CHAR_PROP_BIT_WRITE) || (pr & ESP_GATT_CHAR_PROP_BIT_WRITE_NR))){
+                            l->cfg_h = list[i].char_handle; l->cfg_props = pr; have_cfg=true;
+                        }
+                    }
+                }
+            }
+            free(list);
+        }
+    }
+
+    // 3) CCC-k + feliratkozás
+    if (l->data_h){
+        esp_gattc_descr_elem_t dsc[1]; uint16_t count=1;
+        if (esp_ble_gattc_get_descr_by_char_handle(g_gattc_if, l->conn_id, l->data_h,
+                uuid16(ESP_GATT_UUID_CHAR_CLIENT_CONFIG), dsc, &count)==ESP_GATT_OK && count) {
+            l->data_ccc_h = dsc[0].handle;
+            esp_ble_gattc_register_for_notify(g_gattc_if, l->bda, l->data_h);
+            enable_ccc(l, l->data_ccc_h);
+        }
+    }
+    if (l->cfg_h){
+        esp_gattc_descr_elem_t dsc[1]; uint16_t count=1;
+        if (esp_ble_gattc_get_descr_by_char_handle(g_gattc_if, l->conn_id, l->cfg_h,
+                uuid16(ESP_GATT_UUID_CHAR_CLIENT_CONFIG), dsc, &count)==ESP_GATT_OK && count) {
+            l->cfg_ccc_h = dsc[0].handle;
+            esp_ble_gattc_register_for_notify(g_gattc_if, l->bda, l->cfg_h);
+            enable_ccc(l, l->cfg_ccc_h);
+        }
+    }
+
+    if (!l->data_h || !l->cfg_h){
+        ESP_LOGW(TAG, "[%u] char lookup incomplete; disconnect", link_idx(l));
+        esp_ble_gattc_close(g_gattc_if, l->conn_id);
+        return;
+    }
+    cache_store(l);
+}
+
+/* ====== Gyors út: cache-elt handle-ök ======
+ * Felderítés helyett a két CCC-t olvassuk vissza (2 B érték = a handle
+ * tényleg CCC); eltérésnél / hibánál a teljes felderítés jön. */
+static void discover(ble_link_t* l)
+{
+    l->validate = 0;
+    l->fast = false;
+    l->discoveries++;
+    // Szolgáltatás-keresés szűrő NÉLKÜL, később UUID-egyeztetés
+    esp_ble_gattc_search_service(g_gattc_if, l->conn_id, NULL);
+}
+
+static void validate_step(ble_link_t* l)
+{
+    const uint16_t h = l->validate == 1 ? l->cache.data_ccc_h : l->cache.cfg_ccc_h;
+    if (esp_ble_gattc_read_char_descr(g_gattc_if, l->conn_id, h, ESP_GATT_AUTH_REQ_NONE) != ESP_OK) discover(l);
+}
+
+static void use_cache(ble_link_t* l)
+{
+    const ble_cache_t* c = &l->cache;
+    l->validate   = 0;
+    l->start_h    = c->start_h;    l->end_h  = c->end_h;
+    l->data_h     = c->data_h;     l->cfg_h  = c->cfg_h;
+    l->data_ccc_h = c->data_ccc_h; l->cfg_ccc_h = c->cfg_ccc_h;
+    l->cfg_props  = c->cfg_props;
+    l->fast = true;
+    l->fast_opens++;
+    esp_ble_gattc_register_for_notify(g_gattc_if, l->bda, l->data_h);
+    esp_ble_gattc_register_for_notify(g_gattc_if, l->bda, l->cfg_h);
+    enable_ccc(l, l->data_ccc_h);
+    enable_ccc(l, l->cfg_ccc_h);
+    ESP_LOGI(TAG, "[%u] handles from cache, discovery skipped", link_idx(l));
+}
+
+static void validate_evt(ble_link_t* l, const esp_ble_gattc_cb_param_t* p)
+{
+    const uint16_t want = l->validate == 1 ? l->cache.data_ccc_h : l->cache.cfg_ccc_h;
+    if (p->read.status != ESP_GATT_OK || p->read.handle != want || p->read.value_len != 2) {
+        ESP_LOGW(TAG, "[%u] cached handle 0x%04X invalid (st=0x%x len=%u); discovering", link_idx(l),
+                 want, p->read.status, p->read.value_len);
+        l->cache_ok = false;
+        discover(l);
+        return;
+    }
+    if (l->validate == 1) { l->validate = 2; validate_step(l); }
+    else use_cache(l);
+}
+
+static void link_down(ble_link_t* l, int reason)
+{
+    ESP_LOGW(TAG, "[%u] disconnected; reason=0x%x", link_idx(l), reason);
+    metric_inc(M_BLE_DISCONNECT);
+    metric_gauge_add(G_BLE_LINKS_UP, -1);
+    l->connected = false;
+    l->connecting = false;
+    l->validate = 0;
+    l->t_down_us = esp_timer_get_time();
+    portENTER_CRITICAL(&s_wq_lock);
+    uint32_t n = wq_flush(&l->wq);
+    portEXIT_CRITICAL(&s_wq_lock);
+    if (n) metric_add(M_BLE_WRITE_ERR, n);
+    reset_gatt_state(l);
 }
 
 /* ====== GATTC CB ====== */
@@ -228,184 +977,265 @@ static void gattc_cb(esp_gattc_cb_event_t e, esp_gatt_if_t gattc_if, esp_ble_gat
         return;
     }
 
+    const bool conn_evt = (e == ESP_GATTC_OPEN_EVT || e == ESP_GATTC_CLOSE_EVT || e == ESP_GATTC_DISCONNECT_EVT);
+    if (conn_evt) CONN_LOCK();
     switch (e) {
-    case ESP_GATTC_OPEN_EVT:
+    case ESP_GATTC_OPEN_EVT: {
+        ble_link_t* l = link_connecting(p->open.remote_bda);
+        g_connecting = false;
+        if (!l) {
+            ESP_LOGW(TAG, "open evt for unknown peer; status=0x%x", p->open.status);
+            if (p->open.status == ESP_GATT_OK) esp_ble_gattc_close(g_gattc_if, p->open.conn_id);
+            start_scan_safe(0);
+            break;
+        }
+        l->connecting = false;
+        const bool direct = l->direct;
+        l->direct = false;
         if (p->open.status == ESP_GATT_OK) {
-            g_connecting = false;
-            g_conn_id = p->open.conn_id;
-            g_connected = true;
-            reset_gatt_state();
-            ESP_LOGI(TAG, "connected, conn_id=%u", g_conn_id);
-            esp_ble_gattc_send_mtu_req(g_gattc_if, g_conn_id);
-            // Szolgáltatás-keresés szűrő NÉLKÜL, később UUID-egyeztetés
-            esp_ble_gattc_search_service(g_gattc_if, g_conn_id, NULL);
+            l->direct_fail = 0;
+            l->conn_id = p->open.conn_id;
+            l->connected = true;
+            l->connects++;
+            metric_inc(M_BLE_CONNECT);
+            metric_gauge_add(G_BLE_LINKS_UP, 1);
+            reset_gatt_state(l);
+            l->up_us = l->gp_t_us = esp_timer_get_time();
+            l->gp_n = l->notifies;
+            l->gp_b = l->notify_bytes;
+            ESP_LOGI(TAG, "[%u] connected, conn_id=%u", link_idx(l), l->conn_id);
+            esp_ble_gattc_send_mtu_req(g_gattc_if, l->conn_id);
+            tune_link(l);
+            if (l->cache_ok && !memcmp(l->cache.bda, l->bda, 6)) { l->validate = 1; validate_step(l); }
+            else discover(l);
         } else {
-            ESP_LOGW(TAG, "open failed 0x%x; restart scan", p->open.status);
-            g_connecting = false;
-            vTaskDelay(pdMS_TO_TICKS(200));
-            start_scan_safe(0);
+            if (direct) l->direct_fail++;
+            ESP_LOGW(TAG, "[%u] open failed 0x%x%s; restart scan", link_idx(l), p->open.status,
+                     direct ? " (direct)" : "");
+            metric_inc(M_BLE_OPEN_FAIL);
+            schedule_rescan(BLE_RESCAN_OPEN_FAIL_MS);     /* a stack rendeződjön; a BTC task nem vár */
+            break;
         }
+        start_scan_safe(0);        /* a többi anchor keresése folytatódik */
         break;
+    }
 
-    case ESP_GATTC_CFG_MTU_EVT:
-        ESP_LOGI(TAG, "ATT_MTU=%u", p->cfg_mtu.mtu);
+    case ESP_GATTC_CFG_MTU_EVT: {
+        ble_link_t* l = link_by_conn(p->cfg_mtu.conn_id);
+        if (l && p->cfg_mtu.status == ESP_GATT_OK) l->mtu = p->cfg_mtu.mtu;
+        ESP_LOGI(TAG, "[%d] ATT_MTU=%u", l ? link_idx(l) : -1, p->cfg_mtu.mtu);
         break;
+    }
 
-    case ESP_GATTC_SEARCH_RES_EVT:
-        if (p->search_res.srvc_id.uuid.len == ESP_UUID_LEN_128) {
+    case ESP_GATTC_SEARCH_RES_EVT: {
+        ble_link_t* l = link_by_conn(p->search_res.conn_id);
+        if (l && p->search_res.srvc_id.uuid.len == ESP_UUID_LEN_128) {
             const uint8_t* u = p->search_res.srvc_id.uuid.uuid.uuid128;
             if (memcmp(u, UWB_SVC_UUID_128, 16)==0 || memcmp(u, UWB_SVC_UUID_128_BE, 16)==0) {
-                g_start_handle = p->search_res.start_handle;
-                g_end_handle   = p->search_res.end_handle;
-                ESP_LOGI(TAG, "svc found: 0x%04X..0x%04X", g_start_handle, g_end_handle);
+                l->start_h = p->search_res.start_handle;
+                l->end_h   = p->search_res.end_handle;
+                ESP_LOGI(TAG, "[%u] svc found: 0x%04X..0x%04X", link_idx(l), l->start_h, l->end_h);
             }
         }
         break;
+    }
 
     case ESP_GATTC_SEARCH_CMPL_EVT: {
-        if (!g_start_handle || !g_end_handle){
-            // Fallback: teljes tartomány
-            g_start_handle = 0x0001; g_end_handle = 0xFFFF;
-            ESP_LOGW(TAG, "service not found by UUID, fallback range 0x%04X..0x%04X",
-                     g_start_handle, g_end_handle);
-        }
-
-        bool have_data=false, have_cfg=false;
-
-        // 1) UUID alapján
-        {
-            esp_gattc_char_elem_t chr[1]; uint16_t count=1;
-            esp_bt_uuid_t cu = uuid128(UWB_DATA_UUID_128);
-            if (esp_ble_gattc_get_char_by_uuid(g_gattc_if, g_conn_id,
-                    g_start_handle, g_end_handle, cu, chr, &count) == ESP_GATT_OK && count) {
-                g_data_h = chr[0].char_handle; have_data=true;
-                ESP_LOGI(TAG, "DATA char=0x%04X", g_data_h);
-            }
-        }
-        {
-            esp_gattc_char_elem_t chr[1]; uint16_t count=1;
-            esp_bt_uuid_t cu = uuid128(UWB_CFG_UUID_128);
-            if (esp_ble_gattc_get_char_by_uuid(g_gattc_if, g_conn_id,
-                    g_start_handle, g_end_handle, cu, chr, &count) == ESP_GATT_OK && count) {
-                g_cfg_h = chr[0].char_handle; have_cfg=true;
-                //ESP_LOGI(TAG, "CFG  char=0x%04X", g_cfg_h);
-            }
-        }
+        ble_link_t* l = link_by_conn(p->search_cmpl.conn_id);
+        if (l) resolve_chars(l);
+        break;
+    }
 
-        // 2) Fallback: összes char, tulajdonság alapján
-        if (!have_data || !have_cfg){
-            uint16_t count=0;
-            if (esp_ble_gattc_get_attr_count(g_gattc_if, g_conn_id, ESP_GATT_DB_CHARACTERISTIC,
-                    g_start_handle, g_end_handle, 0, &count)==ESP_GATT_OK && count){
-                esp_gattc_char_elem_t* list = calloc(count, sizeof(*list));
-                if (list && esp_ble_gattc_get_all_char(g_gattc_if, g_conn_id,
-                        g_start_handle, g_end_handle, list, &count, 0)==ESP_GATT_OK){
-                    for (int i=0;i<count;i++){
-                        uint8_t p = list[i].properties;
-                        if (p & ESP_GATT_CHAR_PROP_BIT_NOTIFY){
-                            if (!have_data && (p & ESP_GATT_CHAR_PROP_BIT_READ)){
-                                g_data_h = list[i].char_handle; have_data=true;
-                                ESP_LOGI(TAG,"DATA char(enum)=0x%04X", g_data_h);
-                            } else if (!have_cfg && ((p & ESP_GATT_CHAR_PROP_BIT_WRITE) || (p & ESP_GATT_CHAR_PROP_BIT_WRITE_NR))){
-                                g_cfg_h = list[i].char_handle; have_cfg=true;
-                                //ESP_LOGI(TAG,"CFG  char(enum)=0x%04X", g_cfg_h);
-                            }
-                        }
-                    }
-                }
-                free(list);
-            }
-        }
+    case ESP_GATTC_READ_DESCR_EVT: {
+        ble_link_t* l = link_by_conn(p->read.conn_id);
+        if (l && l->validate) validate_evt(l, p);
+        break;
+    }
 
-        // 3) CCC-k + feliratkozás
-        if (g_data_h){
-            esp_gattc_descr_elem_t dsc[1]; uint16_t count=1;
-            if (esp_ble_gattc_get_descr_by_char_handle(g_gattc_if, g_conn_id, g_data_h,
-                    uuid16(ESP_GATT_UUID_CHAR_CLIENT_CONFIG), dsc, &count)==ESP_GATT_OK && count) {
-                g_data_ccc_h = dsc[0].handle;
-                esp_ble_gattc_register_for_notify(g_gattc_if, g_peer_bda, g_data_h);
-                enable_ccc(g_data_ccc_h);
-            }
-        }
-        if (g_cfg_h){
-            esp_gattc_descr_elem_t dsc[1]; uint16_t count=1;
-            if (esp_ble_gattc_get_descr_by_char_handle(g_gattc_if, g_conn_id, g_cfg_h,
-                    uuid16(ESP_GATT_UUID_CHAR_CLIENT_CONFIG), dsc, &count)==ESP_GATT_OK && count) {
-                g_cfg_ccc_h = dsc[0].handle;
-                esp_ble_gattc_register_for_notify(g_gattc_if, g_peer_bda, g_cfg_h);
-                enable_ccc(g_cfg_ccc_h);
-            }
+    case ESP_GATTC_NOTIFY_EVT: {
+        ble_link_t* l = link_by_conn(p->notify.conn_id);
+        if (!l) break;
+        if (l->t_down_us && p->notify.handle == l->data_h) {
+            /* bontás → első DATA notify */
+            const int64_t now = esp_timer_get_time();
+            l->reconnect_ms = (uint32_t)((now - l->t_down_us) / 1000);
+            l->t_down_us = 0;
+            metric_observe(H_BLE_RECONNECT_MS, l->reconnect_ms);
+            ESP_LOGI(TAG, "[%u] data flowing %u ms after link loss (%s)", link_idx(l),
+                     (unsigned)l->reconnect_ms, l->fast ? "cached" : "discovery");
         }
+        l->notifies++;
+        l->notify_bytes += p->notify.value_len;
+        metric_inc(M_BLE_NOTIFY);
+        metric_add(M_BLE_NOTIFY_BYTES, p->notify.value_len);
+        bool from_cfg = (p->notify.handle == l->cfg_h);
+        const int64_t now = esp_timer_get_time();
+        goodput_roll(l, now);
+        capture_record(link_idx(l), from_cfg, p->notify.value, p->notify.value_len, now);
+        if (notify_ring_push(&s_rx_ring, link_idx(l), now,
+                             p->notify.value, p->notify.value_len, from_cfg))
+            xTaskNotifyGive(s_rx_task);
+        else
+            metric_inc(M_BLE_RX_DROP);
+        break;
+    }
 
-        if (!g_data_h || !g_cfg_h){
-            ESP_LOGW(TAG, "char lookup incomplete; disconnect");
-            esp_ble_gattc_close(g_gattc_if, g_conn_id);
-        }
+    case ESP_GATTC_WRITE_DESCR_EVT:
+    case ESP_GATTC_WRITE_CHAR_EVT: {
+        ble_link_t* l = link_by_conn(p->write.conn_id);
+        if (p->write.status != ESP_GATT_OK || e == ESP_GATTC_WRITE_DESCR_EVT)
+            ESP_LOGI(TAG, "WRITE %s 0x%04X rc=0x%x", e == ESP_GATTC_WRITE_DESCR_EVT ? "descr" : "char",
+                     p->write.handle, p->write.status);
+        if (l) wq_done(l, p->write.status == ESP_GATT_OK);
+        /* a CFG CCC engedélyezése az utolsó lépés: innen jöhet GET/SET */
+        if (l && e == ESP_GATTC_WRITE_DESCR_EVT && p->write.status == ESP_GATT_OK
+            && p->write.handle == l->cfg_ccc_h && s_ready_cb)
+            s_ready_cb(link_idx(l));
         break;
     }
 
-    case ESP_GATTC_NOTIFY_EVT: {
-        bool from_cfg = (p->notify.handle == g_cfg_h);
-        if (g_cb) g_cb(p->notify.value, p->notify.value_len, from_cfg);
+    case ESP_GATTC_PREP_WRITE_EVT: {
+        ble_link_t* l = link_by_conn(p->write.conn_id);
+        if (l) wq_prep_evt(l, p->write.status);
         break;
     }
 
-    case ESP_GATTC_WRITE_DESCR_EVT:
-        ESP_LOGI(TAG, "CCC write 0x%04X rc=0x%x", p->write.handle, p->write.status);
+    case ESP_GATTC_EXEC_EVT: {
+        ble_link_t* l = link_by_conn(p->exec_cmpl.conn_id);
+        if (!l) break;
+        portENTER_CRITICAL(&s_wq_lock);
+        wq_slot_t* s = wq_oldest_sent(&l->wq);
+        bool ok = p->exec_cmpl.status == ESP_GATT_OK && s && !s->err;
+        portEXIT_CRITICAL(&s_wq_lock);
+        wq_done(l, ok);
         break;
+    }
 
-    case ESP_GATTC_WRITE_CHAR_EVT:
-        ESP_LOGI(TAG, "WRITE char 0x%04X rc=0x%x", p->write.handle, p->write.status);
+    case ESP_GATTC_CONGEST_EVT: {
+        ble_link_t* l = link_by_conn(p->congest.conn_id);
+        if (!l) break;
+        l->congested = p->congest.congested;
+        if (!l->congested) wq_pump(l);
         break;
+    }
 
-    case ESP_GATTC_CLOSE_EVT:
-    case ESP_GATTC_DISCONNECT_EVT:
-        ESP_LOGW(TAG, "disconnected; reason=0x%x", p->disconnect.reason);
-        g_connected = false;
-        g_connecting = false;
-        reset_gatt_state();
-        vTaskDelay(pdMS_TO_TICKS(100));
-        start_scan_safe(0);
+    case ESP_GATTC_CLOSE_EVT: {
+        ble_link_t* l = link_by_conn(p->close.conn_id);
+        if (l) link_down(l, p->close.reason);
+        schedule_rescan(BLE_RESCAN_DOWN_MS);
+        break;
+    }
+    case ESP_GATTC_DISCONNECT_EVT: {
+        ble_link_t* l = link_by_conn(p->disconnect.conn_id);
+        if (l) link_down(l, p->disconnect.reason);
+        schedule_rescan(BLE_RESCAN_DOWN_MS);
         break;
+    }
 
     default:
         break;
     }
+    if (conn_evt) CONN_UNLOCK();
 }
 
 /* ====== SET/GET küldők ====== */
 static inline uint16_t max_write_payload(void){ return 240; /* MTU 247 - 7 */ }
 
-esp_err_t ble_send_get(uint16_t req_id)
+static atomic_uint s_req_seq;
+
+uint16_t ble_next_req_id(void)
 {
-    if (!g_connected || !g_cfg_h) return ESP_ERR_INVALID_STATE;
-    uint8_t pkt[5] = {1, 0x02, (uint8_t)(req_id>>8), (uint8_t)req_id, 0};
-    esp_err_t er = esp_ble_gattc_write_char(g_gattc_if, g_conn_id, g_cfg_h,
-                                            sizeof(pkt), pkt,
-                                            ESP_GATT_WRITE_TYPE_RSP,
-                                            ESP_GATT_AUTH_REQ_NONE);
-    //ESP_LOGI(TAG, "SEND GET req=0x%04X -> 0x%x", req_id, er);
-    return er;
+    uint16_t r;
+    do { r = (uint16_t)(atomic_fetch_add(&s_req_seq, 1) + 1); } while (r == 0);
+    return r;
+}
+
+/* ===== Transport shim =====
+ * A maszkolt linkek CFG írásai a hook-hoz mennek (szimulátor), nem a rádióra. */
+static ble_tx_hook_t     s_tx_hook;
+static volatile uint32_t s_tx_mask;
+
+void ble_set_tx_hook(ble_tx_hook_t hook, uint32_t link_mask)
+{
+    s_tx_mask = 0;                      /* előbb a maszk: nincs hívás félkész állapotban */
+    s_tx_hook = hook;
+    s_tx_mask = hook ? link_mask : 0;
 }
 
-esp_err_t ble_send_set(uint16_t req_id, const uint8_t* tlv, uint16_t len)
+static inline ble_tx_hook_t tx_hook(uint8_t link){
+    return (link < BLE_MAX_LINKS && (s_tx_mask & (1u << link))) ? s_tx_hook : NULL;
+}
+
+bool ble_inject_notify(uint8_t link, const uint8_t* data, uint16_t len, bool from_cfg)
 {
-    if (!g_connected || !g_cfg_h) return ESP_ERR_INVALID_STATE;
-    if (len > max_write_payload()) return ESP_ERR_INVALID_SIZE;
+    if (!s_rx_task || link >= BLE_MAX_LINKS) return false;
+    if (!notify_ring_push(&s_rx_ring, link, esp_timer_get_time(), data, len, from_cfg)) return false;
+    xTaskNotifyGive(s_rx_task);
+    return true;
+}
 
-    uint8_t hdr[5] = {1, 0x01, (uint8_t)(req_id>>8), (uint8_t)req_id, 0xFF /* n_tlv (nem kötelező) */};
-    uint16_t total = sizeof(hdr) + len;
+static ble_link_t* ready_link(uint8_t link){
+    if (link >= BLE_MAX_LINKS) return NULL;
+    ble_link_t* l = &s_links[link];
+    return (l->used && l->connected && l->cfg_h) ? l : NULL;
+}
 
-    uint8_t *buf = (uint8_t*)malloc(total);
-    if (!buf) return ESP_ERR_NO_MEM;
-    memcpy(buf, hdr, 5);
-    if (tlv && len) memcpy(buf+5, tlv, len);
+/* NR csak ha a karakterisztika engedi; különben marad a válaszos írás */
+static inline bool use_nr(const ble_link_t* l, ble_wr_mode_t mode){
+    return mode == BLE_WR_NO_RSP && (l->cfg_props & ESP_GATT_CHAR_PROP_BIT_WRITE_NR);
+}
 
-    esp_err_t er = esp_ble_gattc_write_char(g_gattc_if, g_conn_id, g_cfg_h,
-                                            total, buf,
-                                            ESP_GATT_WRITE_TYPE_RSP,
-                                            ESP_GATT_AUTH_REQ_NONE);
-    free(buf);
-    ESP_LOGI(TAG, "SEND SET req=0x%04X len=%u -> 0x%x", req_id, len, er);
+esp_err_t ble_send_get_ex(uint8_t link, uint16_t req_id, ble_wr_mode_t mode)
+{
+    uint8_t pkt[5] = {1, 0x02, (uint8_t)(req_id>>8), (uint8_t)req_id, 0};
+    const ble_tx_hook_t hook = tx_hook(link);
+    if (hook) { hook(link, pkt, sizeof(pkt)); return ESP_OK; }
+    ble_link_t* l = ready_link(link);
+    if (!l) return ESP_ERR_INVALID_STATE;
+    return wq_submit(l, WQ_CHAR, use_nr(l, mode), l->cfg_h, pkt, sizeof(pkt), NULL, 0);
+}
+
+esp_err_t ble_send_get(uint8_t link, uint16_t req_id)
+{
+    return ble_send_get_ex(link, req_id, BLE_WR_RSP);
+}
+
+/* egy SET írásba férő TLV bájtok: a tárgyalt ATT_MTU-ból (3 B ATT + 5 B SET fejléc) */
+uint16_t ble_max_set_len(uint8_t link)
+{
+    if (tx_hook(link)) return max_write_payload();
+    ble_link_t* l = ready_link(link);
+    if (!l || l->mtu < 3 + 5 + 1) return 0;
+    uint16_t n = l->mtu - 3 - 5;
+    return n < max_write_payload() ? n : max_write_payload();
+}
+
+esp_err_t ble_send_set_ex(uint8_t link, uint16_t req_id, const uint8_t* tlv, uint16_t len, ble_wr_mode_t mode)
+{
+    if (len > BLE_SET_MAX_LONG) return ESP_ERR_INVALID_SIZE;
+    const uint8_t hdr[5] = {1, 0x01, (uint8_t)(req_id>>8), (uint8_t)req_id, 0xFF /* n_tlv (nem kötelező) */};
+    const ble_tx_hook_t hook = tx_hook(link);
+    if (hook) {
+        uint8_t pkt[sizeof(hdr) + BLE_SET_MAX_LONG];
+        memcpy(pkt, hdr, sizeof(hdr));
+        if (tlv && len) memcpy(pkt + sizeof(hdr), tlv, len);
+        hook(link, pkt, (uint16_t)(sizeof(hdr) + (tlv ? len : 0)));
+        return ESP_OK;
+    }
+    ble_link_t* l = ready_link(link);
+    if (!l) return ESP_ERR_INVALID_STATE;
+    esp_err_t er = wq_submit(l, WQ_CHAR, use_nr(l, mode), l->cfg_h, hdr, sizeof(hdr), tlv, tlv ? len : 0);
+    ESP_LOGI(TAG, "[%u] SEND SET req=0x%04X len=%u%s -> 0x%x", link, req_id, len,
+             len > ble_max_set_len(link) ? " (prepared)" : "", er);
     return er;
 }
+
+esp_err_t ble_send_set(uint8_t link, uint16_t req_id, const uint8_t* tlv, uint16_t len)
+{
+    return ble_send_set_ex(link, req_id, tlv, len, BLE_WR_RSP);
+}
+
+void ble_set_write_window(uint8_t n)
+{
+    s_wq_window = n < 1 ? 1 : n > WQ_SLOTS ? WQ_SLOTS : n;
+}
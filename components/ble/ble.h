@@ -2,17 +2,117 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "esp_err.h"
+#include "sdkconfig.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-typedef void (*ble_notify_cb_t)(const uint8_t* data, uint16_t len, bool from_cfg);
+/* Egyidejű anchor kapcsolatok száma (a controller limitje) */
+#ifdef CONFIG_BTDM_CTRL_BLE_MAX_CONN_EFF
+#define BLE_MAX_LINKS  CONFIG_BTDM_CTRL_BLE_MAX_CONN_EFF
+#else
+#define BLE_MAX_LINKS  3
+#endif
+
+/* Írási sor: egyszerre ennyi írás lehet a Bluedroid-nál (completion előtt) */
+#ifndef BLE_WQ_WINDOW
+#define BLE_WQ_WINDOW  4
+#endif
+#define BLE_SET_MAX_LONG  251      /* TLV bájt / SET prepared írással (WQ_VAL_MAX - 5) */
+
+typedef enum {
+    BLE_WR_RSP = 0,        /* Write Request: ATT válaszig foglalja a linket */
+    BLE_WR_NO_RSP,         /* Write Command: idempotens parancsokhoz (GET, abszolút SET) */
+} ble_wr_mode_t;
+
+/* Link hangolás alapértékei (OPEN után kérve; a controller dönt) */
+#define BLE_CONN_MIN_INT   12      /* 15 ms (1.25 ms egység) */
+#define BLE_CONN_MAX_INT   24      /* 30 ms */
+#define BLE_CONN_LATENCY   0
+#define BLE_CONN_TIMEOUT   400     /* 4 s (10 ms egység) */
+#define BLE_DATA_LEN       251     /* LL TX payload (DLE); 27 = alap */
 
+typedef struct {
+    uint16_t min_int, max_int;     /* 6..3200, 1.25 ms */
+    uint16_t latency;              /* 0..499 kihagyható connection event */
+    uint16_t timeout;              /* 10..3200, 10 ms; > (1+latency)*max_int*2.5 ms */
+    uint16_t data_len;             /* 27..251, 0 = nem kéri */
+    bool     phy_2m;               /* csak BLE 5 controllerrel (ESP32: nincs) */
+} ble_link_params_t;
+void      ble_get_link_params(ble_link_params_t* out);
+/* apply_now: a már élő linkekre is újra kéri */
+esp_err_t ble_set_link_params(const ble_link_params_t* c, bool apply_now);
+
+/* link: az anchor indexe (0..BLE_MAX_LINKS-1), a ble_add_anchor() sorrendjében */
+typedef void (*ble_notify_cb_t)(uint8_t link, const uint8_t* data, uint16_t len, bool from_cfg);
+
+/* name_filter: vesszővel elválasztott lista, név vagy "AA:BB:CC:DD:EE:FF" cím;
+   NULL/üres → az első talált eszköz (link 0);
+   nvs_flash_init() után hívandó (a "ble_cache" névteret nyitja). */
 esp_err_t ble_start(const char* name_filter, ble_notify_cb_t cb);
-esp_err_t ble_send_get(uint16_t req_id);
-esp_err_t ble_send_set(uint16_t req_id, const uint8_t* tlv_buf, uint16_t tlv_len);
-void ble_register_notify_cb(ble_notify_cb_t cb);
+int       ble_add_anchor(const char* name_or_addr);   /* → link index, -1 ha tele */
+/* A küldők a link írási sorába tesznek (ESP_ERR_NO_MEM: tele a sor), a kiadás
+   és a completion aszinkron. NO_RSP csak ha a CFG karakterisztika támogatja,
+   különben válaszos írás. ATT_MTU-nál hosszabb SET prepare + execute írás. */
+esp_err_t ble_send_get(uint8_t link, uint16_t req_id);
+esp_err_t ble_send_get_ex(uint8_t link, uint16_t req_id, ble_wr_mode_t mode);
+uint16_t  ble_next_req_id(void);   /* közös req_id számláló (0 kihagyva) */
+esp_err_t ble_send_set(uint8_t link, uint16_t req_id, const uint8_t* tlv_buf, uint16_t tlv_len);
+esp_err_t ble_send_set_ex(uint8_t link, uint16_t req_id, const uint8_t* tlv_buf, uint16_t tlv_len, ble_wr_mode_t mode);
+uint16_t  ble_max_set_len(uint8_t link);   /* TLV bájt / egy ATT írás (MTU szerint, max 240); 0 = nincs link */
+void      ble_set_write_window(uint8_t n); /* 1..WQ_SLOTS */
+void ble_register_notify_cb(ble_notify_cb_t cb);   /* fan-out: több feliratkozó is lehet */
+/* link kész: kapcsolat él, mindkét CCC engedélyezve (minden (újra)kapcsolódáskor, GATTC taskból) */
+typedef void (*ble_ready_cb_t)(uint8_t link);
+void ble_register_ready_cb(ble_ready_cb_t cb);
+
+/* ===== Transport shim (szimulátor / terheléses teszt) =====
+   A link_mask linkjeinek CFG írásai (GET / SET) a hook-hoz mennek a rádió
+   helyett; a válasz ble_inject_notify()-jal ugyanazon a notify gyűrűn és rx
+   taskon át jut a feliratkozókhoz, mint a valódi NOTIFY. */
+typedef void (*ble_tx_hook_t)(uint8_t link, const uint8_t* data, uint16_t len);
+void ble_set_tx_hook(ble_tx_hook_t hook, uint32_t link_mask);     /* NULL: ki */
+/* false: tele a notify gyűrű (a gyűrű dropped számlálója nő); a hívó újrapróbálja */
+bool ble_inject_notify(uint8_t link, const uint8_t* data, uint16_t len, bool from_cfg);
+
+/* NOTIFY ingest gyűrű számlálói */
+typedef struct {
+    uint32_t pushed, popped;
+    uint32_t dropped;        /* tele gyűrű miatt eldobott keretek */
+    uint32_t truncated;
+    uint32_t high_water;     /* max. egyidejű foglaltság */
+    uint32_t capacity;
+} ble_rx_stats_t;
+void ble_get_rx_stats(ble_rx_stats_t* out);
+
+/* Linkenkénti állapot (webserver / diagnosztika) */
+typedef struct {
+    char     filter[32];
+    uint8_t  bda[6];
+    bool     connected;
+    uint16_t conn_id;
+    uint16_t mtu;
+    uint32_t notifies, notify_bytes;
+    uint32_t connects;
+    uint8_t  wq_depth, wq_high;        /* írási sor: most / max foglaltság */
+    uint32_t writes, write_nr, write_long, write_err;
+    uint32_t wq_full;
+    /* megtárgyalt link paraméterek (0 = még nincs adat) */
+    uint16_t conn_int, conn_latency, conn_timeout;
+    uint16_t tx_len, rx_len;
+    uint8_t  tx_phy, rx_phy;
+    /* gyors újracsatlakozás */
+    bool     cached, fast;             /* van NVS handle cache / ez a kapcsolat abból állt fel */
+    uint32_t reconnect_ms;             /* utolsó bontás → első DATA notify */
+    uint32_t fast_opens, discoveries;
+    /* notify goodput: utolsó ~1 s ablak */
+    int64_t  up_us;
+    uint32_t rx_mhz;                   /* keret/s * 1000 */
+    uint32_t rx_Bps;
+} ble_link_info_t;
+uint8_t ble_link_count(void);
+bool    ble_link_info(uint8_t link, ble_link_info_t* out);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,131 @@
+// components/ble/ble_sim.c — anchor_sim a transport shimen át (terheléses teszt rádió nélkül)
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "ble.h"
+#include "ble_sim.h"
+
+static const char* TAG = "ble_sim";
+
+#define SIM_TASK_STACK  4096
+#define SIM_TASK_PRIO   3               /* az rx task (5) alatt: minden inject után az ürít */
+#define SIM_MAX_WAIT_MS 100             /* leállítás ellenőrzése */
+
+static SemaphoreHandle_t s_mx;
+static asim_t*           s_mem;         /* BLE_MAX_LINKS db, első indításkor foglalva */
+static asim_t*           s_sim[BLE_MAX_LINKS];
+static uint32_t          s_mask;
+static volatile bool     s_run;
+static TaskHandle_t      s_task;
+
+static bool sim_out(void* ctx, uint8_t link, const uint8_t* d, uint16_t n, bool from_cfg)
+{
+    (void)ctx;
+    return ble_inject_notify(link, d, n, from_cfg);
+}
+
+/* ble_send_get / ble_send_set a maszkolt linkeken (hívó task: httpd, dwm_cache, ...) */
+static void sim_tx(uint8_t link, const uint8_t* d, uint16_t n)
+{
+    xSemaphoreTake(s_mx, portMAX_DELAY);
+    if (link < BLE_MAX_LINKS && s_sim[link]) asim_write(s_sim[link], d, n, esp_timer_get_time(), sim_out, NULL);
+    xSemaphoreGive(s_mx);
+}
+
+static void sim_task(void* arg)
+{
+    (void)arg;
+    while (s_run) {
+        int64_t due = INT64_MAX;
+        xSemaphoreTake(s_mx, portMAX_DELAY);
+        const int64_t now = esp_timer_get_time();
+        for (int l = 0; l < BLE_MAX_LINKS; l++) {
+            if (!s_sim[l]) continue;
+            asim_step(s_sim[l], now, sim_out, NULL);
+            const int64_t t = asim_next_due(s_sim[l]);
+            if (t < due) due = t;
+        }
+        xSemaphoreGive(s_mx);
+
+        const int64_t wait_ms = (due - esp_timer_get_time()) / 1000;
+        TickType_t tk = wait_ms <= 0 ? 1 : pdMS_TO_TICKS(wait_ms < SIM_MAX_WAIT_MS ? wait_ms : SIM_MAX_WAIT_MS);
+        vTaskDelay(tk ? tk : 1);                /* tele gyűrű / esedékes: egy tick */
+    }
+    s_task = NULL;
+    vTaskDelete(NULL);
+}
+
+void ble_sim_stop(void)
+{
+    if (!s_mx) return;
+    ble_set_tx_hook(NULL, 0);
+    s_run = false;
+    for (int i = 0; i < 2 * SIM_MAX_WAIT_MS / 10 && s_task; i++) vTaskDelay(pdMS_TO_TICKS(10));
+    xSemaphoreTake(s_mx, portMAX_DELAY);
+    memset(s_sim, 0, sizeof(s_sim));
+    xSemaphoreGive(s_mx);
+}
+
+esp_err_t ble_sim_start(const asim_cfg_t* tmpl, uint32_t link_mask)
+{
+    if (!s_mx && !(s_mx = xSemaphoreCreateMutex())) return ESP_ERR_NO_MEM;
+    if (!s_mem && !(s_mem = calloc(BLE_MAX_LINKS, sizeof(asim_t)))) return ESP_ERR_NO_MEM;
+    ble_sim_stop();
+    if (s_task) return ESP_ERR_INVALID_STATE;
+
+    if (!link_mask) {
+        for (uint8_t l = 0; l < BLE_MAX_LINKS; l++) {
+            ble_link_info_t i;
+            if (!ble_link_info(l, &i) || !i.connected) link_mask |= 1u << l;
+        }
+    }
+    link_mask &= (1u << BLE_MAX_LINKS) - 1;
+    if (!link_mask) return ESP_ERR_NOT_FOUND;
+
+    const int64_t now = esp_timer_get_time();
+    xSemaphoreTake(s_mx, portMAX_DELAY);
+    for (uint8_t l = 0; l < BLE_MAX_LINKS; l++) {
+        if (!(link_mask & (1u << l))) continue;
+        asim_cfg_t c = *tmpl;
+        c.link = l;
+        c.anchor_id = tmpl->anchor_id + l;
+        c.seed = tmpl->seed + l;
+        asim_init(&s_mem[l], &c, now);
+        s_sim[l] = &s_mem[l];
+    }
+    s_mask = link_mask;
+    xSemaphoreGive(s_mx);
+
+    s_run = true;
+    if (xTaskCreate(sim_task, "ble_sim", SIM_TASK_STACK, NULL, SIM_TASK_PRIO, &s_task) != pdPASS) {
+        s_run = false;
+        return ESP_ERR_NO_MEM;
+    }
+    ble_set_tx_hook(sim_tx, link_mask);
+    ESP_LOGI(TAG, "links=0x%02X tags=%u rate=%u mHz loss=%u ppm", (unsigned)link_mask, tmpl->tags,
+             (unsigned)tmpl->rate_mhz, (unsigned)tmpl->loss_ppm);
+    return ESP_OK;
+}
+
+void ble_sim_get_stats(ble_sim_stats_t* out)
+{
+    memset(out, 0, sizeof(*out));
+    if (!s_mx) return;
+    xSemaphoreTake(s_mx, portMAX_DELAY);
+    out->running = s_run;
+    out->links = s_run ? s_mask : 0;
+    for (int l = 0; l < BLE_MAX_LINKS; l++) {
+        if (!s_sim[l]) continue;
+        const asim_stats_t* s = &s_sim[l]->st;
+        out->st.data += s->data;     out->st.lost += s->lost;       out->st.dups += s->dups;
+        out->st.hb += s->hb;         out->st.state += s->state;
+        out->st.gets += s->gets;     out->st.sets += s->sets;
+        out->st.applied += s->applied; out->st.rejected += s->rejected; out->st.bad_cmd += s->bad_cmd;
+        out->st.resp_drop += s->resp_drop; out->st.stalls += s->stalls;
+    }
+    xSemaphoreGive(s_mx);
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "anchor_sim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===== Szimulált anchorok a gateway-en (rádió nélkül) =====
+ * Linkenként egy anchor_sim a transport shimen át (ble_set_tx_hook /
+ * ble_inject_notify): a GET / SET a szimulátorhoz megy, a HB / STATE / DATA
+ * ugyanazon a notify gyűrűn, rx taskon és feliratkozókon (uplink, dwm_cache,
+ * cfg_engine, /ws) halad, mint a valódi anchoroké. ble_start() után hívható. */
+
+typedef struct {
+    bool         running;
+    uint32_t     links;                 /* szimulált linkek maszkja */
+    asim_stats_t st;                    /* összesítve */
+} ble_sim_stats_t;
+
+/* tmpl: minden linkre; anchor_id és seed linkenként + link index.
+   link_mask = 0: minden link, amin most nincs élő valódi anchor. */
+esp_err_t ble_sim_start(const asim_cfg_t* tmpl, uint32_t link_mask);
+void      ble_sim_stop(void);
+void      ble_sim_get_stats(ble_sim_stats_t* out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,161 @@
+// components/ble/capture.c — NOTIFY felvétel RAM gyűrűbe, letöltés .ncap-ként
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+#include "ncap.h"
+#include "notify_ring.h"
+#include "capture.h"
+
+static const char* TAG = "capture";
+
+_Static_assert(NCAP_PAYLOAD_MAX == NOTIFY_FRAME_MAX, "capture record = notify frame");
+
+/* változó hosszú rekordok bájt-gyűrűben; a rekord a végén átfordulhat */
+static uint8_t*      s_buf;
+static uint32_t      s_head, s_used;            /* legrégebbi rekord / foglalt bájt */
+static uint32_t      s_records, s_total, s_dropped;
+static int64_t       s_t_first, s_t_last;       /* legrégebbi / legújabb rekord ideje */
+static volatile bool s_run;
+static bool          s_dumping;
+static portMUX_TYPE  s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static void ring_put(uint32_t off, const uint8_t* p, uint32_t n)
+{
+    off %= CAPTURE_BYTES;
+    const uint32_t a = (n <= CAPTURE_BYTES - off) ? n : CAPTURE_BYTES - off;
+    memcpy(s_buf + off, p, a);
+    if (n > a) memcpy(s_buf, p + a, n - a);
+}
+static void ring_get(uint32_t off, uint8_t* p, uint32_t n)
+{
+    off %= CAPTURE_BYTES;
+    const uint32_t a = (n <= CAPTURE_BYTES - off) ? n : CAPTURE_BYTES - off;
+    memcpy(p, s_buf + off, a);
+    if (n > a) memcpy(p + a, s_buf, n - a);
+}
+static inline uint16_t hdr_len(const uint8_t* h){ return (uint16_t)(h[4] | (h[5] << 8)); }
+static inline uint32_t hdr_dt(const uint8_t* h){
+    return (uint32_t)h[0] | ((uint32_t)h[1] << 8) | ((uint32_t)h[2] << 16) | ((uint32_t)h[3] << 24);
+}
+
+/* zár alatt: a legrégebbi rekord eldobása; az új legrégebbi ideje dt-ből */
+static void drop_oldest(void)
+{
+    uint8_t h[NCAP_REC_HDR];
+    ring_get(s_head, h, sizeof(h));
+    const uint32_t sz = NCAP_REC_HDR + hdr_len(h);
+    s_head = (s_head + sz) % CAPTURE_BYTES;
+    s_used -= sz;
+    s_records--;
+    s_dropped++;
+    if (s_records) { ring_get(s_head, h, sizeof(h)); s_t_first += hdr_dt(h); }
+}
+
+esp_err_t capture_start(void)
+{
+    if (!s_buf) {
+        uint8_t* b = malloc(CAPTURE_BYTES);
+        if (!b) return ESP_ERR_NO_MEM;
+        portENTER_CRITICAL(&s_lock);
+        s_buf = b;
+        portEXIT_CRITICAL(&s_lock);
+    }
+    s_run = true;
+    ESP_LOGI(TAG, "started (%u B ring)", (unsigned)CAPTURE_BYTES);
+    return ESP_OK;
+}
+
+void capture_stop(void) { s_run = false; }
+
+void capture_clear(void)
+{
+    portENTER_CRITICAL(&s_lock);
+    if (!s_dumping) { s_head = s_used = 0; s_records = s_total = s_dropped = 0; }
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void capture_get_stats(capture_stats_t* out)
+{
+    portENTER_CRITICAL(&s_lock);
+    out->running = s_run;
+    out->cap     = s_buf ? CAPTURE_BYTES : 0;
+    out->used    = s_used;
+    out->records = s_records;
+    out->total   = s_total;
+    out->dropped = s_dropped;
+    out->span_us = s_records ? s_t_last - s_t_first : 0;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void capture_record(uint8_t link, bool from_cfg, const uint8_t* data, uint16_t len, int64_t ts_us)
+{
+    if (!s_run) return;
+    if (len > NCAP_PAYLOAD_MAX) len = NCAP_PAYLOAD_MAX;
+    const uint32_t sz = NCAP_REC_HDR + len;
+    portENTER_CRITICAL(&s_lock);
+    if (!s_buf || s_dumping) { s_dropped++; portEXIT_CRITICAL(&s_lock); return; }
+    while (CAPTURE_BYTES - s_used < sz) drop_oldest();
+    uint32_t dt = 0;
+    if (s_records) {
+        const int64_t d = ts_us - s_t_last;
+        dt = d <= 0 ? 0 : d >= (int64_t)UINT32_MAX ? UINT32_MAX : (uint32_t)d;
+    } else {
+        s_t_first = ts_us;
+    }
+    uint8_t h[NCAP_REC_HDR];
+    ncap_rec_hdr_encode(h, dt, len, link, from_cfg);
+    ring_put(s_head + s_used, h, sizeof(h));
+    if (len) ring_put(s_head + s_used + NCAP_REC_HDR, data, len);
+    s_used += sz;
+    s_records++;
+    s_total++;
+    s_t_last = ts_us;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+/* ===== Letöltés =====
+ * A gyűrű a kiírás alatt nem változik (s_dumping: az új rekordok kimaradnak),
+ * így zár nélkül olvasható; kimenet 512 B-os darabokban. */
+typedef struct { capture_emit_t emit; void* ctx; size_t n, total; char buf[512]; } dump_out_t;
+
+static void out_flush(dump_out_t* o)
+{
+    if (!o->n) return;
+    o->emit(o->ctx, o->buf, o->n);
+    o->total += o->n;
+    o->n = 0;
+}
+
+size_t capture_dump(capture_emit_t emit, void* ctx)
+{
+    portENTER_CRITICAL(&s_lock);
+    if (s_dumping) { portEXIT_CRITICAL(&s_lock); return 0; }
+    s_dumping = true;
+    uint32_t off = s_head, left = s_records;
+    const int64_t t0 = s_t_first;
+    const uint32_t dropped = s_dropped;
+    portEXIT_CRITICAL(&s_lock);
+
+    static dump_out_t o;                        /* egyszerre egy letöltés (s_dumping) */
+    o.emit = emit; o.ctx = ctx; o.n = 0; o.total = 0;
+    ncap_hdr_encode((uint8_t*)o.buf, left ? t0 : 0, dropped);
+    o.n = NCAP_HDR_LEN;
+    for (bool first = true; left; left--, first = false) {
+        uint8_t h[NCAP_REC_HDR];
+        ring_get(off, h, sizeof(h));
+        const uint16_t len = hdr_len(h);
+        if (first) memset(h, 0, 4);            /* dt = 0: az idő a fejlécben (t0) */
+        if (sizeof(o.buf) - o.n < (size_t)NCAP_REC_HDR + len) out_flush(&o);
+        memcpy(o.buf + o.n, h, NCAP_REC_HDR);
+        ring_get(off + NCAP_REC_HDR, (uint8_t*)o.buf + o.n + NCAP_REC_HDR, len);
+        o.n += NCAP_REC_HDR + len;
+        off = (off + NCAP_REC_HDR + len) % CAPTURE_BYTES;
+    }
+    out_flush(&o);
+
+    portENTER_CRITICAL(&s_lock);
+    s_dumping = false;
+    portEXIT_CRITICAL(&s_lock);
+    return o.total;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===== NOTIFY felvétel RAM gyűrűbe (.ncap, lásd ncap.h) =====
+ * A gattc_cb NOTIFY ága hívja: amit a BLE stack átadott, időbélyeggel,
+ * még a notify gyűrű előtt. Tele gyűrűnél a legrégebbi rekord íródik felül.
+ * A puffer az első capture_start()-kor foglalódik; leállítva nem kerül semmibe. */
+
+#define CAPTURE_BYTES  (32 * 1024)
+
+typedef struct {
+    bool     running;
+    uint32_t cap, used;                 /* bájt */
+    uint32_t records;                   /* a gyűrűben */
+    uint32_t total;                     /* felvett rekordok a törlés óta */
+    uint32_t dropped;                   /* felülírva / letöltés alatt kimaradt */
+    int64_t  span_us;                   /* legrégebbi → legújabb rekord */
+} capture_stats_t;
+
+/* ESP_ERR_NO_MEM: a puffer nem foglalható */
+esp_err_t capture_start(void);
+void      capture_stop(void);
+/* letöltés közben hatástalan */
+void      capture_clear(void);
+void      capture_get_stats(capture_stats_t* out);
+
+void      capture_record(uint8_t link, bool from_cfg, const uint8_t* data, uint16_t len, int64_t ts_us);
+
+/* A gyűrű .ncap fájlként, darabokban (a felvétel közben szünetel).
+ * emit ugyanazzal a ctx-szel többször hívódik; visszaad: kiírt bájt. */
+typedef void (*capture_emit_t)(void* ctx, const char* s, size_t n);
+size_t    capture_dump(capture_emit_t emit, void* ctx);
+
+#ifdef __cplusplus
+}
+#endif
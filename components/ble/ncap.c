@@ -0,0 +1,89 @@
+// components/ble/ncap.c — NOTIFY capture formátum, olvasó, visszajátszás
+#include <string.h>
+#include "ncap.h"
+
+static inline void wr16le(uint8_t* p, uint16_t v){ p[0]=(uint8_t)v; p[1]=(uint8_t)(v>>8); }
+static inline void wr32le(uint8_t* p, uint32_t v){ p[0]=(uint8_t)v; p[1]=(uint8_t)(v>>8); p[2]=(uint8_t)(v>>16); p[3]=(uint8_t)(v>>24); }
+static inline uint16_t rd16le(const uint8_t* p){ return (uint16_t)(p[0] | (p[1]<<8)); }
+static inline uint32_t rd32le(const uint8_t* p){
+    return ((uint32_t)p[0]) | ((uint32_t)p[1]<<8) | ((uint32_t)p[2]<<16) | ((uint32_t)p[3]<<24);
+}
+
+void ncap_hdr_encode(uint8_t out[NCAP_HDR_LEN], int64_t t0_us, uint32_t dropped)
+{
+    memcpy(out, "NCAP", 4);
+    out[4] = NCAP_VERSION;
+    out[5] = NCAP_HDR_LEN;
+    out[6] = out[7] = 0;
+    wr32le(&out[8],  (uint32_t)(uint64_t)t0_us);
+    wr32le(&out[12], (uint32_t)((uint64_t)t0_us >> 32));
+    wr32le(&out[16], dropped);
+}
+
+void ncap_rec_hdr_encode(uint8_t out[NCAP_REC_HDR], uint32_t dt_us, uint16_t len, uint8_t link, bool from_cfg)
+{
+    wr32le(&out[0], dt_us);
+    wr16le(&out[4], len);
+    out[6] = link;
+    out[7] = from_cfg ? NCAP_CH_CFG : NCAP_CH_DATA;
+}
+
+bool ncap_rd_init(ncap_rd_t* r, const uint8_t* p, size_t n)
+{
+    memset(r, 0, sizeof(*r));
+    if (!p || n < NCAP_HDR_LEN || memcmp(p, "NCAP", 4) || p[4] != NCAP_VERSION) return false;
+    if (p[5] < NCAP_HDR_LEN || p[5] > n) return false;     /* újabb, hosszabb fejléc: a többlet átugorva */
+    r->p = p; r->n = n; r->off = p[5];
+    r->t_us    = (int64_t)((uint64_t)rd32le(&p[8]) | ((uint64_t)rd32le(&p[12]) << 32));
+    r->dropped = rd32le(&p[16]);
+    return true;
+}
+
+int ncap_rd_next(ncap_rd_t* r, ncap_rec_t* out)
+{
+    if (r->off == r->n) return 0;
+    if (r->n - r->off < NCAP_REC_HDR) return -1;
+    const uint8_t* h = r->p + r->off;
+    const uint16_t len = rd16le(&h[4]);
+    if (len > NCAP_PAYLOAD_MAX || h[7] > NCAP_CH_CFG || r->n - r->off - NCAP_REC_HDR < len) return -1;
+    out->dt_us    = rd32le(&h[0]);
+    out->len      = len;
+    out->link     = h[6];
+    out->from_cfg = h[7] == NCAP_CH_CFG;
+    out->data     = h + NCAP_REC_HDR;
+    r->t_us      += out->dt_us;
+    out->t_us     = r->t_us;
+    r->off       += NCAP_REC_HDR + len;
+    return 1;
+}
+
+/* ===== Visszajátszás =====
+ * Ütemterv: a rekord felvett ideje (t0-tól) / speed a replay kezdetétől.
+ * Abszolút ütemezés, így az alvás / sink késése nem halmozódik. */
+bool ncap_replay(const uint8_t* p, size_t n, const ncap_replay_cfg_t* c, ncap_replay_stats_t* st)
+{
+    memset(st, 0, sizeof(*st));
+    ncap_rd_t r;
+    if (!ncap_rd_init(&r, p, n)) return false;
+    const bool paced = c->speed > 0 && c->now_us && c->sleep_us;
+    const int64_t t0 = r.t_us;
+    const int64_t w0 = c->now_us ? c->now_us() : 0;
+    ncap_rec_t rec;
+    int rc;
+    while ((rc = ncap_rd_next(&r, &rec)) == 1) {
+        if (paced) {
+            const int64_t due = w0 + (int64_t)((double)(rec.t_us - t0) / c->speed);
+            const int64_t now = c->now_us();
+            if (due > now) c->sleep_us(due - now);
+            else if (now - due > st->late_max_us) st->late_max_us = now - due;
+        }
+        if (c->sink) c->sink(rec.link, rec.data, rec.len, rec.from_cfg);
+        st->records++;
+        if (rec.from_cfg) st->cfg++; else st->data++;
+        st->bytes += rec.len;
+        st->span_us = rec.t_us - t0;
+    }
+    st->truncated = rc < 0;
+    st->wall_us = c->now_us ? c->now_us() - w0 : 0;
+    return true;
+}
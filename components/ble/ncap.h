@@ -0,0 +1,88 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===== NOTIFY capture formátum (.ncap) + visszajátszás =====
+ * Fájl (minden mező LE):
+ *   fejléc, NCAP_HDR_LEN B:
+ *     [0..3]   "NCAP"
+ *     [4]      verzió (1)
+ *     [5]      fejléc hossza
+ *     [6..7]   0
+ *     [8..15]  t0: az első rekord monoton ideje (µs, esp_timer)
+ *     [16..19] felvétel közben eldobott rekordok (gyűrű felülírás / tele)
+ *   rekordok, NCAP_REC_HDR + len B:
+ *     [0..3]   dt: µs az előző rekord óta (első: 0; 71 perc fölött levágva)
+ *     [4..5]   len (≤ NCAP_PAYLOAD_MAX)
+ *     [6]      link (ble link index)
+ *     [7]      csatorna: NCAP_CH_DATA / NCAP_CH_CFG
+ *     [8..]    a notify értéke, ahogy a gattc_cb kapta
+ * Tisztán adatfeldolgozás, ESP függőség nélkül: a target felvevő és a host
+ * oldali replay (tools/ncap_replay.c) ugyanezt használja. */
+
+#define NCAP_VERSION      1
+#define NCAP_HDR_LEN      20
+#define NCAP_REC_HDR      8
+#define NCAP_PAYLOAD_MAX  244           /* = NOTIFY_FRAME_MAX */
+
+enum { NCAP_CH_DATA = 0, NCAP_CH_CFG = 1 };
+
+typedef struct {
+    int64_t        t_us;                /* t0 + dt-k összege */
+    uint32_t       dt_us;
+    uint16_t       len;
+    uint8_t        link;
+    bool           from_cfg;
+    const uint8_t* data;                /* a forrás pufferbe mutat */
+} ncap_rec_t;
+
+void ncap_hdr_encode(uint8_t out[NCAP_HDR_LEN], int64_t t0_us, uint32_t dropped);
+void ncap_rec_hdr_encode(uint8_t out[NCAP_REC_HDR], uint32_t dt_us, uint16_t len, uint8_t link, bool from_cfg);
+
+/* ---- Olvasó (a teljes fájl memóriában) ---- */
+typedef struct {
+    const uint8_t* p;
+    size_t         n, off;
+    int64_t        t_us;
+    uint32_t       dropped;             /* fejlécből */
+} ncap_rd_t;
+
+/* false: nem NCAP / ismeretlen verzió / rövid */
+bool ncap_rd_init(ncap_rd_t* r, const uint8_t* p, size_t n);
+/* 1: rekord, 0: vége, -1: csonka / hibás rekord */
+int  ncap_rd_next(ncap_rd_t* r, ncap_rec_t* out);
+
+/* ---- Visszajátszás ----
+ * A rekordokat a felvett időzítéssel (speed = 1), N× gyorsítva (speed = N)
+ * vagy várakozás nélkül (speed = 0) adja a sink-nek. A sink aláírása a
+ * ble_notify_cb_t-vel egyezik, így ugyanazok a fogyasztók köthetők rá.
+ * Óra / alvás a hívótól: a modul nem hív OS-t. */
+typedef void (*ncap_sink_t)(uint8_t link, const uint8_t* data, uint16_t len, bool from_cfg);
+
+typedef struct {
+    double      speed;                  /* 0: amilyen gyorsan csak lehet */
+    ncap_sink_t sink;
+    int64_t   (*now_us)(void);
+    void      (*sleep_us)(int64_t us);
+} ncap_replay_cfg_t;
+
+typedef struct {
+    uint32_t records, data, cfg;
+    uint64_t bytes;
+    int64_t  span_us;                   /* felvett időtartam (utolsó - első) */
+    int64_t  wall_us;                   /* visszajátszás ideje */
+    int64_t  late_max_us;               /* legnagyobb késés az ütemtervhez képest */
+    bool     truncated;                 /* csonka rekordnál megállt */
+} ncap_replay_stats_t;
+
+/* false: hibás fejléc */
+bool ncap_replay(const uint8_t* p, size_t n, const ncap_replay_cfg_t* c, ncap_replay_stats_t* st);
+
+#ifdef __cplusplus
+}
+#endif
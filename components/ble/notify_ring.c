@@ -0,0 +1,92 @@
+// components/ble/notify_ring.c — zármentes NOTIFY keret-gyűrű (bounded MPSC)
+#include <string.h>
+#include "notify_ring.h"
+
+#define MASK (NOTIFY_RING_SLOTS - 1u)
+_Static_assert((NOTIFY_RING_SLOTS & MASK) == 0, "NOTIFY_RING_SLOTS must be a power of two");
+
+void notify_ring_init(notify_ring_t* r)
+{
+    for (unsigned i = 0; i < NOTIFY_RING_SLOTS; i++) atomic_init(&r->slot[i].seq, i);
+    atomic_init(&r->head, 0);
+    atomic_init(&r->tail, 0);
+    atomic_init(&r->pushed, 0);
+    atomic_init(&r->popped, 0);
+    atomic_init(&r->dropped, 0);
+    atomic_init(&r->truncated, 0);
+    atomic_init(&r->high_water, 0);
+}
+
+static void note_high_water(notify_ring_t* r, unsigned used)
+{
+    unsigned hw = atomic_load_explicit(&r->high_water, memory_order_relaxed);
+    while (used > hw &&
+           !atomic_compare_exchange_weak_explicit(&r->high_water, &hw, used,
+                                                  memory_order_relaxed, memory_order_relaxed)) { }
+}
+
+bool notify_ring_push(notify_ring_t* r, uint8_t link, int64_t ts_us, const uint8_t* data, uint16_t len, bool from_cfg)
+{
+    unsigned pos = atomic_load_explicit(&r->head, memory_order_relaxed);
+    notify_slot_t* s;
+    for (;;) {
+        s = &r->slot[pos & MASK];
+        unsigned seq = atomic_load_explicit(&s->seq, memory_order_acquire);
+        int diff = (int)(seq - pos);
+        if (diff == 0) {
+            /* szabad slot → lefoglaljuk */
+            if (atomic_compare_exchange_weak_explicit(&r->head, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            /* a fogyasztó még nem engedte el → tele */
+            atomic_fetch_add_explicit(&r->dropped, 1, memory_order_relaxed);
+            return false;
+        } else {
+            pos = atomic_load_explicit(&r->head, memory_order_relaxed);
+        }
+    }
+
+    if (len > NOTIFY_FRAME_MAX) {
+        len = NOTIFY_FRAME_MAX;
+        atomic_fetch_add_explicit(&r->truncated, 1, memory_order_relaxed);
+    }
+    s->f.ts_us    = ts_us;
+    s->f.len      = len;
+    s->f.from_cfg = from_cfg;
+    s->f.link     = link;
+    if (data && len) memcpy(s->f.data, data, len);
+    atomic_store_explicit(&s->seq, pos + 1, memory_order_release);
+
+    atomic_fetch_add_explicit(&r->pushed, 1, memory_order_relaxed);
+    /* a tail azóta túl is léphetett a keretünkön (kivették) → negatív, nem számít */
+    const int used = (int)(pos + 1 - atomic_load_explicit(&r->tail, memory_order_relaxed));
+    if (used > 0) note_high_water(r, used > NOTIFY_RING_SLOTS ? NOTIFY_RING_SLOTS : (unsigned)used);
+    return true;
+}
+
+const notify_frame_t* notify_ring_peek(notify_ring_t* r)
+{
+    unsigned pos = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    notify_slot_t* s = &r->slot[pos & MASK];
+    unsigned seq = atomic_load_explicit(&s->seq, memory_order_acquire);
+    return (seq == pos + 1) ? &s->f : NULL;
+}
+
+void notify_ring_release(notify_ring_t* r)
+{
+    unsigned pos = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    notify_slot_t* s = &r->slot[pos & MASK];
+    atomic_store_explicit(&s->seq, pos + NOTIFY_RING_SLOTS, memory_order_release);
+    atomic_store_explicit(&r->tail, pos + 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&r->popped, 1, memory_order_relaxed);
+}
+
+void notify_ring_get_stats(const notify_ring_t* r, notify_ring_stats_t* out)
+{
+    notify_ring_t* m = (notify_ring_t*)r;
+    out->pushed     = atomic_load_explicit(&m->pushed, memory_order_relaxed);
+    out->popped     = atomic_load_explicit(&m->popped, memory_order_relaxed);
+    out->dropped    = atomic_load_explicit(&m->dropped, memory_order_relaxed);
+    out->truncated  = atomic_load_explicit(&m->truncated, memory_order_relaxed);
+    out->high_water = atomic_load_explicit(&m->high_water, memory_order_relaxed);
+}
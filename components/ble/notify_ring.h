@@ -0,0 +1,59 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Fix kapacitású, allokációmentes NOTIFY keret-gyűrű.
+ * Több termelő (BTC task, később injektorok) → egy fogyasztó (rx task).
+ * Bounded MPSC: slotonkénti szekvenciaszámmal, zár nélkül. */
+
+#define NOTIFY_RING_SLOTS  32           /* 2 hatványa */
+#define NOTIFY_FRAME_MAX   244          /* ATT_MTU 247 - 3 */
+
+typedef struct {
+    int64_t  ts_us;                     /* esp_timer_get_time() a callbackben */
+    uint16_t len;
+    bool     from_cfg;
+    uint8_t  link;                      /* forrás anchor (ble link index) */
+    uint8_t  data[NOTIFY_FRAME_MAX];
+} notify_frame_t;
+
+typedef struct {
+    uint32_t pushed;
+    uint32_t popped;
+    uint32_t dropped;                   /* tele volt a gyűrű */
+    uint32_t truncated;                 /* > NOTIFY_FRAME_MAX, levágva */
+    uint32_t high_water;                /* max. foglaltság (slot) */
+} notify_ring_stats_t;
+
+typedef struct {
+    atomic_uint    seq;
+    notify_frame_t f;
+} notify_slot_t;
+
+typedef struct {
+    notify_slot_t slot[NOTIFY_RING_SLOTS];
+    atomic_uint   head;                 /* termelők foglalnak */
+    atomic_uint   tail;                 /* csak a fogyasztó írja */
+    atomic_uint   pushed, popped, dropped, truncated, high_water;
+} notify_ring_t;
+
+void notify_ring_init(notify_ring_t* r);
+
+/* Termelő: bemásol egy keretet. false → tele, a keret eldobva (dropped++). */
+bool notify_ring_push(notify_ring_t* r, uint8_t link, int64_t ts_us, const uint8_t* data, uint16_t len, bool from_cfg);
+
+/* Fogyasztó: a legrégebbi keret helyben (másolás nélkül), NULL ha üres.
+ * A slot a notify_ring_release() hívásig a fogyasztóé. */
+const notify_frame_t* notify_ring_peek(notify_ring_t* r);
+void notify_ring_release(notify_ring_t* r);
+
+void notify_ring_get_stats(const notify_ring_t* r, notify_ring_stats_t* out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,108 +1,61 @@
 #include <stdio.h>
 #include "esp_log.h"
 #include "pretty_print.h"
+#include "tlv.h"
+#include "uwb_frame.h"
 #include <inttypes.h>
 
-static const char* TAG_BLE = "BLE";
 static const char* TAG_CFG = "CFG";
 static const char* TAG_DAT = "DATA";
 
-static inline uint32_t rd32le(const uint8_t* p){
-    return ((uint32_t)p[0]) | ((uint32_t)p[1]<<8) | ((uint32_t)p[2]<<16) | ((uint32_t)p[3]<<24);
-}
-static inline uint64_t rd40le(const uint8_t* p){   // 5 B little-endian
-    return ((uint64_t)p[0]) |
-           ((uint64_t)p[1]<<8) |
-           ((uint64_t)p[2]<<16) |
-           ((uint64_t)p[3]<<24) |
-           ((uint64_t)p[4]<<32);
-}
-
 // pretty_print.c
-void pp_log_cfg(const uint8_t* d, uint16_t n,
-                const char* (*tlv_name)(uint8_t),
-                uint16_t (*rd16be)(const uint8_t*),
-                uint32_t (*rd32be)(const uint8_t*))
+void pp_log_cfg(const uint8_t* d, uint16_t n)
 {
-    // HB fast-path: [01 01 <st>] [02 04 <up:BE32>] [03 02 <sync_ms:BE16>]  => 13 B
-    if (n == 13 && d[0]==0x01 && d[1]==0x01 && d[3]==0x02 && d[4]==0x04 && d[9]==0x03 && d[10]==0x02) {
-        uint8_t  st   = d[2];
-        uint32_t up   = rd32be(&d[5]);
-        uint16_t sync = rd16be(&d[11]);
-        ESP_LOGI("CFG", "HB st=0x%02X up=%" PRIu32 " sync_ms=%u", st, up, (unsigned)sync);
+    uwb_cfg_t c;
+    switch (uwb_cfg_decode(d, n, &c)) {
+    case UWB_CFG_HB:
+        ESP_LOGI(TAG_CFG, "HB st=0x%02X up=%" PRIu32 " sync_ms=%u", c.hb.st, c.hb.up_ms, (unsigned)c.hb.sync_ms);
         return;
-    }
-
-    // ACK
-    if(n==6 && d[0]==1 && d[1]==0x81){
-        ESP_LOGI("CFG","ACK req=%u status=0x%02X applied=%u",
-                 (unsigned)rd16be(&d[2]), d[4], d[5]);
+    case UWB_CFG_ACK:
+        ESP_LOGI(TAG_CFG, "ACK req=%u status=0x%02X applied=%u",
+                 (unsigned)c.ack.req_id, c.ack.status, c.ack.applied);
         return;
-    }
-    // STATE
-    if(n==17 && d[0]==1 && d[1]==0x90){
-        ESP_LOGI("CFG","STATE st=0x%02X sync_ms=%u up=%" PRIu32 " net=%u zone=0x%04X anc=0x%08" PRIX32,
-                 d[2], (unsigned)rd16be(&d[3]), (uint32_t)rd32be(&d[5]),
-                 (unsigned)rd16be(&d[9]), (unsigned)rd16be(&d[11]),
-                 (uint32_t)rd32be(&d[13]));
+    case UWB_CFG_STATE:
+        ESP_LOGI(TAG_CFG, "STATE st=0x%02X sync_ms=%u up=%" PRIu32 " net=%u zone=0x%04X anc=0x%08" PRIX32,
+                 c.state.st, (unsigned)c.state.sync_ms, c.state.up_ms,
+                 (unsigned)c.state.net, (unsigned)c.state.zone, c.state.anchor_id);
         return;
+    default:
+        break;
     }
 
     // TLV stream
-    uint16_t i=0;
-    while(i+2<=n){
-        uint8_t t=d[i++], l=d[i++];
-        if(i+l>n){ ESP_LOGW("CFG","TLV overflow t=0x%02X l=%u",t,(unsigned)l); break; }
-        const uint8_t* v=&d[i];
-        const char* nm = tlv_name? tlv_name(t):"TLV";
-
-        switch (t) {
-          case 0x00: if(l==1) ESP_LOGI("CFG","%s=%u", nm, v[0]); break;
-          case 0x01: if(l==1) ESP_LOGI("CFG","%s=0x%02X", nm, v[0]); break;
-          case 0x02: if(l==4) ESP_LOGI("CFG","%s=%" PRIu32, nm, (uint32_t)rd32be(v)); break;
-          case 0x03: if(l==2) ESP_LOGI("CFG","%s=%u", nm, (unsigned)rd16be(v)); break;
-          case 0x10: if(l==2) ESP_LOGI("CFG","%s=%u", nm, (unsigned)rd16be(v)); break;
-          case 0x11: if(l==2) ESP_LOGI("CFG","%s=0x%04X", nm, (unsigned)rd16be(v)); break;
-          case 0x12: if(l==4) ESP_LOGI("CFG","%s=0x%08" PRIX32, nm, (uint32_t)rd32be(v)); break;
-          case 0x13: if(l==4) ESP_LOGI("CFG","%s=%" PRId32, nm, (int32_t) rd32be(v)); break;
-          case 0x14: if(l==4) ESP_LOGI("CFG","%s=%" PRId32, nm, (int32_t) rd32be(v)); break;
-          case 0x16: if(l==4) ESP_LOGI("CFG","%s=%" PRId32, nm, (int32_t) rd32be(v)); break; // BIAS_TICKS
-          case 0x1F: if(l==1) ESP_LOGI("CFG","%s=%u", nm, v[0]); break;
-          case 0x20: if(l==2) ESP_LOGI("CFG","%s=%u", nm, (unsigned)rd16be(v)); break;
-          case 0x30: if(l==2) ESP_LOGI("CFG","%s=%u", nm, (unsigned)rd16be(v)); break;
-          case 0x31: if(l==2) ESP_LOGI("CFG","%s=%u", nm, (unsigned)rd16be(v)); break;
-          case 0x32: if(l==2) ESP_LOGI("CFG","%s=%u", nm, (unsigned)rd16be(v)); break;
-          case 0x33: if(l==1) ESP_LOGI("CFG","%s=%u", nm, v[0]); break;
-          case 0x34: if(l==1) ESP_LOGI("CFG","%s=%u", nm, v[0]); break;
-          case 0x35: if(l==2) ESP_LOGI("CFG","%s=%u", nm, (unsigned)rd16be(v)); break;
-          case 0x36: if(l==2) ESP_LOGI("CFG","%s=%u", nm, (unsigned)rd16be(v)); break;
-          case 0x37: if(l==2) ESP_LOGI("CFG","%s=%u", nm, (unsigned)rd16be(v)); break;
-          case 0x38: if(l==2) ESP_LOGI("CFG","%s=%u", nm, (unsigned)rd16be(v)); break;
-          case 0x39: if(l==1) ESP_LOGI("CFG","%s=%u", nm, v[0]); break;
-          default: {
-            char hex[128]; size_t o=0;
-            for(uint8_t k=0;k<l && o+3<sizeof(hex);k++) o += snprintf(hex+o,sizeof(hex)-o,"%02X ",v[k]);
-            if(o) hex[o-1]=0;
-            ESP_LOGI("CFG","%s[len=%u]: %s", nm, (unsigned)l, hex);
-          } break;
+    tlv_cur_t cur; tlv_t t; tlv_rc_t rc;
+    tlv_cur_init(&cur, d, n);
+    while ((rc = tlv_next(&cur, &t)) == TLV_ITEM) {
+        if (tlv_width_ok(&t)) {                         // szám: egy formázás (a tlv_format_value köztes puffere nélkül)
+            switch (t.d->fmt) {
+            case TLV_FMT_DEC:  ESP_LOGI(TAG_CFG, "%s=%" PRIu32, t.d->name, tlv_u32(&t)); continue;
+            case TLV_FMT_SDEC: ESP_LOGI(TAG_CFG, "%s=%" PRId32, t.d->name, tlv_i32(&t)); continue;
+            case TLV_FMT_HEX:  ESP_LOGI(TAG_CFG, "%s=0x%0*" PRIX32, t.d->name, t.len * 2, tlv_u32(&t)); continue;
+            default: break;
+            }
         }
-        i+=l;
+        char vb[128];
+        tlv_format_value(&t, vb, sizeof(vb));
+        if (tlv_width_ok(&t)) ESP_LOGI(TAG_CFG, "%s=%s", t.d->name, vb);
+        else ESP_LOGI(TAG_CFG, "%s(0x%02X)[len=%u]: %s", t.d->name ? t.d->name : "TLV", t.tag, (unsigned)t.len, vb);
     }
+    if (rc == TLV_TRUNC) ESP_LOGW(TAG_CFG, "TLV overflow t=0x%02X l=%u", t.tag, (unsigned)t.len);
 }
 
 void pp_log_data(const uint8_t* d, uint16_t n)
 {
-    if (n!=20 || d[0]!=0xAB){ /* hexdump fallback ... */ return; }
+    uwb_data_t f;
+    if (!uwb_data_decode(d, n, &f)){ /* hexdump fallback ... */ return; }
 
-    uint8_t  version  = d[1];
-    uint8_t  sync_seq = d[2];
-    uint8_t  tag_seq  = d[3];
-    uint32_t anchor_id= rd32le(&d[4]);
-    uint32_t tag_id   = rd32le(&d[8]);
-    uint64_t ts_40    = rd40le(&d[12]);   // 40 bit érvényes, LE
-
-    ESP_LOGI("DATA",
+    ESP_LOGI(TAG_DAT,
         "VER=%u SYNC=%u TAGSEQ=%u ANCHOR_ID=0x%08" PRIX32
         " TAG_ID=0x%08" PRIX32 " TIMESTAMP=%" PRIu64 " (0x%010" PRIX64 ")",
-        version, sync_seq, tag_seq, anchor_id, tag_id, ts_40, ts_40);
-}
\ No newline at end of file
+        f.ver, f.sync_seq, f.tag_seq, f.anchor_id, f.tag_id, f.ts40, f.ts40);
+}
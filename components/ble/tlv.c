@@ -0,0 +1,102 @@
+// components/ble/tlv.c — táblavezérelt CFG TLV kodek
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "tlv.h"
+#include "metrics.h"
+
+#define D(n, w, f) { n, w, f, (w) ? 1u << (w) : 0x1Eu }     /* változó: 1..4 */
+
+/* tag → leíró; a kihagyott indexek {NULL,0,0} = ismeretlen */
+const tlv_desc_t tlv_desc_tab[256] = {
+    [T_VER]             = D("VER",             1, TLV_FMT_DEC),
+    [T_STATUS]          = D("STATUS",          1, TLV_FMT_HEX),
+    [T_UPTIME_MS]       = D("UPTIME_MS",       4, TLV_FMT_DEC),
+    [T_SYNC_MS]         = D("SYNC_MS",         2, TLV_FMT_DEC),
+    [T_NETWORK_ID]      = D("NETWORK_ID",      2, TLV_FMT_DEC),
+    [T_ZONE_ID]         = D("ZONE_ID",         2, TLV_FMT_HEX),
+    [T_ANCHOR_ID]       = D("ANCHOR_ID",       4, TLV_FMT_HEX),
+    [T_TX_ANT_DLY]      = D("TX_ANT_DLY",      4, TLV_FMT_SDEC),
+    [T_RX_ANT_DLY]      = D("RX_ANT_DLY",      4, TLV_FMT_SDEC),
+    [T_BIAS_TICKS]      = D("BIAS_TICKS",      4, TLV_FMT_SDEC),
+    [T_LOG_LEVEL]       = D("LOG_LEVEL",       1, TLV_FMT_DEC),
+    [T_HB_MS]           = D("HB_MS",           2, TLV_FMT_DEC),
+    [T_SYN_PPM_MAX]     = D("SYN_PPM_MAX",     2, TLV_FMT_DEC),
+    [T_SYN_JUMP_PPM]    = D("SYN_JUMP_PPM",    2, TLV_FMT_DEC),
+    [T_SYN_AB_GAP_MS]   = D("SYN_AB_GAP_MS",   2, TLV_FMT_DEC),
+    [T_SYN_MS_EWMA_DEN] = D("SYN_MS_EWMA_DEN", 1, TLV_FMT_DEC),
+    [T_SYN_TK_EWMA_DEN] = D("SYN_TK_EWMA_DEN", 1, TLV_FMT_DEC),
+    [T_SYN_TK_MIN_MS]   = D("SYN_TK_MIN_MS",   2, TLV_FMT_DEC),
+    [T_SYN_TK_MAX_MS]   = D("SYN_TK_MAX_MS",   2, TLV_FMT_DEC),
+    [T_SYN_DTTX_MIN_MS] = D("SYN_DTTX_MIN_MS", 2, TLV_FMT_DEC),
+    [T_SYN_DTTX_MAX_MS] = D("SYN_DTTX_MAX_MS", 2, TLV_FMT_DEC),
+    [T_SYN_LOCK_NEED]   = D("SYN_LOCK_NEED",   1, TLV_FMT_DEC),
+    [T_PHY_CH]          = D("PHY_CH",          1, TLV_FMT_DEC),
+    [T_PHY_PLEN]        = D("PHY_PLEN",        0, TLV_FMT_DEC),
+    [T_PHY_PAC]         = D("PHY_PAC",         0, TLV_FMT_DEC),
+    [T_PHY_TX_CODE]     = D("PHY_TX_CODE",     0, TLV_FMT_DEC),
+    [T_PHY_RX_CODE]     = D("PHY_RX_CODE",     0, TLV_FMT_DEC),
+    [T_PHY_SFD]         = D("PHY_SFD",         0, TLV_FMT_DEC),
+    [T_PHY_BR]          = D("PHY_BR",          0, TLV_FMT_DEC),
+    [T_PHY_PHRMODE]     = D("PHY_PHRMODE",     0, TLV_FMT_DEC),
+    [T_PHY_PHRRATE]     = D("PHY_PHRRATE",     0, TLV_FMT_DEC),
+    [T_PHY_SFDTO]       = D("PHY_SFDTO",       2, TLV_FMT_DEC),
+    [T_PHY_STS_MODE]    = D("PHY_STS_MODE",    0, TLV_FMT_DEC),
+    [T_PHY_STS_LEN]     = D("PHY_STS_LEN",     0, TLV_FMT_DEC),
+    [T_PHY_PDOA]        = D("PHY_PDOA",        0, TLV_FMT_DEC),
+};
+
+tlv_rc_t tlv_next_trunc(tlv_cur_t* c, tlv_t* out)
+{
+    const uint8_t t = c->p[c->off];
+    out->tag = t; out->len = c->p[c->off + 1]; out->val = NULL; out->d = &tlv_desc_tab[t];
+    c->off = c->n;                                    /* a maradék használhatatlan */
+    metric_inc(M_TLV_TRUNC);
+    return TLV_TRUNC;
+}
+
+int tlv_format_value(const tlv_t* t, char* buf, size_t sz)
+{
+    if (!sz) return 0;
+    uint8_t fmt = t->d->fmt;
+    if (!t->d->name || t->len == 0 || t->len > 4) fmt = TLV_FMT_RAW;
+
+    int n;
+    switch (fmt) {
+    case TLV_FMT_DEC:  n = snprintf(buf, sz, "%" PRIu32, tlv_u32(t)); break;
+    case TLV_FMT_SDEC: n = snprintf(buf, sz, "%" PRId32, tlv_i32(t)); break;
+    case TLV_FMT_HEX:  n = snprintf(buf, sz, "0x%0*" PRIX32, t->len * 2, tlv_u32(t)); break;
+    default: {
+        static const char hx[] = "0123456789ABCDEF";
+        size_t o = 0;
+        for (uint8_t k = 0; k < t->len && o + 3 < sz; k++) {
+            buf[o++] = hx[t->val[k] >> 4];
+            buf[o++] = hx[t->val[k] & 0x0F];
+            buf[o++] = ' ';
+        }
+        if (o) o--;
+        buf[o] = 0;
+        return (int)o;
+    }
+    }
+    return (n < 0) ? 0 : ((size_t)n >= sz ? (int)sz - 1 : n);
+}
+
+bool tlv_put_raw(tlv_wr_t* w, uint8_t tag, const uint8_t* v, uint8_t len)
+{
+    if (w->len + 2 + len > w->cap) return false;
+    w->p[w->len++] = tag;
+    w->p[w->len++] = len;
+    if (len) memcpy(w->p + w->len, v, len);
+    w->len += len;
+    return true;
+}
+
+bool tlv_put(tlv_wr_t* w, uint8_t tag, uint32_t v)
+{
+    uint8_t width = tlv_desc_tab[tag].width;
+    if (!tlv_desc_tab[tag].name || width == 0 || width > 4) return false;
+    uint8_t b[4];
+    for (uint8_t i = 0; i < width; i++) b[i] = (uint8_t)(v >> (8 * (width - 1 - i)));
+    return tlv_put_raw(w, tag, b, width);
+}
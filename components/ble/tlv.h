@@ -0,0 +1,128 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===== CFG TLV kodek =====
+ * Egyetlen leíró tábla (tag → név, szélesség, előjel, formátum) minden
+ * parsernek. A dekóder/enkóder helyben dolgozik a notify pufferen, nem allokál.
+ * Értékek: big-endian, 1..4 bájt. */
+
+typedef enum {
+    TLV_FMT_DEC = 0,     /* előjel nélküli decimális */
+    TLV_FMT_SDEC,        /* előjeles decimális (sign-extend a hosszból) */
+    TLV_FMT_HEX,         /* 0x%0*X, szélesség szerint */
+    TLV_FMT_RAW,         /* bájtonkénti hexdump */
+} tlv_fmt_t;
+
+typedef struct {
+    const char* name;    /* NULL → ismeretlen tag */
+    uint8_t     width;   /* elvárt hossz, 0 = változó (1..4 számként, fölötte RAW) */
+    uint8_t     fmt;     /* tlv_fmt_t */
+    uint8_t     lens;    /* elfogadott hosszak bitmaszkja (bit l); 0 → ismeretlen tag */
+} tlv_desc_t;
+
+/* Ismert tagek */
+enum {
+    T_VER = 0x00, T_STATUS = 0x01, T_UPTIME_MS = 0x02, T_SYNC_MS = 0x03,
+    T_NETWORK_ID = 0x10, T_ZONE_ID = 0x11, T_ANCHOR_ID = 0x12,
+    T_TX_ANT_DLY = 0x13, T_RX_ANT_DLY = 0x14, T_BIAS_TICKS = 0x16,
+    T_LOG_LEVEL = 0x1F, T_HB_MS = 0x20,
+    T_SYN_PPM_MAX = 0x30, T_SYN_JUMP_PPM = 0x31, T_SYN_AB_GAP_MS = 0x32,
+    T_SYN_MS_EWMA_DEN = 0x33, T_SYN_TK_EWMA_DEN = 0x34, T_SYN_TK_MIN_MS = 0x35,
+    T_SYN_TK_MAX_MS = 0x36, T_SYN_DTTX_MIN_MS = 0x37, T_SYN_DTTX_MAX_MS = 0x38,
+    T_SYN_LOCK_NEED = 0x39,
+    T_PHY_CH = 0x40, T_PHY_PLEN = 0x41, T_PHY_PAC = 0x42, T_PHY_TX_CODE = 0x43,
+    T_PHY_RX_CODE = 0x44, T_PHY_SFD = 0x45, T_PHY_BR = 0x46, T_PHY_PHRMODE = 0x47,
+    T_PHY_PHRRATE = 0x48, T_PHY_SFDTO = 0x49, T_PHY_STS_MODE = 0x4A,
+    T_PHY_STS_LEN = 0x4B, T_PHY_PDOA = 0x4C,
+};
+
+extern const tlv_desc_t tlv_desc_tab[256];
+static inline const tlv_desc_t* tlv_desc(uint8_t tag){ return &tlv_desc_tab[tag]; }   /* name==NULL ha ismeretlen */
+
+/* ---- Dekóder (cursor) ---- */
+typedef struct {
+    uint8_t            tag;
+    uint8_t            len;
+    const uint8_t*     val;                       /* a forrás pufferbe mutat */
+    const tlv_desc_t*  d;
+} tlv_t;
+
+typedef struct {
+    const uint8_t* p;
+    uint16_t       n;
+    uint16_t       off;
+} tlv_cur_t;
+
+typedef enum { TLV_END = 0, TLV_ITEM = 1, TLV_TRUNC = -1 } tlv_rc_t;
+
+static inline void tlv_cur_init(tlv_cur_t* c, const uint8_t* p, uint16_t n){ c->p = p; c->n = n; c->off = 0; }
+
+/* A forró út (tlv_next / tlv_width_ok / tlv_u32) inline: a snapshot ~35 eleménél
+ * a függvényhívás többe került, mint maga a dekódolás (bench_tlv). */
+tlv_rc_t tlv_next_trunc(tlv_cur_t* c, tlv_t* out);    /* tlv_next csonka ága (metrika) */
+
+static inline tlv_rc_t tlv_next(tlv_cur_t* c, tlv_t* out)
+{
+    const unsigned off = c->off;
+    if (off + 2 > c->n) return TLV_END;
+    const uint8_t l = c->p[off + 1];
+    if (off + 2 + l > c->n) return tlv_next_trunc(c, out);
+    out->tag = c->p[off];
+    out->len = l;
+    out->val = c->p + off + 2;
+    out->d   = &tlv_desc_tab[out->tag];
+    c->off   = (uint16_t)(off + 2 + l);
+    return TLV_ITEM;
+}
+
+/* ismert tag és a hossz a leírónak megfelel */
+static inline bool tlv_width_ok(const tlv_t* t)
+{
+    return t->len < 8 && (t->d->lens >> t->len & 1);
+}
+
+/* BE, 1..4 B (hosszabbnál az első 4) */
+static inline uint32_t tlv_u32(const tlv_t* t)
+{
+    const uint8_t* v = t->val;
+    switch (t->len) {
+    case 0:  return 0;
+    case 1:  return v[0];
+    case 2:  return (uint32_t)v[0] << 8 | v[1];
+    case 3:  return (uint32_t)v[0] << 16 | (uint32_t)v[1] << 8 | v[2];
+    default: return (uint32_t)v[0] << 24 | (uint32_t)v[1] << 16 | (uint32_t)v[2] << 8 | v[3];
+    }
+}
+
+/* BE, sign-extend a hosszból */
+static inline int32_t tlv_i32(const tlv_t* t)
+{
+    uint32_t v = tlv_u32(t);
+    const uint8_t n = t->len < 4 ? t->len : 4;
+    if (n && n < 4 && (v & (1u << (n * 8 - 1)))) v |= ~0u << (n * 8);
+    return (int32_t)v;
+}
+
+/* Érték szövegként a leíró formátuma szerint; visszaad: írt hossz. */
+int tlv_format_value(const tlv_t* t, char* buf, size_t sz);
+
+/* ---- Enkóder ---- */
+typedef struct {
+    uint8_t* p;
+    uint16_t cap;
+    uint16_t len;
+} tlv_wr_t;
+
+static inline void tlv_wr_init(tlv_wr_t* w, uint8_t* buf, uint16_t cap){ w->p = buf; w->cap = cap; w->len = 0; }
+bool tlv_put(tlv_wr_t* w, uint8_t tag, uint32_t v);                              /* szélesség a táblából */
+bool tlv_put_raw(tlv_wr_t* w, uint8_t tag, const uint8_t* v, uint8_t len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,44 @@
+// components/ble/uwb_frame.c — DATA / HB / ACK / STATE dekóder
+#include <stddef.h>
+#include "uwb_frame.h"
+
+static inline uint16_t rd16be(const uint8_t* v){ return ((uint16_t)v[0]<<8) | v[1]; }
+static inline uint32_t rd32be(const uint8_t* v){ return ((uint32_t)v[0]<<24)|((uint32_t)v[1]<<16)|((uint32_t)v[2]<<8)|v[3]; }
+static inline uint32_t rd32le(const uint8_t* p){
+    return ((uint32_t)p[0]) | ((uint32_t)p[1]<<8) | ((uint32_t)p[2]<<16) | ((uint32_t)p[3]<<24);
+}
+
+bool uwb_data_decode(const uint8_t* d, uint16_t n, uwb_data_t* out)
+{
+    if (!d || n != UWB_DATA_LEN || d[0] != UWB_DATA_HDR) return false;
+    out->ver       = d[1];
+    out->sync_seq  = d[2];
+    out->tag_seq   = d[3];
+    out->anchor_id = rd32le(&d[4]);
+    out->tag_id    = rd32le(&d[8]);
+    out->ts40      = (uint64_t)rd32le(&d[12]) | ((uint64_t)d[16] << 32);
+    return true;
+}
+
+uwb_cfg_kind_t uwb_cfg_decode(const uint8_t* d, uint16_t n, uwb_cfg_t* out)
+{
+    uwb_cfg_kind_t k = UWB_CFG_TLV;
+    if (!d) return k;
+    // HB fast-path: [01 01 <st>] [02 04 <up:BE32>] [03 02 <sync_ms:BE16>]  => 13 B
+    if (n == 13 && d[0]==0x01 && d[1]==0x01 && d[3]==0x02 && d[4]==0x04 && d[9]==0x03 && d[10]==0x02) {
+        k = UWB_CFG_HB;
+        if (out) { out->hb.st = d[2]; out->hb.up_ms = rd32be(&d[5]); out->hb.sync_ms = rd16be(&d[11]); }
+    } else if (n == 6 && d[0]==1 && d[1]==0x81) {            // [1,0x81,req_hi,req_lo,status,applied]
+        k = UWB_CFG_ACK;
+        if (out) { out->ack.req_id = rd16be(&d[2]); out->ack.status = d[4]; out->ack.applied = d[5]; }
+    } else if (n == 17 && d[0]==1 && d[1]==0x90) {
+        k = UWB_CFG_STATE;
+        if (out) {
+            out->state.st = d[2];           out->state.sync_ms = rd16be(&d[3]);
+            out->state.up_ms = rd32be(&d[5]); out->state.net = rd16be(&d[9]);
+            out->state.zone = rd16be(&d[11]); out->state.anchor_id = rd32be(&d[13]);
+        }
+    }
+    if (out) out->kind = k;
+    return k;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===== UWB anchor keretek dekódolása =====
+ * Tisztán adatfeldolgozás (nincs ESP függőség), a logolás / JSON / cache
+ * ugyanezt használja. */
+
+/* DATA: 20 B, 0xAB fejléc, LE mezők */
+#define UWB_DATA_LEN  20
+#define UWB_DATA_HDR  0xAB
+
+typedef struct {
+    uint8_t  ver;
+    uint8_t  sync_seq;
+    uint8_t  tag_seq;
+    uint32_t anchor_id;
+    uint32_t tag_id;
+    uint64_t ts40;          /* 40 bites DW időbélyeg */
+} uwb_data_t;
+
+bool uwb_data_decode(const uint8_t* d, uint16_t n, uwb_data_t* out);
+
+/* CFG csatorna: HB (13 B TLV fast-path), ACK, STATE, egyébként TLV folyam */
+typedef enum { UWB_CFG_TLV = 0, UWB_CFG_HB, UWB_CFG_ACK, UWB_CFG_STATE } uwb_cfg_kind_t;
+
+typedef struct {
+    uwb_cfg_kind_t kind;
+    union {
+        struct { uint8_t st; uint32_t up_ms; uint16_t sync_ms; } hb;
+        struct { uint16_t req_id; uint8_t status, applied; } ack;
+        struct { uint8_t st; uint16_t sync_ms; uint32_t up_ms; uint16_t net, zone; uint32_t anchor_id; } state;
+    };
+} uwb_cfg_t;
+
+/* out lehet NULL, ha csak az osztályozás kell */
+uwb_cfg_kind_t uwb_cfg_decode(const uint8_t* d, uint16_t n, uwb_cfg_t* out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,101 @@
+// components/ble/write_queue.c — előre foglalt GATT írási sor (FIFO, in-flight ablak)
+#include <string.h>
+#include "write_queue.h"
+
+static inline uint8_t at(const wq_t* q, uint8_t i){ return (uint8_t)((q->head + i) % WQ_SLOTS); }
+
+void wq_init(wq_t* q)
+{
+    memset(q, 0, sizeof(*q));
+}
+
+wq_slot_t* wq_push(wq_t* q, uint8_t kind, bool no_rsp, uint16_t handle,
+                   const void* hdr, uint16_t hlen, const void* data, uint16_t len, int64_t now_us)
+{
+    if ((uint32_t)hlen + len > WQ_VAL_MAX || !(hlen + len)) return NULL;
+    if (q->count == WQ_SLOTS) { q->st.full++; return NULL; }
+    wq_slot_t* s = &q->slot[at(q, q->count)];
+    s->state   = WQ_QUEUED;
+    s->kind    = kind;
+    s->no_rsp  = no_rsp;
+    s->is_long = s->err = false;
+    s->handle  = handle;
+    s->len     = hlen + len;
+    s->off     = s->chunk = 0;
+    s->t_us    = now_us;
+    if (hlen) memcpy(s->buf, hdr, hlen);
+    if (len)  memcpy(s->buf + hlen, data, len);
+    q->count++;
+    q->st.queued++;
+    if (q->count > q->st.high_water) q->st.high_water = q->count;
+    return s;
+}
+
+wq_slot_t* wq_next(wq_t* q, uint8_t window, uint16_t max_pdu)
+{
+    if (q->long_busy || q->inflight >= window) return NULL;
+    for (uint8_t i = 0; i < q->count; i++) {
+        wq_slot_t* s = &q->slot[at(q, i)];
+        if (s->state != WQ_QUEUED) continue;
+        const bool lng = s->kind == WQ_CHAR && s->len > max_pdu;
+        if (lng && q->inflight) return NULL;          /* kizárólagos: kivárja a többit */
+        s->state   = WQ_SENT;
+        s->is_long = lng;
+        if (lng) { s->no_rsp = 0; q->long_busy = true; q->st.longw++; }
+        else if (s->no_rsp) q->st.no_rsp++;
+        q->inflight++;
+        return s;
+    }
+    return NULL;
+}
+
+wq_slot_t* wq_oldest_sent(wq_t* q)
+{
+    for (uint8_t i = 0; i < q->count; i++) {
+        wq_slot_t* s = &q->slot[at(q, i)];
+        if (s->state == WQ_SENT) return s;
+    }
+    return NULL;
+}
+
+static void pop_done(wq_t* q)
+{
+    while (q->count && q->slot[q->head].state == WQ_DONE) {
+        q->slot[q->head].state = WQ_FREE;
+        q->head = at(q, 1);
+        q->count--;
+    }
+}
+
+static void close_slot(wq_t* q, wq_slot_t* s, bool ok)
+{
+    s->state = WQ_DONE;
+    if (s->is_long) q->long_busy = false;
+    q->inflight--;
+    if (ok) q->st.done++; else q->st.failed++;
+    pop_done(q);
+}
+
+bool wq_complete(wq_t* q, bool ok, int64_t* t_us)
+{
+    wq_slot_t* s = wq_oldest_sent(q);
+    if (!s) return false;
+    if (t_us) *t_us = s->t_us;
+    close_slot(q, s, ok);
+    return true;
+}
+
+void wq_fail(wq_t* q, wq_slot_t* s)
+{
+    if (s->state == WQ_SENT) close_slot(q, s, false);   /* közben flush-olva: már szabad */
+}
+
+uint32_t wq_flush(wq_t* q)
+{
+    const uint32_t n = q->count;
+    for (uint8_t i = 0; i < WQ_SLOTS; i++) q->slot[i].state = WQ_FREE;
+    q->head = q->count = q->inflight = 0;
+    q->long_busy = false;
+    q->st.failed += n;
+    return n;
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===== Linkenkénti GATT írási sor =====
+ * Előre foglalt slotok, FIFO. A slot állapota QUEUED → SENT (a stacknek
+ * átadva) → DONE (completion esemény / hiba); a fej DONE slotjai szabadulnak.
+ * A Bluedroid a completion-öket sorrendben adja, így mindig a legrégebbi
+ * SENT slot zárul. Egyszerre legfeljebb `window` SENT; a hosszú (prepared)
+ * írás kizárólagos. Nem szálbiztos, ESP API-t nem hív: a hívó zárol. */
+
+#define WQ_SLOTS     8
+#define WQ_VAL_MAX   256          /* érték bájt / írás (prepared írással > ATT_MTU is) */
+
+enum { WQ_FREE = 0, WQ_QUEUED, WQ_SENT, WQ_DONE };
+enum { WQ_CHAR = 0, WQ_DESCR };
+
+typedef struct {
+    uint8_t  state, kind;
+    uint8_t  no_rsp;              /* write without response */
+    bool     is_long;             /* prepare + execute */
+    bool     err;                 /* prepared sorozat közbeni hiba */
+    uint16_t handle, len;
+    uint16_t off, chunk;          /* prepared: elküldött / futó darab */
+    int64_t  t_us;                /* sorba tétel ideje */
+    uint8_t  buf[WQ_VAL_MAX];
+} wq_slot_t;
+
+typedef struct {
+    uint32_t queued, done, failed;
+    uint32_t full;                /* tele sor miatt visszautasítva */
+    uint32_t no_rsp, longw;       /* kiadott NR / prepared írások */
+    uint16_t high_water;
+} wq_stats_t;
+
+typedef struct {
+    wq_slot_t  slot[WQ_SLOTS];
+    uint8_t    head, count;       /* FIFO: head = legrégebbi */
+    uint8_t    inflight;          /* SENT slotok */
+    bool       long_busy;
+    bool       pumping;           /* egy kiadó egyszerre (sorrend) */
+    wq_stats_t st;
+} wq_t;
+
+void       wq_init(wq_t* q);
+/* hdr + data egymás után a slotba; NULL, ha tele vagy túl hosszú */
+wq_slot_t* wq_push(wq_t* q, uint8_t kind, bool no_rsp, uint16_t handle,
+                   const void* hdr, uint16_t hlen, const void* data, uint16_t len, int64_t now_us);
+/* következő kiadható slot (→ SENT), NULL ha nincs vagy az ablak tele.
+   max_pdu: egy ATT írásba férő érték (MTU - 3); afölött prepared írás. */
+wq_slot_t* wq_next(wq_t* q, uint8_t window, uint16_t max_pdu);
+/* a legrégebbi SENT slot (prepared láncoláshoz), NULL ha nincs */
+wq_slot_t* wq_oldest_sent(wq_t* q);
+/* completion: a legrégebbi SENT lezárása; false ha nem volt függő írás */
+bool       wq_complete(wq_t* q, bool ok, int64_t* t_us);
+/* a kiadás sikertelen (a stack nem vette át): a slot lezárva hibával */
+void       wq_fail(wq_t* q, wq_slot_t* s);
+/* link bontás: minden függő írás hibával zárul; → eldobott slotok */
+uint32_t   wq_flush(wq_t* q);
+static inline uint8_t wq_depth(const wq_t* q){ return q->count; }
+
+#ifdef __cplusplus
+}
+#endif
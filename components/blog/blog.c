@@ -0,0 +1,300 @@
+// components/blog/blog.c — bináris napló: szintek, rátalimit, drain task (UART / SPIFFS)
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "blog_core.h"
+#include "blog.h"
+
+static const char* TAG = "blog";
+
+#define BLOG_RING_SIZE   (16 * 1024)
+#define BLOG_TASK_STACK  3072
+#define BLOG_TASK_PRIO   1                  /* minden más alatt: a napló sosem foglalja a CPU-t */
+#define BLOG_DRAIN_MS    50
+#define BLOG_FILE        "/spiffs/blog.bin"
+#define BLOG_FILE_OLD    "/spiffs/blog.1.bin"
+#define BLOG_FILE_MAX    (128 * 1024)
+#define BLOG_DATA_RATE   200                /* DATA rekord / s alapból: ~115200 baud-on kifér */
+
+typedef struct {
+    atomic_uchar level;
+    atomic_uint  rate, win_s, cnt;
+    atomic_uint  written, suppressed;
+} chan_t;
+
+static blog_ring_t       s_ring;
+static chan_t            s_ch[BLOG_CH__COUNT];
+static SemaphoreHandle_t s_mx;              /* fogyasztó oldal: drain task / letöltés / sink váltás */
+static TaskHandle_t      s_task;
+static uint32_t          s_sinks;
+static FILE*             s_file;
+static uint32_t          s_file_len;
+static uint32_t          s_uart_bytes, s_uart_lines, s_file_bytes;
+static uint32_t          s_lost_seen;      /* dropped + suppressed az utolsó LOST rekordnál */
+
+/* ===== Szint, rátalimit (termelő oldal) ===== */
+bool blog_enabled(blog_fmt_t fmt)
+{
+    const uint8_t ch = blog_fmt_ch(fmt);
+    if (!s_ring.buf || ch >= BLOG_CH__COUNT) return false;
+    const uint8_t lvl = blog_fmt_lvl(fmt);
+    return lvl != BLOG_LVL_NONE && lvl <= atomic_load_explicit(&s_ch[ch].level, memory_order_relaxed);
+}
+
+void blog_put(blog_fmt_t fmt, uint8_t link, const void* p, uint16_t n)
+{
+    if (!blog_enabled(fmt)) return;
+    chan_t* c = &s_ch[blog_fmt_ch(fmt)];
+    const int64_t now = esp_timer_get_time();
+    const uint32_t lim = atomic_load_explicit(&c->rate, memory_order_relaxed);
+    if (lim) {
+        /* másodperces ablak; az ablakváltás versenye legfeljebb pár rekordot enged át */
+        const uint32_t sec = (uint32_t)(now / 1000000);
+        if (atomic_load_explicit(&c->win_s, memory_order_relaxed) != sec) {
+            atomic_store_explicit(&c->win_s, sec, memory_order_relaxed);
+            atomic_store_explicit(&c->cnt, 0, memory_order_relaxed);
+        }
+        if (atomic_fetch_add_explicit(&c->cnt, 1, memory_order_relaxed) >= lim) {
+            atomic_fetch_add_explicit(&c->suppressed, 1, memory_order_relaxed);
+            return;
+        }
+    }
+    if (blog_ring_put(&s_ring, fmt, link, (uint32_t)now, p, n, NULL, 0))
+        atomic_fetch_add_explicit(&c->written, 1, memory_order_relaxed);
+}
+
+void blog_set_level(blog_ch_t ch, uint8_t level)
+{
+    if (ch < BLOG_CH__COUNT) atomic_store(&s_ch[ch].level, level > BLOG_LVL_V ? BLOG_LVL_V : level);
+}
+
+void blog_set_rate(blog_ch_t ch, uint32_t per_s)
+{
+    if (ch < BLOG_CH__COUNT) atomic_store(&s_ch[ch].rate, per_s);
+}
+
+/* ===== Kimenetek (s_mx alatt) ===== */
+static struct {
+    uint8_t  raw[BLOG_REC_HDR + BLOG_PAYLOAD_MAX];
+    size_t   n;
+    uint16_t seq;
+    char     line[BLOG_LINE_MAX];
+} s_u;
+
+static void uart_flush(void)
+{
+    if (!s_u.n) return;
+    const size_t k = blog_line_encode(s_u.line, s_u.seq++, s_u.raw, s_u.n);
+    fwrite(s_u.line, 1, k, stdout);
+    s_uart_bytes += k;
+    s_uart_lines++;
+    s_u.n = 0;
+}
+
+/* egész rekordok soronként: egy elveszett sor csak a saját rekordjait viszi */
+static void uart_rec(const uint8_t* p, uint16_t n)
+{
+    if (s_u.n + n > BLOG_LINE_RAW) uart_flush();
+    memcpy(s_u.raw + s_u.n, p, n);
+    s_u.n += n;
+    if (s_u.n >= BLOG_LINE_RAW) uart_flush();
+}
+
+static void file_open(void)
+{
+    s_file = fopen(BLOG_FILE, "ab");
+    if (!s_file) { ESP_LOGW(TAG, "%s: open failed, file sink off", BLOG_FILE); s_sinks &= ~BLOG_SINK_FILE; return; }
+    fseek(s_file, 0, SEEK_END);
+    s_file_len = (uint32_t)ftell(s_file);
+    if (!s_file_len) {
+        uint8_t h[BLOG_HDR_LEN];
+        blog_hdr_encode(h);
+        s_file_len = (uint32_t)fwrite(h, 1, sizeof(h), s_file);
+    }
+}
+
+static void file_rotate(void)
+{
+    fclose(s_file);
+    remove(BLOG_FILE_OLD);
+    rename(BLOG_FILE, BLOG_FILE_OLD);
+    file_open();
+}
+
+static void sink_rec(const uint8_t* p, uint16_t n)
+{
+    if (s_sinks & BLOG_SINK_UART) uart_rec(p, n);
+    if (s_file) { fwrite(p, 1, n, s_file); s_file_len += n; s_file_bytes += n; }
+}
+
+static uint32_t lost_total(void)
+{
+    uint32_t n = atomic_load(&s_ring.dropped);
+    for (int i = 0; i < BLOG_CH__COUNT; i++) n += atomic_load(&s_ch[i].suppressed);
+    return n;
+}
+
+/* CLOCK (+ LOST, ha változott) meta rekord, utána a gyűrű tartalma, amíg
+   belefér a budget bájtba (legalább 2 meta + 1 teljes rekord); visszaad: maradt-e rekord */
+static bool drain_locked(void (*rec)(const uint8_t*, uint16_t), size_t budget)
+{
+    uint16_t n;
+    const uint8_t* p = blog_ring_peek(&s_ring, &n);
+    const uint32_t lost = lost_total();
+    if (!p && lost == s_lost_seen) return false;
+
+    uint8_t m[BLOG_REC_HDR + 8];
+    const uint64_t now = (uint64_t)esp_timer_get_time();
+    uint8_t v[8];
+    for (int i = 0; i < 8; i++) v[i] = (uint8_t)(now >> (8 * i));
+    blog_rec_encode(m, BLF_CLOCK, BLOG_LINK_NONE, (uint32_t)now, v, 8);
+    rec(m, sizeof(m));
+    budget -= sizeof(m);
+    if (lost != s_lost_seen) {
+        uint32_t sup = 0;
+        for (int i = 0; i < BLOG_CH__COUNT; i++) sup += atomic_load(&s_ch[i].suppressed);
+        const uint32_t drop = atomic_load(&s_ring.dropped);
+        for (int i = 0; i < 4; i++) { v[i] = (uint8_t)(drop >> (8 * i)); v[4 + i] = (uint8_t)(sup >> (8 * i)); }
+        blog_rec_encode(m, BLF_LOST, BLOG_LINK_NONE, (uint32_t)now, v, 8);
+        rec(m, sizeof(m));
+        budget -= sizeof(m);
+        s_lost_seen = lost;
+    }
+    for (; p && n <= budget; p = blog_ring_peek(&s_ring, &n)) {
+        rec(p, n);
+        budget -= n;
+        blog_ring_release(&s_ring);
+    }
+    return p != NULL;
+}
+
+static void drain_sinks(void)
+{
+    if (!s_sinks) return;                   /* nincs kimenet: a gyűrű a letöltésre vár */
+    drain_locked(sink_rec, SIZE_MAX);
+    uart_flush();
+    if (s_file) {
+        fflush(s_file);
+        if (s_file_len >= BLOG_FILE_MAX) file_rotate();
+    }
+}
+
+static void blog_task(void* arg)
+{
+    (void)arg;
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(BLOG_DRAIN_MS));
+        xSemaphoreTake(s_mx, portMAX_DELAY);
+        drain_sinks();
+        xSemaphoreGive(s_mx);
+    }
+}
+
+void blog_set_sinks(uint32_t sinks)
+{
+    if (!s_mx) return;
+    xSemaphoreTake(s_mx, portMAX_DELAY);
+    drain_sinks();
+    s_sinks = sinks & (BLOG_SINK_UART | BLOG_SINK_FILE);
+    if ((s_sinks & BLOG_SINK_FILE) && !s_file) file_open();
+    if (!(s_sinks & BLOG_SINK_FILE) && s_file) { fclose(s_file); s_file = NULL; }
+    xSemaphoreGive(s_mx);
+}
+
+esp_err_t blog_start(uint32_t sinks)
+{
+    if (s_ring.buf) return ESP_OK;
+    void* buf = malloc(BLOG_RING_SIZE);
+    if (!buf || !(s_mx = xSemaphoreCreateMutex())) { free(buf); return ESP_ERR_NO_MEM; }
+    for (int i = 0; i < BLOG_CH__COUNT; i++) {
+        atomic_init(&s_ch[i].level, BLOG_LVL_I);
+        atomic_init(&s_ch[i].rate, i == BLOG_CH_DATA ? BLOG_DATA_RATE : 0);
+    }
+    blog_ring_init(&s_ring, buf, BLOG_RING_SIZE);
+    blog_set_sinks(sinks);
+    if (xTaskCreate(blog_task, "blog", BLOG_TASK_STACK, NULL, BLOG_TASK_PRIO, &s_task) != pdPASS) return ESP_ERR_NO_MEM;
+    return ESP_OK;
+}
+
+/* ===== Letöltés ===== */
+#define BLOG_DUMP_BATCH  512
+_Static_assert(BLOG_DUMP_BATCH >= 2 * (BLOG_REC_HDR + 8) + BLOG_REC_HDR + BLOG_PAYLOAD_MAX, "dump batch");
+
+static char*  s_dump;                       /* a letöltő batch puffere, csak s_mx alatt */
+static size_t s_dump_n;
+static void dump_rec(const uint8_t* p, uint16_t n){ memcpy(s_dump + s_dump_n, p, n); s_dump_n += n; }
+
+/* false: küldési hiba */
+static bool emit_file(const char* path, blog_emit_t emit, void* ctx)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f) return true;
+    char b[512];
+    bool ok = true;
+    size_t n = fread(b, 1, sizeof(b), f);
+    if (n >= BLOG_HDR_LEN && blog_hdr_check((const uint8_t*)b, n)) {
+        ok = emit(ctx, b + BLOG_HDR_LEN, n - BLOG_HDR_LEN);  /* a fejléc egyszer, elöl */
+        while (ok && (n = fread(b, 1, sizeof(b), f)) > 0) ok = emit(ctx, b, n);
+    }
+    fclose(f);
+    return ok;
+}
+
+void blog_dump(blog_emit_t emit, void* ctx)
+{
+    uint8_t h[BLOG_HDR_LEN];
+    blog_hdr_encode(h);
+    if (!emit(ctx, (const char*)h, sizeof(h)) || !s_mx) return;
+    xSemaphoreTake(s_mx, portMAX_DELAY);
+    if (s_sinks & BLOG_SINK_FILE) {
+        /* a fájlt a drain task írja / forgatja: olvasás s_mx alatt */
+        drain_sinks();                      /* a várakozó rekordok is a fájlba */
+        if (emit_file(BLOG_FILE_OLD, emit, ctx)) emit_file(BLOG_FILE, emit, ctx);
+        xSemaphoreGive(s_mx);
+        return;
+    }
+    xSemaphoreGive(s_mx);
+
+    /* gyűrű: batch-enként másolat s_mx alatt, küldés nélküle (lassú kliens nem
+       tartja fel a drain taskot); legfeljebb egy gyűrűnyi, hogy folyamatos
+       termelés mellett is véget érjen */
+    char b[BLOG_DUMP_BATCH];
+    for (size_t total = 0; total < BLOG_RING_SIZE; ) {
+        xSemaphoreTake(s_mx, portMAX_DELAY);
+        s_dump = b; s_dump_n = 0;
+        const bool more = drain_locked(dump_rec, sizeof(b));
+        const size_t n = s_dump_n;
+        s_dump = NULL;
+        xSemaphoreGive(s_mx);
+        if (!n || !emit(ctx, b, n) || !more) return;
+        total += n;
+    }
+}
+
+void blog_get_stats(blog_stats_t* out)
+{
+    memset(out, 0, sizeof(*out));
+    if (!s_ring.buf) return;
+    out->sinks      = s_sinks;
+    out->ring_cap   = s_ring.cap;
+    out->ring_used  = blog_ring_used(&s_ring);
+    out->ring_high  = atomic_load(&s_ring.high_water);
+    out->written    = atomic_load(&s_ring.written);
+    out->dropped    = atomic_load(&s_ring.dropped);
+    out->uart_bytes = s_uart_bytes;
+    out->uart_lines = s_uart_lines;
+    out->file_bytes = s_file_bytes;
+    for (int i = 0; i < BLOG_CH__COUNT; i++) {
+        out->ch[i].level      = atomic_load(&s_ch[i].level);
+        out->ch[i].rate       = atomic_load(&s_ch[i].rate);
+        out->ch[i].written    = atomic_load(&s_ch[i].written);
+        out->ch[i].suppressed = atomic_load(&s_ch[i].suppressed);
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "blog_fmt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===== Halasztott bináris napló =====
+ * A hívási hely (rx task, BTC, httpd) csak formátum id-t + nyers
+ * argumentumokat másol egy zármentes RAM gyűrűbe (blog_core.h); szöveg
+ * formázás és UART nincs a forró úton. Egy alacsony prioritású task üríti a
+ * bekapcsolt kimenetekre (UART base64 sorok, SPIFFS fájl); a
+ * /api/blog.bin letöltés is innen jön. Szöveg: tools/blog_decode.c.
+ * Csatornánként futás közben állítható szint és rátalimit (rekord / s). */
+
+#define BLOG_SINK_UART  (1u << 0)           /* "#BL ..." sorok a konzolon */
+#define BLOG_SINK_FILE  (1u << 1)           /* /spiffs/blog.bin (+ blog.1.bin forgatva) */
+
+typedef struct {
+    uint8_t  level;                         /* BLOG_LVL_* */
+    uint32_t rate;                          /* rekord / s, 0: nincs limit */
+    uint32_t written, suppressed;           /* suppressed: rátalimit */
+} blog_ch_stats_t;
+
+typedef struct {
+    uint32_t sinks;
+    uint32_t ring_cap, ring_used, ring_high;
+    uint32_t written, dropped;              /* gyűrű: beírt / tele miatt eldobott */
+    uint32_t uart_bytes, uart_lines, file_bytes;
+    blog_ch_stats_t ch[BLOG_CH__COUNT];
+} blog_stats_t;
+
+esp_err_t blog_start(uint32_t sinks);
+void      blog_set_sinks(uint32_t sinks);  /* SPIFFS mount után kapcsolható a FILE */
+void      blog_set_level(blog_ch_t ch, uint8_t level);
+void      blog_set_rate(blog_ch_t ch, uint32_t per_s);
+void      blog_get_stats(blog_stats_t* out);
+
+/* szint szűrő (olcsó, a payload összerakása előtt hívható) */
+bool blog_enabled(blog_fmt_t fmt);
+/* rekord: szint + rátalimit, majd a gyűrűbe; sosem blokkol */
+void blog_put(blog_fmt_t fmt, uint8_t link, const void* p, uint16_t n);
+
+/* letöltés: fejléc, a fájl(ok) tartalma, majd a gyűrűben várakozó rekordok;
+   emit false (küldési hiba) → a letöltés leáll */
+typedef bool (*blog_emit_t)(void* ctx, const char* s, size_t n);
+void blog_dump(blog_emit_t emit, void* ctx);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,217 @@
+// components/blog/blog_core.c — bináris napló: rekord formátum, MPSC gyűrű, UART sor kódolás
+#include <string.h>
+#include <stdio.h>
+#include "blog_core.h"
+
+/* ===== Formátum tábla ===== */
+uint8_t blog_fmt_ch(uint8_t fmt)
+{
+    switch (fmt) {
+#define BLOG_X_CH(id, n, ch, lvl) case n: return ch;
+    BLOG_FMTS(BLOG_X_CH)
+#undef BLOG_X_CH
+    default: return BLOG_CH__COUNT;
+    }
+}
+
+uint8_t blog_fmt_lvl(uint8_t fmt)
+{
+    switch (fmt) {
+#define BLOG_X_LVL(id, n, ch, lvl) case n: return lvl;
+    BLOG_FMTS(BLOG_X_LVL)
+#undef BLOG_X_LVL
+    default: return BLOG_LVL_NONE;
+    }
+}
+
+const char* blog_ch_name(uint8_t ch)
+{
+    static const char* const k[BLOG_CH__COUNT] = { "BLE", "CFG", "DATA", "WEB" };
+    return ch < BLOG_CH__COUNT ? k[ch] : "?";
+}
+
+/* ===== Gyűrű =====
+ * A gyűrűben rekordonként egy 4 B-os vezérlő szó előzi meg a stream rekordot:
+ * bit31 kész, bit30 kitöltés (a puffer végén, ha a rekord nem fér ki), alsó
+ * 24 bit a teljes (4-re kerekített) méret. A fogyasztó az elengedett részt
+ * nullázza, így egy még nem kész rekord helyén mindig 0 a vezérlő szó. */
+#define W_DONE   (1u << 31)
+#define W_PAD    (1u << 30)
+#define W_SIZE   0x00FFFFFFu
+
+static inline atomic_uint* ctl(const blog_ring_t* r, uint32_t off){ return (atomic_uint*)(void*)(r->buf + off); }
+
+void blog_ring_init(blog_ring_t* r, void* buf, uint32_t cap)
+{
+    r->buf = buf;
+    r->cap = cap;
+    memset(buf, 0, cap);
+    atomic_init(&r->head, 0);       atomic_init(&r->tail, 0);
+    atomic_init(&r->written, 0);    atomic_init(&r->dropped, 0);
+    atomic_init(&r->high_water, 0);
+    r->cur = 0;
+}
+
+static void put_hdr(uint8_t* o, uint8_t fmt, uint8_t link, uint32_t ts_us, uint16_t n)
+{
+    o[0] = (uint8_t)n; o[1] = fmt; o[2] = link; o[3] = 0;
+    o[4] = (uint8_t)ts_us; o[5] = (uint8_t)(ts_us >> 8); o[6] = (uint8_t)(ts_us >> 16); o[7] = (uint8_t)(ts_us >> 24);
+}
+
+bool blog_ring_put(blog_ring_t* r, uint8_t fmt, uint8_t link, uint32_t ts_us,
+                   const void* a, uint16_t na, const void* b, uint16_t nb)
+{
+    const uint32_t len = (uint32_t)na + nb;
+    if (len > BLOG_PAYLOAD_MAX) { atomic_fetch_add_explicit(&r->dropped, 1, memory_order_relaxed); return false; }
+    const uint32_t total = (4 + BLOG_REC_HDR + len + 3) & ~3u;
+
+    uint32_t h = atomic_load_explicit(&r->head, memory_order_relaxed), off, pad, used;
+    for (;;) {
+        const uint32_t t = atomic_load_explicit(&r->tail, memory_order_acquire);
+        off = h & (r->cap - 1);
+        pad = off + total > r->cap ? r->cap - off : 0;
+        used = h - t + pad + total;
+        if (used > r->cap) {
+            atomic_fetch_add_explicit(&r->dropped, 1, memory_order_relaxed);
+            return false;
+        }
+        if (atomic_compare_exchange_weak_explicit(&r->head, &h, h + pad + total,
+                                                  memory_order_relaxed, memory_order_relaxed)) break;
+    }
+    if (pad) { atomic_store_explicit(ctl(r, off), W_DONE | W_PAD | pad, memory_order_release); off = 0; }
+
+    uint8_t* p = r->buf + off + 4;
+    put_hdr(p, fmt, link, ts_us, (uint16_t)len);
+    if (na) memcpy(p + BLOG_REC_HDR, a, na);
+    if (nb) memcpy(p + BLOG_REC_HDR + na, b, nb);
+    atomic_store_explicit(ctl(r, off), W_DONE | total, memory_order_release);
+
+    atomic_fetch_add_explicit(&r->written, 1, memory_order_relaxed);
+    uint32_t hw = atomic_load_explicit(&r->high_water, memory_order_relaxed);
+    while (used > hw && !atomic_compare_exchange_weak_explicit(&r->high_water, &hw, used,
+                                                               memory_order_relaxed, memory_order_relaxed)) { }
+    return true;
+}
+
+const uint8_t* blog_ring_peek(blog_ring_t* r, uint16_t* n)
+{
+    for (;;) {
+        const uint32_t t = atomic_load_explicit(&r->tail, memory_order_relaxed);
+        if (t == atomic_load_explicit(&r->head, memory_order_acquire)) return NULL;
+        const uint32_t off = t & (r->cap - 1);
+        const uint32_t w = atomic_load_explicit(ctl(r, off), memory_order_acquire);
+        if (!(w & W_DONE)) return NULL;                         /* foglalva, még írják */
+        if (w & W_PAD) {
+            const uint32_t sz = w & W_SIZE;
+            if (sz > 4) memset(r->buf + off + 4, 0, sz - 4);
+            atomic_store_explicit(ctl(r, off), 0, memory_order_relaxed);
+            atomic_store_explicit(&r->tail, t + sz, memory_order_release);
+            continue;
+        }
+        r->cur = w & W_SIZE;
+        const uint8_t* p = r->buf + off + 4;
+        *n = (uint16_t)(BLOG_REC_HDR + p[0]);
+        return p;
+    }
+}
+
+void blog_ring_release(blog_ring_t* r)
+{
+    if (!r->cur) return;
+    const uint32_t t = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    const uint32_t off = t & (r->cap - 1);
+    memset(r->buf + off + 4, 0, r->cur - 4);
+    atomic_store_explicit(ctl(r, off), 0, memory_order_relaxed);
+    atomic_store_explicit(&r->tail, t + r->cur, memory_order_release);
+    r->cur = 0;
+}
+
+uint32_t blog_ring_used(const blog_ring_t* r)
+{
+    return atomic_load_explicit(&((blog_ring_t*)r)->head, memory_order_relaxed) -
+           atomic_load_explicit(&((blog_ring_t*)r)->tail, memory_order_relaxed);
+}
+
+/* ===== Stream ===== */
+void blog_hdr_encode(uint8_t out[BLOG_HDR_LEN])
+{
+    memcpy(out, BLOG_MAGIC, 4);
+    out[4] = BLOG_VERSION; out[5] = BLOG_HDR_LEN; out[6] = 0; out[7] = 0;
+}
+
+bool blog_hdr_check(const uint8_t* p, size_t n)
+{
+    return n >= BLOG_HDR_LEN && memcmp(p, BLOG_MAGIC, 4) == 0 && p[4] == BLOG_VERSION && p[5] >= BLOG_HDR_LEN && p[5] <= n;
+}
+
+void blog_rec_encode(uint8_t* out, uint8_t fmt, uint8_t link, uint32_t ts_us, const void* p, uint16_t n)
+{
+    put_hdr(out, fmt, link, ts_us, n);
+    if (n) memcpy(out + BLOG_REC_HDR, p, n);
+}
+
+int blog_rec_next(const uint8_t* p, size_t n, size_t* off, blog_rec_t* out)
+{
+    if (*off >= n) return 0;
+    if (n - *off < BLOG_REC_HDR) return -1;
+    const uint8_t* h = p + *off;
+    if (n - *off < (size_t)BLOG_REC_HDR + h[0]) return -1;
+    out->len = h[0]; out->fmt = h[1]; out->link = h[2]; out->flags = h[3];
+    out->ts_us = (uint32_t)h[4] | (uint32_t)h[5] << 8 | (uint32_t)h[6] << 16 | (uint32_t)h[7] << 24;
+    out->p = h + BLOG_REC_HDR;
+    *off += BLOG_REC_HDR + h[0];
+    return 1;
+}
+
+/* ===== UART sor (base64) ===== */
+static const char k_b64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+size_t blog_line_encode(char* out, uint16_t seq, const uint8_t* raw, size_t n)
+{
+    char* o = out + sprintf(out, "#BL %04X:", seq);
+    size_t i = 0;
+    for (; i + 3 <= n; i += 3) {
+        const uint32_t v = (uint32_t)raw[i] << 16 | (uint32_t)raw[i + 1] << 8 | raw[i + 2];
+        *o++ = k_b64[v >> 18]; *o++ = k_b64[(v >> 12) & 63]; *o++ = k_b64[(v >> 6) & 63]; *o++ = k_b64[v & 63];
+    }
+    if (i < n) {
+        const uint32_t v = (uint32_t)raw[i] << 16 | (i + 1 < n ? (uint32_t)raw[i + 1] << 8 : 0);
+        *o++ = k_b64[v >> 18]; *o++ = k_b64[(v >> 12) & 63];
+        *o++ = i + 1 < n ? k_b64[(v >> 6) & 63] : '=';
+        *o++ = '=';
+    }
+    *o++ = '\n';
+    *o = 0;
+    return (size_t)(o - out);
+}
+
+static int b64v(char c)
+{
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    return c == '+' ? 62 : c == '/' ? 63 : -1;
+}
+
+int blog_line_decode(const char* line, uint16_t* seq, uint8_t* raw, size_t cap)
+{
+    unsigned s;
+    int pos = 0;
+    if (sscanf(line, "#BL %4X:%n", &s, &pos) != 1 || !pos) return -1;
+    *seq = (uint16_t)s;
+    size_t n = 0;
+    uint32_t acc = 0;
+    int bits = 0;
+    for (const char* c = line + pos; *c && *c != '\n' && *c != '\r' && *c != '='; c++) {
+        const int v = b64v(*c);
+        if (v < 0) return -1;
+        acc = acc << 6 | (uint32_t)v;
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            if (n == cap) return -1;
+            raw[n++] = (uint8_t)(acc >> bits);
+        }
+    }
+    return (int)n;
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include "blog_fmt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===== Bináris napló: rekord formátum, gyűrű, UART sor kódolás =====
+ * A hívási hely szöveg helyett formátum id-t + nyers argumentumokat ír
+ * (DATA / CFG keretnél magát a keretet); a szöveget a host rakja össze
+ * (tools/blog_decode.c, a pretty_print.c-vel). Nem allokál, OS-t nem hív:
+ * target (blog.c) és host ugyanezt fordítja.
+ *
+ * Rekord (stream, LE):  len u8 | fmt u8 | link u8 | flags u8 | ts_us u32 | payload[len]
+ * Fájl / letöltés:       "BLOG" | ver u8 | hdr_len u8 | 0 u16, utána rekordok
+ * UART sor:              "#BL " seq(4 hex) ":" base64(egész rekordok) "\n"
+ *                        — minden sor önállóan dekódolható, a seq résből látszik a vesztés. */
+
+#define BLOG_MAGIC        "BLOG"
+#define BLOG_VERSION      1
+#define BLOG_HDR_LEN      8
+#define BLOG_REC_HDR      8
+#define BLOG_PAYLOAD_MAX  248               /* notify keret (244) + tartalék */
+#define BLOG_LINK_NONE    0xFF
+#define BLOG_LINE_RAW     96                /* nyers bájt / UART sor (nagyobb rekord: saját sor) */
+#define BLOG_LINE_MAX     (4 + 5 + 4 * ((BLOG_REC_HDR + BLOG_PAYLOAD_MAX + 2) / 3) + 2)
+
+/* ===== Gyűrű =====
+ * Változó hosszú rekordok, több termelő (zár nélkül: head foglalás CAS-sal,
+ * rekordonkénti commit szó) → egy fogyasztó (a drain; több fogyasztó
+ * esetén a hívó sorosít). Tele gyűrűnél az új rekord esik ki (dropped),
+ * a termelő sosem vár. */
+typedef struct {
+    uint8_t*    buf;                        /* 4-re igazított, cap bájt */
+    uint32_t    cap;                        /* 2 hatványa, ≤ 1 MB */
+    atomic_uint head, tail;
+    atomic_uint written, dropped, high_water;
+    uint32_t    cur;                        /* fogyasztó: peek-elt rekord teljes mérete */
+} blog_ring_t;
+
+void blog_ring_init(blog_ring_t* r, void* buf, uint32_t cap);
+/* payload = a[na] + b[nb] (argumentumok + nyers keret); false: tele / túl hosszú */
+bool blog_ring_put(blog_ring_t* r, uint8_t fmt, uint8_t link, uint32_t ts_us,
+                   const void* a, uint16_t na, const void* b, uint16_t nb);
+/* legrégebbi kész rekord (stream formátum, *n bájt), NULL: üres / még írják */
+const uint8_t* blog_ring_peek(blog_ring_t* r, uint16_t* n);
+void     blog_ring_release(blog_ring_t* r);
+uint32_t blog_ring_used(const blog_ring_t* r);
+
+/* ===== Stream ===== */
+void blog_hdr_encode(uint8_t out[BLOG_HDR_LEN]);
+bool blog_hdr_check(const uint8_t* p, size_t n);
+void blog_rec_encode(uint8_t* out, uint8_t fmt, uint8_t link, uint32_t ts_us, const void* p, uint16_t n);
+
+typedef struct { uint8_t fmt, link, flags; uint16_t len; uint32_t ts_us; const uint8_t* p; } blog_rec_t;
+/* 1: rekord, 0: vége, -1: csonka */
+int  blog_rec_next(const uint8_t* p, size_t n, size_t* off, blog_rec_t* out);
+
+/* ===== UART sor ===== */
+size_t blog_line_encode(char* out, uint16_t seq, const uint8_t* raw, size_t n);   /* NUL-lal */
+/* "#BL ssss:base64" (sor vége nélkül) → raw; -1: nem blog sor / hibás */
+int    blog_line_decode(const char* line, uint16_t* seq, uint8_t* raw, size_t cap);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,41 @@
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===== Csatornák (log tag-ek) és szintek (esp_log_level_t értékek) ===== */
+typedef enum { BLOG_CH_BLE = 0, BLOG_CH_CFG, BLOG_CH_DATA, BLOG_CH_WEB, BLOG_CH__COUNT } blog_ch_t;
+enum { BLOG_LVL_NONE = 0, BLOG_LVL_E, BLOG_LVL_W, BLOG_LVL_I, BLOG_LVL_D, BLOG_LVL_V };
+
+/* ===== Formátumok =====
+ * id (stabil, a host dekóder ugyanezt olvassa), csatorna, szint. Payload:
+ *   CLOCK  u64 µs (a drain task írja, a ts_us 32 bites kiterjesztéséhez)
+ *   LOST   u32 gyűrű eldobás, u32 rátalimit elnyelés (összesített)
+ *   DATA   nyers 20 B 0xAB keret          → pp_log_data
+ *   CFG    nyers CFG notify               → pp_log_cfg
+ *   HEX    nyers bájtok (webserver napló) → "[link][CFG] len=N: XX .."
+ *   RX     from_cfg u8, len u16           → "[link][CFG|DATA] len=N" */
+#define BLOG_FMTS(X) \
+    X(BLF_CLOCK, 1, BLOG_CH_BLE,  BLOG_LVL_E) \
+    X(BLF_LOST,  2, BLOG_CH_BLE,  BLOG_LVL_W) \
+    X(BLF_DATA,  3, BLOG_CH_DATA, BLOG_LVL_I) \
+    X(BLF_CFG,   4, BLOG_CH_CFG,  BLOG_LVL_I) \
+    X(BLF_HEX,   5, BLOG_CH_WEB,  BLOG_LVL_I) \
+    X(BLF_RX,    6, BLOG_CH_BLE,  BLOG_LVL_D)
+
+typedef enum {
+#define BLOG_X_ENUM(id, n, ch, lvl) id = n,
+    BLOG_FMTS(BLOG_X_ENUM)
+#undef BLOG_X_ENUM
+    BLF__COUNT
+} blog_fmt_t;
+
+uint8_t     blog_fmt_ch(uint8_t fmt);       /* BLOG_CH__COUNT: ismeretlen */
+uint8_t     blog_fmt_lvl(uint8_t fmt);
+const char* blog_ch_name(uint8_t ch);
+
+#ifdef __cplusplus
+}
+#endif
@@ -9,9 +9,9 @@
 #include "esp_eth.h"
 #include "esp_eth_mac_esp.h"
 #include "esp_eth_phy.h"
-#include "esp_rom_sys.h"
 #include "ethernet.h"
 #include "globals.h"
+#include "boot.h"
 
 #define TAG                 "eth"
 #define PHY_ADDR            0        // ha nem jó, próbáld 1-et
@@ -24,10 +24,10 @@ static esp_netif_t* s_eth = NULL;
 
 static void on_eth_event(void *arg, esp_event_base_t base, int32_t id, void *data) {
     switch (id) {
-        case ETHERNET_EVENT_CONNECTED:    ESP_LOGI(TAG, "link up"); break;
-        case ETHERNET_EVENT_DISCONNECTED: ESP_LOGW(TAG, "link down"); break;
+        case ETHERNET_EVENT_CONNECTED:    eth_up = 1; boot_mark(BOOT_LINK_UP); ESP_LOGI(TAG, "link up"); break;
+        case ETHERNET_EVENT_DISCONNECTED: eth_up = 0; ESP_LOGW(TAG, "link down"); break;
         case ETHERNET_EVENT_START:        ESP_LOGI(TAG, "start"); break;
-        case ETHERNET_EVENT_STOP:         ESP_LOGI(TAG, "stop"); break;
+        case ETHERNET_EVENT_STOP:         eth_up = 0; ESP_LOGI(TAG, "stop"); break;
         default: break;
     }
 }
@@ -75,7 +75,7 @@ esp_err_t ethernet_init(ethernet_ctx_t *ctx) {
 
     // PoE táp felfutás
     phy_power_enable();
-    esp_rom_delay_us(300000); // 300 ms késleltetés indulás előtt
+    vTaskDelay(pdMS_TO_TICKS(300)); // 300 ms PHY felfutás; a boot többi ága közben fut
 
     // netif
     esp_netif_config_t netif_cfg = ESP_NETIF_DEFAULT_ETH();
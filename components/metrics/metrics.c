@@ -0,0 +1,148 @@
+// components/metrics/metrics.c — atomi számlálók, gauge-ok, hisztogramok
+#include <stdio.h>
+#include <stdarg.h>
+#include <assert.h>
+#include <stdatomic.h>
+#include "metrics.h"
+
+#define PFX "uwbgw_"
+
+typedef struct { const char* name; const char* help; } mdesc_t;
+
+static const mdesc_t k_ctr[M__COUNT] = {
+    [M_BLE_SCAN_START]   = { "ble_scan_start_total",    "BLE scan starts" },
+    [M_BLE_CONNECT]      = { "ble_connect_total",       "BLE links opened" },
+    [M_BLE_OPEN_FAIL]    = { "ble_open_fail_total",     "Failed GATTC opens" },
+    [M_BLE_DISCONNECT]   = { "ble_disconnect_total",    "BLE link drops" },
+    [M_BLE_NOTIFY]       = { "ble_notify_total",        "Notifications received" },
+    [M_BLE_NOTIFY_BYTES] = { "ble_notify_bytes_total",  "Notification payload bytes" },
+    [M_BLE_RX_DROP]      = { "ble_rx_drop_total",       "Notifies dropped, ingest ring full" },
+    [M_BLE_WRITE]        = { "ble_write_total",         "Completed GATT writes" },
+    [M_BLE_WRITE_ERR]    = { "ble_write_err_total",     "Failed GATT writes" },
+    [M_BLE_WQ_FULL]      = { "ble_wq_full_total",       "Writes rejected, write queue full" },
+    [M_TLV_TRUNC]        = { "tlv_trunc_total",         "Truncated TLV items" },
+    [M_DWM_GET]          = { "dwm_get_total",           "DWM GET requests sent" },
+    [M_DWM_GET_TIMEOUT]  = { "dwm_get_timeout_total",   "DWM GET without ACK" },
+    [M_DWM_CACHE_HIT]    = { "dwm_cache_hit_total",     "DWM snapshot served from cache" },
+    [M_HTTP_REQ]         = { "http_requests_total",     "HTTP requests handled" },
+    [M_HTTP_ERR]         = { "http_errors_total",       "HTTP handlers returning error" },
+    [M_HTTP_BUSY]        = { "http_busy_total",         "Requests rejected with 503, async queue full" },
+    [M_LIVE_DROP]        = { "live_drop_total",         "/ws messages dropped (oldest)" },
+    [M_LIVE_TRUNC]       = { "live_trunc_total",        "/ws messages dropped (longer than LIVE_MSG_MAX)" },
+};
+
+static const mdesc_t k_gauge[G__COUNT] = {
+    [G_BLE_LINKS_UP]     = { "ble_links_up",            "Connected anchors" },
+    [G_LIVE_CLIENTS]     = { "live_clients",            "/ws subscribers" },
+    [G_HTTP_ASYNC_QUEUED] = { "http_async_queued",      "Async requests queued or running" },
+};
+
+/* vödör határok (le), az utolsó után +Inf */
+#define NB 10
+static const uint32_t k_b_us[NB] = { 50, 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 100000 };
+static const uint32_t k_b_ms[NB] = { 1, 5, 10, 25, 50, 100, 250, 500, 1000, 2500 };
+
+typedef struct { const char* name; const char* help; const uint32_t* le; } hdesc_t;
+static const hdesc_t k_hist[H__COUNT] = {
+    [H_BLE_RX_LAT_US]  = { "ble_rx_latency_us", "Notify ingest to dispatch latency", k_b_us },
+    [H_BLE_WRITE_US]   = { "ble_write_latency_us", "GATT write queued to completion", k_b_us },
+    [H_DWM_GET_RTT_MS] = { "dwm_get_rtt_ms",    "DWM GET round trip",                k_b_ms },
+    [H_HTTP_MS]        = { "http_handler_ms",   "HTTP handler latency, httpd task",  k_b_ms },
+    [H_HTTP_QUEUE_MS]  = { "http_async_wait_ms", "Async request queue wait",         k_b_ms },
+    [H_HTTP_ASYNC_MS]  = { "http_async_handler_ms", "Async handler latency, worker", k_b_ms },
+    [H_BLE_RECONNECT_MS] = { "ble_reconnect_ms", "Link loss to first DATA notify",   k_b_ms },
+};
+
+typedef struct {
+    atomic_uint bucket[NB + 1];
+    atomic_uint sum;
+} hist_t;
+
+static atomic_uint s_ctr[M__COUNT];
+static atomic_int  s_gauge[G__COUNT];
+static hist_t      s_hist[H__COUNT];
+
+void metric_add(metric_ctr_t id, uint32_t n)
+{
+    if ((unsigned)id < M__COUNT) atomic_fetch_add_explicit(&s_ctr[id], n, memory_order_relaxed);
+}
+
+uint32_t metric_get(metric_ctr_t id)
+{
+    return ((unsigned)id < M__COUNT) ? atomic_load_explicit(&s_ctr[id], memory_order_relaxed) : 0;
+}
+
+void metric_gauge_set(metric_gauge_t id, int32_t v)
+{
+    if ((unsigned)id < G__COUNT) atomic_store_explicit(&s_gauge[id], v, memory_order_relaxed);
+}
+
+void metric_gauge_add(metric_gauge_t id, int32_t d)
+{
+    if ((unsigned)id < G__COUNT) atomic_fetch_add_explicit(&s_gauge[id], d, memory_order_relaxed);
+}
+
+void metric_observe(metric_hist_t id, uint32_t v)
+{
+    if ((unsigned)id >= H__COUNT) return;
+    const uint32_t* le = k_hist[id].le;
+    int b = 0;
+    while (b < NB && v > le[b]) b++;
+    hist_t* h = &s_hist[id];
+    atomic_fetch_add_explicit(&h->bucket[b], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&h->sum, v, memory_order_relaxed);
+}
+
+/* ===== Prometheus szöveg ===== */
+/* egy hívás = egy sor; csonka sor elrontaná a teljes kimenetet (a következő
+   sorhoz ragad), ezért a túl hosszú sor hiba: assert, NDEBUG mellett kimarad */
+__attribute__((format(printf, 3, 4)))
+static void emitf(metrics_emit_t emit, void* ctx, const char* fmt, ...)
+{
+    char line[160];
+    va_list ap; va_start(ap, fmt);
+    int n = vsnprintf(line, sizeof(line), fmt, ap);
+    va_end(ap);
+    assert(n > 0 && (size_t)n < sizeof(line));
+    if (n > 0 && (size_t)n < sizeof(line)) emit(ctx, line, (size_t)n);
+}
+
+static void emit_hdr(metrics_emit_t emit, void* ctx, const char* name, const char* type, const char* help)
+{
+    emitf(emit, ctx, "# HELP " PFX "%s %s\n", name, help);
+    emitf(emit, ctx, "# TYPE " PFX "%s %s\n", name, type);
+}
+
+void metrics_emit_value(metrics_emit_t emit, void* ctx, const char* name,
+                        const char* type, const char* help, uint32_t v)
+{
+    emit_hdr(emit, ctx, name, type, help);
+    emitf(emit, ctx, PFX "%s %u\n", name, (unsigned)v);
+}
+
+void metrics_render(metrics_emit_t emit, void* ctx)
+{
+    for (int i = 0; i < M__COUNT; i++)
+        metrics_emit_value(emit, ctx, k_ctr[i].name, "counter", k_ctr[i].help,
+                           atomic_load_explicit(&s_ctr[i], memory_order_relaxed));
+
+    for (int i = 0; i < G__COUNT; i++) {
+        emit_hdr(emit, ctx, k_gauge[i].name, "gauge", k_gauge[i].help);
+        emitf(emit, ctx, PFX "%s %d\n", k_gauge[i].name, (int)atomic_load_explicit(&s_gauge[i], memory_order_relaxed));
+    }
+
+    for (int i = 0; i < H__COUNT; i++) {
+        const hdesc_t* d = &k_hist[i];
+        hist_t* h = &s_hist[i];
+        emit_hdr(emit, ctx, d->name, "histogram", d->help);
+        uint32_t cum = 0;
+        for (int b = 0; b <= NB; b++) {
+            cum += atomic_load_explicit(&h->bucket[b], memory_order_relaxed);
+            if (b < NB) emitf(emit, ctx, PFX "%s_bucket{le=\"%u\"} %u\n", d->name, (unsigned)d->le[b], (unsigned)cum);
+            else        emitf(emit, ctx, PFX "%s_bucket{le=\"+Inf\"} %u\n", d->name, (unsigned)cum);
+        }
+        /* count a vödrök összegéből: a sorok egymással konzisztensek maradnak */
+        emitf(emit, ctx, PFX "%s_sum %u\n", d->name, (unsigned)atomic_load_explicit(&h->sum, memory_order_relaxed));
+        emitf(emit, ctx, PFX "%s_count %u\n", d->name, (unsigned)cum);
+    }
+}
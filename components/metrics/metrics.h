@@ -0,0 +1,75 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===== Hot-path metrikák =====
+ * Statikus regiszter: számlálók, gauge-ok és fix vödrös hisztogramok,
+ * mind 32 bites atomi változó → BTC taskból / ISR-közeli kódból is
+ * hívható, zár és allokáció nélkül. Export: Prometheus szöveges formátum. */
+
+typedef enum {
+    M_BLE_SCAN_START = 0,
+    M_BLE_CONNECT,
+    M_BLE_OPEN_FAIL,
+    M_BLE_DISCONNECT,
+    M_BLE_NOTIFY,
+    M_BLE_NOTIFY_BYTES,
+    M_BLE_RX_DROP,          /* tele notify gyűrű */
+    M_BLE_WRITE,
+    M_BLE_WRITE_ERR,
+    M_BLE_WQ_FULL,          /* tele írási sor */
+    M_TLV_TRUNC,
+    M_DWM_GET,              /* elindított BLE GET */
+    M_DWM_GET_TIMEOUT,
+    M_DWM_CACHE_HIT,
+    M_HTTP_REQ,
+    M_HTTP_ERR,             /* handler != ESP_OK */
+    M_HTTP_BUSY,            /* 503: async sor tele */
+    M_LIVE_DROP,            /* /ws drop-oldest */
+    M_LIVE_TRUNC,           /* /ws sor nem fért LIVE_MSG_MAX-ba */
+    M__COUNT
+} metric_ctr_t;
+
+typedef enum {
+    G_BLE_LINKS_UP = 0,
+    G_LIVE_CLIENTS,
+    G_HTTP_ASYNC_QUEUED,    /* async kérés sorban / futóban */
+    G__COUNT
+} metric_gauge_t;
+
+typedef enum {
+    H_BLE_RX_LAT_US = 0,    /* notify callback → feliratkozók */
+    H_BLE_WRITE_US,         /* írás sorba tétele → completion */
+    H_DWM_GET_RTT_MS,       /* GET küldés → snapshot lezárás */
+    H_HTTP_MS,              /* handler futásidő (httpd task) */
+    H_HTTP_QUEUE_MS,        /* async: sorba tétel → worker */
+    H_HTTP_ASYNC_MS,        /* async handler futásidő (worker) */
+    H_BLE_RECONNECT_MS,     /* link bontás → első DATA notify */
+    H__COUNT
+} metric_hist_t;
+
+void metric_add(metric_ctr_t id, uint32_t n);
+static inline void metric_inc(metric_ctr_t id){ metric_add(id, 1); }
+
+void metric_gauge_set(metric_gauge_t id, int32_t v);
+void metric_gauge_add(metric_gauge_t id, int32_t d);
+
+void metric_observe(metric_hist_t id, uint32_t v);
+
+uint32_t metric_get(metric_ctr_t id);
+
+/* Szöveges export darabokban; emit ugyanazzal a ctx-szel többször hívódik. */
+typedef void (*metrics_emit_t)(void* ctx, const char* s, size_t n);
+void metrics_render(metrics_emit_t emit, void* ctx);
+
+/* Más modulok saját számlálóinak kiírása ugyanabban a formátumban */
+void metrics_emit_value(metrics_emit_t emit, void* ctx, const char* name,
+                        const char* type, const char* help, uint32_t v);
+
+#ifdef __cplusplus
+}
+#endif
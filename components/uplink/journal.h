@@ -0,0 +1,64 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===== Store-and-forward napló (nyers flash partíció) =====
+ * Csak hozzáfűzős szektor-gyűrű. Szektor: 8 B fejléc ("JRN" + ver, LE seq),
+ * utána rekordok: [0]=0xA5, [1]=done (0xFF függő, 0x00 visszajátszva),
+ * [2..3] hossz LE, [4..7] CRC32(payload), payload 4 B-ra kerekítve.
+ * A visszajátszott jelzés 1→0 programozás (nincs törlés), így a kiolvasási
+ * pont újraindulás után is megvan. Szektort csak akkor törlünk, amikor az író
+ * belép — a gyűrű egyenletesen kopik. Tele gyűrűnél a legrégebbi szektor
+ * tartalma elveszik (dropped). Nem allokál, ESP API-t nem hív: a flash
+ * műveletek a jr_flash_t-n mennek (host-on fájl is lehet). Nem szálbiztos. */
+
+#define JR_SECTOR_HDR   8
+#define JR_REC_HDR      8
+#define JR_MAX_REC      1472
+
+typedef struct {
+    /* 0 = OK; a write NOR szemantikájú (csak 1→0), az erase szektor-igazított */
+    int (*read)(void* ctx, uint32_t off, void* buf, uint32_t len);
+    int (*write)(void* ctx, uint32_t off, const void* buf, uint32_t len);
+    int (*erase)(void* ctx, uint32_t off, uint32_t len);
+    void*    ctx;
+    uint32_t size;            /* partíció mérete (szektor többszöröse) */
+    uint32_t sector;          /* törlési egység: 4 KB szektor vagy 64 KB blokk */
+} jr_flash_t;
+
+typedef struct {
+    uint32_t pending;         /* még vissza nem játszott rekord */
+    uint32_t appended, appended_bytes;    /* payload */
+    uint32_t prog_bytes;      /* flash-re írt összes bájt (fejléc, kitöltés, done jel) */
+    uint32_t erases;
+    uint32_t replayed, replayed_bytes;
+    uint32_t dropped;         /* tele gyűrű miatt felülírt, vissza nem játszott */
+    uint32_t corrupt;         /* CRC / fejléc hiba felcsatoláskor vagy olvasáskor */
+    uint32_t io_errors;
+} jr_stats_t;
+
+typedef struct {
+    jr_flash_t f;
+    uint32_t   nsec;
+    uint32_t   w_sec, w_off, w_seq;   /* író: szektor, offszet, szektor-sorszám */
+    uint32_t   r_sec, r_off;          /* olvasó: következő (esetleg függő) rekord */
+    bool       w_valid;               /* van már megnyitott író szektor */
+    jr_stats_t st;
+} journal_t;
+
+/* felcsatolás: szektorfejlécek + író/olvasó szektor letapogatása */
+int  jr_mount(journal_t* j, const jr_flash_t* f);
+int  jr_append(journal_t* j, const void* data, uint16_t len);
+/* következő függő rekord kimásolása (nem jelöli meg); 0 = van, 1 = üres, <0 hiba */
+int  jr_peek(journal_t* j, void* buf, uint16_t max, uint16_t* len);
+/* a jr_peek-kel kapott rekord visszajátszottnak jelölése */
+int  jr_pop(journal_t* j);
+static inline uint32_t jr_pending(const journal_t* j){ return j->st.pending; }
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,287 @@
+// components/uplink/tag_track.c — ts40 → 64 bites idő, tag_seq/sync_seq rések tagonként
+#include <string.h>
+#include "uwb_frame.h"
+#include "tag_track.h"
+
+#define TT_MASK   (TT_WRAP - 1)
+#define SLOTS     (TT_MAX_TAGS * 2)      /* 2 hatványa, ≤50% töltés */
+#define EMPTY     0                      /* s_slot: index+1, 0 = üres */
+#define NIL       0xFFFF
+#define WIN       32                     /* dedup ablak (tag_seq) */
+#define EWMA_SH   3                      /* 1/8 súly */
+
+_Static_assert((SLOTS & (SLOTS - 1)) == 0, "SLOTS: 2 hatványa");
+_Static_assert(TT_MAX_TAGS < NIL, "index uint16_t");
+
+typedef struct {
+    tt_tag_stats_t st;
+    uint64_t       raw40;       /* utolsó elfogadott nyers ts40 */
+    uint32_t       hash;
+    uint32_t       seen;        /* bit k: (tag_seq - k) már megjött */
+    uint32_t       ewma_dt_us;  /* keretköz EWMA */
+    uint16_t       prev, next;  /* LRU lánc (head = legutóbb látott); szabad lista: next */
+    uint8_t        tag_seq, sync_seq;
+    bool           used;
+} tt_entry_t;
+
+static tt_entry_t s_e[TT_MAX_TAGS];
+static uint16_t   s_slot[SLOTS];         /* hash → s_e index+1 */
+static uint16_t   s_head = NIL, s_tail = NIL, s_free = NIL;
+static uint16_t   s_hw;                  /* eddig kiosztott indexek (szabad lista mellett) */
+static uint32_t   s_n, s_evict, s_expired;
+
+/* DW tick = 1/(128*499.2 MHz) = 15.65 ps → 63897.6 tick/µs */
+static inline uint64_t us_to_ticks(int64_t us){ return us > 0 ? (uint64_t)us * 638976ULL / 10ULL : 0; }
+
+/* a tag_id-k gyakran sorszerűek: murmur3 fmix a szórásért */
+static inline uint32_t h_key(uint32_t anchor_id, uint32_t tag_id)
+{
+    uint32_t h = tag_id ^ (anchor_id * 0x9E3779B1u);
+    h ^= h >> 16; h *= 0x85EBCA6Bu;
+    h ^= h >> 13; h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+/* ---- LRU ---- */
+static void lru_unlink(uint16_t i)
+{
+    tt_entry_t* e = &s_e[i];
+    if (e->prev != NIL) s_e[e->prev].next = e->next; else s_head = e->next;
+    if (e->next != NIL) s_e[e->next].prev = e->prev; else s_tail = e->prev;
+    e->prev = e->next = NIL;
+}
+
+static void lru_front(uint16_t i)
+{
+    tt_entry_t* e = &s_e[i];
+    e->prev = NIL; e->next = s_head;
+    if (s_head != NIL) s_e[s_head].prev = i;
+    s_head = i;
+    if (s_tail == NIL) s_tail = i;
+}
+
+/* ---- hash ---- */
+static int find_slot(uint32_t anchor_id, uint32_t tag_id, uint32_t h)
+{
+    for (uint32_t k = 0, p = h & (SLOTS - 1); k < SLOTS; k++, p = (p + 1) & (SLOTS - 1)) {
+        if (s_slot[p] == EMPTY) return -1;
+        const tt_entry_t* e = &s_e[s_slot[p] - 1];
+        if (e->hash == h && e->st.tag_id == tag_id && e->st.anchor_id == anchor_id) return (int)p;
+    }
+    return -1;
+}
+
+/* backward-shift: a próbalánc tömör marad, nincs tombstone */
+static void slot_erase(uint32_t p)
+{
+    uint32_t q = p;
+    for (;;) {
+        q = (q + 1) & (SLOTS - 1);
+        if (s_slot[q] == EMPTY) break;
+        uint32_t home = s_e[s_slot[q] - 1].hash & (SLOTS - 1);
+        if (((q - home) & (SLOTS - 1)) >= ((q - p) & (SLOTS - 1))) { s_slot[p] = s_slot[q]; p = q; }
+    }
+    s_slot[p] = EMPTY;
+}
+
+static void remove_idx(uint16_t i)
+{
+    int p = find_slot(s_e[i].st.anchor_id, s_e[i].st.tag_id, s_e[i].hash);
+    if (p >= 0) slot_erase((uint32_t)p);
+    lru_unlink(i);
+    memset(&s_e[i], 0, sizeof(s_e[i]));
+    s_e[i].next = s_free;
+    s_free = i;
+    s_n--;
+}
+
+void tt_reset(void)
+{
+    memset(s_e, 0, sizeof(s_e));
+    memset(s_slot, 0, sizeof(s_slot));
+    s_head = s_tail = s_free = NIL;
+    s_hw = 0;
+    s_n = s_evict = s_expired = 0;
+}
+
+static uint32_t expire_tail(int64_t now_us, uint32_t max)
+{
+    uint32_t n = 0;
+    while (n < max && s_tail != NIL && now_us - s_e[s_tail].st.last_us > TT_IDLE_US) { remove_idx(s_tail); n++; }
+    s_expired += n;
+    return n;
+}
+
+uint32_t tt_expire(int64_t now_us) { return expire_tail(now_us, TT_MAX_TAGS); }
+
+static tt_entry_t* find_or_add(uint32_t anchor_id, uint32_t tag_id, int64_t now_us, bool* fresh)
+{
+    const uint32_t h = h_key(anchor_id, tag_id);
+    int p = find_slot(anchor_id, tag_id, h);
+    if (p >= 0) {
+        uint16_t i = s_slot[p] - 1;
+        if (s_head != i) { lru_unlink(i); lru_front(i); }
+        *fresh = false;
+        return &s_e[i];
+    }
+
+    /* a LRU végéről legfeljebb néhány tétlen tag söprése (amortizált O(1)) */
+    expire_tail(now_us, 4);
+    if (s_free == NIL && s_hw == TT_MAX_TAGS) { remove_idx(s_tail); s_evict++; }
+
+    uint16_t i;
+    if (s_free != NIL) { i = s_free; s_free = s_e[i].next; }
+    else               i = s_hw++;
+    tt_entry_t* e = &s_e[i];
+    memset(e, 0, sizeof(*e));
+    e->st.anchor_id = anchor_id;
+    e->st.tag_id = tag_id;
+    e->hash = h;
+    e->used = true;
+    lru_front(i);
+    uint32_t q = h & (SLOTS - 1);
+    while (s_slot[q] != EMPTY) q = (q + 1) & (SLOTS - 1);
+    s_slot[q] = i + 1;
+    s_n++;
+    *fresh = true;
+    return e;
+}
+
+/* ts40 kiterjesztése: a nyers előrelépés (mod 2^40) mellé annyi teljes
+ * átfordulást adunk, amennyi az érkezési időkülönbséghez a legközelebb esik.
+ * Negatív eredmény = visszalépés (csere vagy óra-reset). */
+static int64_t advance_ticks(const tt_entry_t* e, uint64_t ts40, int64_t now_us)
+{
+    const uint64_t delta = (ts40 - e->raw40) & TT_MASK;
+    const uint64_t pred  = us_to_ticks(now_us - e->st.last_us);
+    /* k = round((pred - delta) / 2^40), előjelesen */
+    int64_t k;
+    if (pred + TT_WRAP / 2 >= delta) k = (int64_t)((pred + TT_WRAP / 2 - delta) / TT_WRAP);
+    else                             k = -1;
+    return (int64_t)delta + k * (int64_t)TT_WRAP;
+}
+
+static void rate_update(tt_entry_t* e, int64_t now_us)
+{
+    const int64_t dt = now_us - e->st.last_us;
+    if (dt <= 0) return;
+    const uint32_t d = dt > 0x7FFFFFFF ? 0x7FFFFFFF : (uint32_t)dt;
+    if (!e->ewma_dt_us) e->ewma_dt_us = d;
+    else                e->ewma_dt_us = (uint32_t)((int64_t)e->ewma_dt_us + (((int64_t)d - e->ewma_dt_us) >> EWMA_SH));
+    e->st.rate_mhz = e->ewma_dt_us ? (uint32_t)(1000000000ULL / e->ewma_dt_us) : 0;
+}
+
+static inline uint64_t ts_at(const tt_tag_stats_t* s, int64_t adv)
+{
+    return adv < 0 ? s->ts64 - (uint64_t)(-adv) : s->ts64 + (uint64_t)adv;
+}
+
+bool tt_process(const uint8_t* frame, uint16_t len, int64_t now_us, tt_out_t* out)
+{
+    uwb_data_t f;
+    if (!uwb_data_decode(frame, len, &f)) return false;
+
+    bool fresh;
+    tt_entry_t* e = find_or_add(f.anchor_id, f.tag_id, now_us, &fresh);
+    tt_tag_stats_t* s = &e->st;
+    memset(out, 0, sizeof(*out));
+
+    if (fresh) {
+        e->raw40 = f.ts40;
+        e->tag_seq = f.tag_seq;
+        e->sync_seq = f.sync_seq;
+        e->seen = 1;
+        s->frames = 1;
+        s->ts64 = f.ts40;
+        s->first_us = s->last_us = now_us;
+        out->ts64 = s->ts64;
+        out->flags = TT_F_FIRST;
+        return true;
+    }
+
+    const int64_t  adv  = advance_ticks(e, f.ts40, now_us);
+    const uint8_t  d    = (uint8_t)(f.tag_seq - e->tag_seq);
+    const uint32_t back = d ? 256u - d : 0;              /* hány kerettel régebbi (d ≥ 128) */
+    bool reset = adv < 0 && (uint64_t)(-adv) > TT_REORDER_TICKS;
+    /* ablakon belüli régebbi seq, ideje is illik hozzá (back keretköz + tűrés):
+       késve / újra küldött keret, nem óra-reset */
+    if (reset && (d == 0 || d >= 128) && back < WIN &&
+        (uint64_t)(-adv) <= us_to_ticks((int64_t)(back + 1) * e->ewma_dt_us) + TT_REORDER_TICKS) reset = false;
+
+    /* ---- duplikátum / késve érkezett keret (tag_seq ablak); az állapot marad ---- */
+    if (!reset && (d == 0 || d >= 128)) {
+        out->ts64 = ts_at(s, adv);
+        if (back < WIN && (e->seen & (1u << back))) {
+            s->dups++;
+            out->flags = TT_F_DUP;
+            return true;
+        }
+        if (back < WIN) {
+            e->seen |= 1u << back;
+            if (s->lost) s->lost--;                       /* a rés mégis megtelt */
+        }
+        s->frames++;
+        s->reorders++;
+        out->flags = TT_F_REORDER;
+        return true;
+    }
+
+    /* ---- időbélyeg ---- */
+    if (reset) {
+        /* anchor óra újraindult: a 64 bites idő a becsült eltelt idővel folytatódik */
+        s->resets++;
+        s->ts64 += us_to_ticks(now_us - s->last_us) + 1;
+        e->raw40 = f.ts40;
+        out->ts64 = s->ts64;
+        out->flags |= TT_F_RESET;
+    } else if (adv < 0) {
+        /* időben kicsit régebbi, de sorszámban előrébb: az idő nem lép vissza */
+        s->reorders++;
+        out->ts64 = ts_at(s, adv);
+        out->flags |= TT_F_REORDER;
+    } else {
+        const uint64_t nwrap = (((e->raw40 & TT_MASK) + (uint64_t)adv) >> 40);
+        if (nwrap) { s->wraps += (uint32_t)nwrap; out->flags |= TT_F_WRAP; }
+        s->ts64 += (uint64_t)adv;
+        e->raw40 = f.ts40;
+        out->ts64 = s->ts64;
+    }
+    rate_update(e, now_us);
+    s->last_us = now_us;
+    s->frames++;
+
+    /* ---- tag_seq ---- */
+    if (reset && (d == 0 || d >= 128)) {
+        e->seen = 1;
+    } else {
+        if (f.tag_seq < e->tag_seq) { s->seq_rolls++; out->flags |= TT_F_SEQ_ROLL; }
+        out->lost = d - 1;
+        s->lost += d - 1;
+        e->seen = (d >= WIN ? 0 : e->seen << d) | 1u;
+    }
+    e->tag_seq = f.tag_seq;
+
+    /* ---- sync_seq: több keret is eshet egy sync ciklusra ---- */
+    const uint8_t ds = (uint8_t)(f.sync_seq - e->sync_seq);
+    if (ds > 0 && ds < 128) {
+        out->sync_lost = ds - 1;
+        s->sync_lost += ds - 1;
+        e->sync_seq = f.sync_seq;
+    } else if (ds >= 128 && reset) {
+        e->sync_seq = f.sync_seq;
+    }
+    return true;
+}
+
+uint32_t tt_count(void) { return s_n; }
+
+bool tt_get(uint32_t idx, tt_tag_stats_t* out)
+{
+    if (idx >= TT_MAX_TAGS || !s_e[idx].used) return false;
+    *out = s_e[idx].st;
+    return true;
+}
+
+uint32_t tt_evictions(void) { return s_evict; }
+uint32_t tt_expired(void)   { return s_expired; }
@@ -0,0 +1,77 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===== Tag állapot: 40 bites DW időbélyeg kiterjesztése + sorszám-rések =====
+ * (anchor_id, tag_id) páronként tartott állapot. A ts40 ~17.2 s-onként
+ * átfordul; a 64 bites idő a nyers különbségből és a gateway oldali érkezési
+ * időből becsült átfordulás-számból áll, így hosszabb csend után is helyes.
+ * tag_seq / sync_seq (8 bit) réseiből veszteséget számolunk; a 32 keretes
+ * tag_seq ablakban már látott keret duplikátum (TT_F_DUP, eldobandó).
+ *
+ * Tábla: fix kapacitás, nyílt címzésű hash (lineáris próba, backward-shift
+ * törlés) + LRU lista; keretenként O(1), nincs heap. Tétlen tagok a LRU
+ * végéről öregednek ki, tele táblánál a legrégebben látott esik ki.
+ * Nem allokál, ESP API-t nem hív (host-on szintetikus sorozattal tesztelhető);
+ * a szálbiztonság a hívó dolga. */
+
+#ifndef TT_MAX_TAGS
+#define TT_MAX_TAGS       256
+#endif
+#ifndef TT_IDLE_US
+#define TT_IDLE_US        (60LL * 1000000)            /* ennyi csend után kiöregszik */
+#endif
+#define TT_WRAP           (1ULL << 40)
+#define TT_REORDER_TICKS  (63898ULL * 100000ULL)   /* 100 ms: ennél kisebb visszalépés = csere */
+
+/* keret jelzők (tt_out_t.flags, uplink rekord) */
+#define TT_F_FIRST     (1u<<0)   /* első keret ettől a tagtól */
+#define TT_F_WRAP      (1u<<1)   /* ts40 átfordult az előző óta */
+#define TT_F_SEQ_ROLL  (1u<<2)   /* tag_seq 255→0 */
+#define TT_F_DUP       (1u<<3)   /* már látott tag_seq: eldobandó */
+#define TT_F_REORDER   (1u<<4)   /* régebbi keret (ts / seq visszafelé) */
+#define TT_F_RESET     (1u<<5)   /* anchor óra újraindult, új alap */
+
+typedef struct {
+    uint64_t ts64;        /* kiterjesztett DW idő (tick) */
+    uint16_t lost;        /* kimaradt tag_seq az előző keret óta */
+    uint8_t  sync_lost;   /* kimaradt sync_seq az előző keret óta */
+    uint8_t  flags;       /* TT_F_* */
+} tt_out_t;
+
+typedef struct {
+    uint32_t anchor_id, tag_id;
+    uint32_t frames;        /* elfogadott (nem duplikált) keretek */
+    uint32_t lost;          /* tag_seq rések (késve beérkezettek levonva) */
+    uint32_t sync_lost;     /* sync_seq rések összege */
+    uint32_t dups, reorders, resets;
+    uint32_t wraps;         /* ts40 átfordulások */
+    uint32_t seq_rolls;     /* tag_seq átfordulások */
+    uint32_t rate_mhz;      /* EWMA keretráta (mHz), 0 = még nincs */
+    uint64_t ts64;          /* utolsó kiterjesztett idő */
+    int64_t  first_us;      /* első / utolsó érkezés (gateway idő) */
+    int64_t  last_us;
+} tt_tag_stats_t;
+
+void tt_reset(void);
+
+/* 20 B-os 0xAB DATA keret; now_us a gateway érkezési ideje (monoton).
+ * false, ha nem DATA keret. TT_F_DUP esetén a keretet nem kell továbbítani. */
+bool tt_process(const uint8_t* frame, uint16_t len, int64_t now_us, tt_out_t* out);
+
+/* now_us-hoz képest TT_IDLE_US óta csendes tagok törlése; visszaad: törölt db */
+uint32_t tt_expire(int64_t now_us);
+
+uint32_t tt_count(void);
+/* bejárás: idx < TT_MAX_TAGS, üres helyre false */
+bool     tt_get(uint32_t idx, tt_tag_stats_t* out);
+uint32_t tt_evictions(void);     /* tele tábla miatt */
+uint32_t tt_expired(void);       /* tétlenség miatt */
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,268 @@
+// components/uplink/uplink.c — UWB DATA keretek kötegelt UDP továbbítása
+#include <string.h>
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "lwip/sockets.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_mac.h"
+#include "esp_partition.h"
+#include "globals.h"
+#include "boot.h"
+#include "uplink.h"
+#include "uplink_pack.h"
+#include "journal.h"
+
+static const char* TAG = "UPLINK";
+
+#define UPLINK_QUEUE_LEN  128
+#define UPLINK_BUF_MAX    1472      /* Ethernet MTU - IP/UDP fejléc */
+#define JOURNAL_SUBTYPE   0x40      /* partitions.csv: journal, data, 0x40 */
+#define JOURNAL_BLOCK     65536     /* törlési egység: 64 KB blokk (1400 B datagramnál ~3% hulladék) */
+
+static QueueHandle_t s_q = NULL;
+static TaskHandle_t  s_task = NULL;
+static int           s_sock = -1;
+static uint32_t      s_gw_id = 0;
+static uint32_t      s_seq = 0;
+
+static portMUX_TYPE  s_lock = portMUX_INITIALIZER_UNLOCKED;
+static uplink_cfg_t  s_cfg = { .max_frames = 64, .flush_ms = 5, .max_rate = 0, .mtu = 1400, .replay_rate = 50 };
+static uplink_stats_t s_st;
+static portMUX_TYPE  s_tt_lock = portMUX_INITIALIZER_UNLOCKED;   /* tag tábla */
+
+static uint8_t s_buf[UPLINK_BUF_MAX];
+
+/* napló: csak az uplink task használja, a stat másolat s_lock alatt */
+static journal_t              s_jr;
+static const esp_partition_t* s_jr_part = NULL;
+static uplink_journal_stats_t s_jst;
+static uint8_t                s_rbuf[UPLINK_BUF_MAX];
+
+/* ====== Config / stat ====== */
+void uplink_get_config(uplink_cfg_t* out)
+{
+    portENTER_CRITICAL(&s_lock); *out = s_cfg; portEXIT_CRITICAL(&s_lock);
+}
+
+esp_err_t uplink_set_config(const uplink_cfg_t* c)
+{
+    if (!c) return ESP_ERR_INVALID_ARG;
+    if (c->max_frames < 1 || c->max_frames > UPLINK_MAX_FRAMES) return ESP_ERR_INVALID_ARG;
+    if (c->mtu < UPLINK_HDR_LEN + UPLINK_REC_LEN || c->mtu > UPLINK_BUF_MAX) return ESP_ERR_INVALID_ARG;
+    if (c->flush_ms > 10000) return ESP_ERR_INVALID_ARG;
+    if (c->replay_rate > 1000) return ESP_ERR_INVALID_ARG;
+    portENTER_CRITICAL(&s_lock); s_cfg = *c; portEXIT_CRITICAL(&s_lock);
+    ESP_LOGI(TAG, "cfg frames=%u flush=%ums rate=%u/s mtu=%u replay=%u/s",
+             c->max_frames, c->flush_ms, c->max_rate, c->mtu, c->replay_rate);
+    return ESP_OK;
+}
+
+void uplink_get_stats(uplink_stats_t* out)
+{
+    portENTER_CRITICAL(&s_lock); *out = s_st; portEXIT_CRITICAL(&s_lock);
+}
+
+void uplink_get_journal_stats(uplink_journal_stats_t* out)
+{
+    portENTER_CRITICAL(&s_lock); *out = s_jst; portEXIT_CRITICAL(&s_lock);
+}
+
+#define ST_ADD(f, n) do { portENTER_CRITICAL(&s_lock); s_st.f += (n); portEXIT_CRITICAL(&s_lock); } while (0)
+
+uint32_t uplink_tag_count(void)
+{
+    const int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&s_tt_lock);
+    tt_expire(now);              /* csendes időszakban is kiöregszenek */
+    uint32_t n = tt_count();
+    portEXIT_CRITICAL(&s_tt_lock);
+    return n;
+}
+
+bool uplink_tag_get(uint32_t idx, tt_tag_stats_t* out)
+{
+    portENTER_CRITICAL(&s_tt_lock); bool ok = tt_get(idx, out); portEXIT_CRITICAL(&s_tt_lock);
+    return ok;
+}
+
+/* ====== Bemenet ====== */
+/* A tag állapot az érkezéskor frissül (a sorba már a kiterjesztett rekord megy),
+ * így a sor okozta késleltetés nem torzítja az átfordulás-becslést. */
+bool uplink_push_data(const uint8_t* frame, uint16_t len)
+{
+    if (!s_q || !frame || len != UPLINK_FRAME_LEN || frame[0] != 0xAB) return false;
+    tt_out_t t;
+    const int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&s_tt_lock);
+    bool ok = tt_process(frame, len, now, &t);
+    portEXIT_CRITICAL(&s_tt_lock);
+    if (!ok) return false;
+    if (t.flags & TT_F_DUP) { ST_ADD(frames_dup, 1); return true; }
+
+    uint8_t rec[UPLINK_REC_LEN];
+    uplink_rec_encode(rec, frame, &t);
+    if (xQueueSend(s_q, rec, 0) != pdTRUE) { ST_ADD(frames_dropped, 1); return false; }
+    ST_ADD(frames_in, 1);
+    return true;
+}
+
+/* ====== Napló (store-and-forward) ====== */
+static int jp_read(void* c, uint32_t off, void* b, uint32_t n)        { return esp_partition_read(c, off, b, n) != ESP_OK; }
+static int jp_write(void* c, uint32_t off, const void* b, uint32_t n) { return esp_partition_write(c, off, b, n) != ESP_OK; }
+static int jp_erase(void* c, uint32_t off, uint32_t n)                { return esp_partition_erase_range(c, off, n) != ESP_OK; }
+
+static void journal_open(void)
+{
+    s_jr_part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, JOURNAL_SUBTYPE, "journal");
+    if (!s_jr_part) { ESP_LOGW(TAG, "no journal partition, outage frames are lost"); return; }
+    const jr_flash_t f = {
+        .read = jp_read, .write = jp_write, .erase = jp_erase, .ctx = (void*)s_jr_part,
+        .size = s_jr_part->size - s_jr_part->size % JOURNAL_BLOCK, .sector = JOURNAL_BLOCK,
+    };
+    if (jr_mount(&s_jr, &f) != 0) { ESP_LOGE(TAG, "journal mount failed"); s_jr_part = NULL; return; }
+    s_jst.present = true;
+    s_jst.size = f.size;
+    s_jst.jr = s_jr.st;
+    ESP_LOGI(TAG, "journal %" PRIu32 " KB, %" PRIu32 " pending", f.size / 1024, s_jr.st.pending);
+}
+
+static void journal_sync_stats(uint32_t replay_ms)
+{
+    portENTER_CRITICAL(&s_lock); s_jst.jr = s_jr.st; s_jst.replay_ms += replay_ms; portEXIT_CRITICAL(&s_lock);
+}
+
+static int udp_send(const uint8_t* p, uint16_t n)
+{
+    struct sockaddr_in to = {0};
+    to.sin_family = AF_INET;
+    to.sin_port = htons(NET.udp_port);
+    to.sin_addr.s_addr = NET.udp_dst.addr;
+    return sendto(s_sock, p, n, 0, (struct sockaddr*)&to, sizeof(to));
+}
+
+/* ====== Küldés ====== */
+/* Link nélkül vagy sikertelen küldéskor a kész datagram (fejléccel, sorszámmal)
+ * a naplóba kerül; visszajátszáskor változatlanul megy ki, a backend a
+ * (gw_id, seq) alapján szűri a duplikátumot. */
+static void send_batch(uplink_batch_t* b)
+{
+    uint16_t n = uplink_batch_finish(b, s_gw_id, s_seq++);
+    int r = eth_up ? udp_send(b->buf, n) : -1;
+    bool jr = false;
+    if (r != n && s_jr_part) {
+        jr = jr_append(&s_jr, b->buf, n) == 0;
+        journal_sync_stats(0);
+    }
+    portENTER_CRITICAL(&s_lock);
+    if (r == n)  { s_st.datagrams++; s_st.frames_sent += b->count; s_st.bytes_sent += n; }
+    else if (jr) { s_st.journaled++; }
+    else         { s_st.send_errors++; }
+    portEXIT_CRITICAL(&s_lock);
+    if (r == n) boot_mark(BOOT_FIRST_FRAME);        /* csak az első számít */
+}
+
+/* egy naplózott datagram újraküldése; true, ha sikerült */
+static bool replay_one(void)
+{
+    uint16_t n;
+    if (jr_peek(&s_jr, s_rbuf, sizeof(s_rbuf), &n) != 0) return false;
+    if (udp_send(s_rbuf, n) != n) return false;
+    jr_pop(&s_jr);
+    ST_ADD(bytes_sent, n);
+    return true;
+}
+
+static TickType_t us_to_ticks_ceil(int64_t us)
+{
+    if (us <= 0) return 0;
+    TickType_t t = (TickType_t)((us + portTICK_PERIOD_MS * 1000 - 1) / (portTICK_PERIOD_MS * 1000));
+    return t ? t : 1;
+}
+
+/* Forwarder: az első keret után flush_ms-ig (vagy MTU/max_frames telítésig) gyűjt.
+ * A várakozás tick-felbontású (CONFIG_FREERTOS_HZ). */
+static void uplink_task(void* arg)
+{
+    (void)arg;
+    uplink_batch_t b;
+    uplink_cfg_t c;
+    int64_t deadline = 0, last_tx = 0, next_replay = 0, replay_t0 = 0;
+    uint8_t rec[UPLINK_REC_LEN];
+
+    uplink_get_config(&c);
+    uplink_batch_begin(&b, s_buf, c.mtu, (uint8_t)c.max_frames);
+
+    for (;;) {
+        TickType_t wait = portMAX_DELAY;
+        if (b.count) wait = us_to_ticks_ceil(deadline - esp_timer_get_time());
+
+        /* visszajátszás: link fent, van függő rekord; replay_rate datagram / s.
+         * Az élő forgalom elsőbbséget kap, a régi datagramok a szünetekben mennek. */
+        const bool replaying = s_jr_part && eth_up && c.replay_rate && jr_pending(&s_jr);
+        if (!replaying && replay_t0) {
+            journal_sync_stats((uint32_t)((esp_timer_get_time() - replay_t0) / 1000));
+            replay_t0 = 0;
+        }
+        if (replaying) {
+            int64_t now = esp_timer_get_time();
+            if (!replay_t0) replay_t0 = now;
+            if (now >= next_replay) {
+                next_replay = now + (replay_one() ? 1000000 / c.replay_rate : 1000000);   /* hiba: 1 s múlva */
+                if (!jr_pending(&s_jr)) ESP_LOGI(TAG, "journal replay done");
+                journal_sync_stats(0);
+            }
+            TickType_t w = us_to_ticks_ceil(next_replay - esp_timer_get_time());
+            if (w < wait) wait = w;
+        }
+
+        bool got = xQueueReceive(s_q, rec, wait) == pdTRUE;
+        if (got) {
+            if (!b.count) deadline = esp_timer_get_time() + (int64_t)c.flush_ms * 1000;
+            uplink_batch_add(&b, rec);
+        }
+        if (!b.count) continue;
+        if (!uplink_batch_full(&b) && esp_timer_get_time() < deadline) continue;
+
+        /* datagram / s korlát: a köteg tovább gyűlik, tele köteg kivár */
+        if (c.max_rate) {
+            int64_t gap = 1000000 / c.max_rate - (esp_timer_get_time() - last_tx);
+            if (gap > 0) {
+                if (!uplink_batch_full(&b)) { deadline = esp_timer_get_time() + gap; continue; }
+                vTaskDelay(us_to_ticks_ceil(gap));
+            }
+        }
+
+        send_batch(&b);
+        last_tx = esp_timer_get_time();
+
+        uplink_get_config(&c);   /* új paraméterek a következő kötegtől */
+        uplink_batch_begin(&b, s_buf, c.mtu, (uint8_t)c.max_frames);
+    }
+}
+
+esp_err_t uplink_start(void)
+{
+    if (s_task) return ESP_OK;
+
+    uint8_t mac[6] = {0};
+    esp_read_mac(mac, ESP_MAC_ETH);
+    s_gw_id = ((uint32_t)mac[2]<<24) | ((uint32_t)mac[3]<<16) | ((uint32_t)mac[4]<<8) | mac[5];
+
+    s_sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s_sock < 0) { ESP_LOGE(TAG, "socket failed"); return ESP_FAIL; }
+    int on = 1;
+    setsockopt(s_sock, SOL_SOCKET, SO_BROADCAST, &on, sizeof(on));
+
+    journal_open();
+
+    s_q = xQueueCreate(UPLINK_QUEUE_LEN, UPLINK_REC_LEN);
+    if (!s_q) { close(s_sock); s_sock = -1; return ESP_ERR_NO_MEM; }
+    if (xTaskCreate(uplink_task, "uplink", 4096, NULL, 6, &s_task) != pdPASS) return ESP_ERR_NO_MEM;
+
+    ESP_LOGI(TAG, "started gw_id=0x%08" PRIX32 " -> %s:%u",
+             s_gw_id, ip4addr_ntoa(&NET.udp_dst), NET.udp_port);
+    return ESP_OK;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "tag_track.h"
+#include "journal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Futás közben állítható batch paraméterek */
+typedef struct {
+    uint16_t max_frames;   /* keret / datagram (1..255) */
+    uint16_t flush_ms;     /* max. várakozás az első keret után */
+    uint16_t max_rate;     /* datagram / s felső korlát, 0 = nincs */
+    uint16_t mtu;          /* datagram max. hossza bájtban */
+    uint16_t replay_rate;  /* napló visszajátszás datagram / s, 0 = szünetel */
+} uplink_cfg_t;
+
+typedef struct {
+    uint32_t frames_in;      /* elfogadott DATA keretek */
+    uint32_t frames_dropped; /* tele sor miatt eldobva */
+    uint32_t frames_dup;     /* duplikátumként eldobva (tag tábla) */
+    uint32_t frames_sent;
+    uint32_t datagrams;
+    uint32_t send_errors;    /* se elküldeni, se naplózni nem sikerült */
+    uint32_t journaled;      /* link / küldés hiba miatt naplóba írt datagram */
+    uint32_t bytes_sent;
+} uplink_stats_t;
+
+/* Store-and-forward napló (journal partíció) */
+typedef struct {
+    bool       present;
+    uint32_t   size;         /* használt partíció méret */
+    uint32_t   replay_ms;    /* lezárt visszajátszások összideje (átviteli ráta) */
+    jr_stats_t jr;
+} uplink_journal_stats_t;
+
+/* Forwarder task + UDP socket (cél: NET.udp_dst:NET.udp_port) */
+esp_err_t uplink_start(void);
+
+/* 20 B-os 0xAB DATA keret beadása; nem blokkol. A tag állapotot
+ * (64 bites idő, veszteség) itt frissíti, a datagramba 32 B-os rekord kerül. */
+bool uplink_push_data(const uint8_t* frame, uint16_t len);
+
+void      uplink_get_config(uplink_cfg_t* out);
+esp_err_t uplink_set_config(const uplink_cfg_t* cfg);
+void      uplink_get_stats(uplink_stats_t* out);
+void      uplink_get_journal_stats(uplink_journal_stats_t* out);
+
+/* tagonkénti statisztika; bejárás idx < TT_MAX_TAGS, üres helyre false.
+ * A count hívás a tétlen tagokat is kiöregíti. */
+uint32_t  uplink_tag_count(void);
+bool      uplink_tag_get(uint32_t idx, tt_tag_stats_t* out);
+
+#ifdef __cplusplus
+}
+#endif
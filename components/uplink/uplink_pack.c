@@ -0,0 +1,48 @@
+// components/uplink/uplink_pack.c — DATA keretek csomagolása UDP datagramba
+#include <string.h>
+#include "uplink_pack.h"
+
+static inline void wr32be(uint8_t* p, uint32_t v){ p[0]=v>>24; p[1]=v>>16; p[2]=v>>8; p[3]=v; }
+
+void uplink_rec_encode(uint8_t rec[UPLINK_REC_LEN], const uint8_t frame[UPLINK_FRAME_LEN], const tt_out_t* t)
+{
+    memcpy(rec, frame, UPLINK_FRAME_LEN);
+    for (int i = 0; i < 8; i++) rec[20 + i] = (uint8_t)(t->ts64 >> (8 * i));
+    rec[28] = (uint8_t)t->lost; rec[29] = (uint8_t)(t->lost >> 8);
+    rec[30] = t->sync_lost;
+    rec[31] = t->flags;
+}
+
+void uplink_batch_begin(uplink_batch_t* b, uint8_t* buf, uint16_t cap, uint8_t max_frames)
+{
+    b->buf = buf;
+    b->cap = cap;
+    b->len = UPLINK_HDR_LEN;
+    b->count = 0;
+    b->max_frames = max_frames ? max_frames : 1;
+}
+
+bool uplink_batch_full(const uplink_batch_t* b)
+{
+    return b->count >= b->max_frames || b->len + UPLINK_REC_LEN > b->cap;
+}
+
+bool uplink_batch_add(uplink_batch_t* b, const uint8_t rec[UPLINK_REC_LEN])
+{
+    if (uplink_batch_full(b)) return false;
+    memcpy(b->buf + b->len, rec, UPLINK_REC_LEN);
+    b->len += UPLINK_REC_LEN;
+    b->count++;
+    return true;
+}
+
+uint16_t uplink_batch_finish(uplink_batch_t* b, uint32_t gw_id, uint32_t seq)
+{
+    uint8_t* h = b->buf;
+    h[0] = UPLINK_MAGIC0; h[1] = UPLINK_MAGIC1;
+    h[2] = UPLINK_VERSION;
+    h[3] = b->count;
+    wr32be(&h[4], gw_id);
+    wr32be(&h[8], seq);
+    return b->len;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include "tag_track.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* UDP uplink datagram (minden mező BE):
+ *   [0..1]  magic 'U','B'
+ *   [2]     verzió (2)
+ *   [3]     keretszám
+ *   [4..7]  gateway id
+ *   [8..11] datagram sorszám
+ *   [12..]  count × 32 B rekord
+ *
+ * Rekord (a nyers kerethez igazodva LE):
+ *   [0..19]  nyers 0xAB DATA keret
+ *   [20..27] kiterjesztett 64 bites DW idő (tick)
+ *   [28..29] kimaradt tag_seq az előző keret óta
+ *   [30]     kimaradt sync_seq
+ *   [31]     TT_F_* jelzők
+ */
+#define UPLINK_MAGIC0     0x55
+#define UPLINK_MAGIC1     0x42
+#define UPLINK_VERSION    2
+#define UPLINK_HDR_LEN    12
+#define UPLINK_FRAME_LEN  20
+#define UPLINK_REC_LEN    32
+#define UPLINK_MAX_FRAMES 255
+
+typedef struct {
+    uint8_t* buf;
+    uint16_t cap;        /* datagram max. hossza (MTU) */
+    uint16_t len;
+    uint8_t  count;
+    uint8_t  max_frames;
+} uplink_batch_t;
+
+void     uplink_rec_encode(uint8_t rec[UPLINK_REC_LEN], const uint8_t frame[UPLINK_FRAME_LEN], const tt_out_t* t);
+
+void     uplink_batch_begin(uplink_batch_t* b, uint8_t* buf, uint16_t cap, uint8_t max_frames);
+bool     uplink_batch_add(uplink_batch_t* b, const uint8_t rec[UPLINK_REC_LEN]);   /* false → tele */
+bool     uplink_batch_full(const uplink_batch_t* b);
+uint16_t uplink_batch_finish(uplink_batch_t* b, uint32_t gw_id, uint32_t seq);     /* fejléc, hossz */
+
+#ifdef __cplusplus
+}
+#endif
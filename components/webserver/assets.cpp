@@ -0,0 +1,38 @@
+// components/webserver/assets.cpp — pack_assets.py tábla olvasó
+#include <cstring>
+#include "esp_log.h"
+#include "assets.hpp"
+
+static const char* TAG = "ASSET";
+
+extern const uint8_t assets_bin_start[] asm("_binary_assets_bin_start");
+extern const uint8_t assets_bin_end[]   asm("_binary_assets_bin_end");
+
+/* a packer formátuma, little-endian (ESP32 natív) */
+struct __attribute__((packed)) AstHdr { char magic[4]; uint16_t version, count; };
+struct __attribute__((packed)) AstEnt {
+    char     path[24], mime[24], etag[12];
+    uint32_t off, len, raw_len, flags;
+};
+static_assert(sizeof(AstHdr)==8,  "pack_assets.py HDR");
+static_assert(sizeof(AstEnt)==76, "pack_assets.py ENT");
+
+bool asset_find(const char* path, Asset* out){
+    const size_t sz = assets_bin_end - assets_bin_start;
+    const AstHdr* h = (const AstHdr*)assets_bin_start;
+    if(sz < sizeof(AstHdr) || memcmp(h->magic,"WAST",4)!=0 || h->version!=1){
+        ESP_LOGE(TAG,"bad asset table"); return false;
+    }
+    if(sizeof(AstHdr) + (size_t)h->count*sizeof(AstEnt) > sz) return false;
+
+    const AstEnt* e = (const AstEnt*)(h+1);
+    for(uint16_t i=0;i<h->count;i++,e++){
+        if(strncmp(e->path,path,sizeof(e->path))!=0) continue;
+        if((size_t)e->off + e->len > sz) return false;
+        out->path=e->path; out->mime=e->mime; out->etag=e->etag;
+        out->data=assets_bin_start+e->off;
+        out->len=e->len; out->raw_len=e->raw_len; out->flags=e->flags;
+        return true;
+    }
+    return false;
+}
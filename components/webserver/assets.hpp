@@ -0,0 +1,22 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+/* ================= Beágyazott asset tábla =================
+   tools/pack_assets.py állítja elő build közben (gzip + ETag); a blob a
+   flash-be mappelt .rodata-ban van, a kiszolgálás másolás nélküli. */
+
+#define ASSET_F_GZIP  1u
+
+struct Asset {
+    const char*    path;       // "/login.html"
+    const char*    mime;
+    const char*    etag;       // idézőjelekkel együtt
+    const uint8_t* data;
+    uint32_t       len;        // tárolt (tömörített) hossz
+    uint32_t       raw_len;
+    uint32_t       flags;
+};
+
+/* false, ha nincs ilyen / a tábla hibás */
+bool asset_find(const char* path, Asset* out);
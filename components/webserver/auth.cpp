@@ -0,0 +1,122 @@
+// components/webserver/auth.cpp — login, SID cookie, Basic Auth (lásd auth.hpp)
+#include <cstring>
+#include <cstdio>
+#include "esp_timer.h"
+#include "esp_system.h"
+#include "mbedtls/base64.h"
+#include "auth.hpp"
+#include "session_store.hpp"
+#include "http_json.hpp"
+
+/* ================= Users ================= */
+struct User { const char* u; const char* p; user_role_t r; };
+static const User kUsers[] = {
+    {"diag","diag",ROLE_DIAG},
+    {"admin","admin",ROLE_BLE},
+    {"root","root",ROLE_ROOT},
+    {nullptr,nullptr,ROLE_NONE}
+};
+static inline uint32_t now_s(){ return (uint32_t)(esp_timer_get_time()/1000000ULL); }
+
+static void mk_sid(char out[33]){
+    for(int i=0;i<32;i++){ uint8_t b = esp_random() & 0x0F; out[i] = "0123456789abcdef"[b]; }
+    out[32] = 0;
+}
+static user_role_t check_user(const char* u, const char* pw){
+    for (auto& x: kUsers) if (x.u && strcmp(u,x.u)==0 && strcmp(pw,x.p)==0) return x.r;
+    return ROLE_NONE;
+}
+
+/* ---------- Basic Auth ---------- */
+struct CredEnt { uint8_t len; char hdr[CRED_HDR_MAX]; user_role_t role; uint32_t exp_s; };
+static CredEnt s_cred[CRED_CACHE];
+static uint8_t s_cred_next;
+
+static user_role_t decode_basic(const char* h){
+    if (strncmp(h, "Basic ", 6) != 0) return ROLE_NONE;
+    const char* b64 = h + 6;
+    unsigned char buf[72]; size_t olen=0;
+    if (mbedtls_base64_decode(buf,sizeof(buf)-1,&olen,(const unsigned char*)b64,strlen(b64))!=0) return ROLE_NONE;
+    buf[olen]=0;
+    char* sep = (char*)strchr((char*)buf,':'); if(!sep) return ROLE_NONE;
+    *sep=0;
+    user_role_t r = check_user((char*)buf, sep+1);
+    memset(buf,0,sizeof(buf));
+    return r;
+}
+static user_role_t role_from_basic(httpd_req_t* req, uint32_t now){
+    char auth[128];
+    if(httpd_req_get_hdr_value_str(req,"Authorization",auth,sizeof(auth))!=ESP_OK) return ROLE_NONE;
+    const size_t n=strlen(auth);
+    if(n<CRED_HDR_MAX)
+        for(auto& c: s_cred)
+            if(c.len==n && c.exp_s>now && ct_equal(c.hdr,auth,n)) return c.role;
+
+    user_role_t r=decode_basic(auth);
+    if(r!=ROLE_NONE && n<CRED_HDR_MAX){
+        CredEnt& c=s_cred[s_cred_next++ % CRED_CACHE];
+        memcpy(c.hdr,auth,n); c.len=(uint8_t)n; c.role=r; c.exp_s=now+CRED_TTL_S;
+    }
+    return r;
+}
+
+/* ---------- Cookie (SID) ellenőrzés ---------- */
+static user_role_t role_from_cookie(httpd_req_t* req, uint32_t now){
+    char ck[256];
+    esp_err_t er=httpd_req_get_hdr_value_str(req,"Cookie",ck,sizeof(ck));
+    if(er!=ESP_OK && er!=ESP_ERR_HTTPD_RESULT_TRUNC) return ROLE_NONE;
+    const char* m=strstr(ck,"SID="); if(!m) return ROLE_NONE; m+=4;
+    char sid[SESS_SID_LEN+1]={0}; int i=0; while(*m && *m!=';' && i<SESS_SID_LEN) sid[i++]=*m++;
+    return sess_lookup(sid, now);
+}
+user_role_t role_from_auth(httpd_req_t* req){
+    const uint32_t now=now_s();
+    user_role_t r = role_from_cookie(req, now);
+    if (r != ROLE_NONE) return r;
+    return role_from_basic(req, now);
+}
+bool require_role(httpd_req_t* req, user_role_t need, user_role_t* have){
+    user_role_t r=role_from_auth(req);
+    if(have) *have=r;
+    if(r<need){
+        if (strncmp(req->uri,"/api/",5)==0 || strncmp(req->uri,"/auth/",6)==0){
+            httpd_resp_set_status(req,"401 Unauthorized"); httpd_resp_sendstr(req,"");
+        } else {
+            httpd_resp_set_status(req,"302 Found"); httpd_resp_set_hdr(req,"Location","/login"); httpd_resp_sendstr(req,"");
+        }
+        return false;
+    }
+    return true;
+}
+
+void auth_reset(){
+    sess_reset();
+    memset(s_cred,0,sizeof(s_cred)); s_cred_next=0;
+}
+
+/* ================= /auth/login =================
+   Body: {"user":"admin","pass":"admin"}
+   Siker: Set-Cookie: SID=...; Path=/; HttpOnly; Max-Age=86400
+*/
+struct LoginBody { char pass[64]; char user[32]; };
+static const JrField k_login_json[] = { JR_STR(LoginBody, pass, 0), JR_STR(LoginBody, user, 1) };
+
+esp_err_t auth_login_post(httpd_req_t* req){
+    LoginBody lb{}; JsonR jr;
+    const esp_err_t er=recv_json(req,jr,k_login_json,sizeof(k_login_json)/sizeof(k_login_json[0]),&lb);
+    const user_role_t r=(er==ESP_OK)?check_user(lb.user,lb.pass):ROLE_NONE;
+    memset(&lb,0,sizeof(lb)); memset(jr.val,0,sizeof(jr.val));   // jelszó ne maradjon a stacken
+    if(er!=ESP_OK) return ESP_FAIL;
+    if(r==ROLE_NONE) return httpd_resp_send_err(req,HTTPD_401_UNAUTHORIZED,"bad creds");
+
+    // session mentés (tele táblánál a legrégebben használt esik ki)
+    char sid[SESS_SID_LEN+1];
+    const uint32_t now=now_s();
+    do { mk_sid(sid); } while(!sess_put(sid,r,now+SESS_TTL_S,now));
+
+    char cookie[80];
+    snprintf(cookie,sizeof(cookie),"SID=%s; Path=/; HttpOnly; Max-Age=%u",sid,(unsigned)SESS_TTL_S);
+    httpd_resp_set_hdr(req,"Set-Cookie",cookie);
+    httpd_resp_set_type(req,"application/json");
+    return httpd_resp_sendstr(req,"{\"ok\":true}\n");
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdint>
+#include "esp_err.h"
+#include "esp_http_server.h"
+#include "webserver.hpp"
+
+/* ================= Hitelesítés =================
+   Login (SID cookie, session_store) és Basic Auth fallback. Az ellenőrzött
+   "Basic ..." fejlécet szó szerint cache-eljük, így a pollozó API hívásoknál
+   nincs base64 dekódolás és heap. Nincs FreeRTOS hívás: host-on is mérhető.
+   Zár nélkül (session_store, cred cache): csak a httpd taskról hívható; a
+   worker poolban futó handler a szerepkört a http_async Job-ban kapja. */
+
+#define SESS_TTL_S   86400
+#define CRED_CACHE   4
+#define CRED_HDR_MAX 64
+#define CRED_TTL_S   300
+
+void        auth_reset();                                   // sessionök + cred cache
+user_role_t role_from_auth(httpd_req_t* req);
+/* need alatt: 401 (/api/, /auth/) vagy 302 → /login, a válasz elmegy; false.
+   have: a megállapított szerepkör (ha nem nullptr) */
+bool        require_role(httpd_req_t* req, user_role_t need, user_role_t* have=nullptr);
+/* POST /auth/login  {"user":"admin","pass":"admin"} */
+esp_err_t   auth_login_post(httpd_req_t* req);
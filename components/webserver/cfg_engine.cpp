@@ -0,0 +1,136 @@
+// components/webserver/cfg_engine.cpp — minimális delta, kötegelt CFG SET + ACK követés
+#include <cstring>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "ble.h"
+#include "uwb_frame.h"
+#include "dwm_cache.hpp"
+#include "cfg_engine.hpp"
+
+static const char* TAG = "CFG";
+
+/* a futó írás: ezt párosítja a notify ág */
+struct CfgPending {
+    uint8_t  link;
+    uint16_t req_id;       // 0 = nincs futó írás
+    bool     acked;
+    uint8_t  status, applied;
+};
+
+static SemaphoreHandle_t s_run;     // egyszerre egy apply
+static SemaphoreHandle_t s_ack;     // ACK jelzés
+static portMUX_TYPE      s_lock = portMUX_INITIALIZER_UNLOCKED;
+static CfgPending        s_pend;
+
+esp_err_t cfg_engine_init(){
+    if(s_run) return ESP_OK;
+    s_run = xSemaphoreCreateMutex();
+    s_ack = xSemaphoreCreateBinary();
+    return (s_run && s_ack) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+void cfg_engine_on_notify(uint8_t link, const uint8_t* p, uint16_t n, bool from_cfg){
+    if(!s_ack || !from_cfg || n<6 || p[1]!=0x81) return;
+    uwb_cfg_t c;
+    if(uwb_cfg_decode(p,n,&c)!=UWB_CFG_ACK) return;
+    bool hit=false;
+    portENTER_CRITICAL(&s_lock);
+    if(s_pend.req_id && s_pend.req_id==c.ack.req_id && s_pend.link==link && !s_pend.acked){
+        s_pend.acked=true; s_pend.status=c.ack.status; s_pend.applied=c.ack.applied;
+        hit=true;
+    }
+    portEXIT_CRITICAL(&s_lock);
+    if(hit) xSemaphoreGive(s_ack);
+}
+
+/* egy SET írás: küldés + ACK várás, timeout után ugyanazzal a req_id-vel újra */
+static uint8_t send_wait(uint8_t link, const uint8_t* buf, uint16_t len, uint8_t* status, uint8_t* applied, uint8_t* retries){
+    const uint16_t req=ble_next_req_id();
+    portENTER_CRITICAL(&s_lock);
+    s_pend = CfgPending{link, req, false, 0, 0};
+    portEXIT_CRITICAL(&s_lock);
+    xSemaphoreTake(s_ack,0);                          // korábbi, elkésett jelzés
+
+    uint8_t r=CFG_R_TIMEOUT;
+    for(int k=0;k<=CFG_RETRIES;k++){
+        if(k) (*retries)++;
+        if(ble_send_set_ex(link,req,buf,len,CFG_WRITE_MODE)!=ESP_OK){ r=CFG_R_SEND_ERR; break; }
+        if(xSemaphoreTake(s_ack,pdMS_TO_TICKS(CFG_ACK_TIMEOUT_MS))==pdTRUE){ r=CFG_R_APPLIED; break; }
+        ESP_LOGW(TAG,"[%u] SET req=%u: no ACK (%d)",(unsigned)link,(unsigned)req,k);
+    }
+    portENTER_CRITICAL(&s_lock);
+    *status=s_pend.status; *applied=s_pend.applied;
+    s_pend.req_id=0;
+    portEXIT_CRITICAL(&s_lock);
+    return r;
+}
+
+esp_err_t cfg_engine_apply(uint8_t link, const EspCfg& want, uint16_t mask, CfgApplyResult* out){
+    if(!s_run) return ESP_ERR_INVALID_STATE;
+    if(link>=BLE_MAX_LINKS) return ESP_ERR_INVALID_ARG;
+    *out=CfgApplyResult{};
+    out->requested=mask;
+
+    xSemaphoreTake(s_run,portMAX_DELAY);
+    DwmSnapshot snap;
+    esp_err_t er=dwm_cache_get(link,&snap,DWM_CACHE_TTL_MS,DWM_ACK_TIMEOUT_MS+1500);
+    if(er!=ESP_OK){ xSemaphoreGive(s_run); return er; }
+
+    out->device=want;                                 // a hiányzó mezők alapértéke
+    out->device_mask=cfg_from_tlv(snap.bytes,snap.len,out->device);
+    out->changed=cfg_diff(out->device,out->device_mask,want,mask);
+    for(uint8_t f=0;f<CFG_NFIELDS;f++)
+        if((mask & CFG_M(f)) && !(out->changed & CFG_M(f))) out->res[f]=CFG_R_UNCHANGED;
+
+    const uint16_t cap=ble_max_set_len(link);
+    uint16_t todo=out->changed;
+    uint8_t  buf[240];
+    while(todo){
+        uint16_t len;
+        const uint16_t fields=cfg_pack_next(want,&todo,buf,cap<sizeof(buf)?cap:sizeof(buf),&len);
+        if(!fields){                                  // nincs link / túl kicsi MTU
+            for(uint8_t f=0;f<CFG_NFIELDS;f++) if(todo & CFG_M(f)) out->res[f]=CFG_R_SEND_ERR;
+            break;
+        }
+        out->writes++;
+        uint8_t st=0, applied=0;
+        uint8_t r=send_wait(link,buf,len,&st,&applied,&out->retries);
+
+        /* ACK applied = alkalmazott TLV-k száma; a készülék sorban dolgoz fel,
+           így az írás első `applied` mezője ment, a többi nem (status: az oka). */
+        uint8_t k=0;
+        for(uint8_t f=0;f<CFG_NFIELDS;f++){
+            if(!(fields & CFG_M(f))) continue;
+            uint8_t fr=r;
+            if(r==CFG_R_APPLIED){
+                out->ack_status[f]=st;
+                fr=(k<applied)?CFG_R_APPLIED:CFG_R_REJECTED;
+            }
+            out->res[f]=fr;
+            if(fr==CFG_R_APPLIED){
+                out->applied|=CFG_M(f);
+                cfg_set(out->device,f,cfg_get(want,f));
+                out->device_mask|=CFG_M(f);
+            }
+            k++;
+        }
+    }
+    if(out->writes) dwm_cache_invalidate(link);      // a snapshot már nem a készülék állapota
+    xSemaphoreGive(s_run);
+
+    ESP_LOGI(TAG,"[%u] SET changed=0x%03X applied=0x%03X writes=%u retries=%u",(unsigned)link,
+             (unsigned)out->changed,(unsigned)out->applied,(unsigned)out->writes,(unsigned)out->retries);
+    return ESP_OK;
+}
+
+const char* cfg_res_str(uint8_t r){
+    switch(r){
+    case CFG_R_UNCHANGED: return "unchanged";
+    case CFG_R_APPLIED:   return "applied";
+    case CFG_R_REJECTED:  return "rejected";
+    case CFG_R_TIMEOUT:   return "timeout";
+    case CFG_R_SEND_ERR:  return "send_error";
+    default:              return "none";
+    }
+}
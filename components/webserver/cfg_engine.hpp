@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include "esp_err.h"
+#include "ble.h"
+#include "cfg_json.hpp"
+
+/* ================= CFG SET motor (/api/config) =================
+   A kért EspCfg-t a legutóbbi GET snapshothoz (dwm_cache) hasonlítja, csak az
+   eltérő mezőket kódolja TLV-be, és a link MTU-jába férő legkevesebb SET
+   írásba csomagolja. Írásonként új req_id; az ACK-ra (status/applied)
+   timeouttal vár, timeout után ugyanazzal a req_id-vel újraküld.
+   Egyszerre egy alkalmazás fut (mutex). */
+
+#define CFG_ACK_TIMEOUT_MS   1000
+#define CFG_RETRIES          2         // újraküldés írásonként timeout után
+#define CFG_WRITE_MODE       BLE_WR_NO_RSP  // abszolút értékek: idempotens, a nyugta az ACK notify
+
+enum CfgFieldRes : uint8_t {
+    CFG_R_NONE = 0,      // nem kérték
+    CFG_R_UNCHANGED,     // a készüléken már ez az érték
+    CFG_R_APPLIED,       // ACK: alkalmazva
+    CFG_R_REJECTED,      // ACK: nem alkalmazta (status / applied szerint)
+    CFG_R_TIMEOUT,       // nincs ACK az újraküldések után sem
+    CFG_R_SEND_ERR,      // az írás el sem ment
+};
+
+struct CfgApplyResult {
+    uint16_t requested, changed, applied;   // mezőmaszkok (CFG_M)
+    uint8_t  writes, retries;
+    uint8_t  res[CFG_NFIELDS];              // CfgFieldRes
+    uint8_t  ack_status[CFG_NFIELDS];       // az írás ACK status-a (ha jött)
+    EspCfg   device;                        // snapshot + az alkalmazott mezők
+    uint16_t device_mask;                   // device ismert mezői
+};
+
+esp_err_t cfg_engine_init();
+
+/* ble_rx task hívja minden notify-ra (ACK párosítás) */
+void cfg_engine_on_notify(uint8_t link, const uint8_t* p, uint16_t n, bool from_cfg);
+
+/* want: a kért értékek, mask: a body-ban szereplő mezők.
+   Hibák: mint a dwm_cache_get-nél (INVALID_ARG, INVALID_STATE, NO_MEM, TIMEOUT: nincs
+   snapshot). Mezőszintű hibák az out-ban (ESP_OK mellett). */
+esp_err_t cfg_engine_apply(uint8_t link, const EspCfg& want, uint16_t mask, CfgApplyResult* out);
+
+const char* cfg_res_str(uint8_t r);
@@ -0,0 +1,110 @@
+// components/webserver/cfg_json.cpp — /api/config JSON kiírás + body kulcstábla
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include "tlv.h"
+#include "cfg_json.hpp"
+#include "json_out.hpp"
+#include "json_in.hpp"
+
+#define F(name, tag) { #name, tag, (uint8_t)offsetof(EspCfg, name), (uint8_t)sizeof(EspCfg::name) }
+const CfgField k_cfg_fields[CFG_NFIELDS] = {
+    F(NETWORK_ID, T_NETWORK_ID), F(ZONE_ID,    T_ZONE_ID),    F(ANCHOR_ID,  T_ANCHOR_ID),
+    F(HB_MS,      T_HB_MS),      F(LOG_LEVEL,  T_LOG_LEVEL),  F(TX_ANT_DLY, T_TX_ANT_DLY),
+    F(RX_ANT_DLY, T_RX_ANT_DLY), F(BIAS_TICKS, T_BIAS_TICKS), F(PHY_CH,     T_PHY_CH),
+    F(PHY_SFDTO,  T_PHY_SFDTO),
+};
+#undef F
+
+uint32_t cfg_get(const EspCfg& c, uint8_t f){
+    const CfgField& d=k_cfg_fields[f];
+    const uint8_t* p=(const uint8_t*)&c+d.off;
+    switch(d.size){
+    case 1:  return *p;
+    case 2:  { uint16_t v; memcpy(&v,p,2); return v; }
+    default: { uint32_t v; memcpy(&v,p,4); return v; }
+    }
+}
+void cfg_set(EspCfg& c, uint8_t f, uint32_t v){
+    const CfgField& d=k_cfg_fields[f];
+    uint8_t* p=(uint8_t*)&c+d.off;
+    switch(d.size){
+    case 1:  *p=(uint8_t)v; break;
+    case 2:  { uint16_t t=(uint16_t)v; memcpy(p,&t,2); break; }
+    default: memcpy(p,&v,4); break;
+    }
+}
+
+void cfg_json_write(JsonW& w, const EspCfg& c){
+    jw_obj(w);
+    jw_kv_u32(w,"NETWORK_ID",c.NETWORK_ID);
+    jw_key(w,"ZONE_ID");   jw_hex_u32(w,c.ZONE_ID,4);
+    jw_key(w,"ANCHOR_ID"); jw_hex_u32(w,c.ANCHOR_ID,8);
+    jw_kv_u32(w,"HB_MS",c.HB_MS);
+    jw_kv_u32(w,"LOG_LEVEL",c.LOG_LEVEL);
+    jw_kv_i32(w,"TX_ANT_DLY",c.TX_ANT_DLY);
+    jw_kv_i32(w,"RX_ANT_DLY",c.RX_ANT_DLY);
+    jw_kv_i32(w,"BIAS_TICKS",c.BIAS_TICKS);
+    jw_kv_u32(w,"PHY_CH",c.PHY_CH);
+    jw_kv_u32(w,"PHY_SFDTO",c.PHY_SFDTO);
+    jw_obj_end(w);
+}
+/* body kulcstábla (strcmp sorrend); bit = CfgFieldId, így a jr.set közvetlenül cfg maszk */
+#define N(m, t, lo, hi) JR_NUM(EspCfg, m, t, CFG_F_##m, lo, hi)
+const JrField k_cfg_json[] = {
+    N(ANCHOR_ID,  JF_U32, 0, 0xFFFFFFFF),
+    N(BIAS_TICKS, JF_I32, INT32_MIN, INT32_MAX),
+    N(HB_MS,      JF_U16, 0, 0xFFFF),
+    N(LOG_LEVEL,  JF_U8,  0, 0xFF),
+    N(NETWORK_ID, JF_U16, 0, 0xFFFF),
+    N(PHY_CH,     JF_U8,  5, 9),                     // DW3000: 5 / 9
+    N(PHY_SFDTO,  JF_U16, 0, 0xFFFF),
+    N(RX_ANT_DLY, JF_I32, INT32_MIN, INT32_MAX),
+    N(TX_ANT_DLY, JF_I32, INT32_MIN, INT32_MAX),
+    N(ZONE_ID,    JF_U16, 0, 0xFFFF),
+};
+#undef N
+const uint8_t k_cfg_json_n=sizeof(k_cfg_json)/sizeof(k_cfg_json[0]);
+
+/* ================= Snapshot diff + SET csomagolás ================= */
+static int field_by_tag(uint8_t tag){
+    for(uint8_t f=0;f<CFG_NFIELDS;f++) if(k_cfg_fields[f].tag==tag) return f;
+    return -1;
+}
+
+uint16_t cfg_from_tlv(const uint8_t* p, uint16_t n, EspCfg& c){
+    uint16_t m=0;
+    tlv_cur_t cur; tlv_t t;
+    tlv_cur_init(&cur,p,n);
+    while(tlv_next(&cur,&t)==TLV_ITEM){
+        int f=field_by_tag(t.tag);
+        if(f<0 || !tlv_width_ok(&t)) continue;
+        cfg_set(c,(uint8_t)f,tlv_u32(&t));
+        m|=CFG_M(f);
+    }
+    return m;
+}
+
+uint16_t cfg_diff(const EspCfg& have, uint16_t have_mask, const EspCfg& want, uint16_t want_mask){
+    uint16_t d=0;
+    for(uint8_t f=0;f<CFG_NFIELDS;f++){
+        if(!(want_mask & CFG_M(f))) continue;
+        if(!(have_mask & CFG_M(f)) || cfg_get(have,f)!=cfg_get(want,f)) d|=CFG_M(f);
+    }
+    return d;
+}
+
+/* a mezők 3..6 B-osak, a mohó kitöltés legfeljebb 5 B-ot hagy írásonként;
+   done==0 → cap a legkisebb mezőnél is kisebb */
+uint16_t cfg_pack_next(const EspCfg& want, uint16_t* todo, uint8_t* buf, uint16_t cap, uint16_t* len){
+    tlv_wr_t w; tlv_wr_init(&w,buf,cap);
+    uint16_t done=0;
+    for(uint8_t f=0;f<CFG_NFIELDS;f++){
+        if(!(*todo & CFG_M(f))) continue;
+        if(!tlv_put(&w,k_cfg_fields[f].tag,cfg_get(want,f))) continue;  // nem fér: következő írásba
+        done|=CFG_M(f);
+    }
+    *todo&=~done;
+    *len=w.len;
+    return done;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+/* ================= ESP config JSON (UI tükör) =================
+   Csak szöveg- / TLV-feldolgozás: nincs httpd / ESP hívás, host-on is fordul. */
+
+struct EspCfg {
+    uint16_t NETWORK_ID = 1;
+    uint16_t ZONE_ID    = 0x5A31;
+    uint32_t ANCHOR_ID  = 0x00000001;
+    uint16_t HB_MS      = 10000;
+    uint8_t  LOG_LEVEL  = 1;
+    int32_t  TX_ANT_DLY = 0;
+    int32_t  RX_ANT_DLY = 0;
+    int32_t  BIAS_TICKS = 0;
+    uint8_t  PHY_CH     = 9;
+    uint16_t PHY_SFDTO  = 248;
+};
+
+/* mezők sorrendje = bitmaszk bitjei (CFG_M(f)) */
+enum CfgFieldId : uint8_t {
+    CFG_F_NETWORK_ID = 0, CFG_F_ZONE_ID, CFG_F_ANCHOR_ID, CFG_F_HB_MS, CFG_F_LOG_LEVEL,
+    CFG_F_TX_ANT_DLY, CFG_F_RX_ANT_DLY, CFG_F_BIAS_TICKS, CFG_F_PHY_CH, CFG_F_PHY_SFDTO,
+    CFG_NFIELDS
+};
+#define CFG_M(f)  ((uint16_t)(1u<<(f)))
+
+struct CfgField {
+    const char* name;       // JSON kulcs = TLV név
+    uint8_t     tag;        // TLV tag
+    uint8_t     off, size;  // EspCfg-n belül
+};
+extern const CfgField k_cfg_fields[CFG_NFIELDS];
+
+uint32_t cfg_get(const EspCfg& c, uint8_t f);          // nyers bitek (előjeles mezőnél is)
+void     cfg_set(EspCfg& c, uint8_t f, uint32_t v);
+
+struct JsonW;
+void cfg_json_write(JsonW& w, const EspCfg& c);      // egy JSON objektum
+/* POST body → EspCfg (json_in): csak a body-ban szereplő kulcsok íródnak,
+   a JsonR.set a CFG_M maszk */
+struct JrField;
+extern const JrField k_cfg_json[];
+extern const uint8_t k_cfg_json_n;
+
+/* TLV folyam (GET snapshot) → EspCfg; visszaad: megtalált mezők maszkja */
+uint16_t cfg_from_tlv(const uint8_t* p, uint16_t n, EspCfg& c);
+/* eltérő (vagy a snapshotban hiányzó) kért mezők */
+uint16_t cfg_diff(const EspCfg& have, uint16_t have_mask, const EspCfg& want, uint16_t want_mask);
+/* a *todo maszk mezőiből annyit kódol buf-ba (mezősorrendben), amennyi cap-be fér;
+   a kódolt mezőket törli *todo-ból és visszaadja; *len = kódolt hossz */
+uint16_t cfg_pack_next(const EspCfg& want, uint16_t* todo, uint8_t* buf, uint16_t cap, uint16_t* len);
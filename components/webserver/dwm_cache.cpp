@@ -0,0 +1,160 @@
+// components/webserver/dwm_cache.cpp — req_id-párosított, verziózott DWM GET cache
+#include <cstring>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "ble.h"
+#include "uwb_frame.h"
+#include "metrics.h"
+#include "dwm_cache.hpp"
+
+static const char* TAG = "DWM";
+
+#define EV_DONE(l)  (1u<<(l))  // az adott linken nincs futó GET (lezárult vagy hibás)
+
+struct DwmLink {
+    DwmSnapshot        snap;   // utolsó teljes snapshot
+    DwmSnapshot        stage;  // épülő snapshot (futó GET)
+    bool               inflight;
+    bool               acked;
+    int64_t            t_req_us;   // GET küldés ideje (RTT)
+    int64_t            due_us;     // az utolsó rearm lejárata
+    esp_timer_handle_t tmr;
+};
+
+static SemaphoreHandle_t  s_mx;
+static EventGroupHandle_t s_ev;
+static DwmLink            s_link[BLE_MAX_LINKS];
+
+/* hívó fogja s_mx-et */
+static void finish_locked(uint8_t l, bool ok){
+    DwmLink& L = s_link[l];
+    if(ok){
+        L.stage.t_us = esp_timer_get_time();
+        L.stage.version = L.snap.version + 1;
+        metric_observe(H_DWM_GET_RTT_MS, (uint32_t)((L.stage.t_us - L.t_req_us)/1000));
+        memcpy(&L.snap, &L.stage, sizeof(L.snap));
+    } else {
+        ESP_LOGW(TAG,"[%u] GET req=%u: no ACK", (unsigned)l, (unsigned)L.stage.req_id);
+        metric_inc(M_DWM_GET_TIMEOUT);
+    }
+    L.inflight = false;
+    xEventGroupSetBits(s_ev, EV_DONE(l));
+}
+
+/* ACK-timeout és csendes ablak ugyanazzal a one-shot timerrel (linkenként).
+   Az esp_timer_stop a már kiadott, s_mx-re váró hívást nem vonja vissza:
+   ha közben rearm volt (pl. az ACK a timeouttal egy időben jött), a régi
+   hívás due_us előtt fut → eldobjuk, az új lejárat zár. */
+static void tmr_cb(void* arg){
+    uint8_t l = (uint8_t)(uintptr_t)arg;
+    xSemaphoreTake(s_mx, portMAX_DELAY);
+    DwmLink& L = s_link[l];
+    if(L.inflight && esp_timer_get_time() >= L.due_us) finish_locked(l, L.acked);
+    xSemaphoreGive(s_mx);
+}
+
+/* hívó fogja s_mx-et */
+static void rearm(uint8_t l, uint32_t ms){
+    esp_timer_stop(s_link[l].tmr);
+    s_link[l].due_us = esp_timer_get_time() + (int64_t)ms*1000;
+    esp_timer_start_once(s_link[l].tmr, (uint64_t)ms*1000ULL);
+}
+
+esp_err_t dwm_cache_init(){
+    if(s_mx) return ESP_OK;
+    s_mx = xSemaphoreCreateMutex();
+    s_ev = xEventGroupCreate();
+    if(!s_mx || !s_ev) return ESP_ERR_NO_MEM;
+    for(uint8_t l=0;l<BLE_MAX_LINKS;l++){
+        xEventGroupSetBits(s_ev, EV_DONE(l));
+        esp_timer_create_args_t a{};
+        a.callback = tmr_cb; a.arg = (void*)(uintptr_t)l; a.name = "dwm_get";
+        esp_err_t er = esp_timer_create(&a, &s_link[l].tmr);
+        if(er != ESP_OK) return er;
+    }
+    return ESP_OK;
+}
+
+void dwm_cache_on_notify(uint8_t link, const uint8_t* p, uint16_t n, bool from_cfg){
+    if(!s_mx || link>=BLE_MAX_LINKS || !from_cfg || !p || n==0) return;
+    if(n>=2 && p[0]==1 && p[1]==0x90) return;          // STATE
+    uwb_cfg_t c;
+    const uwb_cfg_kind_t k = uwb_cfg_decode(p,n,&c);
+    if(k==UWB_CFG_HB) return;                          // HB nem része a snapshotnak
+
+    DwmLink& L = s_link[link];
+    xSemaphoreTake(s_mx, portMAX_DELAY);
+    if(L.inflight){
+        if(k==UWB_CFG_ACK){
+            if(c.ack.req_id==L.stage.req_id){
+                L.acked = true;
+                L.stage.ack_status  = c.ack.status;
+                L.stage.ack_applied = c.ack.applied;
+                rearm(link, DWM_QUIET_MS);
+            }
+        } else if(L.stage.len + n <= DWM_SNAP_MAX && L.stage.nframes < DWM_SNAP_FRAMES){
+            memcpy(L.stage.bytes + L.stage.len, p, n);
+            L.stage.len += n;
+            L.stage.frames[L.stage.nframes++] = DwmFrame{from_cfg, n};
+            if(L.acked) rearm(link, DWM_QUIET_MS);
+        } else {
+            ESP_LOGW(TAG,"[%u] snapshot full, frame len=%u dropped",(unsigned)link,(unsigned)n);
+        }
+    }
+    xSemaphoreGive(s_mx);
+}
+
+/* hívó fogja s_mx-et */
+static esp_err_t start_get_locked(uint8_t l){
+    DwmLink& L = s_link[l];
+    if(L.inflight) return ESP_OK;
+    memset(&L.stage, 0, sizeof(L.stage));
+    L.stage.req_id = ble_next_req_id();
+    L.acked = false;
+    esp_err_t er = ble_send_get_ex(l, L.stage.req_id, BLE_WR_NO_RSP);   // idempotens; az ACK a nyugta
+    if(er != ESP_OK) return er;
+    metric_inc(M_DWM_GET);
+    L.t_req_us = esp_timer_get_time();
+    L.inflight = true;
+    xEventGroupClearBits(s_ev, EV_DONE(l));
+    rearm(l, DWM_ACK_TIMEOUT_MS);
+    return ESP_OK;
+}
+
+esp_err_t dwm_cache_get(uint8_t link, DwmSnapshot* out, uint32_t max_age_ms, uint32_t timeout_ms){
+    if(!s_mx) return ESP_ERR_INVALID_STATE;
+    if(link>=BLE_MAX_LINKS) return ESP_ERR_INVALID_ARG;
+    DwmLink& L = s_link[link];
+    const int64_t t0 = esp_timer_get_time();
+
+    xSemaphoreTake(s_mx, portMAX_DELAY);
+    const uint32_t v0 = L.snap.version;
+    if(v0 && (t0 - L.snap.t_us) <= (int64_t)max_age_ms*1000){
+        memcpy(out, &L.snap, sizeof(*out));
+        xSemaphoreGive(s_mx);
+        metric_inc(M_DWM_CACHE_HIT);
+        return ESP_OK;
+    }
+    esp_err_t er = start_get_locked(link);
+    xSemaphoreGive(s_mx);
+    if(er != ESP_OK) return er;                        // ble_send_get_ex hibája változatlanul
+
+    /* a lezárást esemény jelzi, nincs pollozás */
+    xEventGroupWaitBits(s_ev, EV_DONE(link), pdFALSE, pdFALSE, pdMS_TO_TICKS(timeout_ms));
+
+    xSemaphoreTake(s_mx, portMAX_DELAY);
+    er = (L.snap.version != v0) ? ESP_OK : ESP_ERR_TIMEOUT;
+    if(er == ESP_OK) memcpy(out, &L.snap, sizeof(*out));
+    xSemaphoreGive(s_mx);
+    return er;
+}
+
+void dwm_cache_invalidate(uint8_t link){
+    if(!s_mx || link>=BLE_MAX_LINKS) return;
+    xSemaphoreTake(s_mx, portMAX_DELAY);
+    s_link[link].snap.t_us = INT64_MIN/2;     // bármely max_age-nél régebbi
+    xSemaphoreGive(s_mx);
+}
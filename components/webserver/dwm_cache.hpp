@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+#include "esp_err.h"
+
+/* ================= DWM GET snapshot cache =================
+   Anchoronként (BLE link) külön cache; linkenként legfeljebb egy GET fut.
+   Az ACK-ot a req_id alapján
+   párosítjuk, a snapshot a TLV-folyam utáni csendes ablak végén (esp_timer)
+   zárul le. Az olvasók a verziózott cache-ből kapnak másolatot. */
+
+#define DWM_SNAP_MAX        1024
+#define DWM_SNAP_FRAMES     16
+#define DWM_CACHE_TTL_MS    2000
+#define DWM_ACK_TIMEOUT_MS  800
+#define DWM_QUIET_MS        150
+
+struct DwmFrame { bool from_cfg; uint16_t len; };
+
+struct DwmSnapshot {
+    uint32_t version;          // 0 = még nincs snapshot
+    int64_t  t_us;             // lezárás ideje
+    uint16_t req_id;
+    uint8_t  ack_status;
+    uint8_t  ack_applied;
+    uint16_t len;
+    uint8_t  nframes;
+    DwmFrame frames[DWM_SNAP_FRAMES];
+    uint8_t  bytes[DWM_SNAP_MAX];
+};
+
+esp_err_t dwm_cache_init();
+
+/* ble_rx task hívja minden notify-ra */
+void dwm_cache_on_notify(uint8_t link, const uint8_t* p, uint16_t n, bool from_cfg);
+
+/* Snapshot másolása. Ha a cache max_age_ms-nél régebbi, GET-et indít (vagy
+   a már futóra vár) legfeljebb timeout_ms-ig.
+   ESP_ERR_INVALID_ARG: ismeretlen link, ESP_ERR_INVALID_STATE: nincs BLE kapcsolat,
+   ESP_ERR_NO_MEM: tele a BLE írási sor, ESP_ERR_TIMEOUT: nincs ACK/adat.
+   A GET indításának egyéb hibái (ble_send_get_ex) változatlanul jönnek vissza. */
+esp_err_t dwm_cache_get(uint8_t link, DwmSnapshot* out, uint32_t max_age_ms, uint32_t timeout_ms);
+
+/* a következő dwm_cache_get friss GET-et indít (pl. SET után) */
+void dwm_cache_invalidate(uint8_t link);
@@ -0,0 +1,81 @@
+// components/webserver/http_async.cpp — BLE-re váró handlerek worker poolban
+#include <cstdio>
+#include "http_async.hpp"
+#include "auth.hpp"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "metrics.h"
+
+static const char* TAG = "HTTP_ASYNC";
+
+struct Job { httpd_req_t* req; http_async_fn fn; user_role_t role; int64_t t_q; };
+
+static QueueHandle_t s_q;
+static portMUX_TYPE  s_mux = portMUX_INITIALIZER_UNLOCKED;
+static HttpAsyncStats s_st;
+
+static void worker(void*){
+    Job j;
+    for(;;){
+        if(xQueueReceive(s_q,&j,portMAX_DELAY)!=pdTRUE) continue;
+        const int64_t t0=esp_timer_get_time();
+        metric_observe(H_HTTP_QUEUE_MS,(uint32_t)((t0-j.t_q)/1000));
+        esp_err_t er=j.fn(j.req,j.role);
+        metric_observe(H_HTTP_ASYNC_MS,(uint32_t)((esp_timer_get_time()-t0)/1000));
+        metric_inc(M_HTTP_REQ);
+        if(er!=ESP_OK) metric_inc(M_HTTP_ERR);
+        httpd_req_async_handler_complete(j.req);    // socket vissza a httpd-nek
+        portENTER_CRITICAL(&s_mux); s_st.queued--; portEXIT_CRITICAL(&s_mux);
+        metric_gauge_add(G_HTTP_ASYNC_QUEUED,-1);
+    }
+}
+
+esp_err_t http_async_init(){
+    if(s_q) return ESP_OK;
+    s_q=xQueueCreate(HTTP_ASYNC_QUEUE,sizeof(Job));
+    if(!s_q) return ESP_ERR_NO_MEM;
+    for(int i=0;i<HTTP_ASYNC_WORKERS;i++){
+        char name[12]; snprintf(name,sizeof(name),"http_w%d",i);
+        if(xTaskCreate(worker,name,HTTP_ASYNC_STACK,nullptr,HTTP_ASYNC_PRIO,nullptr)!=pdPASS) return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t busy(httpd_req_t* req){
+    metric_inc(M_HTTP_BUSY);
+    portENTER_CRITICAL(&s_mux); s_st.busy++; portEXIT_CRITICAL(&s_mux);
+    httpd_resp_set_status(req,"503 Service Unavailable");
+    httpd_resp_set_hdr(req,"Retry-After",HTTP_RETRY_AFTER_S);
+    return httpd_resp_sendstr(req,"busy");
+}
+
+/* httpd taskon: hitelesítés, másolat + sorba tétel, nem blokkol */
+esp_err_t http_async_entry(httpd_req_t* req){
+    const HttpAsyncRoute* rt=(const HttpAsyncRoute*)req->user_ctx;
+    user_role_t role;
+    if(!require_role(req,rt->need,&role)){ metric_inc(M_HTTP_REQ); metric_inc(M_HTTP_ERR); return ESP_FAIL; }
+    if(!s_q) return busy(req);
+    httpd_req_t* copy=nullptr;
+    if(httpd_req_async_handler_begin(req,&copy)!=ESP_OK) return busy(req);
+    const Job j{copy,rt->fn,role,esp_timer_get_time()};
+    portENTER_CRITICAL(&s_mux);
+    s_st.queued++; if(s_st.queued>s_st.high) s_st.high=s_st.queued;
+    portEXIT_CRITICAL(&s_mux);
+    metric_gauge_add(G_HTTP_ASYNC_QUEUED,1);           // a worker előbb is végezhet
+    if(xQueueSend(s_q,&j,0)!=pdTRUE){
+        portENTER_CRITICAL(&s_mux); s_st.queued--; portEXIT_CRITICAL(&s_mux);
+        metric_gauge_add(G_HTTP_ASYNC_QUEUED,-1);
+        httpd_req_async_handler_complete(copy);
+        ESP_LOGW(TAG,"queue full: %s",req->uri);
+        return busy(req);
+    }
+    portENTER_CRITICAL(&s_mux); s_st.submitted++; portEXIT_CRITICAL(&s_mux);
+    return ESP_OK;
+}
+
+void http_async_stats(HttpAsyncStats* out){
+    portENTER_CRITICAL(&s_mux); *out=s_st; portEXIT_CRITICAL(&s_mux);
+}
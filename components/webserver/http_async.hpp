@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include "esp_err.h"
+#include "esp_http_server.h"
+#include "webserver.hpp"
+
+/* ================= Aszinkron handlerek (worker pool) =================
+   A BLE-re váró handlerek (dwm_get, config POST: akár ~2.3 s) nem a httpd
+   taskon futnak: httpd_req_async_handler_begin másolatot ad a kérésről,
+   az egy korlátos sorba kerül, a workerek ott futtatják az eredeti handlert.
+   Így a httpd task szabad marad a gyors végpontoknak (oldalak, status, login).
+   Tele sornál 503 + Retry-After.
+   Hitelesítés a sorba tétel előtt, a httpd taskon (auth / session_store
+   zár nélkül, csak onnan hívható); a worker a szerepkört a Job-ban kapja.
+   Minden async kérés egy socketet tart nyitva a válaszig:
+   HTTP_ASYNC_WORKERS + HTTP_ASYNC_QUEUE < max_open_sockets kell maradjon. */
+
+#define HTTP_ASYNC_WORKERS   2
+#define HTTP_ASYNC_QUEUE     2
+#define HTTP_ASYNC_STACK     8192      // DWM snapshot másolat a handler stacken
+#define HTTP_ASYNC_PRIO      5         // = httpd task
+#define HTTP_RETRY_AFTER_S   "1"
+
+struct HttpAsyncStats {
+    uint32_t queued;          // sorban + futó
+    uint32_t submitted, busy; // busy: 503-mal visszautasítva
+    uint32_t high;            // queued csúcs
+};
+
+esp_err_t http_async_init();
+/* a workeren futó handler; role: a httpd taskon már ellenőrzött (≥ need) */
+typedef esp_err_t (*http_async_fn)(httpd_req_t* req, user_role_t role);
+struct HttpAsyncRoute { http_async_fn fn; user_role_t need; };
+
+/* uri handlerként regisztrálandó, user_ctx: const HttpAsyncRoute* (ld. reg_async) */
+esp_err_t http_async_entry(httpd_req_t* req);
+void      http_async_stats(HttpAsyncStats* out);
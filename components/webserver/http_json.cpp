@@ -0,0 +1,40 @@
+// components/webserver/http_json.cpp — JsonR / JsonW a httpd kérésen (lásd http_json.hpp)
+#include <cstdio>
+#include "http_json.hpp"
+
+/* ================= POST body ================= */
+esp_err_t recv_json(httpd_req_t* req, JsonR& r, const JrField* tab, uint8_t ntab, void* dst){
+    jr_init(r,tab,ntab,dst);
+    int left=req->content_len;
+    if(left<=0) { httpd_resp_send_err(req,HTTPD_400_BAD_REQUEST,"empty"); return ESP_FAIL; }
+    if(left>BODY_MAX){ httpd_resp_send_err(req,HTTPD_400_BAD_REQUEST,"too long"); return ESP_FAIL; }
+    char b[128];
+    while(left>0){
+        const int k=httpd_req_recv(req,b,left<(int)sizeof(b)?left:(int)sizeof(b));
+        if(k<=0){ httpd_resp_send_err(req,HTTPD_500_INTERNAL_SERVER_ERROR,"recv"); return ESP_FAIL; }
+        left-=k;
+        if(!jr_feed(r,b,k)) break;                      // a maradékot a httpd eldobja
+    }
+    if(!jr_end(r)){ httpd_resp_send_err(req,HTTPD_400_BAD_REQUEST,"bad json"); return ESP_FAIL; }
+    if(r.bad){
+        char m[48]; snprintf(m,sizeof(m),"%s: %s",jr_bad_key(r),jr_err_str(r.err));
+        httpd_resp_send_err(req,HTTPD_400_BAD_REQUEST,m); return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+/* ================= JSON válaszok ================= */
+void resp_chunk(void* ctx, const char* s, size_t n){
+    httpd_resp_send_chunk((httpd_req_t*)ctx, s, n);
+}
+bool resp_chunk_ok(void* ctx, const char* s, size_t n){
+    return httpd_resp_send_chunk((httpd_req_t*)ctx, s, n)==ESP_OK;
+}
+void json_begin(httpd_req_t* req, JsonW& w){
+    httpd_resp_set_type(req,"application/json");
+    jw_init(w,resp_chunk,req);
+}
+esp_err_t json_end(httpd_req_t* req, JsonW& w){
+    jw_finish(w);
+    return httpd_resp_send_chunk(req,nullptr,0);
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include "esp_err.h"
+#include "esp_http_server.h"
+#include "json_in.hpp"
+#include "json_out.hpp"
+
+/* ================= JSON a httpd-n =================
+   POST body darabonként a json_in-be (heap és teljes body másolat nélkül),
+   válasz a JsonW-n át chunked: a handler stackjén egy JW_BUF puffer. */
+
+#define BODY_MAX   2048
+
+/* hibánál a választ is elküldi (ESP_FAIL) */
+esp_err_t recv_json(httpd_req_t* req, JsonR& r, const JrField* tab, uint8_t ntab, void* dst);
+
+void      resp_chunk(void* ctx, const char* s, size_t n);   // jw_sink_t / metrics_emit_t
+bool      resp_chunk_ok(void* ctx, const char* s, size_t n); // false: küldési hiba (blog_emit_t)
+void      json_begin(httpd_req_t* req, JsonW& w);
+esp_err_t json_end(httpd_req_t* req, JsonW& w);
@@ -2,6 +2,7 @@
 #include "esp_http_server.h"
 #include "cJSON.h"
 #include "ble.h"        // ble_send_get, ble_register_notify_cb
+#include "tlv.h"
 #include "freertos/semphr.h"
 
 static SemaphoreHandle_t s_sem_ack, s_sem_tlv;
@@ -18,9 +19,9 @@ static struct {
     bool     have[11];
 } s_cfg;
 
-static void on_ble_notify(const uint8_t* p, uint16_t n, bool from_cfg)
+static void on_ble_notify(uint8_t link, const uint8_t* p, uint16_t n, bool from_cfg)
 {
-    if(!from_cfg || !p || n<1) return;
+    if(link!=0 || !from_cfg || !p || n<1) return;
 
     // ACK: [1,0x81,req_hi,req_lo,status,applied]
     if(n==6 && p[0]==1 && p[1]==0x81){
@@ -31,26 +32,23 @@ static void on_ble_notify(const uint8_t* p, uint16_t n, bool from_cfg)
     }
 
     // TLV blokkok
-    const uint8_t* q=p; uint16_t r=n; bool first=true;
-    while(r>=2){
-        uint8_t t=q[0], l=q[1]; q+=2; r-=2;
-        if(r<l) break;
-        if(first && t==0x00){ first=false; q+=l; r-=l; continue; } // T_VER skip
-
-        switch(t){
-            case 0x10: if(l==2){ s_cfg.network_id=(q[0]<<8)|q[1]; s_cfg.have[0]=true; } break;
-            case 0x11: if(l==2){ s_cfg.zone_id   =(q[0]<<8)|q[1]; s_cfg.have[1]=true; } break;
-            case 0x12: if(l==4){ s_cfg.anchor_id =(q[0]<<24)|(q[1]<<16)|(q[2]<<8)|q[3]; s_cfg.have[2]=true; } break;
-            case 0x20: if(l==2){ s_cfg.hb_ms     =(q[0]<<8)|q[1]; s_cfg.have[3]=true; } break;
-            case 0x1F: if(l==1){ s_cfg.log_level = q[0];           s_cfg.have[4]=true; } break;
-            case 0x13: if(l==4){ s_cfg.tx_ant_dly=(int32_t)((q[0]<<24)|(q[1]<<16)|(q[2]<<8)|q[3]); s_cfg.have[5]=true; } break;
-            case 0x14: if(l==4){ s_cfg.rx_ant_dly=(int32_t)((q[0]<<24)|(q[1]<<16)|(q[2]<<8)|q[3]); s_cfg.have[6]=true; } break;
-            case 0x16: if(l==4){ s_cfg.bias_ticks=(int32_t)((q[0]<<24)|(q[1]<<16)|(q[2]<<8)|q[3]); s_cfg.have[7]=true; } break;
-            case 0x40: if(l==1){ s_cfg.phy_ch     = q[0];           s_cfg.have[8]=true; } break;
-            case 0x49: if(l==2){ s_cfg.phy_sfdto  =(q[0]<<8)|q[1]; s_cfg.have[9]=true; } break;
+    tlv_cur_t cur; tlv_t t;
+    tlv_cur_init(&cur, p, n);
+    while(tlv_next(&cur, &t)==TLV_ITEM){
+        if(!tlv_width_ok(&t)) continue;
+        switch(t.tag){
+            case T_NETWORK_ID: s_cfg.network_id=tlv_u32(&t); s_cfg.have[0]=true; break;
+            case T_ZONE_ID:    s_cfg.zone_id   =tlv_u32(&t); s_cfg.have[1]=true; break;
+            case T_ANCHOR_ID:  s_cfg.anchor_id =tlv_u32(&t); s_cfg.have[2]=true; break;
+            case T_HB_MS:      s_cfg.hb_ms     =tlv_u32(&t); s_cfg.have[3]=true; break;
+            case T_LOG_LEVEL:  s_cfg.log_level =tlv_u32(&t); s_cfg.have[4]=true; break;
+            case T_TX_ANT_DLY: s_cfg.tx_ant_dly=tlv_i32(&t); s_cfg.have[5]=true; break;
+            case T_RX_ANT_DLY: s_cfg.rx_ant_dly=tlv_i32(&t); s_cfg.have[6]=true; break;
+            case T_BIAS_TICKS: s_cfg.bias_ticks=tlv_i32(&t); s_cfg.have[7]=true; break;
+            case T_PHY_CH:     s_cfg.phy_ch    =tlv_u32(&t); s_cfg.have[8]=true; break;
+            case T_PHY_SFDTO:  s_cfg.phy_sfdto =tlv_u32(&t); s_cfg.have[9]=true; break;
             default: break;
         }
-        q+=l; r-=l;
     }
 
     // Heuriszta: ha sok mező bejött, engedjük tovább a HTTP választ
@@ -66,7 +64,7 @@ static esp_err_t dwm_get_handler(httpd_req_t* req)
 
     // BLE GET
     s_last_req++;
-    ble_send_get(s_last_req);
+    ble_send_get(0, s_last_req);
 
     // ACK várakozás
     if(xSemaphoreTake(s_sem_ack, pdMS_TO_TICKS(1500))!=pdTRUE){
@@ -0,0 +1,297 @@
+// components/webserver/json_in.cpp — streaming JSON body olvasó, rendezett kulcstáblával
+#include <cstring>
+#include "json_in.hpp"
+
+enum : uint8_t { S_BEGIN, S_KEY0, S_KEYN, S_KEY, S_COLON, S_VAL, S_VSTR, S_VNUM, S_VLIT, S_SKIP, S_AFTER, S_DONE, S_ERR };
+#define VN_OVF  0xFF          // val túlcsordult (JF_STR: JR_TRUNC, szám: JR_RANGE)
+
+static inline bool ws(char c){ return c==' '||c=='\t'||c=='\n'||c=='\r'; }
+static inline int  hexv(char c){
+    if(c>='0'&&c<='9') return c-'0';
+    if(c>='a'&&c<='f') return c-'a'+10;
+    if(c>='A'&&c<='F') return c-'A'+10;
+    return -1;
+}
+
+void jr_init(JsonR& r, const JrField* tab, uint8_t ntab, void* dst){
+    memset(&r,0,sizeof(r));
+    r.tab=tab; r.ntab=ntab; r.dst=dst;
+    r.st=S_BEGIN; r.field=-1;
+}
+
+static bool fail(JsonR& r){ r.st=S_ERR; r.err=JR_SYNTAX; return false; }
+static void bad(JsonR& r, uint8_t e){ r.bad|=1u<<r.tab[r.field].bit; if(!r.err) r.err=e; }
+
+/* rövid kulcsokra a könyvtári strcmp hívása drágább, mint maga az összevetés */
+static inline int kcmp(const char* a, const char* b){
+    while(*a && *a==*b){ a++; b++; }
+    return (unsigned char)*a-(unsigned char)*b;
+}
+
+/* rendezett tábla: bináris keresés */
+static int8_t lookup(const JsonR& r){
+    if(r.kn==VN_OVF) return -1;
+    int lo=0, hi=r.ntab-1;
+    while(lo<=hi){
+        const int m=(lo+hi)>>1;
+        const int c=kcmp(r.key,r.tab[m].key);
+        if(!c) return (int8_t)m;
+        if(c<0) hi=m-1; else lo=m+1;
+    }
+    return -1;
+}
+
+static inline void put_val(JsonR& r, char c){
+    if(r.vn==VN_OVF) return;
+    if(r.vn<JR_VAL_MAX-1) r.val[r.vn++]=c; else r.vn=VN_OVF;
+}
+static inline bool str_ch(char c){ return c!='"' && c!='\\' && (unsigned char)c>=0x20; }
+static inline bool num_ch(char c){ return (c>='0'&&c<='9')||c=='.'||c=='e'||c=='E'||c=='+'||c=='-'; }
+static inline bool lit_ch(char c){ return c>='a'&&c<='z'; }
+
+/* az ok() karakterek futása, közben dst-be másolva (túl hosszú: n=VN_OVF);
+   visszaad: a futás vége */
+template<bool (*ok)(char)>
+static inline const char* run_copy(const char* p, const char* e, char* dst, uint8_t& n, uint8_t cap){
+    for(;p<e && ok(*p);p++){
+        if(n==VN_OVF) continue;
+        if(n<cap-1) dst[n++]=*p; else n=VN_OVF;
+    }
+    return p;
+}
+
+/* JSON szám alak: -?d+(.d+)?([eE][+-]?d+)?; 0: hibás, 1: egész, 2: tört / exponens */
+static int num_shape(const char* p, const char* e){
+    if(p<e && *p=='-') p++;
+    const char* d=p; while(p<e && *p>='0'&&*p<='9') p++;
+    if(p==d) return 0;
+    if(p==e) return 1;
+    if(*p=='.'){ d=++p; while(p<e && *p>='0'&&*p<='9') p++; if(p==d) return 0; }
+    if(p<e && (*p=='e'||*p=='E')){
+        if(++p<e && (*p=='+'||*p=='-')) p++;
+        d=p; while(p<e && *p>='0'&&*p<='9') p++; if(p==d) return 0;
+    }
+    return p==e?2:0;
+}
+
+/* "123" / "-5" decimálisan, idézőjelesen hexa ("0x1F", "-1F").
+   Tört / exponens (1.5, 1e3) nem egész: JR_RANGE, akkor is, ha egész értékű. */
+static uint8_t parse_num(const JsonR& r, int64_t& out){
+    if(r.vn==VN_OVF) return JR_RANGE;
+    const char* p=r.val; const char* e=r.val+r.vn;
+    const bool neg=(p<e && *p=='-'); if(neg) p++;
+    const unsigned base=r.quoted?16:10;
+    if(r.quoted && e-p>2 && p[0]=='0' && (p[1]=='x'||p[1]=='X')) p+=2;
+    if(p==e) return JR_TYPE;
+    if(r.frac) return JR_RANGE;                          // alak: S_VNUM (num_shape)
+    uint64_t v=0;
+    for(;p<e;p++){
+        const int d=(base==16)?hexv(*p):((*p>='0'&&*p<='9')?*p-'0':-1);
+        if(d<0) return JR_TYPE;
+        v=v*base+(unsigned)d;
+        if(v>0xFFFFFFFFull) return JR_RANGE;
+    }
+    out=neg?-(int64_t)v:(int64_t)v;
+    return JR_OK;
+}
+
+static void apply(JsonR& r){
+    if(r.field<0) return;
+    const JrField& f=r.tab[r.field];
+    uint8_t* d=(uint8_t*)r.dst+f.off;
+    if(r.u_bad){ bad(r,JR_CHAR); return; }
+    if(f.type==JF_STR){
+        if(!r.quoted){ bad(r,JR_TYPE); return; }
+        if(r.vn==VN_OVF || r.vn>=f.cap){ bad(r,JR_TRUNC); return; }
+        memcpy(d,r.val,r.vn); d[r.vn]=0;
+    } else if(f.type==JF_BOOL){
+        bool b;
+        if(!r.quoted && r.vn==4 && !memcmp(r.val,"true",4))  b=true;
+        else if(!r.quoted && r.vn==5 && !memcmp(r.val,"false",5)) b=false;
+        else if(!r.quoted && r.vn==1 && (r.val[0]=='0'||r.val[0]=='1')) b=(r.val[0]=='1');
+        else { bad(r,JR_TYPE); return; }
+        *(bool*)d=b;
+    } else {
+        int64_t v;
+        if(r.lit){ bad(r,JR_TYPE); return; }
+        const uint8_t e=parse_num(r,v);
+        if(e){ bad(r,e); return; }
+        if(v<f.min || v>f.max){ bad(r,JR_RANGE); return; }
+        switch(f.type){
+        case JF_U8:  *d=(uint8_t)v; break;
+        case JF_U16: { uint16_t x=(uint16_t)v; memcpy(d,&x,2); } break;
+        case JF_U32: { uint32_t x=(uint32_t)v; memcpy(d,&x,4); } break;
+        default:     { int32_t  x=(int32_t)v;  memcpy(d,&x,4); } break;
+        }
+    }
+    r.set|=1u<<f.bit;
+}
+
+static inline const char* str_run(const char* p, const char* e){ while(p<e && str_ch(*p)) p++; return p; }
+
+/* A switch csak a darab elején folytat (a előző darab végén mentett
+   állapotból); azon belül az átmenetek közvetlen ugrások, és minden állapot
+   egy futásban halad (kulcs, string, szám, whitespace, átugrott érték).
+   A bájtonkénti állapotgép a régi strstr-es feldolgozás ~2x-ese volt. */
+#define GO(x, l)   do { st=(x); goto l; } while(0)
+#define SKIP_WS()  do { while(p<e && ws(*p)) p++; if(p==e) goto out; } while(0)
+#define FAIL()     do { r.pos+=(uint32_t)(p-s); return fail(r); } while(0)
+
+bool jr_feed(JsonR& r, const char* s, size_t n){
+    if(r.st==S_ERR) return false;
+    const char* p=s; const char* const e=s+n;
+    uint8_t st=r.st;
+    char c;
+    switch(st){
+    case S_BEGIN:
+        SKIP_WS();
+        if(*p!='{') FAIL();
+        p++; GO(S_KEY0,l_key0);
+    case S_KEY0:
+    l_key0:
+        SKIP_WS();
+        if(*p=='}'){ p++; GO(S_DONE,l_done); }
+        goto l_key_open;
+    case S_KEYN:
+    l_keyn:
+        SKIP_WS();
+    l_key_open:
+        if(*p!='"') FAIL();
+        p++; r.kn=0; r.esc=false; GO(S_KEY,l_key);
+    case S_KEY:
+    l_key:
+        for(;;){
+            if(p==e) goto out;
+            if(r.esc){ r.esc=false; r.kn=VN_OVF; p++; continue; }   // escape-elt kulcs: egyik sem
+            p=run_copy<str_ch>(p,e,r.key,r.kn,JR_KEY_MAX);
+            if(p==e) goto out;
+            if(*p=='\\'){ r.esc=true; p++; continue; }
+            if(*p!='"') FAIL();                                      // vezérlő karakter
+            break;
+        }
+        if(r.kn!=VN_OVF) r.key[r.kn]=0;
+        r.field=lookup(r); p++; GO(S_COLON,l_colon);
+    case S_COLON:
+    l_colon:
+        SKIP_WS();
+        if(*p!=':') FAIL();
+        p++; GO(S_VAL,l_val);
+    case S_VAL:
+    l_val:
+        SKIP_WS();
+        r.vn=0; r.quoted=false; r.lit=false; r.frac=false; r.u_bad=false;
+        c=*p;
+        if(c=='"'){ r.quoted=true; r.esc=false; r.u_left=0; p++; GO(S_VSTR,l_vstr); }
+        if(c=='{'||c=='['){
+            if(r.field>=0) bad(r,JR_TYPE);
+            r.depth=1; r.skip_str=false; r.esc=false; p++; GO(S_SKIP,l_skip);
+        }
+        if(c=='-'||(c>='0'&&c<='9')) GO(S_VNUM,l_vnum);
+        if(c>='a'&&c<='z'){ r.lit=true; GO(S_VLIT,l_vlit); }
+        FAIL();
+    case S_VSTR:
+    l_vstr:
+        for(;;){
+            if(p==e) goto out;
+            c=*p;
+            if(r.u_left){                                            // \uXXXX: ASCII (0x01..0x7F, a jw_str alakja), különben JR_CHAR
+                const int h=hexv(c); if(h<0) FAIL();
+                r.u_acc=(uint16_t)(r.u_acc<<4|h);
+                if(!--r.u_left){ if(r.u_acc>=0x01&&r.u_acc<0x80) put_val(r,(char)r.u_acc); else r.u_bad=true; }
+                p++; continue;
+            }
+            if(r.esc){
+                r.esc=false;
+                switch(c){
+                case '"': case '\\': case '/': put_val(r,c); break;
+                case 'n': put_val(r,'\n'); break;
+                case 't': put_val(r,'\t'); break;
+                case 'r': put_val(r,'\r'); break;
+                case 'b': put_val(r,'\b'); break;
+                case 'f': put_val(r,'\f'); break;
+                case 'u': r.u_left=4; r.u_acc=0; break;
+                default: FAIL();
+                }
+                p++; continue;
+            }
+            p=(r.field>=0)?run_copy<str_ch>(p,e,r.val,r.vn,JR_VAL_MAX):str_run(p,e);   // ismeretlen kulcs értéke nem másolódik
+            if(p==e) goto out;
+            if(*p=='\\'){ r.esc=true; p++; continue; }
+            if(*p!='"') FAIL();
+            break;
+        }
+        apply(r); p++; GO(S_AFTER,l_after);
+    case S_VNUM:
+    l_vnum:
+        p=run_copy<num_ch>(p,e,r.val,r.vn,JR_VAL_MAX);
+        if(p==e) goto out;
+        if(r.vn!=VN_OVF){
+            const int sh=num_shape(r.val,r.val+r.vn);
+            if(!sh) FAIL();                                          // "1-2", "1.", "-"
+            r.frac=(sh==2);
+        }
+        apply(r); GO(S_AFTER,l_after);
+    case S_VLIT:
+    l_vlit:
+        p=run_copy<lit_ch>(p,e,r.val,r.vn,JR_VAL_MAX);
+        if(p==e) goto out;
+        if(!(r.vn==4&&!memcmp(r.val,"true",4)) && !(r.vn==5&&!memcmp(r.val,"false",5))
+           && !(r.vn==4&&!memcmp(r.val,"null",4))) FAIL();
+        apply(r); GO(S_AFTER,l_after);
+    case S_SKIP:
+    l_skip:
+        while(p<e){
+            c=*p++;
+            if(r.skip_str){
+                if(r.esc) r.esc=false;
+                else if(c=='\\') r.esc=true;
+                else if(c=='"') r.skip_str=false;
+                continue;
+            }
+            if(c=='"') r.skip_str=true;
+            else if(c=='{'||c=='['){ if(++r.depth==0){ p--; FAIL(); } }
+            else if(c=='}'||c==']'){ if(!--r.depth) GO(S_AFTER,l_after); }
+        }
+        goto out;
+    case S_AFTER:
+    l_after:
+        SKIP_WS();
+        if(*p==','){ p++; GO(S_KEYN,l_keyn); }
+        if(*p=='}'){ p++; GO(S_DONE,l_done); }
+        FAIL();
+    case S_DONE:
+    l_done:
+        SKIP_WS();
+        FAIL();
+    default:
+        return false;
+    }
+out:
+    r.st=st; r.pos+=(uint32_t)n;
+    return true;
+}
+#undef GO
+#undef SKIP_WS
+#undef FAIL
+
+bool jr_end(JsonR& r){
+    if(r.st!=S_DONE){ fail(r); return false; }
+    return true;
+}
+
+const char* jr_err_str(uint8_t e){
+    switch(e){
+    case JR_OK:     return "ok";
+    case JR_SYNTAX: return "syntax";
+    case JR_RANGE:  return "range";
+    case JR_TYPE:   return "type";
+    case JR_TRUNC:  return "too long";
+    case JR_CHAR:   return "non-ascii \\u";
+    default:        return "?";
+    }
+}
+
+const char* jr_bad_key(const JsonR& r){
+    for(uint8_t i=0;i<r.ntab;i++) if(r.bad & (1u<<r.tab[i].bit)) return r.tab[i].key;
+    return nullptr;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+/* ================= Streaming JSON body olvasó =================
+   Egy menetben, darabonként etetve (httpd_req_recv pufferéből), heap nélkül.
+   Csak a gyökér objektum kulcsai számítanak: a kulcs a rendezett mezőtáblában
+   bináris kereséssel, az érték típusos setterrel + tartomány-ellenőrzéssel
+   kerül a cél struktúrába. Ismeretlen kulcs / beágyazott érték átugorva;
+   string értéken belüli "kulcs" nem találhat.
+   Számmezőn idézőjeles érték hexa ("0x1F" / "1F"), a régi UI formátum szerint;
+   csak egész: tört / exponens (1.5, 1e3) JR_RANGE, hibás alak ("1-2") JR_SYNTAX.
+   String: \uXXXX csak ASCII 0x01..0x7F (a jw_str vezérlő karakterei), \u0000
+   és a többi kódpont JR_CHAR; nyers UTF-8 bájtok változatlanul átmennek.
+   Nincs httpd / ESP hívás: host-on is fordul és fuzzolható. */
+
+#define JR_KEY_MAX   24       // leghosszabb ismert kulcs + 1
+#define JR_VAL_MAX   96       // szám / string érték (JF_STR kapacitása is legfeljebb ennyi: anchor lista)
+
+enum JrType : uint8_t { JF_U8, JF_U16, JF_U32, JF_I32, JF_BOOL, JF_STR };
+
+struct JrField {
+    const char* key;          // a táblában strcmp szerint növekvő sorrendben!
+    uint8_t     type;
+    uint8_t     bit;          // maszk bit (≤ 31)
+    uint16_t    off;          // cél struktúrán belül
+    uint16_t    cap;          // JF_STR: pufferméret (NUL-lal)
+    int64_t     min, max;     // számmezők tartománya
+};
+#define JR_NUM(s, m, t, b, lo, hi)  { #m, t, b, (uint16_t)offsetof(s, m), 0, lo, hi }
+#define JR_STR(s, m, b)             { #m, JF_STR, b, (uint16_t)offsetof(s, m), (uint16_t)sizeof(s::m), 0, 0 }
+
+enum JrErr : uint8_t { JR_OK = 0, JR_SYNTAX, JR_RANGE, JR_TYPE, JR_TRUNC, JR_CHAR };
+
+struct JsonR {
+    const JrField* tab; uint8_t ntab;
+    void*     dst;
+    uint32_t  set;            // beállított mezők
+    uint32_t  bad;            // típus / tartomány hibás mezők (nem íródtak)
+    uint8_t   err;            // első hiba (JrErr)
+    uint8_t   st;             // belső állapot
+    uint8_t   depth;          // átugrott konténer mélysége
+    uint8_t   kn, vn;
+    int8_t    field;          // aktuális kulcs indexe, -1: ismeretlen
+    bool      quoted, esc, skip_str, lit, frac, u_bad;
+    uint8_t   u_left; uint16_t u_acc;
+    uint32_t  pos;            // feldolgozott bájtok (hibaüzenethez)
+    char      key[JR_KEY_MAX];
+    char      val[JR_VAL_MAX];
+};
+
+void jr_init(JsonR& r, const JrField* tab, uint8_t ntab, void* dst);
+/* a következő darab; false: szintaktikai hiba (a többi bemenet felesleges) */
+bool jr_feed(JsonR& r, const char* s, size_t n);
+/* bemenet vége; true: teljes, jól formált objektum */
+bool jr_end(JsonR& r);
+const char* jr_err_str(uint8_t e);
+/* az első hibás mező kulcsa (r.bad alapján), vagy nullptr */
+const char* jr_bad_key(const JsonR& r);
@@ -0,0 +1,128 @@
+// components/webserver/json_out.cpp — streaming JSON író fix pufferrel
+#include <cstdio>
+#include <cstring>
+#include "json_out.hpp"
+
+static const char k_hex[] = "0123456789ABCDEF";
+
+static void drain(JsonW& w){
+    if(!w.n) return;
+    w.sink(w.ctx,w.buf,w.n);
+    w.total+=w.n;
+    w.n=0;
+}
+static inline void need(JsonW& w, size_t k){ if(w.n+k>JW_BUF) drain(w); }
+static inline void put(JsonW& w, char c){ need(w,1); w.buf[w.n++]=c; }
+static void put_n(JsonW& w, const char* s, size_t k){
+    while(k){
+        if(w.n==JW_BUF) drain(w);
+        size_t c=JW_BUF-w.n; if(c>k) c=k;
+        memcpy(w.buf+w.n,s,c); w.n+=c; s+=c; k-=c;
+    }
+}
+
+/* érték előtti vessző: kulcs után nincs, konténer első eleme előtt nincs */
+static void sep(JsonW& w){
+    if(w.after_key){ w.after_key=false; return; }
+    const uint16_t bit=(uint16_t)(1u<<w.depth);
+    if(!(w.empty & bit)) put(w,',');
+    w.empty&=~bit;
+}
+
+void jw_init(JsonW& w, jw_sink_t sink, void* ctx){
+    w.sink=sink; w.ctx=ctx; w.total=0; w.n=0;
+    w.depth=0; w.after_key=false; w.empty=1;    // gyökér: egy érték, vessző nélkül
+}
+
+uint32_t jw_flush(JsonW& w){ drain(w); return w.total; }
+uint32_t jw_finish(JsonW& w){ put(w,'\n'); return jw_flush(w); }
+
+static void nest(JsonW& w, char c){
+    sep(w); put(w,c);
+    w.depth++;                                          // legfeljebb JW_DEPTH szint
+    w.empty|=(uint16_t)(1u<<w.depth);
+}
+static void unnest(JsonW& w, char c){
+    put(w,c);
+    if(w.depth) w.depth--;
+}
+void jw_obj(JsonW& w)    { nest(w,'{'); }
+void jw_obj_end(JsonW& w){ unnest(w,'}'); }
+void jw_arr(JsonW& w)    { nest(w,'['); }
+void jw_arr_end(JsonW& w){ unnest(w,']'); }
+
+void jw_key(JsonW& w, const char* k){
+    sep(w);
+    const size_t kn=strlen(k);
+    need(w,kn+3);
+    if(kn+3>JW_BUF){ put(w,'"'); put_n(w,k,kn); put(w,'"'); put(w,':'); }
+    else { char* d=w.buf+w.n; *d++='"'; memcpy(d,k,kn); d+=kn; *d++='"'; *d=':'; w.n+=kn+3; }
+    w.after_key=true;
+}
+
+/* decimális: jobbról balra egy 20 B-os ideiglenesbe */
+static void put_dec(JsonW& w, uint64_t v, bool neg){
+    char t[21]; int i=21;
+    if(v<=0xFFFFFFFFu){ uint32_t x=(uint32_t)v; do{ t[--i]=(char)('0'+x%10); x/=10; }while(x); }
+    else              { do{ t[--i]=(char)('0'+v%10); v/=10; }while(v); }
+    if(neg) t[--i]='-';
+    put_n(w,t+i,21-i);
+}
+void jw_u32(JsonW& w, uint32_t v){ sep(w); put_dec(w,v,false); }
+void jw_u64(JsonW& w, uint64_t v){ sep(w); put_dec(w,v,false); }
+void jw_i32(JsonW& w, int32_t v) { sep(w); put_dec(w,v<0?(uint64_t)(-(int64_t)v):(uint64_t)v,v<0); }
+void jw_i64(JsonW& w, int64_t v) { sep(w); put_dec(w,v<0?(uint64_t)0-(uint64_t)v:(uint64_t)v,v<0); }
+
+void jw_num(JsonW& w, double v, uint8_t prec){
+    sep(w);
+    if(v!=v || v>1e300 || v<-1e300){ put_n(w,"null",4); return; }    // JSON-ban nincs NaN/Inf
+    char t[40]; int k=snprintf(t,sizeof(t),"%.*f",(int)prec,v);
+    if(k>0) put_n(w,t,(size_t)k<sizeof(t)?(size_t)k:sizeof(t)-1);
+}
+void jw_bool(JsonW& w, bool v){ sep(w); if(v) put_n(w,"true",4); else put_n(w,"false",5); }
+
+void jw_str(JsonW& w, const char* s){
+    sep(w); put(w,'"');
+    const char* run=s;                                   // escape nélküli szakasz egyben
+    for(;*s;s++){
+        const unsigned char c=(unsigned char)*s;
+        if(c>=0x20 && c!='"' && c!='\\') continue;
+        put_n(w,run,s-run); run=s+1;
+        switch(c){
+        case '"':  put_n(w,"\\\"",2); break;
+        case '\\': put_n(w,"\\\\",2); break;
+        case '\n': put_n(w,"\\n",2);  break;
+        case '\r': put_n(w,"\\r",2);  break;
+        case '\t': put_n(w,"\\t",2);  break;
+        default: { char u[6]={'\\','u','0','0',k_hex[c>>4],k_hex[c&15]}; put_n(w,u,6); }
+        }
+    }
+    put_n(w,run,s-run);
+    put(w,'"');
+}
+
+void jw_hex_u32(JsonW& w, uint32_t v, uint8_t digits){
+    sep(w);
+    if(digits<1) digits=1;
+    if(digits>8) digits=8;
+    char t[12]; int i=0;
+    t[i++]='"'; t[i++]='0'; t[i++]='x';
+    for(int k=digits-1;k>=0;k--) t[i++]=k_hex[(v>>(4*k))&15];
+    t[i++]='"';
+    put_n(w,t,i);
+}
+
+void jw_hex(JsonW& w, const uint8_t* p, size_t n, char sep_c){
+    sep(w); put(w,'"');
+    const size_t per=sep_c?3:2;
+    for(size_t i=0;i<n;i++){
+        need(w,per);
+        char* d=w.buf+w.n;
+        if(sep_c && i) *d++=sep_c;
+        *d++=k_hex[p[i]>>4]; *d++=k_hex[p[i]&15];
+        w.n=(uint16_t)(d-w.buf);
+    }
+    put(w,'"');
+}
+
+void jw_raw(JsonW& w, const char* s, size_t n){ sep(w); put_n(w,s,n); }
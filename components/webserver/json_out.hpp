@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+/* ================= Streaming JSON író =================
+   Fix méretű pufferbe ír, teli puffernél a sink-nek adja tovább (httpd-n
+   httpd_resp_send_chunk), így a válasz mérete nem kötött és nincs heap /
+   dupla másolás. Vesszők és kulcsok a beágyazási szint szerint automatikusan.
+   Számok és hex táblából, snprintf nélkül (kivéve lebegőpont).
+   Nincs httpd / ESP hívás: host-on is fordul és mérhető. */
+
+#define JW_BUF     512
+#define JW_DEPTH   15         // beágyazási szint (empty bitmaszk)
+
+typedef void (*jw_sink_t)(void* ctx, const char* s, size_t n);
+
+struct JsonW {
+    jw_sink_t sink;
+    void*     ctx;
+    uint32_t  total;          // a sink-nek átadott bájtok
+    uint16_t  n;              // pufferben
+    uint8_t   depth;
+    bool      after_key;
+    uint16_t  empty;          // bit d: a d. szintű konténerben még nincs elem
+    char      buf[JW_BUF];
+};
+
+void jw_init(JsonW& w, jw_sink_t sink, void* ctx);
+/* maradék kiírása; visszaad: összes bájt */
+uint32_t jw_flush(JsonW& w);
+/* záró "\n" + flush (a válaszok soronként zárulnak) */
+uint32_t jw_finish(JsonW& w);
+
+void jw_obj(JsonW& w);
+void jw_obj_end(JsonW& w);
+void jw_arr(JsonW& w);
+void jw_arr_end(JsonW& w);
+void jw_key(JsonW& w, const char* k);        // k: escape nélkül (azonosító)
+
+void jw_u32(JsonW& w, uint32_t v);
+void jw_i32(JsonW& w, int32_t v);
+void jw_u64(JsonW& w, uint64_t v);
+void jw_i64(JsonW& w, int64_t v);
+void jw_num(JsonW& w, double v, uint8_t prec);
+void jw_bool(JsonW& w, bool v);
+void jw_str(JsonW& w, const char* s);       // escape-elve
+void jw_hex_u32(JsonW& w, uint32_t v, uint8_t digits);               // "0x%0*X"
+void jw_hex(JsonW& w, const uint8_t* p, size_t n, char sep = ' ');    // "AA BB .."
+void jw_raw(JsonW& w, const char* s, size_t n);                       // kész JSON érték
+
+/* kulcs + érték */
+inline void jw_kv_u32(JsonW& w, const char* k, uint32_t v)  { jw_key(w,k); jw_u32(w,v); }
+inline void jw_kv_i32(JsonW& w, const char* k, int32_t v)   { jw_key(w,k); jw_i32(w,v); }
+inline void jw_kv_u64(JsonW& w, const char* k, uint64_t v)  { jw_key(w,k); jw_u64(w,v); }
+inline void jw_kv_i64(JsonW& w, const char* k, int64_t v)   { jw_key(w,k); jw_i64(w,v); }
+inline void jw_kv_num(JsonW& w, const char* k, double v, uint8_t prec) { jw_key(w,k); jw_num(w,v,prec); }
+inline void jw_kv_bool(JsonW& w, const char* k, bool v)     { jw_key(w,k); jw_bool(w,v); }
+inline void jw_kv_str(JsonW& w, const char* k, const char* s){ jw_key(w,k); jw_str(w,s); }
@@ -0,0 +1,243 @@
+// components/webserver/live_stream.cpp — WebSocket push: DATA / HB / STATE / státusz
+#include <cstring>
+#include <cstdio>
+#include <cinttypes>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "ble.h"
+#include "uwb_frame.h"
+#include "globals.h"
+#include "metrics.h"
+#include "live_stream.hpp"
+
+static const char* TAG = "LIVE";
+
+struct LiveMsg { uint8_t len; char s[LIVE_MSG_MAX]; };
+
+struct LiveClient {
+    int      fd;               // -1 = szabad
+    uint8_t  allowed, filter;
+    uint8_t  head, count;
+    LiveMsg  q[LIVE_Q_LEN];
+};
+
+static httpd_handle_t     s_hd;
+static SemaphoreHandle_t  s_mx;
+static esp_timer_handle_t s_tmr;
+static LiveClient         s_cli[LIVE_MAX_CLIENTS];
+static bool               s_flush_queued = false;
+static LiveStats          s_st;
+
+/* "data,cfg,status" → maszk; üres → minden */
+static uint8_t parse_filter(const char* s){
+    if(!s || !*s) return LIVE_F_ALL;
+    uint8_t m=0;
+    if(strstr(s,"data"))   m|=LIVE_F_DATA;
+    if(strstr(s,"cfg"))    m|=LIVE_F_CFG;
+    if(strstr(s,"status")) m|=LIVE_F_STATUS;
+    return m;
+}
+
+/* hívó fogja s_mx-et; snprintf eredmény: csonka (fél JSON) vagy hibás sor nem megy ki */
+static bool fmt_ok_locked(int n){
+    if(n>0 && n<LIVE_MSG_MAX) return true;
+    s_st.trunc++; metric_inc(M_LIVE_TRUNC);
+    return false;
+}
+
+/* hívó fogja s_mx-et; drop-oldest */
+static void push_locked(LiveClient& c, uint8_t mask, const char* s, int n){
+    if(c.fd<0 || !(c.filter & c.allowed & mask) || n<=0 || n>=LIVE_MSG_MAX) return;
+    if(c.count==LIVE_Q_LEN){ c.head=(c.head+1)%LIVE_Q_LEN; c.count--; s_st.dropped++; metric_inc(M_LIVE_DROP); }
+    LiveMsg& m=c.q[(c.head+c.count)%LIVE_Q_LEN];
+    m.len=(uint8_t)n; memcpy(m.s,s,n);
+    c.count++; s_st.queued++;
+}
+
+static void flush_work(void*);
+
+/* hívó fogja s_mx-et */
+static void kick_locked(){
+    if(s_flush_queued || !s_hd) return;
+    s_flush_queued = (httpd_queue_work(s_hd, flush_work, nullptr) == ESP_OK);
+}
+
+static void broadcast(uint8_t mask, const char* s, int n){
+    xSemaphoreTake(s_mx, portMAX_DELAY);
+    if(!fmt_ok_locked(n)){ xSemaphoreGive(s_mx); return; }
+    bool any=false;
+    for(auto& c: s_cli){ if(c.fd>=0 && (c.filter & c.allowed & mask)){ push_locked(c,mask,s,n); any=true; } }
+    if(any) kick_locked();
+    xSemaphoreGive(s_mx);
+}
+
+/* ---- httpd task: sorok → egy WS text frame kliensenként ---- */
+static char s_out[LIVE_Q_LEN*(LIVE_MSG_MAX+1)];   // csak a httpd task használja
+
+static void flush_work(void*){
+    for(int i=0;i<LIVE_MAX_CLIENTS;i++){
+        size_t wp=0; int fd;
+        xSemaphoreTake(s_mx, portMAX_DELAY);
+        if(i==0) s_flush_queued=false;
+        LiveClient& c=s_cli[i];
+        fd=c.fd;
+        while(fd>=0 && c.count){
+            const LiveMsg& m=c.q[c.head];
+            memcpy(s_out+wp,m.s,m.len); wp+=m.len; s_out[wp++]='\n';
+            c.head=(c.head+1)%LIVE_Q_LEN; c.count--; s_st.sent++;
+        }
+        xSemaphoreGive(s_mx);
+        if(!wp) continue;
+
+        esp_err_t er=ESP_FAIL;
+        if(httpd_ws_get_fd_info(s_hd,fd)==HTTPD_WS_CLIENT_WEBSOCKET){
+            httpd_ws_frame_t f{};
+            f.final=true; f.type=HTTPD_WS_TYPE_TEXT;
+            f.payload=(uint8_t*)s_out; f.len=wp-1;      // utolsó "\n" nélkül
+            er=httpd_ws_send_frame_async(s_hd,fd,&f);
+        }
+        xSemaphoreTake(s_mx, portMAX_DELAY);
+        if(er==ESP_OK) s_st.frames++;
+        else if(c.fd==fd){ ESP_LOGI(TAG,"client fd=%d gone",fd); c.fd=-1; c.count=0; s_st.clients--; metric_gauge_add(G_LIVE_CLIENTS,-1); }
+        xSemaphoreGive(s_mx);
+    }
+}
+
+/* ---- formázók ---- */
+static int fmt_status(char* b, size_t sz){
+    const char* st=(g_status.state==ST_OK?"ok":g_status.state==ST_WARN?"warn":g_status.state==ST_ERR?"err":"off");
+    return snprintf(b,sz,"{\"t\":\"status\",\"anchor\":\"%s\",\"id\":%u,\"last_s\":%.2f,\"last_v\":%.2f,\"state\":\"%s\"}",
+                    g_status.anchor?g_status.anchor:"",g_status.id,g_status.last_meas_s,g_status.last_volt,st);
+}
+static int fmt_link(char* b, size_t sz, uint8_t l, const ble_link_info_t& li){
+    return snprintf(b,sz,"{\"t\":\"link\",\"a\":%u,\"up\":%s,\"bda\":\"%02X:%02X:%02X:%02X:%02X:%02X\"}",
+                    (unsigned)l,li.connected?"true":"false",li.bda[0],li.bda[1],li.bda[2],li.bda[3],li.bda[4],li.bda[5]);
+}
+
+/* ---- ble_rx task ---- */
+void live_on_notify(uint8_t link, const uint8_t* p, uint16_t n, bool from_cfg){
+    if(!s_mx || !s_st.clients || !p) return;
+    char b[LIVE_MSG_MAX]; int w=0; uint8_t mask=LIVE_F_CFG;
+    if(!from_cfg){
+        uwb_data_t f;
+        if(!uwb_data_decode(p,n,&f)) return;
+        w=snprintf(b,sizeof(b),"{\"t\":\"d\",\"a\":%u,\"anc\":%" PRIu32 ",\"tag\":%" PRIu32 ",\"ss\":%u,\"ts\":%u,\"t40\":%" PRIu64 "}",
+                   (unsigned)link,f.anchor_id,f.tag_id,f.sync_seq,f.tag_seq,f.ts40);
+        mask=LIVE_F_DATA;
+    } else {
+        uwb_cfg_t c;
+        switch(uwb_cfg_decode(p,n,&c)){
+        case UWB_CFG_HB:
+            w=snprintf(b,sizeof(b),"{\"t\":\"hb\",\"a\":%u,\"st\":%u,\"up\":%" PRIu32 ",\"sync_ms\":%u}",
+                       (unsigned)link,c.hb.st,c.hb.up_ms,(unsigned)c.hb.sync_ms);
+            break;
+        case UWB_CFG_STATE:
+            w=snprintf(b,sizeof(b),"{\"t\":\"state\",\"a\":%u,\"st\":%u,\"sync_ms\":%u,\"up\":%" PRIu32 ",\"net\":%u,\"zone\":%u,\"anc\":%" PRIu32 "}",
+                       (unsigned)link,c.state.st,(unsigned)c.state.sync_ms,c.state.up_ms,(unsigned)c.state.net,(unsigned)c.state.zone,c.state.anchor_id);
+            break;
+        case UWB_CFG_ACK:
+            w=snprintf(b,sizeof(b),"{\"t\":\"ack\",\"a\":%u,\"req\":%u,\"st\":%u,\"applied\":%u}",
+                       (unsigned)link,(unsigned)c.ack.req_id,c.ack.status,c.ack.applied);
+            break;
+        default: return;                                // GET TLV blokkok: /api/dwm_get
+        }
+    }
+    broadcast(mask,b,w);
+}
+
+/* ---- státusz figyelő (esp_timer task) ---- */
+static void tmr_cb(void*){
+    static status_t s_last;
+    static uint32_t s_links_up;
+    if(!s_st.clients) return;
+    char b[LIVE_MSG_MAX];
+    if(g_status.state!=s_last.state || g_status.id!=s_last.id || g_status.anchor!=s_last.anchor ||
+       g_status.last_meas_s!=s_last.last_meas_s || g_status.last_volt!=s_last.last_volt){
+        s_last=g_status;
+        broadcast(LIVE_F_STATUS,b,fmt_status(b,sizeof(b)));
+    }
+
+    uint32_t up=0;
+    for(uint8_t l=0;l<BLE_MAX_LINKS;l++){
+        ble_link_info_t li;
+        if(!ble_link_info(l,&li)) continue;
+        if(li.connected) up|=1u<<l;
+        if(((s_links_up>>l)&1u)!=(uint32_t)li.connected) broadcast(LIVE_F_CFG,b,fmt_link(b,sizeof(b),l,li));
+    }
+    s_links_up=up;
+}
+
+/* ---- publikus ---- */
+esp_err_t live_init(httpd_handle_t h){
+    if(s_mx) return ESP_OK;
+    s_hd=h;
+    s_mx=xSemaphoreCreateMutex();
+    if(!s_mx) return ESP_ERR_NO_MEM;
+    for(auto& c: s_cli) c.fd=-1;
+    esp_timer_create_args_t a{};
+    a.callback=tmr_cb; a.name="live_st";
+    esp_err_t er=esp_timer_create(&a,&s_tmr);
+    if(er!=ESP_OK) return er;
+    ble_register_notify_cb(live_on_notify);
+    return esp_timer_start_periodic(s_tmr,(uint64_t)LIVE_STATUS_MS*1000ULL);
+}
+
+esp_err_t live_ws_open(httpd_req_t* req, uint8_t allowed){
+    if(!s_mx) return ESP_ERR_INVALID_STATE;
+    char q[48]={0}, v[32]={0};
+    if(httpd_req_get_url_query_str(req,q,sizeof(q))==ESP_OK) httpd_query_key_value(q,"f",v,sizeof(v));
+    const int fd=httpd_req_to_sockfd(req);
+
+    xSemaphoreTake(s_mx, portMAX_DELAY);
+    LiveClient* c=nullptr;
+    for(auto& x: s_cli) if(x.fd==fd){ c=&x; break; }         // újrahasznált fd
+    if(!c) for(auto& x: s_cli) if(x.fd<0){ c=&x; s_st.clients++; metric_gauge_add(G_LIVE_CLIENTS,1); break; }
+    if(c){
+        c->fd=fd; c->allowed=allowed; c->filter=parse_filter(v);
+        c->head=c->count=0;
+        /* kezdő pillanatkép az új kliensnek */
+        char b[LIVE_MSG_MAX];
+        int n=fmt_status(b,sizeof(b));
+        if(fmt_ok_locked(n)) push_locked(*c,LIVE_F_STATUS,b,n);
+        for(uint8_t l=0;l<BLE_MAX_LINKS;l++){
+            ble_link_info_t li;
+            if(ble_link_info(l,&li) && fmt_ok_locked(n=fmt_link(b,sizeof(b),l,li))) push_locked(*c,LIVE_F_CFG,b,n);
+        }
+        kick_locked();
+    }
+    const uint8_t eff = c ? (c->filter & allowed) : 0;
+    xSemaphoreGive(s_mx);
+    if(!c){ ESP_LOGW(TAG,"client table full, fd=%d",fd); return ESP_ERR_NO_MEM; }
+    ESP_LOGI(TAG,"client fd=%d filter=0x%02X",fd,(unsigned)eff);
+    return ESP_OK;
+}
+
+esp_err_t live_ws_recv(httpd_req_t* req){
+    httpd_ws_frame_t f{};
+    esp_err_t er=httpd_ws_recv_frame(req,&f,0);                // csak a hossz
+    if(er!=ESP_OK) return er;
+    uint8_t buf[40]={0};
+    if(f.len==0) return ESP_OK;
+    /* httpd_ws_recv_frame nem olvas részletben (hosszabb payload: INVALID_SIZE,
+       a bájtok a socketben maradnának és a következő frame fejlécének látszanának)
+       → túl hosszú frame-re a kapcsolatot zárjuk */
+    if(f.len>=sizeof(buf)){ ESP_LOGW(TAG,"frame %u B too long, closing",(unsigned)f.len); return ESP_FAIL; }
+    f.payload=buf;
+    if((er=httpd_ws_recv_frame(req,&f,f.len))!=ESP_OK) return er;
+    if(f.type==HTTPD_WS_TYPE_TEXT && f.len>2 && buf[0]=='f' && buf[1]=='='){
+        const int fd=httpd_req_to_sockfd(req);
+        xSemaphoreTake(s_mx, portMAX_DELAY);
+        for(auto& c: s_cli) if(c.fd==fd) c.filter=parse_filter((const char*)buf+2);
+        xSemaphoreGive(s_mx);
+    }
+    return ESP_OK;
+}
+
+void live_get_stats(LiveStats* out){
+    if(!s_mx){ memset(out,0,sizeof(*out)); return; }
+    xSemaphoreTake(s_mx, portMAX_DELAY);
+    *out=s_st;
+    xSemaphoreGive(s_mx);
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include "esp_err.h"
+#include "esp_http_server.h"
+
+/* ================= /ws élő folyam =================
+   DATA keretek, HB/STATE/ACK események és státuszváltozások tömör JSON
+   sorokként ("\n"-nel elválasztva, egy WS text frame-ben több sor).
+   Kliensenként fix méretű sor; tele sor esetén a legrégebbi esik ki,
+   így lassú böngésző nem fogja vissza a BLE ingest utat. */
+
+#define LIVE_MAX_CLIENTS   4
+#define LIVE_Q_LEN         24      // üzenet / kliens
+#define LIVE_MSG_MAX       112     // egy JSON sor max. hossza
+#define LIVE_STATUS_MS     500     // státusz-változás figyelés periódusa
+
+/* előfizetés szűrő bitek (?f=data,cfg,status) */
+#define LIVE_F_DATA        (1u<<0)
+#define LIVE_F_CFG         (1u<<1)     // HB/STATE/ACK + BLE link fel/le
+#define LIVE_F_STATUS      (1u<<2)
+#define LIVE_F_ALL         (LIVE_F_DATA|LIVE_F_CFG|LIVE_F_STATUS)
+
+struct LiveStats {
+    uint32_t clients;
+    uint32_t queued, sent, dropped;    // dropped: drop-oldest miatt
+    uint32_t frames;                   // kiküldött WS frame-ek
+    uint32_t trunc;                    // LIVE_MSG_MAX-ba nem fért sor, eldobva
+};
+
+esp_err_t live_init(httpd_handle_t h);
+
+/* WS handshake (GET): kliens felvétele; allowed = a szerep alapján engedett bitek */
+esp_err_t live_ws_open(httpd_req_t* req, uint8_t allowed);
+/* WS frame a klienstől: "f=data,cfg" szűrőcsere, egyébként eldobva */
+esp_err_t live_ws_recv(httpd_req_t* req);
+
+/* ble_rx task hívja minden notify-ra */
+void live_on_notify(uint8_t link, const uint8_t* p, uint16_t n, bool from_cfg);
+
+void live_get_stats(LiveStats* out);
@@ -0,0 +1,146 @@
+// components/webserver/session_store.cpp — hash + LRU session tábla
+#include <cstring>
+#include "session_store.hpp"
+
+#define SLOTS      (SESS_CAP*2)         // 2 hatványa, ≤50% töltés
+#define EMPTY      0                    // s_slot: index+1, 0 = üres
+#define NIL        0xFFFF
+
+static_assert((SLOTS & (SLOTS-1))==0, "SLOTS: 2 hatványa");
+static_assert(SESS_CAP < NIL, "index uint16_t");
+
+struct Sess {
+    char        sid[SESS_SID_LEN];
+    user_role_t role;
+    uint32_t    exp_s;
+    uint32_t    hash;
+    uint16_t    prev, next;             // LRU lánc (head = legutóbb használt)
+    bool        used;
+};
+
+static Sess     s_e[SESS_CAP];
+static uint16_t s_slot[SLOTS];          // hash → s_e index+1
+static uint16_t s_head=NIL, s_tail=NIL, s_free_hint;
+static uint32_t s_n;
+
+bool ct_equal(const void* a, const void* b, uint32_t n){
+    const volatile uint8_t* x=(const volatile uint8_t*)a;
+    const volatile uint8_t* y=(const volatile uint8_t*)b;
+    uint8_t d=0;
+    for(uint32_t i=0;i<n;i++) d|=x[i]^y[i];
+    return d==0;
+}
+
+/* FNV-1a; a SID véletlen, de a hossz/tartalom kívülről jön */
+static uint32_t h_sid(const char* sid){
+    uint32_t h=2166136261u;
+    for(int i=0;i<SESS_SID_LEN;i++){ h^=(uint8_t)sid[i]; h*=16777619u; }
+    return h;
+}
+
+static bool sid_ok(const char* sid){
+    if(!sid) return false;
+    for(int i=0;i<SESS_SID_LEN;i++) if(!sid[i]) return false;
+    return true;
+}
+
+/* ---- LRU ---- */
+static void lru_unlink(uint16_t i){
+    Sess& e=s_e[i];
+    if(e.prev!=NIL) s_e[e.prev].next=e.next; else s_head=e.next;
+    if(e.next!=NIL) s_e[e.next].prev=e.prev; else s_tail=e.prev;
+    e.prev=e.next=NIL;
+}
+static void lru_front(uint16_t i){
+    Sess& e=s_e[i];
+    e.prev=NIL; e.next=s_head;
+    if(s_head!=NIL) s_e[s_head].prev=i;
+    s_head=i;
+    if(s_tail==NIL) s_tail=i;
+}
+
+/* ---- hash ---- */
+static int find_slot(const char* sid, uint32_t h){
+    for(uint32_t k=0,p=h&(SLOTS-1); k<SLOTS; k++,p=(p+1)&(SLOTS-1)){
+        if(s_slot[p]==EMPTY) return -1;
+        uint16_t i=s_slot[p]-1;
+        if(s_e[i].hash==h && ct_equal(s_e[i].sid,sid,SESS_SID_LEN)) return (int)p;
+    }
+    return -1;
+}
+
+/* backward-shift: a próbalánc tömör marad, nincs tombstone */
+static void slot_erase(uint32_t p){
+    uint32_t q=p;
+    for(;;){
+        q=(q+1)&(SLOTS-1);
+        if(s_slot[q]==EMPTY) break;
+        uint32_t home=s_e[s_slot[q]-1].hash&(SLOTS-1);
+        /* q elemét p-re húzzuk, ha home nincs a (p,q] ciklikus intervallumban */
+        if(((q-home)&(SLOTS-1)) >= ((q-p)&(SLOTS-1))){ s_slot[p]=s_slot[q]; p=q; }
+    }
+    s_slot[p]=EMPTY;
+}
+
+static void remove_at(uint32_t p){
+    uint16_t i=s_slot[p]-1;
+    slot_erase(p);
+    lru_unlink(i);
+    memset(&s_e[i],0,sizeof(s_e[i]));
+    s_free_hint=i;
+    s_n--;
+}
+
+static void remove_idx(uint16_t i){
+    int p=find_slot(s_e[i].sid,s_e[i].hash);
+    if(p>=0) remove_at((uint32_t)p);
+}
+
+void sess_reset(){
+    memset(s_e,0,sizeof(s_e));
+    memset(s_slot,0,sizeof(s_slot));
+    s_head=s_tail=NIL; s_n=0; s_free_hint=0;
+}
+
+user_role_t sess_lookup(const char* sid, uint32_t now_s){
+    if(!s_n || !sid_ok(sid)) return ROLE_NONE;
+    int p=find_slot(sid,h_sid(sid));
+    if(p<0) return ROLE_NONE;
+    uint16_t i=s_slot[p]-1;
+    if(s_e[i].exp_s<=now_s){ remove_at((uint32_t)p); return ROLE_NONE; }   // lusta lejárat
+    if(s_head!=i){ lru_unlink(i); lru_front(i); }
+    return s_e[i].role;
+}
+
+bool sess_put(const char* sid, user_role_t role, uint32_t exp_s, uint32_t now_s){
+    if(!sid_ok(sid)) return false;
+    const uint32_t h=h_sid(sid);
+    if(find_slot(sid,h)>=0) return false;
+
+    /* lejártak söprése a LRU végéről (legfeljebb néhány lépés) */
+    for(int k=0;k<4 && s_tail!=NIL && s_e[s_tail].exp_s<=now_s;k++) remove_idx(s_tail);
+    if(s_n==SESS_CAP) remove_idx(s_tail);                                       // LRU kilakoltatás
+
+    uint16_t i=s_free_hint;
+    if(s_e[i].used) for(i=0;i<SESS_CAP && s_e[i].used;i++){}
+    Sess& e=s_e[i];
+    memcpy(e.sid,sid,SESS_SID_LEN);
+    e.role=role; e.exp_s=exp_s; e.hash=h; e.used=true;
+    lru_front(i);
+    uint32_t p=h&(SLOTS-1);
+    while(s_slot[p]!=EMPTY) p=(p+1)&(SLOTS-1);
+    s_slot[p]=i+1;
+    s_n++;
+    s_free_hint=(uint16_t)((i+1)%SESS_CAP);
+    return true;
+}
+
+bool sess_drop(const char* sid){
+    if(!s_n || !sid_ok(sid)) return false;
+    int p=find_slot(sid,h_sid(sid));
+    if(p<0) return false;
+    remove_at((uint32_t)p);
+    return true;
+}
+
+uint32_t sess_count(){ return s_n; }
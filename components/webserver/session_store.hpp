@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include "webserver.hpp"
+
+/* ================= Session tábla =================
+   Fix kapacitás, nyílt címzésű hash (lineáris próba, backward-shift törlés)
+   + LRU lista. Lejárt bejegyzéseket keresés/beszúrás közben takarítunk;
+   tele táblánál a legrégebben használt esik ki. A SID összevetése
+   konstans idejű. Nem allokál, ESP API-t nem hív (host-on is mérhető).
+   Zár nincs: csak a httpd taskról hívható (auth.cpp); az async handlerek
+   nem keresnek, a szerepkört a http_async Job hozza. */
+
+#ifndef SESS_CAP
+#define SESS_CAP      16          // egyidejű session
+#endif
+#define SESS_SID_LEN  32          // hex karakter
+
+void        sess_reset();
+/* új session; a SID-et a hívó generálja. Visszaad: false ha a SID már létezik */
+bool        sess_put(const char* sid, user_role_t role, uint32_t exp_s, uint32_t now_s);
+/* ROLE_NONE, ha nincs / lejárt; találatkor LRU elejére kerül */
+user_role_t sess_lookup(const char* sid, uint32_t now_s);
+bool        sess_drop(const char* sid);
+uint32_t    sess_count();
+
+/* konstans idejű összehasonlítás (n bájt) */
+bool ct_equal(const void* a, const void* b, uint32_t n);
@@ -1,101 +1,77 @@
 // components/webserver/webserver.cpp — ESP-IDF v5.3.x
-// Auth (login + SID cookie), Basic Auth fallback, DWM TLV GET diagnosztikával.
+// Oldalak és API végpontok (auth: auth.cpp, body / JSON válasz: http_json.cpp), DWM TLV GET diagnosztikával.
 
-#include <string>
-#include <vector>
 #include <cstring>
 #include <cstdio>
+#include <cstdlib>
 #include <cinttypes>
 #include "esp_http_server.h"
 #include "esp_log.h"
 #include "esp_timer.h"
-#include "esp_system.h"
-#include "mbedtls/base64.h"
+#include "freertos/FreeRTOS.h"
 #include "webserver.hpp"
 #include "globals.h"
 #include "ble.h"
+#include "tlv.h"
+#include "dwm_cache.hpp"
+#include "live_stream.hpp"
+#include "assets.hpp"
+#include "auth.hpp"
+#include "metrics.h"
+#include "cfg_json.hpp"
+#include "cfg_engine.hpp"
+#include "json_out.hpp"
+#include "json_in.hpp"
+#include "http_json.hpp"
+#include "http_async.hpp"
+#include "uplink.h"
+#include "cfg_store.h"
+#include "boot.h"
+#include "capture.h"
+#include "ble_sim.h"
+#include "blog.h"
+#include "lwip/ip4_addr.h"
 
 static const char* TAG = "WEB";
 
 /* ================= HTTPD handle ================= */
 static httpd_handle_t s_http = NULL;
+#define HTTP_MAX_SOCKETS  7         // ≤ LWIP_MAX_SOCKETS - 3
+static_assert(HTTP_ASYNC_WORKERS + HTTP_ASYNC_QUEUE + 2 <= HTTP_MAX_SOCKETS,
+              "async kérések foglalják a socketeket: maradjon a gyors végpontoknak");
+
+/* ================= Static file helper =================
+   Elsőként a beágyazott (gzip, ETag) táblából; 304 ha az ETag egyezik.
+   SPIFFS csak akkor, ha nincs a táblában vagy a kliens nem fogad gzip-et. */
+static bool hdr_has(httpd_req_t* req, const char* hdr, const char* needle){
+    char v[96];
+    if(httpd_req_get_hdr_value_str(req,hdr,v,sizeof(v))!=ESP_OK) return false;
+    return strstr(v,needle)!=nullptr;
+}
 
-/* ================= Users + Sessions ================= */
-struct User { const char* u; const char* p; user_role_t r; };
-static const User kUsers[] = {
-    {"diag","diag",ROLE_DIAG},
-    {"admin","admin",ROLE_BLE},
-    {"root","root",ROLE_ROOT},
-    {nullptr,nullptr,ROLE_NONE}
-};
-struct Session { char sid[33]; user_role_t role; uint32_t exp_s; };
-static Session g_sess[8]; // kevés is elég
-
-static void mk_sid(char out[33]){
-    for(int i=0;i<32;i++){ uint8_t b = esp_random() & 0x0F; out[i] = "0123456789abcdef"[b]; }
-    out[32] = 0;
-}
-static user_role_t check_user(const char* u, const char* pw){
-    for (auto& x: kUsers) if (x.u && strcmp(u,x.u)==0 && strcmp(pw,x.p)==0) return x.r;
-    return ROLE_NONE;
-}
-
-/* ---------- Basic Auth decode ---------- */
-static bool decode_basic(const char* h, std::string& u, std::string& p){
-    if (!h) return false;
-    const char* pref = "Basic ";
-    if (strncmp(h, pref, 6) != 0) return false;
-    const char* b64 = h + 6;
-    size_t olen=0;
-    (void)mbedtls_base64_decode(nullptr,0,&olen,(const unsigned char*)b64,strlen(b64));
-    std::vector<unsigned char> buf(olen+1);
-    if (mbedtls_base64_decode(buf.data(),olen,&olen,(const unsigned char*)b64,strlen(b64))!=0) return false;
-    buf[olen]=0;
-    char* sep = (char*)strchr((char*)buf.data(),':'); if(!sep) return false;
-    *sep=0; u.assign((char*)buf.data()); p.assign(sep+1); return true;
-}
-static bool decode_basic_hdr(httpd_req_t* req, std::string& u, std::string& p){
-    size_t len=httpd_req_get_hdr_value_len(req,"Authorization"); if(!len) return false;
-    std::vector<char> auth(len+1);
-    if(httpd_req_get_hdr_value_str(req,"Authorization",auth.data(),auth.size())!=ESP_OK) return false;
-    return decode_basic(auth.data(), u, p);
-}
-
-/* ---------- Cookie (SID) ellenőrzés ---------- */
-static user_role_t role_from_cookie(httpd_req_t* req){
-    size_t n=httpd_req_get_hdr_value_len(req,"Cookie"); if(!n) return ROLE_NONE;
-    std::vector<char> ck(n+1);
-    if(httpd_req_get_hdr_value_str(req,"Cookie",ck.data(),ck.size())!=ESP_OK) return ROLE_NONE;
-    const char* m=strstr(ck.data(),"SID="); if(!m) return ROLE_NONE; m+=4;
-    char sid[33]={0}; int i=0; while(*m && *m!=';' && i<32) sid[i++]=*m++;
-    uint32_t now=(uint32_t)(esp_timer_get_time()/1000000ULL);
-    for(auto& s: g_sess) if(s.sid[0] && strcmp(s.sid,sid)==0 && s.exp_s>now) return s.role;
-    return ROLE_NONE;
-}
-static user_role_t role_from_auth(httpd_req_t* req){
-    user_role_t r = role_from_cookie(req);
-    if (r != ROLE_NONE) return r;
-    std::string u,p; if(!decode_basic_hdr(req,u,p)) return ROLE_NONE;
-    return check_user(u.c_str(), p.c_str());
-}
-static bool require_role(httpd_req_t* req, user_role_t need){
-    user_role_t r=role_from_auth(req);
-    if(r<need){
-        if (strncmp(req->uri,"/api/",5)==0 || strncmp(req->uri,"/auth/",6)==0){
-            httpd_resp_set_status(req,"401 Unauthorized"); httpd_resp_sendstr(req,"");
-        } else {
-            httpd_resp_set_status(req,"302 Found"); httpd_resp_set_hdr(req,"Location","/login"); httpd_resp_sendstr(req,"");
-        }
-        return false;
+static esp_err_t send_asset(httpd_req_t* req, const Asset& a, const char* ctype){
+    httpd_resp_set_hdr(req,"ETag",a.etag);
+    httpd_resp_set_hdr(req,"Cache-Control","private, no-cache");   // mindig revalidál, 304-gyel olcsó
+    httpd_resp_set_hdr(req,"Vary","Accept-Encoding");              // ugyanaz az URL gzip / identity is lehet
+    if(hdr_has(req,"If-None-Match",a.etag)){
+        httpd_resp_set_status(req,"304 Not Modified");
+        return httpd_resp_send(req,nullptr,0);
     }
-    return true;
+    httpd_resp_set_type(req,ctype);
+    if(a.flags & ASSET_F_GZIP) httpd_resp_set_hdr(req,"Content-Encoding","gzip");
+    return httpd_resp_send(req,(const char*)a.data,a.len);            // flash-ből, másolás nélkül
 }
 
-/* ================= Static file helper ================= */
 static esp_err_t send_file(httpd_req_t* req, const char* path, const char* ctype){
+    Asset a;
+    const char* name=strncmp(path,"/spiffs/",8)==0 ? path+7 : path;
+    if(asset_find(name,&a) && (!(a.flags & ASSET_F_GZIP) || hdr_has(req,"Accept-Encoding","gzip")))
+        return send_asset(req,a,ctype);
+
     FILE* f=fopen(path,"rb");
     if(!f){ httpd_resp_send_err(req,HTTPD_404_NOT_FOUND,"Not found"); return ESP_FAIL; }
     httpd_resp_set_type(req, ctype);
+    httpd_resp_set_hdr(req,"Vary","Accept-Encoding");
     char buf[1024]; size_t n;
     while((n=fread(buf,1,sizeof(buf),f))>0){
         if(httpd_resp_send_chunk(req,buf,n)!=ESP_OK){ fclose(f); httpd_resp_sendstr_chunk(req,NULL); return ESP_FAIL; }
@@ -110,260 +86,850 @@ static esp_err_t ble_get  (httpd_req_t* r){ if(!require_role(r,ROLE_BLE ))return
 static esp_err_t admin_get(httpd_req_t* r){ if(!require_role(r,ROLE_ROOT))return ESP_FAIL; return send_file(r,"/spiffs/admin.html","text/html"); }
 static esp_err_t super_user_get(httpd_req_t* r){ if(!require_role(r,ROLE_BLE))return ESP_FAIL; return send_file(r,"/spiffs/super_user.html","text/html"); }
 
-/* ================= /auth/login =================
-   Body: {"user":"admin","pass":"admin"}
-   Siker: Set-Cookie: SID=...; Path=/; HttpOnly; Max-Age=86400
-*/
-static esp_err_t auth_login_post(httpd_req_t* req){
-    int len=req->content_len; if(len<=0) return httpd_resp_send_err(req,HTTPD_400_BAD_REQUEST,"empty");
-    std::vector<char> body(len+1,0); int off=0;
-    while(off<len){ int r=httpd_req_recv(req,body.data()+off,len-off); if(r<=0) return httpd_resp_send_err(req,HTTPD_500_INTERNAL_SERVER_ERROR,"recv"); off+=r; }
-
-    auto getstr=[&](const char* key)->std::string{
-        const char* k=strstr(body.data(),key); if(!k) return {};
-        k=strchr(k,':'); if(!k) return {}; k++;
-        while(*k==' '||*k=='\"') ++k;
-        const char* e=k; while(*e && *e!='\"' && *e!=',' && *e!='}') ++e;
-        return std::string(k,e-k);
-    };
-    std::string u=getstr("\"user\""); std::string p=getstr("\"pass\"");
-    user_role_t r=check_user(u.c_str(),p.c_str());
-    if(r==ROLE_NONE) return httpd_resp_send_err(req,HTTPD_401_UNAUTHORIZED,"bad creds");
-
-    // session mentés
-    char sid[33]; mk_sid(sid);
-    uint32_t now=(uint32_t)(esp_timer_get_time()/1000000ULL);
-    // első szabad slot
-    int idx=0; for(int i=0;i<(int)(sizeof(g_sess)/sizeof(g_sess[0]));++i){ if(g_sess[i].sid[0]==0){ idx=i; break; } }
-    memset(&g_sess[idx],0,sizeof(g_sess[0]));
-    strncpy(g_sess[idx].sid,sid,sizeof(g_sess[0].sid)-1);
-    g_sess[idx].role=r; g_sess[idx].exp_s=now+86400;
-
-    std::string cookie = std::string("SID=")+sid+"; Path=/; HttpOnly; Max-Age=86400";
-    httpd_resp_set_hdr(req,"Set-Cookie",cookie.c_str());
-    httpd_resp_set_type(req,"application/json");
-    return httpd_resp_sendstr(req,"{\"ok\":true}\n");
+/* ================= ESP config tükör az UI-hoz =================
+   Linkenként (?anchor=N): minden anchor saját DWM konfiggal fut. A POST a
+   worker poolban írja, a GET a httpd taskon olvassa → s_cfg_mux alatt másolunk.
+   A készülékről ismert állapot a cfg_store-ban is megmarad (újraindítás után
+   a UI nem alapértékeket mutat), linkenként az anchor szűrőjével kulcsolva
+   (cfgb_link_key). A link szűrője csak ble_start után ismert, ezért a tükör
+   első hozzáféréskor töltődik. Mentés késleltetve, a HTTP út nem vár rá. */
+static EspCfg       s_cfg[BLE_MAX_LINKS];
+static uint32_t     s_cfg_loaded;                      // link bitek
+static portMUX_TYPE s_cfg_mux=portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t link_key(uint8_t link){
+    ble_link_info_t li;
+    return ble_link_info(link,&li) ? cfgb_link_key(li.filter) : 0;
+}
+static void mirror_load(uint8_t link){
+    const uint32_t key=link_key(link);
+    if(!key) return;                                   // még nincs ilyen anchor: alapértékek
+    sys_cfg_t s; cfg_store_get(&s);
+    const cfgb_dwm_t* d=cfgb_link_find(&s,key);
+    EspCfg c;
+    if(d && d->mask){
+        c.NETWORK_ID=d->network_id; c.ZONE_ID=d->zone_id;       c.ANCHOR_ID=d->anchor_id;
+        c.HB_MS=d->hb_ms;           c.LOG_LEVEL=d->log_level;
+        c.TX_ANT_DLY=d->tx_ant_dly; c.RX_ANT_DLY=d->rx_ant_dly; c.BIAS_TICKS=d->bias_ticks;
+        c.PHY_CH=d->phy_ch;         c.PHY_SFDTO=d->phy_sfdto;
+    }
+    portENTER_CRITICAL(&s_cfg_mux);
+    if(!(s_cfg_loaded & (1u<<link))){ if(d && d->mask) s_cfg[link]=c; s_cfg_loaded|=1u<<link; }
+    portEXIT_CRITICAL(&s_cfg_mux);
+}
+static void mirror_get(uint8_t link, EspCfg* out){
+    if(!(s_cfg_loaded & (1u<<link))) mirror_load(link);
+    portENTER_CRITICAL(&s_cfg_mux); *out=s_cfg[link]; portEXIT_CRITICAL(&s_cfg_mux);
+}
+
+struct MirrorSave { uint8_t link; uint32_t key; uint16_t mask; EspCfg c; };
+static void mirror_put(sys_cfg_t* s, void* arg){
+    const MirrorSave& m=*(const MirrorSave*)arg;
+    cfgb_dwm_t* d=cfgb_link_slot(s,m.key);
+    d->mask|=m.mask;
+    d->network_id=m.c.NETWORK_ID; d->zone_id=m.c.ZONE_ID;       d->anchor_id=m.c.ANCHOR_ID;
+    d->hb_ms=m.c.HB_MS;           d->log_level=m.c.LOG_LEVEL;
+    d->tx_ant_dly=m.c.TX_ANT_DLY; d->rx_ant_dly=m.c.RX_ANT_DLY; d->bias_ticks=m.c.BIAS_TICKS;
+    d->phy_ch=m.c.PHY_CH;         d->phy_sfdto=m.c.PHY_SFDTO;
+    if(m.link==0){ s->dwm_v1=*d; s->dwm_v1.key=0; }     // v1 firmware ezt olvassa
+}
+static void mirror_save(uint8_t link, uint16_t mask){
+    MirrorSave m{link,link_key(link),mask,{}};
+    if(!m.key) return;
+    mirror_get(link,&m.c);
+    cfg_store_update(mirror_put,&m);
 }
 
-/* ================= ESP config tükör az UI-hoz ================= */
-struct EspCfg {
-    uint16_t NETWORK_ID = 1;
-    uint16_t ZONE_ID    = 0x5A31;
-    uint32_t ANCHOR_ID  = 0x00000001;
-    uint16_t HB_MS      = 10000;
-    uint8_t  LOG_LEVEL  = 1;
-    int32_t  TX_ANT_DLY = 0;
-    int32_t  RX_ANT_DLY = 0;
-    int32_t  BIAS_TICKS = 0;
-    uint8_t  PHY_CH     = 9;
-    uint16_t PHY_SFDTO  = 248;
-} g_cfg;
-
-static void json_cfg_print(char* buf, size_t sz, const EspCfg& c){
-    snprintf(buf, sz,
-      "{"
-      "\"NETWORK_ID\":%u,"
-      "\"ZONE_ID\":\"0x%04X\","
-      "\"ANCHOR_ID\":\"0x%08X\","
-      "\"HB_MS\":%u,"
-      "\"LOG_LEVEL\":%u,"
-      "\"TX_ANT_DLY\":%d,"
-      "\"RX_ANT_DLY\":%d,"
-      "\"BIAS_TICKS\":%d,"
-      "\"PHY_CH\":%u,"
-      "\"PHY_SFDTO\":%u"
-      "}\n",
-      (unsigned)c.NETWORK_ID,(unsigned)c.ZONE_ID,(unsigned)c.ANCHOR_ID,
-      (unsigned)c.HB_MS,(unsigned)c.LOG_LEVEL,
-      (int)c.TX_ANT_DLY,(int)c.RX_ANT_DLY,(int)c.BIAS_TICKS,
-      (unsigned)c.PHY_CH,(unsigned)c.PHY_SFDTO);
-}
-static bool find_key(const char* body, const char* key, const char** val_start){
-    const char* p=strstr(body,key); if(!p) return false;
-    p=strchr(p,':'); if(!p) return false; p++;
-    while(*p==' '||*p=='\"'){ if(*p=='\"'){ *val_start=p; return true; } ++p; }
-    *val_start=p; return true;
-}
-static bool parse_u32(const char* body, const char* key, uint32_t& out){
-    const char* v=nullptr; if(!find_key(body,key,&v)) return false; char* end=nullptr;
-    if(*v=='\"') out=strtoul(v+1,&end,16); else out=strtoul(v,&end,10); return true;
-}
-static bool parse_i32(const char* body, const char* key, int32_t& out){
-    const char* v=nullptr; if(!find_key(body,key,&v)) return false; char* end=nullptr;
-    if(*v=='\"') out=(int32_t)strtol(v+1,&end,16); else out=(int32_t)strtol(v,&end,10); return true;
-}
-static bool parse_u16(const char* body, const char* key, uint16_t& out){ uint32_t t; if(!parse_u32(body,key,t)) return false; out=(uint16_t)t; return true; }
-static bool parse_u8 (const char* body, const char* key, uint8_t&  out){ uint32_t t; if(!parse_u32(body,key,t)) return false; out=(uint8_t)t;  return true; }
+/* ?anchor=N (alapértelmezés 0); false, ha nincs ilyen link vagy csonka a query */
+static bool anchor_arg(httpd_req_t* req, uint8_t* out){
+    char q[64], v[8];
+    *out=0;
+    esp_err_t er=httpd_req_get_url_query_str(req,q,sizeof(q));
+    if(er==ESP_ERR_NOT_FOUND) return true;
+    if(er==ESP_OK) er=httpd_query_key_value(q,"anchor",v,sizeof(v));
+    if(er==ESP_ERR_NOT_FOUND) return true;
+    if(er!=ESP_OK) return false;
+    char* e; const unsigned long a=strtoul(v,&e,10);
+    if(e==v || *e || a>=BLE_MAX_LINKS) return false;
+    *out=(uint8_t)a;
+    return true;
+}
+
+/* dwm_cache_get / cfg_engine_apply hiba → HTTP válasz */
+static esp_err_t send_dwm_err(httpd_req_t* req, esp_err_t er){
+    switch(er){
+    case ESP_ERR_INVALID_ARG:   return httpd_resp_send_err(req,HTTPD_400_BAD_REQUEST,"anchor");
+    case ESP_ERR_INVALID_STATE: httpd_resp_set_status(req,"503 Service Unavailable"); return httpd_resp_sendstr(req,"BLE not connected");
+    case ESP_ERR_NO_MEM:                                   // BLE írási sor tele: átmeneti
+        httpd_resp_set_status(req,"503 Service Unavailable"); httpd_resp_set_hdr(req,"Retry-After",HTTP_RETRY_AFTER_S);
+        return httpd_resp_sendstr(req,"BLE write queue full");
+    case ESP_ERR_TIMEOUT:       httpd_resp_set_status(req,"504 Gateway Timeout"); return httpd_resp_sendstr(req,"DWM GET timeout");
+    default: {
+        char m[48]; snprintf(m,sizeof(m),"DWM GET: %s",esp_err_to_name(er));
+        return httpd_resp_send_err(req,HTTPD_500_INTERNAL_SERVER_ERROR,m);
+    }
+    }
+}
 
 static esp_err_t api_config_get(httpd_req_t* req){
     if(!require_role(req, ROLE_BLE)) return ESP_FAIL;
-    char buf[256]; json_cfg_print(buf,sizeof(buf),g_cfg);
-    httpd_resp_set_type(req,"application/json");
-    return httpd_resp_send(req, buf, strlen(buf));
+    uint8_t anchor;
+    if(!anchor_arg(req,&anchor)) return httpd_resp_send_err(req,HTTPD_400_BAD_REQUEST,"anchor");
+    EspCfg c; mirror_get(anchor,&c);
+    JsonW w; json_begin(req,w);
+    cfg_json_write(w,c);
+    return json_end(req,w);
 }
-static esp_err_t api_config_post(httpd_req_t* req){
-    if(!require_role(req, ROLE_BLE)) return ESP_FAIL;
-    int len=req->content_len; if(len<=0) return httpd_resp_send_err(req,HTTPD_400_BAD_REQUEST,"empty");
-    std::vector<char> body(len+1,0); int off=0;
-    while(off<len){ int r=httpd_req_recv(req,body.data()+off,len-off); if(r<=0) return httpd_resp_send_err(req,HTTPD_500_INTERNAL_SERVER_ERROR,"recv"); off+=r; }
-    parse_u16(body.data(),"\"NETWORK_ID\"",g_cfg.NETWORK_ID);
-    parse_u16(body.data(),"\"ZONE_ID\""   ,g_cfg.ZONE_ID);
-    { uint32_t t; if(parse_u32(body.data(),"\"ANCHOR_ID\"",t)) g_cfg.ANCHOR_ID=t; }
-    parse_u16(body.data(),"\"HB_MS\""     ,g_cfg.HB_MS);
-    parse_u8 (body.data(),"\"LOG_LEVEL\"" ,g_cfg.LOG_LEVEL);
-    parse_i32(body.data(),"\"TX_ANT_DLY\"",g_cfg.TX_ANT_DLY);
-    parse_i32(body.data(),"\"RX_ANT_DLY\"",g_cfg.RX_ANT_DLY);
-    parse_i32(body.data(),"\"BIAS_TICKS\"",g_cfg.BIAS_TICKS);
-    parse_u8 (body.data(),"\"PHY_CH\""    ,g_cfg.PHY_CH);
-    parse_u16(body.data(),"\"PHY_SFDTO\"" ,g_cfg.PHY_SFDTO);
-    httpd_resp_set_type(req,"application/json");
-    return httpd_resp_sendstr(req,"{\"ok\":true}\n");
+/* POST: csak az eltérő mezők mennek ki SET-ben (cfg_engine), mezőnkénti eredménnyel */
+static esp_err_t api_config_post(httpd_req_t* req, user_role_t){
+    uint8_t anchor;
+    if(!anchor_arg(req,&anchor)) return httpd_resp_send_err(req,HTTPD_400_BAD_REQUEST,"anchor");
+
+    EspCfg want; mirror_get(anchor,&want);
+    JsonR jr;
+    if(recv_json(req,jr,k_cfg_json,k_cfg_json_n,&want)!=ESP_OK) return ESP_FAIL;
+    const uint16_t mask=(uint16_t)jr.set;
+    if(!mask) return httpd_resp_send_err(req,HTTPD_400_BAD_REQUEST,"no known field");
+
+    CfgApplyResult res;
+    esp_err_t er=cfg_engine_apply(anchor,want,mask,&res);
+    if(er!=ESP_OK) return send_dwm_err(req,er);
+
+    if(res.device_mask){                               // tükör: a készülék ismert állapota
+        portENTER_CRITICAL(&s_cfg_mux);
+        for(uint8_t f=0;f<CFG_NFIELDS;f++)
+            if(res.device_mask & CFG_M(f)) cfg_set(s_cfg[anchor],f,cfg_get(res.device,f));
+        portEXIT_CRITICAL(&s_cfg_mux);
+        mirror_save(anchor,res.device_mask);
+    }
+
+    JsonW w; json_begin(req,w);
+    jw_obj(w);
+    jw_kv_bool(w,"ok",res.applied==res.changed);
+    jw_kv_u32(w,"anchor",anchor);
+    jw_kv_u32(w,"writes",res.writes);
+    jw_kv_u32(w,"retries",res.retries);
+    jw_key(w,"fields"); jw_obj(w);
+    for(uint8_t f=0;f<CFG_NFIELDS;f++){
+        if(!(mask & CFG_M(f))) continue;
+        jw_key(w,k_cfg_fields[f].name); jw_obj(w);
+        jw_kv_str(w,"res",cfg_res_str(res.res[f]));
+        jw_kv_u32(w,"status",res.ack_status[f]);
+        jw_obj_end(w);
+    }
+    jw_obj_end(w);
+    jw_obj_end(w);
+    return json_end(req,w);
 }
 
 /* ================= /api/status ================= */
 static esp_err_t api_status_get(httpd_req_t* req){
     const char* st = (g_status.state==ST_OK?"ok":g_status.state==ST_WARN?"warn":g_status.state==ST_ERR?"err":"off");
-    char buf[128];
-    int n=snprintf(buf,sizeof(buf),
-        "{\"anchor\":\"%s\",\"id\":%u,\"last_s\":%.2f,\"last_v\":%.2f,\"state\":\"%s\"}\n",
-        g_status.anchor,g_status.id,g_status.last_meas_s,g_status.last_volt,st);
+    JsonW w; json_begin(req,w);
+    jw_obj(w);
+    jw_kv_str(w,"anchor",g_status.anchor?g_status.anchor:"");
+    jw_kv_u32(w,"id",g_status.id);
+    jw_kv_num(w,"last_s",g_status.last_meas_s,2);
+    jw_kv_num(w,"last_v",g_status.last_volt,2);
+    jw_kv_str(w,"state",st);
+    jw_obj_end(w);
+    return json_end(req,w);
+}
+
+/* ================= /api/uplink (UDP batch paraméterek) ================= */
+static esp_err_t api_uplink_get(httpd_req_t* req){
+    if(!require_role(req, ROLE_ROOT)) return ESP_FAIL;
+    uplink_cfg_t c; uplink_get_config(&c);
+    uplink_stats_t st; uplink_get_stats(&st);
+    uplink_journal_stats_t js; uplink_get_journal_stats(&js);
+    const jr_stats_t& j=js.jr;
+    JsonW w; json_begin(req,w);
+    jw_obj(w);
+    jw_kv_u32(w,"max_frames",c.max_frames);
+    jw_kv_u32(w,"flush_ms",c.flush_ms);
+    jw_kv_u32(w,"max_rate",c.max_rate);
+    jw_kv_u32(w,"mtu",c.mtu);
+    jw_kv_u32(w,"replay_rate",c.replay_rate);
+    jw_kv_bool(w,"eth_up",eth_up);
+    jw_kv_u32(w,"frames_in",st.frames_in);
+    jw_kv_u32(w,"frames_dropped",st.frames_dropped);
+    jw_kv_u32(w,"frames_dup",st.frames_dup);
+    jw_kv_u32(w,"frames_sent",st.frames_sent);
+    jw_kv_u32(w,"datagrams",st.datagrams);
+    jw_kv_u32(w,"send_errors",st.send_errors);
+    jw_kv_u32(w,"journaled",st.journaled);
+    jw_kv_u32(w,"bytes_sent",st.bytes_sent);
+    jw_key(w,"journal"); jw_obj(w);
+    jw_kv_bool(w,"present",js.present);
+    jw_kv_u32(w,"size",js.size);
+    jw_kv_u32(w,"pending",j.pending);
+    jw_kv_u32(w,"appended",j.appended);
+    jw_kv_u32(w,"appended_bytes",j.appended_bytes);
+    jw_kv_u32(w,"prog_bytes",j.prog_bytes);
+    jw_kv_u32(w,"erases",j.erases);
+    jw_kv_num(w,"write_amp",j.appended_bytes?(double)j.prog_bytes/j.appended_bytes:0.0,3);
+    jw_kv_u32(w,"replayed",j.replayed);
+    jw_kv_u32(w,"replayed_bytes",j.replayed_bytes);
+    jw_kv_u32(w,"replay_ms",js.replay_ms);
+    jw_kv_u32(w,"replay_Bps",js.replay_ms?(uint32_t)((uint64_t)j.replayed_bytes*1000/js.replay_ms):0);
+    jw_kv_u32(w,"dropped",j.dropped);
+    jw_kv_u32(w,"corrupt",j.corrupt);
+    jw_kv_u32(w,"io_errors",j.io_errors);
+    jw_obj_end(w);
+    jw_obj_end(w);
+    return json_end(req,w);
+}
+static const JrField k_uplink_json[] = {       // strcmp sorrend; tartomány: uplink_set_config
+    JR_NUM(uplink_cfg_t, flush_ms,    JF_U16, 0, 0, 0xFFFF),
+    JR_NUM(uplink_cfg_t, max_frames,  JF_U16, 1, 0, 0xFFFF),
+    JR_NUM(uplink_cfg_t, max_rate,    JF_U16, 2, 0, 0xFFFF),
+    JR_NUM(uplink_cfg_t, mtu,         JF_U16, 3, 0, 0xFFFF),
+    JR_NUM(uplink_cfg_t, replay_rate, JF_U16, 4, 0, 0xFFFF),
+};
+static esp_err_t api_uplink_post(httpd_req_t* req){
+    if(!require_role(req, ROLE_ROOT)) return ESP_FAIL;
+    uplink_cfg_t c; uplink_get_config(&c); JsonR jr;
+    if(recv_json(req,jr,k_uplink_json,sizeof(k_uplink_json)/sizeof(k_uplink_json[0]),&c)!=ESP_OK) return ESP_FAIL;
+    if(uplink_set_config(&c)!=ESP_OK) return httpd_resp_send_err(req,HTTPD_400_BAD_REQUEST,"range");
+    httpd_resp_set_type(req,"application/json");
+    return httpd_resp_sendstr(req,"{\"ok\":true}\n");
+}
+
+/* ================= /api/net (hálózat + anchor lista, cfg_store) =================
+   Újraindítás után érvényes: élő IP csere nem kell, a blob mentése késleltetett. */
+static void ip_str(char* b, uint32_t a){ ip4_addr_t x; x.addr=a; ip4addr_ntoa_r(&x,b,16); }
+static esp_err_t api_net_get(httpd_req_t* req){
+    if(!require_role(req, ROLE_ROOT)) return ESP_FAIL;
+    sys_cfg_t c; cfg_store_get(&c);
+    cfg_store_stats_t st; cfg_store_get_stats(&st);
+    char b[16];
+    JsonW w; json_begin(req,w);
+    jw_obj(w);
+    ip_str(b,c.ip);      jw_kv_str(w,"ip",b);
+    ip_str(b,c.gw);      jw_kv_str(w,"gw",b);
+    ip_str(b,c.mask);    jw_kv_str(w,"mask",b);
+    ip_str(b,c.dns1);    jw_kv_str(w,"dns1",b);
+    ip_str(b,c.dns2);    jw_kv_str(w,"dns2",b);
+    ip_str(b,c.udp_dst); jw_kv_str(w,"udp_dst",b);
+    jw_kv_u32(w,"udp_port",c.udp_port);
+    jw_kv_str(w,"anchors",c.anchors);
+    jw_key(w,"store"); jw_obj(w);
+    jw_kv_u32(w,"schema",CFGB_VER);
+    jw_kv_u32(w,"loaded_ver",st.loaded_ver);
+    jw_kv_u32(w,"sets",st.sets);
+    jw_kv_u32(w,"writes",st.writes);
+    jw_kv_u32(w,"write_errors",st.write_errors);
+    jw_obj_end(w);
+    jw_obj_end(w);
+    return json_end(req,w);
+}
+struct NetBody {
+    char anchors[CFGB_ANCHORS];
+    char dns1[16], dns2[16], gw[16], ip[16], mask[16], udp_dst[16];
+    uint16_t udp_port;
+};
+static const JrField k_net_json[] = {          // strcmp sorrend
+    JR_STR(NetBody, anchors, 0), JR_STR(NetBody, dns1, 1), JR_STR(NetBody, dns2, 2),
+    JR_STR(NetBody, gw, 3),      JR_STR(NetBody, ip, 4),   JR_STR(NetBody, mask, 5),
+    JR_STR(NetBody, udp_dst, 6), JR_NUM(NetBody, udp_port, JF_U16, 7, 1, 0xFFFF),
+};
+struct NetSave { const NetBody* b; uint32_t set; uint32_t ip[7]; };
+static void net_put(sys_cfg_t* c, void* arg){
+    const NetSave& n=*(const NetSave*)arg;
+    uint32_t* d[7]={nullptr,&c->dns1,&c->dns2,&c->gw,&c->ip,&c->mask,&c->udp_dst};
+    for(uint8_t bit=1;bit<=6;bit++) if(n.set & (1u<<bit)) *d[bit]=n.ip[bit];
+    if(n.set & (1u<<0)) memcpy(c->anchors,n.b->anchors,sizeof(c->anchors));
+    if(n.set & (1u<<7)) c->udp_port=n.b->udp_port;
+}
+static esp_err_t api_net_post(httpd_req_t* req){
+    if(!require_role(req, ROLE_ROOT)) return ESP_FAIL;
+    NetBody b{}; JsonR jr;
+    if(recv_json(req,jr,k_net_json,sizeof(k_net_json)/sizeof(k_net_json[0]),&b)!=ESP_OK) return ESP_FAIL;
+    NetSave n{&b,jr.set,{}};
+    const char* ips[7]={nullptr,b.dns1,b.dns2,b.gw,b.ip,b.mask,b.udp_dst};
+    for(uint8_t bit=1;bit<=6;bit++){
+        if(!(jr.set & (1u<<bit))) continue;
+        ip4_addr_t a;
+        if(!ip4addr_aton(ips[bit],&a)) return httpd_resp_send_err(req,HTTPD_400_BAD_REQUEST,"bad address");
+        n.ip[bit]=a.addr;
+    }
+    cfg_store_update(net_put,&n);
     httpd_resp_set_type(req,"application/json");
-    return httpd_resp_send(req,buf,n);
+    return httpd_resp_sendstr(req,"{\"ok\":true,\"reboot\":true}\n");
 }
 
 /* ================= BLE notify + TLV GET diagnosztika ================= */
-static volatile bool     s_ack_seen     = false;
-static uint64_t          s_last_tlv_us  = 0;
-static std::vector<uint8_t> s_bytes;
-struct Frame { bool from_cfg; uint16_t len; };
-static std::vector<Frame> s_frames;
-
-static inline uint16_t rd16be(const uint8_t* p){ return (uint16_t)p[0]<<8 | p[1]; }
-static inline uint32_t rd32be(const uint8_t* p){ return ((uint32_t)p[0]<<24)|((uint32_t)p[1]<<16)|((uint32_t)p[2]<<8)|p[3]; }
-
-static void on_ble_notify(const uint8_t* p, uint16_t n, bool from_cfg){
-    if(!p || n==0) return;
-    if(n==6 && p[0]==1 && p[1]==0x81){ s_ack_seen=true; return; }       // ACK
-    if(n>=2 && p[0]==1 && p[1]==0x90) return;                            // STATE → eldob
-    s_frames.push_back(Frame{from_cfg,n});
-    s_bytes.insert(s_bytes.end(),p,p+n);
-    s_last_tlv_us = esp_timer_get_time();
-    // napló rövid hexdump
-    char line[192]; int wp=0;
-    wp+=snprintf(line+wp,sizeof(line)-wp,"[%s] len=%u: ",from_cfg?"CFG":"DATA",(unsigned)n);
-    for (int i=0;i<n && wp<(int)sizeof(line)-3;i++) wp+=snprintf(line+wp,sizeof(line)-wp,"%02X ",p[i]);
-    ESP_LOGI(TAG,"%s",line);
-}
-
-static esp_err_t api_dwm_get(httpd_req_t* req){
-    if(!require_role(req, ROLE_BLE)) return ESP_FAIL;
+static void on_ble_notify(uint8_t link, const uint8_t* p, uint16_t n, bool from_cfg){
+    if(!p || n==0 || !from_cfg) return;
+    dwm_cache_on_notify(link,p,n,from_cfg);
+    cfg_engine_on_notify(link,p,n,from_cfg);
+    blog_put(BLF_HEX,link,p,n);     // napló hexdump: a host formázza (WEB csatorna)
+}
 
-    s_ack_seen=false; s_last_tlv_us=0; s_bytes.clear(); s_frames.clear();
-    static uint16_t s_req=1; s_req++; (void)ble_send_get(s_req);
-
-    const uint64_t t0=esp_timer_get_time();
-    while(!s_ack_seen && (esp_timer_get_time()-t0)<800000ULL) vTaskDelay(pdMS_TO_TICKS(10));
-    const uint64_t t1=esp_timer_get_time();
-    for(;;){
-        uint64_t now=esp_timer_get_time();
-        if(s_last_tlv_us && (now-s_last_tlv_us)>200000ULL) break;
-        if((now-t1)>1500000ULL) break;
-        vTaskDelay(pdMS_TO_TICKS(20));
+/* /api/dwm_get[?anchor=N&max_age=ms] — meleg cache esetén azonnal válaszol */
+static esp_err_t api_dwm_get(httpd_req_t* req, user_role_t){
+    uint32_t max_age=DWM_CACHE_TTL_MS;
+    uint8_t  anchor;
+    if(!anchor_arg(req,&anchor)) return httpd_resp_send_err(req,HTTPD_400_BAD_REQUEST,"anchor");
+    char q[64], v[12];
+    if(httpd_req_get_url_query_str(req,q,sizeof(q))==ESP_OK &&
+       httpd_query_key_value(q,"max_age",v,sizeof(v))==ESP_OK) max_age=strtoul(v,nullptr,10);
+
+    DwmSnapshot snap;
+    esp_err_t er=dwm_cache_get(anchor,&snap,max_age,DWM_ACK_TIMEOUT_MS+1500);
+    if(er!=ESP_OK) return send_dwm_err(req,er);
+
+    const uint8_t* bytes=snap.bytes;
+    const size_t alen=snap.len;
+
+    // TLV → JSON + RAW_HEX, FRAMES: egy menetben a chunk pufferbe
+    JsonW w; json_begin(req,w);
+    jw_obj(w);
+    jw_kv_u32(w,"ANCHOR",anchor);
+    jw_kv_u32(w,"SNAP_VER",snap.version);
+    jw_kv_i64(w,"SNAP_AGE_MS",(esp_timer_get_time()-snap.t_us)/1000);
+    jw_kv_u32(w,"REQ_ID",snap.req_id);
+
+    tlv_cur_t cur; tlv_t t;
+    tlv_cur_init(&cur, bytes, (uint16_t)alen);
+    while(tlv_next(&cur,&t)==TLV_ITEM){
+        if(t.tag==T_VER || !tlv_width_ok(&t)) continue;
+        jw_key(w,t.d->name);
+        if(t.len>4)                       jw_hex(w,t.val,t.len);
+        else if(t.d->fmt==TLV_FMT_DEC)    jw_u32(w,tlv_u32(&t));
+        else if(t.d->fmt==TLV_FMT_SDEC)   jw_i32(w,tlv_i32(&t));
+        else if(t.d->fmt==TLV_FMT_HEX)    jw_hex_u32(w,tlv_u32(&t),t.len*2);
+        else                              jw_hex(w,t.val,t.len);
     }
 
-    // TLV → JSON + RAW_HEX, FRAMES
-    char json[2048]; size_t wp=0; bool first=true;
-    auto add=[&](const char* k, const char* v){ wp+=snprintf(json+wp,sizeof(json)-wp,"%s\"%s\":%s",first?"":",",k,v); first=false; };
-    wp+=snprintf(json+wp,sizeof(json)-wp,"{");
-
-    size_t off=0, alen=s_bytes.size();
-    if(alen>=2 && s_bytes[0]==0x00){ uint8_t l=s_bytes[1]; if(alen>=2+l) off=2+l; } // VER skip
-
-    auto name_of=[](uint8_t t)->const char*{
-        switch(t){
-            case 0x10: return "NETWORK_ID"; case 0x11: return "ZONE_ID";
-            case 0x12: return "ANCHOR_ID";  case 0x13: return "TX_ANT_DLY";
-            case 0x14: return "RX_ANT_DLY"; case 0x16: return "BIAS_TICKS";
-            case 0x1F: return "LOG_LEVEL";  case 0x20: return "HB_MS";
-            case 0x40: return "PHY_CH";     case 0x49: return "PHY_SFDTO";
-            default:   return nullptr;
-        }
-    };
+    jw_key(w,"RAW_HEX"); jw_hex(w,bytes,alen);
+    jw_key(w,"FRAMES");  jw_arr(w);
+    for(size_t i=0;i<snap.nframes;i++){
+        jw_arr(w);
+        jw_str(w,snap.frames[i].from_cfg?"CFG":"DATA");
+        jw_u32(w,snap.frames[i].len);
+        jw_arr_end(w);
+    }
+    jw_arr_end(w);
+    jw_obj_end(w);
+    return json_end(req,w);
+}
+
+/* /api/anchors — BLE linkek állapota */
+static esp_err_t api_anchors_get(httpd_req_t* req){
+    if(!require_role(req, ROLE_BLE)) return ESP_FAIL;
+    JsonW w; json_begin(req,w);
+    jw_arr(w);
+    for(uint8_t l=0;l<BLE_MAX_LINKS;l++){
+        ble_link_info_t li;
+        if(!ble_link_info(l,&li)) continue;
+        jw_obj(w);
+        jw_kv_u32(w,"anchor",l);
+        jw_kv_str(w,"filter",li.filter);
+        jw_kv_bool(w,"connected",li.connected);
+        char bda[18];
+        snprintf(bda,sizeof(bda),"%02X:%02X:%02X:%02X:%02X:%02X",li.bda[0],li.bda[1],li.bda[2],li.bda[3],li.bda[4],li.bda[5]);
+        jw_kv_str(w,"bda",bda);
+        jw_kv_u32(w,"mtu",li.mtu);
+        jw_kv_u32(w,"notifies",li.notifies);
+        jw_kv_u32(w,"bytes",li.notify_bytes);
+        jw_kv_u32(w,"connects",li.connects);
+        jw_key(w,"wq"); jw_obj(w);
+        jw_kv_u32(w,"depth",li.wq_depth);
+        jw_kv_u32(w,"high",li.wq_high);
+        jw_kv_u32(w,"writes",li.writes);
+        jw_kv_u32(w,"no_rsp",li.write_nr);
+        jw_kv_u32(w,"long",li.write_long);
+        jw_kv_u32(w,"err",li.write_err);
+        jw_kv_u32(w,"full",li.wq_full);
+        jw_obj_end(w);
+        jw_key(w,"link"); jw_obj(w);
+        jw_kv_num(w,"int_ms",li.conn_int*1.25,2);
+        jw_kv_u32(w,"latency",li.conn_latency);
+        jw_kv_u32(w,"timeout_ms",li.conn_timeout*10u);
+        jw_kv_u32(w,"tx_len",li.tx_len);
+        jw_kv_u32(w,"rx_len",li.rx_len);
+        jw_kv_u32(w,"tx_phy",li.tx_phy);
+        jw_kv_u32(w,"rx_phy",li.rx_phy);
+        jw_obj_end(w);
+        jw_key(w,"goodput"); jw_obj(w);
+        jw_kv_num(w,"fps",li.rx_mhz/1000.0,2);
+        jw_kv_u32(w,"Bps",li.rx_Bps);
+        jw_kv_num(w,"avg_fps",li.up_us>0?li.notifies*1e6/li.up_us:0.0,2);
+        jw_kv_i64(w,"up_s",li.up_us/1000000);
+        jw_obj_end(w);
+        jw_key(w,"reconnect"); jw_obj(w);
+        jw_kv_bool(w,"cached",li.cached);
+        jw_kv_bool(w,"fast",li.fast);
+        jw_kv_u32(w,"last_ms",li.reconnect_ms);
+        jw_kv_u32(w,"fast_opens",li.fast_opens);
+        jw_kv_u32(w,"discoveries",li.discoveries);
+        jw_obj_end(w);
+        jw_obj_end(w);
+    }
+    jw_arr_end(w);
+    return json_end(req,w);
+}
+
+/* /api/ble_params — link hangolás (conn interval, latency, timeout, DLE, PHY) */
+static esp_err_t api_ble_params_get(httpd_req_t* req){
+    if(!require_role(req, ROLE_ROOT)) return ESP_FAIL;
+    ble_link_params_t c; ble_get_link_params(&c);
+    JsonW w; json_begin(req,w);
+    jw_obj(w);
+    jw_kv_u32(w,"min_int",c.min_int);
+    jw_kv_u32(w,"max_int",c.max_int);
+    jw_kv_u32(w,"latency",c.latency);
+    jw_kv_u32(w,"timeout",c.timeout);
+    jw_kv_u32(w,"data_len",c.data_len);
+    jw_kv_bool(w,"phy_2m",c.phy_2m);
+    jw_obj_end(w);
+    return json_end(req,w);
+}
+struct BleParamsBody { ble_link_params_t p; bool apply; };
+#define BP(m, t, b, hi) { #m, t, b, (uint16_t)offsetof(BleParamsBody, p.m), 0, 0, hi }
+static const JrField k_ble_params_json[] = {    // strcmp sorrend; tartomány: ble_set_link_params
+    { "apply", JF_BOOL, 0, (uint16_t)offsetof(BleParamsBody, apply), 0, 0, 1 },
+    BP(data_len, JF_U16, 1, 0xFFFF), BP(latency, JF_U16, 2, 0xFFFF), BP(max_int, JF_U16, 3, 0xFFFF),
+    BP(min_int,  JF_U16, 4, 0xFFFF), BP(phy_2m,  JF_BOOL, 5, 1),     BP(timeout, JF_U16, 6, 0xFFFF),
+};
+#undef BP
+static esp_err_t api_ble_params_post(httpd_req_t* req){
+    if(!require_role(req, ROLE_ROOT)) return ESP_FAIL;
+    BleParamsBody b{}; ble_get_link_params(&b.p); JsonR jr;
+    if(recv_json(req,jr,k_ble_params_json,sizeof(k_ble_params_json)/sizeof(k_ble_params_json[0]),&b)!=ESP_OK) return ESP_FAIL;
+    if(ble_set_link_params(&b.p,b.apply)!=ESP_OK) return httpd_resp_send_err(req,HTTPD_400_BAD_REQUEST,"range");
+    httpd_resp_set_type(req,"application/json");
+    return httpd_resp_sendstr(req,"{\"ok\":true}\n");
+}
 
-    while(off+2<=alen){
-        uint8_t t=s_bytes[off], l=s_bytes[off+1]; off+=2;
-        if(off+l>alen) break;
-        const uint8_t* v=&s_bytes[off]; off+=l;
-        const char* nm=name_of(t); if(!nm) continue;
-        char vb[32];
-        if(l==1) snprintf(vb,sizeof(vb),"%u",(unsigned)v[0]);
-        else if(l==2) snprintf(vb,sizeof(vb),"%u",(unsigned)rd16be(v));
-        else if(l==4) snprintf(vb,sizeof(vb),"\"0x%08" PRIX32 "\"", rd32be(v));
-        else continue;
-        add(nm,vb);
+/* ================= /api/tags (aktív tagok) =================
+   Tagonként: ráta (EWMA), utoljára látva, veszteség / duplikátum számlálók. */
+static esp_err_t api_tags_get(httpd_req_t* req){
+    if(!require_role(req, ROLE_BLE)) return ESP_FAIL;
+    const int64_t now=esp_timer_get_time();
+    JsonW w; json_begin(req,w);
+    jw_obj(w);
+    jw_kv_u32(w,"count",uplink_tag_count());
+    jw_kv_u32(w,"cap",TT_MAX_TAGS);
+    jw_key(w,"tags"); jw_arr(w);
+    for(uint32_t i=0;i<TT_MAX_TAGS;i++){
+        tt_tag_stats_t t;
+        if(!uplink_tag_get(i,&t)) continue;
+        jw_obj(w);
+        jw_kv_u32(w,"anchor_id",t.anchor_id);
+        jw_kv_u32(w,"tag_id",t.tag_id);
+        jw_kv_num(w,"rate_hz",t.rate_mhz/1000.0,2);
+        jw_kv_i64(w,"last_ms",(now-t.last_us)/1000);
+        jw_kv_i64(w,"up_s",(t.last_us-t.first_us)/1000000);
+        jw_kv_u32(w,"frames",t.frames);
+        jw_kv_u32(w,"lost",t.lost);
+        jw_kv_u32(w,"sync_lost",t.sync_lost);
+        jw_kv_u32(w,"dups",t.dups);
+        jw_kv_u32(w,"reorders",t.reorders);
+        jw_kv_u32(w,"resets",t.resets);
+        jw_kv_u32(w,"wraps",t.wraps);
+        jw_kv_u32(w,"seq_rolls",t.seq_rolls);
+        jw_kv_u64(w,"ts64",t.ts64);
+        jw_obj_end(w);
     }
+    jw_arr_end(w);
+    jw_obj_end(w);
+    return json_end(req,w);
+}
 
-    // RAW_HEX
-    {
-        std::string hex; hex.reserve(alen*3);
-        for(size_t i=0;i<alen;i++){ char b[4]; snprintf(b,sizeof(b),"%02X ",s_bytes[i]); hex+=b; }
-        if(!hex.empty()) hex.pop_back();
-        char b[1024]; snprintf(b,sizeof(b),"\"%s\"",hex.c_str());
-        add("RAW_HEX",b);
+/* ================= /api/boot idővonal =================
+   Szakaszok a boot_stage_t sorrendjében; t_ms: az app indulása óta, null ha még nem volt. */
+static esp_err_t api_boot_get(httpd_req_t* req){
+    if(!require_role(req, ROLE_DIAG)) return ESP_FAIL;
+    JsonW w; json_begin(req,w);
+    jw_obj(w);
+    jw_key(w,"stages"); jw_arr(w);
+    for(int i=0;i<BOOT__COUNT;i++){
+        const int64_t t=boot_t_us((boot_stage_t)i);
+        jw_obj(w);
+        jw_kv_str(w,"name",boot_name((boot_stage_t)i));
+        jw_key(w,"t_ms");
+        if(t<0) jw_raw(w,"null",4); else jw_num(w,t/1000.0,1);
+        jw_obj_end(w);
     }
-    // FRAMES
-    {
-        std::string fr="[";
-        for(size_t i=0;i<s_frames.size();i++){
-            char b[32]; snprintf(b,sizeof(b),"%s[\"%s\",%u]",i?",":"",s_frames[i].from_cfg?"CFG":"DATA",(unsigned)s_frames[i].len);
-            fr+=b;
+    jw_arr_end(w);
+    jw_obj_end(w);
+    return json_end(req,w);
+}
+
+/* ================= /api/capture: NOTIFY felvétel (.ncap) =================
+   GET: állapot; POST {"run":bool,"clear":bool}; /api/capture.bin: letöltés
+   (tools/ncap_replay.c játssza vissza host-on). */
+static esp_err_t capture_json(httpd_req_t* req){
+    capture_stats_t c; capture_get_stats(&c);
+    JsonW w; json_begin(req,w);
+    jw_obj(w);
+    jw_kv_bool(w,"running",c.running);
+    jw_kv_u32(w,"cap",c.cap);
+    jw_kv_u32(w,"used",c.used);
+    jw_kv_u32(w,"records",c.records);
+    jw_kv_u32(w,"total",c.total);
+    jw_kv_u32(w,"dropped",c.dropped);
+    jw_kv_num(w,"span_s",c.span_us/1e6,3);
+    jw_obj_end(w);
+    return json_end(req,w);
+}
+static esp_err_t api_capture_get(httpd_req_t* req){
+    if(!require_role(req, ROLE_DIAG)) return ESP_FAIL;
+    return capture_json(req);
+}
+struct CaptureBody { bool clear, run; };
+static const JrField k_capture_json[] = {       // strcmp sorrend
+    { "clear", JF_BOOL, 0, (uint16_t)offsetof(CaptureBody, clear), 0, 0, 1 },
+    { "run",   JF_BOOL, 1, (uint16_t)offsetof(CaptureBody, run),   0, 0, 1 },
+};
+static esp_err_t api_capture_post(httpd_req_t* req){
+    if(!require_role(req, ROLE_DIAG)) return ESP_FAIL;
+    CaptureBody b{}; JsonR jr;
+    if(recv_json(req,jr,k_capture_json,2,&b)!=ESP_OK) return ESP_FAIL;
+    if((jr.set&2) && !b.run) capture_stop();
+    if((jr.set&1) && b.clear) capture_clear();
+    if((jr.set&2) && b.run && capture_start()!=ESP_OK)
+        return httpd_resp_send_err(req,HTTPD_500_INTERNAL_SERVER_ERROR,"no memory");
+    return capture_json(req);
+}
+static esp_err_t api_capture_bin(httpd_req_t* req){
+    if(!require_role(req, ROLE_DIAG)) return ESP_FAIL;
+    httpd_resp_set_type(req,"application/octet-stream");
+    httpd_resp_set_hdr(req,"Content-Disposition","attachment; filename=\"notify.ncap\"");
+    capture_dump(resp_chunk,req);
+    return httpd_resp_send_chunk(req,nullptr,0);
+}
+
+/* ================= /api/sim: szimulált anchorok (terheléses teszt) =================
+   GET: számlálók; POST {"run":true, ...}: (újra)indítás a megadott + korábbi
+   paraméterekkel, {"run":false}: leállítás. links = 0: a szabad linkek. */
+static asim_cfg_t s_sim_cfg = {
+    .link = 0, .anchor_id = 0x51A00000u, .network_id = 0, .tags = 16, .tag_base = 0x7A000000u,
+    .rate_mhz = 10000, .hb_ms = 1000, .state_ms = 5000, .sync_ms = 100,
+};
+static uint8_t s_sim_links;
+
+static esp_err_t sim_json(httpd_req_t* req){
+    ble_sim_stats_t s; ble_sim_get_stats(&s);
+    JsonW w; json_begin(req,w);
+    jw_obj(w);
+    jw_kv_bool(w,"running",s.running);
+    jw_kv_u32(w,"links",s.links);
+    jw_kv_u32(w,"tags",s_sim_cfg.tags);
+    jw_kv_u32(w,"rate_mhz",s_sim_cfg.rate_mhz);
+    jw_kv_u32(w,"data",s.st.data);
+    jw_kv_u32(w,"lost",s.st.lost);
+    jw_kv_u32(w,"dups",s.st.dups);
+    jw_kv_u32(w,"hb",s.st.hb);
+    jw_kv_u32(w,"state",s.st.state);
+    jw_kv_u32(w,"gets",s.st.gets);
+    jw_kv_u32(w,"sets",s.st.sets);
+    jw_kv_u32(w,"applied",s.st.applied);
+    jw_kv_u32(w,"rejected",s.st.rejected);
+    jw_kv_u32(w,"bad_cmd",s.st.bad_cmd);
+    jw_kv_u32(w,"resp_drop",s.st.resp_drop);
+    jw_kv_u32(w,"stalls",s.st.stalls);
+    jw_obj_end(w);
+    return json_end(req,w);
+}
+static esp_err_t api_sim_get(httpd_req_t* req){
+    if(!require_role(req, ROLE_ROOT)) return ESP_FAIL;
+    return sim_json(req);
+}
+struct SimBody {
+    uint32_t dup_ppm, loss_ppm, rate_mhz;
+    uint16_t hb_ms, outage_every_ms, outage_ms, state_ms, tags;
+    uint8_t  links;
+    bool     run;
+};
+static const JrField k_sim_json[] = {           // strcmp sorrend
+    JR_NUM(SimBody, dup_ppm,         JF_U32,  0, 0, 1000000),
+    JR_NUM(SimBody, hb_ms,           JF_U16,  1, 0, 60000),
+    JR_NUM(SimBody, links,           JF_U8,   2, 0, (1 << BLE_MAX_LINKS) - 1),
+    JR_NUM(SimBody, loss_ppm,        JF_U32,  3, 0, 1000000),
+    JR_NUM(SimBody, outage_every_ms, JF_U16,  4, 0, 60000),
+    JR_NUM(SimBody, outage_ms,       JF_U16,  5, 0, 60000),
+    JR_NUM(SimBody, rate_mhz,        JF_U32,  6, 0, 1000000),
+    JR_NUM(SimBody, run,             JF_BOOL, 7, 0, 1),
+    JR_NUM(SimBody, state_ms,        JF_U16,  8, 0, 60000),
+    JR_NUM(SimBody, tags,            JF_U16,  9, 0, ASIM_MAX_TAGS),
+};
+static esp_err_t api_sim_post(httpd_req_t* req){
+    if(!require_role(req, ROLE_ROOT)) return ESP_FAIL;
+    SimBody b{}; JsonR jr;
+    if(recv_json(req,jr,k_sim_json,sizeof(k_sim_json)/sizeof(k_sim_json[0]),&b)!=ESP_OK) return ESP_FAIL;
+    if(jr.set&(1u<<0)) s_sim_cfg.dup_ppm=b.dup_ppm;
+    if(jr.set&(1u<<1)) s_sim_cfg.hb_ms=b.hb_ms;
+    if(jr.set&(1u<<2)) s_sim_links=b.links;
+    if(jr.set&(1u<<3)) s_sim_cfg.loss_ppm=b.loss_ppm;
+    if(jr.set&(1u<<4)) s_sim_cfg.outage_every_ms=b.outage_every_ms;
+    if(jr.set&(1u<<5)) s_sim_cfg.outage_ms=b.outage_ms;
+    if(jr.set&(1u<<6)) s_sim_cfg.rate_mhz=b.rate_mhz;
+    if(jr.set&(1u<<8)) s_sim_cfg.state_ms=b.state_ms;
+    if(jr.set&(1u<<9)) s_sim_cfg.tags=b.tags;
+    if(jr.set&(1u<<7)){
+        if(!b.run) ble_sim_stop();
+        else{
+            s_sim_cfg.seed=(uint32_t)esp_timer_get_time();
+            const esp_err_t er=ble_sim_start(&s_sim_cfg,s_sim_links);
+            if(er==ESP_ERR_NOT_FOUND) return httpd_resp_send_err(req,HTTPD_400_BAD_REQUEST,"no free link");
+            if(er!=ESP_OK) return httpd_resp_send_err(req,HTTPD_500_INTERNAL_SERVER_ERROR,"sim start failed");
         }
-        fr+="]";
-        add("FRAMES",fr.c_str());
     }
+    return sim_json(req);
+}
 
-    wp+=snprintf(json+wp,sizeof(json)-wp,"}\n");
-    httpd_resp_set_type(req,"application/json");
-    return httpd_resp_send(req,json,wp);
+/* ================= /api/blog: bináris napló =================
+   GET: csatornák (szint, ráta), gyűrű, kimenetek; POST {"data":4,"data_rate":0,"file":true,...}
+   (szint: 0..5 = NONE..VERBOSE); /api/blog.bin: letöltés (tools/blog_decode.c). */
+static esp_err_t blog_json(httpd_req_t* req){
+    blog_stats_t b; blog_get_stats(&b);
+    JsonW w; json_begin(req,w);
+    jw_obj(w);
+    jw_kv_bool(w,"uart",(b.sinks&BLOG_SINK_UART)!=0);
+    jw_kv_bool(w,"file",(b.sinks&BLOG_SINK_FILE)!=0);
+    jw_kv_u32(w,"ring_cap",b.ring_cap);
+    jw_kv_u32(w,"ring_used",b.ring_used);
+    jw_kv_u32(w,"ring_high",b.ring_high);
+    jw_kv_u32(w,"written",b.written);
+    jw_kv_u32(w,"dropped",b.dropped);
+    jw_kv_u32(w,"uart_bytes",b.uart_bytes);
+    jw_kv_u32(w,"uart_lines",b.uart_lines);
+    jw_kv_u32(w,"file_bytes",b.file_bytes);
+    jw_key(w,"channels"); jw_arr(w);
+    for(int i=0;i<BLOG_CH__COUNT;i++){
+        jw_obj(w);
+        jw_kv_str(w,"name",blog_ch_name((uint8_t)i));
+        jw_kv_u32(w,"level",b.ch[i].level);
+        jw_kv_u32(w,"rate",b.ch[i].rate);
+        jw_kv_u32(w,"written",b.ch[i].written);
+        jw_kv_u32(w,"suppressed",b.ch[i].suppressed);
+        jw_obj_end(w);
+    }
+    jw_arr_end(w);
+    jw_obj_end(w);
+    return json_end(req,w);
+}
+static esp_err_t api_blog_get(httpd_req_t* req){
+    if(!require_role(req, ROLE_DIAG)) return ESP_FAIL;
+    return blog_json(req);
+}
+struct BlogBody {
+    uint8_t  ble, cfg, data, web;
+    uint32_t ble_rate, cfg_rate, data_rate, web_rate;
+    bool     file, uart;
+};
+static const JrField k_blog_json[] = {          // strcmp sorrend
+    JR_NUM(BlogBody, ble,       JF_U8,   0, 0, BLOG_LVL_V),
+    JR_NUM(BlogBody, ble_rate,  JF_U32,  1, 0, 100000),
+    JR_NUM(BlogBody, cfg,       JF_U8,   2, 0, BLOG_LVL_V),
+    JR_NUM(BlogBody, cfg_rate,  JF_U32,  3, 0, 100000),
+    JR_NUM(BlogBody, data,      JF_U8,   4, 0, BLOG_LVL_V),
+    JR_NUM(BlogBody, data_rate, JF_U32,  5, 0, 100000),
+    JR_NUM(BlogBody, file,      JF_BOOL, 6, 0, 1),
+    JR_NUM(BlogBody, uart,      JF_BOOL, 7, 0, 1),
+    JR_NUM(BlogBody, web,       JF_U8,   8, 0, BLOG_LVL_V),
+    JR_NUM(BlogBody, web_rate,  JF_U32,  9, 0, 100000),
+};
+static esp_err_t api_blog_post(httpd_req_t* req){
+    if(!require_role(req, ROLE_DIAG)) return ESP_FAIL;
+    BlogBody b{}; JsonR jr;
+    if(recv_json(req,jr,k_blog_json,sizeof(k_blog_json)/sizeof(k_blog_json[0]),&b)!=ESP_OK) return ESP_FAIL;
+    struct { blog_ch_t ch; uint8_t bit; const uint8_t* lvl; const uint32_t* rate; } const m[] = {
+        { BLOG_CH_BLE,  0, &b.ble,  &b.ble_rate  }, { BLOG_CH_CFG, 2, &b.cfg, &b.cfg_rate },
+        { BLOG_CH_DATA, 4, &b.data, &b.data_rate }, { BLOG_CH_WEB, 8, &b.web, &b.web_rate },
+    };
+    for(const auto& x: m){
+        if(jr.set&(1u<<x.bit))     blog_set_level(x.ch,*x.lvl);
+        if(jr.set&(1u<<(x.bit+1))) blog_set_rate(x.ch,*x.rate);
+    }
+    if(jr.set&((1u<<6)|(1u<<7))){
+        blog_stats_t s; blog_get_stats(&s);
+        uint32_t sinks=s.sinks;
+        if(jr.set&(1u<<6)) sinks=b.file ? (sinks|BLOG_SINK_FILE) : (sinks&~BLOG_SINK_FILE);
+        if(jr.set&(1u<<7)) sinks=b.uart ? (sinks|BLOG_SINK_UART) : (sinks&~BLOG_SINK_UART);
+        blog_set_sinks(sinks);
+    }
+    return blog_json(req);
+}
+static esp_err_t api_blog_bin(httpd_req_t* req){
+    if(!require_role(req, ROLE_DIAG)) return ESP_FAIL;
+    httpd_resp_set_type(req,"application/octet-stream");
+    httpd_resp_set_hdr(req,"Content-Disposition","attachment; filename=\"gateway.blog\"");
+    blog_dump(resp_chunk_ok,req);
+    return httpd_resp_send_chunk(req,nullptr,0);
+}
+
+/* ================= /ws élő folyam =================
+   Státusz bárkinek (login oldal); DATA/HB/STATE csak BLE szereptől. */
+static esp_err_t ws_live(httpd_req_t* req){
+    if(req->method==HTTP_GET){
+        uint8_t allowed=LIVE_F_STATUS;
+        if(role_from_auth(req)>=ROLE_BLE) allowed|=LIVE_F_DATA|LIVE_F_CFG;
+        return live_ws_open(req,allowed);
+    }
+    return live_ws_recv(req);
+}
+
+/* ================= /api/metrics (Prometheus) ================= */
+static esp_err_t api_metrics_get(httpd_req_t* req){
+    if(!require_role(req, ROLE_DIAG)) return ESP_FAIL;
+    httpd_resp_set_type(req,"text/plain; version=0.0.4");
+    metrics_render(resp_chunk, req);
+
+    // a modulok saját számlálói
+    ble_rx_stats_t rx; ble_get_rx_stats(&rx);
+    metrics_emit_value(resp_chunk,req,"ble_rx_ring_high_water","gauge","Notify ring peak occupancy",rx.high_water);
+    metrics_emit_value(resp_chunk,req,"ble_rx_truncated_total","counter","Notifies truncated to ring slot",rx.truncated);
+    uplink_stats_t up; uplink_get_stats(&up);
+    metrics_emit_value(resp_chunk,req,"uplink_frames_in_total","counter","DATA frames queued for UDP",up.frames_in);
+    metrics_emit_value(resp_chunk,req,"uplink_frames_dropped_total","counter","DATA frames dropped, uplink queue full",up.frames_dropped);
+    metrics_emit_value(resp_chunk,req,"uplink_frames_dup_total","counter","Duplicate DATA frames suppressed",up.frames_dup);
+    metrics_emit_value(resp_chunk,req,"uplink_datagrams_total","counter","UDP datagrams sent",up.datagrams);
+    metrics_emit_value(resp_chunk,req,"uplink_send_errors_total","counter","UDP send errors",up.send_errors);
+    metrics_emit_value(resp_chunk,req,"uplink_bytes_total","counter","UDP payload bytes sent",up.bytes_sent);
+    uplink_journal_stats_t js; uplink_get_journal_stats(&js);
+    metrics_emit_value(resp_chunk,req,"journal_pending","gauge","Journaled datagrams awaiting replay",js.jr.pending);
+    metrics_emit_value(resp_chunk,req,"journal_appended_bytes_total","counter","Datagram bytes written to the journal",js.jr.appended_bytes);
+    metrics_emit_value(resp_chunk,req,"journal_flash_bytes_total","counter","Bytes programmed into the journal partition",js.jr.prog_bytes);
+    metrics_emit_value(resp_chunk,req,"journal_erases_total","counter","Journal block erases",js.jr.erases);
+    metrics_emit_value(resp_chunk,req,"journal_replayed_total","counter","Journaled datagrams replayed",js.jr.replayed);
+    metrics_emit_value(resp_chunk,req,"journal_dropped_total","counter","Journaled datagrams overwritten before replay",js.jr.dropped);
+    uint32_t lost=0,sync_lost=0,n=uplink_tag_count();
+    for(uint32_t i=0;i<TT_MAX_TAGS;i++){ tt_tag_stats_t t; if(uplink_tag_get(i,&t)){ lost+=t.lost; sync_lost+=t.sync_lost; } }
+    metrics_emit_value(resp_chunk,req,"tags_tracked","gauge","Active tags in the tracking table",n);
+    metrics_emit_value(resp_chunk,req,"tag_frames_lost","gauge","tag_seq gaps over active tags",lost);
+    metrics_emit_value(resp_chunk,req,"tag_sync_lost","gauge","sync_seq gaps over active tags",sync_lost);
+    HttpAsyncStats as; http_async_stats(&as);
+    metrics_emit_value(resp_chunk,req,"http_async_high_water","gauge","Async requests queued or running, peak",as.high);
+    return httpd_resp_send_chunk(req,nullptr,0);
 }
 
 /* ================= Server start/stop ================= */
+/* minden HTTP handler mérve: az eredeti a user_ctx-ben */
+static esp_err_t timed(httpd_req_t* req){
+    const int64_t t0=esp_timer_get_time();
+    esp_err_t er=((httpd_handler_t)req->user_ctx)(req);
+    metric_observe(H_HTTP_MS,(uint32_t)((esp_timer_get_time()-t0)/1000));
+    metric_inc(M_HTTP_REQ);
+    if(er!=ESP_OK) metric_inc(M_HTTP_ERR);
+    return er;
+}
+static void reg(httpd_uri_t u){
+    u.user_ctx=(void*)u.handler; u.handler=timed;
+    httpd_register_uri_handler(s_http,&u);
+}
+/* BLE-re váró handler: worker poolban (http_async), hitelesítés előtte a
+   httpd taskon (rt->need), mérés a workerben */
+static void reg_async(httpd_uri_t u, const HttpAsyncRoute* rt){
+    u.user_ctx=(void*)rt; u.handler=http_async_entry;
+    httpd_register_uri_handler(s_http,&u);
+}
+
 esp_err_t webserver_start(){
     if (s_http) return ESP_OK;
 
     httpd_config_t cfg = HTTPD_DEFAULT_CONFIG();
     cfg.uri_match_fn = httpd_uri_match_wildcard;
-    cfg.max_uri_handlers = 16;
+    cfg.max_uri_handlers = 40;
+    cfg.stack_size = 8192;
+    cfg.max_open_sockets = HTTP_MAX_SOCKETS;
+    auth_reset();
+    ESP_ERROR_CHECK(http_async_init());
     ESP_ERROR_CHECK(httpd_start(&s_http, &cfg));
 
+    ESP_ERROR_CHECK(dwm_cache_init());
+    ESP_ERROR_CHECK(cfg_engine_init());
+    ESP_ERROR_CHECK(live_init(s_http));
     ble_register_notify_cb(on_ble_notify);
 
     httpd_uri_t u{};
 
     u.method=HTTP_GET;
-    u.uri="/login";            u.handler=login_get;        httpd_register_uri_handler(s_http,&u);
-    u.uri="/diag";             u.handler=diag_get;         httpd_register_uri_handler(s_http,&u);
-    u.uri="/ble-data";         u.handler=ble_get;          httpd_register_uri_handler(s_http,&u);
-    u.uri="/admin";            u.handler=admin_get;        httpd_register_uri_handler(s_http,&u);
-    u.uri="/super_user.html";  u.handler=super_user_get;   httpd_register_uri_handler(s_http,&u);
+    u.uri="/login";            u.handler=login_get;        reg(u);
+    u.uri="/diag";             u.handler=diag_get;         reg(u);
+    u.uri="/ble-data";         u.handler=ble_get;          reg(u);
+    u.uri="/admin";            u.handler=admin_get;        reg(u);
+    u.uri="/super_user.html";  u.handler=super_user_get;   reg(u);
+
+    u.uri="/api/status";       u.handler=api_status_get;   reg(u);
+
+    static const HttpAsyncRoute dwm_rt{api_dwm_get,ROLE_BLE};
+    httpd_uri_t dwm_get{};  dwm_get.method=HTTP_GET;  dwm_get.uri="/api/dwm_get";
+    reg_async(dwm_get,&dwm_rt);
+
+    httpd_uri_t ws{};       ws.method=HTTP_GET;       ws.uri="/ws";            ws.handler=ws_live;  ws.is_websocket=true;
+    httpd_register_uri_handler(s_http,&ws);
+
+    httpd_uri_t metrics{};  metrics.method=HTTP_GET;  metrics.uri="/api/metrics";  metrics.handler=api_metrics_get;
+    reg(metrics);
+
+    httpd_uri_t anchors{};  anchors.method=HTTP_GET;  anchors.uri="/api/anchors";  anchors.handler=api_anchors_get;
+    reg(anchors);
+
+    httpd_uri_t tags{};     tags.method=HTTP_GET;     tags.uri="/api/tags";        tags.handler=api_tags_get;
+    reg(tags);
 
-    u.uri="/api/status";       u.handler=api_status_get;   httpd_register_uri_handler(s_http,&u);
+    httpd_uri_t boot{};     boot.method=HTTP_GET;     boot.uri="/api/boot";        boot.handler=api_boot_get;
+    reg(boot);
 
-    httpd_uri_t dwm_get{};  dwm_get.method=HTTP_GET;  dwm_get.uri="/api/dwm_get";  dwm_get.handler=api_dwm_get;
-    httpd_register_uri_handler(s_http,&dwm_get);
+    httpd_uri_t cap_get{};  cap_get.method=HTTP_GET;  cap_get.uri="/api/capture";   cap_get.handler=api_capture_get;
+    reg(cap_get);
+
+    httpd_uri_t cap_post{}; cap_post.method=HTTP_POST; cap_post.uri="/api/capture"; cap_post.handler=api_capture_post;
+    reg(cap_post);
+
+    httpd_uri_t cap_bin{};  cap_bin.method=HTTP_GET;  cap_bin.uri="/api/capture.bin"; cap_bin.handler=api_capture_bin;
+    reg(cap_bin);
+
+    httpd_uri_t sim_get{};  sim_get.method=HTTP_GET;  sim_get.uri="/api/sim";      sim_get.handler=api_sim_get;
+    reg(sim_get);
+
+    httpd_uri_t sim_post{}; sim_post.method=HTTP_POST; sim_post.uri="/api/sim";    sim_post.handler=api_sim_post;
+    reg(sim_post);
+
+    httpd_uri_t blog_get{};  blog_get.method=HTTP_GET;  blog_get.uri="/api/blog";    blog_get.handler=api_blog_get;
+    reg(blog_get);
+
+    httpd_uri_t blog_post{}; blog_post.method=HTTP_POST; blog_post.uri="/api/blog";  blog_post.handler=api_blog_post;
+    reg(blog_post);
+
+    httpd_uri_t blog_bin{};  blog_bin.method=HTTP_GET;  blog_bin.uri="/api/blog.bin"; blog_bin.handler=api_blog_bin;
+    reg(blog_bin);
 
     httpd_uri_t get_cfg{};  get_cfg.method=HTTP_GET;  get_cfg.uri="/api/config";   get_cfg.handler=api_config_get;
-    httpd_register_uri_handler(s_http,&get_cfg);
+    reg(get_cfg);
+
+    static const HttpAsyncRoute post_cfg_rt{api_config_post,ROLE_BLE};
+    httpd_uri_t post_cfg{}; post_cfg.method=HTTP_POST; post_cfg.uri="/api/config";
+    reg_async(post_cfg,&post_cfg_rt);
+
+    httpd_uri_t upl_get{};  upl_get.method=HTTP_GET;  upl_get.uri="/api/uplink";   upl_get.handler=api_uplink_get;
+    reg(upl_get);
+
+    httpd_uri_t upl_post{}; upl_post.method=HTTP_POST; upl_post.uri="/api/uplink"; upl_post.handler=api_uplink_post;
+    reg(upl_post);
+
+    httpd_uri_t blp_get{};  blp_get.method=HTTP_GET;  blp_get.uri="/api/ble_params"; blp_get.handler=api_ble_params_get;
+    reg(blp_get);
+
+    httpd_uri_t blp_post{}; blp_post.method=HTTP_POST; blp_post.uri="/api/ble_params"; blp_post.handler=api_ble_params_post;
+    reg(blp_post);
+
+    httpd_uri_t net_get{};  net_get.method=HTTP_GET;  net_get.uri="/api/net";     net_get.handler=api_net_get;
+    reg(net_get);
 
-    httpd_uri_t post_cfg{}; post_cfg.method=HTTP_POST; post_cfg.uri="/api/config"; post_cfg.handler=api_config_post;
-    httpd_register_uri_handler(s_http,&post_cfg);
+    httpd_uri_t net_post{}; net_post.method=HTTP_POST; net_post.uri="/api/net";   net_post.handler=api_net_post;
+    reg(net_post);
 
     httpd_uri_t auth{};     auth.method=HTTP_POST;    auth.uri="/auth/login";     auth.handler=auth_login_post;
-    httpd_register_uri_handler(s_http,&auth);
+    reg(auth);
 
     // Root és catch-all → login
-    httpd_uri_t root{}; root.method=HTTP_GET; root.uri="/";  root.handler=login_get; httpd_register_uri_handler(s_http,&root);
-    httpd_uri_t any{};  any .method=HTTP_GET; any .uri="/*"; any .handler=login_get; httpd_register_uri_handler(s_http,&any);
+    httpd_uri_t root{}; root.method=HTTP_GET; root.uri="/";  root.handler=login_get; reg(root);
+    httpd_uri_t any{};  any .method=HTTP_GET; any .uri="/*"; any .handler=login_get; reg(any);
 
     ESP_LOGI(TAG,"webserver started");
     return ESP_OK;
@@ -0,0 +1,52 @@
+// main/boot.c — boot szakaszok event group-pal, időbélyegekkel
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "boot.h"
+
+static const char* TAG = "boot";
+
+static EventGroupHandle_t s_eg;
+static int64_t            s_t[BOOT__COUNT];
+
+static const char* const k_names[BOOT__COUNT] = {
+    [BOOT_NVS] = "nvs",           [BOOT_CFG] = "cfg",         [BOOT_NETIF] = "netif",
+    [BOOT_ETH_INIT] = "eth_init", [BOOT_LINK_UP] = "link_up", [BOOT_FS] = "fs",
+    [BOOT_HTTP] = "http",         [BOOT_UPLINK] = "uplink",   [BOOT_BLE_INIT] = "ble_init",
+    [BOOT_BLE_READY] = "ble_ready", [BOOT_FIRST_GET] = "first_get", [BOOT_FIRST_FRAME] = "first_frame",
+};
+
+void boot_init(void)
+{
+    if (s_eg) return;
+    for (int i = 0; i < BOOT__COUNT; i++) s_t[i] = -1;
+    s_eg = xEventGroupCreate();
+}
+
+void boot_mark(boot_stage_t s)
+{
+    if (!s_eg || (unsigned)s >= BOOT__COUNT) return;
+    if (xEventGroupGetBits(s_eg) & BOOT_BIT(s)) return;
+    s_t[s] = esp_timer_get_time();          /* két egyidejű jelzésnél az utolsó marad: elég pontos */
+    xEventGroupSetBits(s_eg, BOOT_BIT(s));
+    ESP_LOGI(TAG, "%-11s %7.1f ms", k_names[s], s_t[s] / 1000.0);
+}
+
+bool boot_wait(uint32_t bits, uint32_t timeout_ms)
+{
+    if (!s_eg) return false;
+    const EventBits_t b = xEventGroupWaitBits(s_eg, bits, pdFALSE, pdTRUE,
+                            timeout_ms == BOOT_FOREVER ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms));
+    return (b & bits) == bits;
+}
+
+int64_t boot_t_us(boot_stage_t s)
+{
+    return ((unsigned)s < BOOT__COUNT) ? s_t[s] : -1;
+}
+
+const char* boot_name(boot_stage_t s)
+{
+    return ((unsigned)s < BOOT__COUNT) ? k_names[s] : "?";
+}
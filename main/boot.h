@@ -0,0 +1,44 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===== Boot szakaszok (event group) + idővonal =====
+ * Minden init lépés a saját bitjét jelzi; a függő lépések erre várnak,
+ * nem fix késleltetésre. Az első jelzés ideje (esp_timer, µs az app indulása
+ * óta) megmarad: /api/boot. A sorrend = kijelzési sorrend. */
+
+typedef enum {
+    BOOT_NVS = 0,        /* nvs_flash_init */
+    BOOT_CFG,            /* cfg_store betöltve, NET kitöltve */
+    BOOT_NETIF,          /* event loop + esp_netif_init */
+    BOOT_ETH_INIT,       /* EMAC/PHY driver fut */
+    BOOT_LINK_UP,        /* Ethernet link (statikus IP) */
+    BOOT_FS,             /* SPIFFS felcsatolva */
+    BOOT_HTTP,           /* webserver fut */
+    BOOT_UPLINK,         /* UDP forwarder fut */
+    BOOT_BLE_INIT,       /* controller + bluedroid + GATTC */
+    BOOT_BLE_READY,      /* első anchor: kapcsolat + CCC engedélyezve */
+    BOOT_FIRST_GET,      /* első DWM GET kiküldve */
+    BOOT_FIRST_FRAME,    /* első DATA keret UDP-n továbbítva */
+    BOOT__COUNT
+} boot_stage_t;
+
+#define BOOT_BIT(s)   (1u << (s))
+#define BOOT_FOREVER  UINT32_MAX
+
+void        boot_init(void);
+/* csak az első hívás számít */
+void        boot_mark(boot_stage_t s);
+/* true: minden bit megvan timeout_ms-en belül (BOOT_FOREVER: nincs timeout) */
+bool        boot_wait(uint32_t bits, uint32_t timeout_ms);
+/* -1: még nem történt meg */
+int64_t     boot_t_us(boot_stage_t s);
+const char* boot_name(boot_stage_t s);
+
+#ifdef __cplusplus
+}
+#endif
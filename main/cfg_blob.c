@@ -0,0 +1,171 @@
+// main/cfg_blob.c — verziózott, CRC-s rendszer konfig blob (kódolás / migráció)
+#include <string.h>
+#include <ctype.h>
+#include "cfg_blob.h"
+
+typedef struct { uint16_t off; uint8_t size; uint8_t since; } fdesc_t;
+#define F(m, v) { (uint16_t)offsetof(sys_cfg_t, m), (uint8_t)sizeof(((sys_cfg_t*)0)->m), v }
+
+#define DWM(d, v) \
+    F(d.mask, v), F(d.network_id, v), F(d.zone_id, v), F(d.anchor_id, v), F(d.hb_ms, v), F(d.log_level, v), \
+    F(d.tx_ant_dly, v), F(d.rx_ant_dly, v), F(d.bias_ticks, v), F(d.phy_ch, v), F(d.phy_sfdto, v)
+
+/* sorrend = blob sorrend; új mező csak a végére, since = bevezető séma verzió */
+static const fdesc_t k_fields[] = {
+    F(ip, 1), F(gw, 1), F(mask, 1), F(dns1, 1), F(dns2, 1), F(udp_dst, 1), F(udp_port, 1),
+    F(anchors, 1),
+    DWM(dwm_v1, 1),
+    F(dwm[0].key, 2), DWM(dwm[0], 2),
+    F(dwm[1].key, 2), DWM(dwm[1], 2),
+    F(dwm[2].key, 2), DWM(dwm[2], 2),
+    F(dwm[3].key, 2), DWM(dwm[3], 2),
+};
+_Static_assert(CFGB_LINKS == 4, "k_fields: dwm[] sorok");
+#undef DWM
+#undef F
+#define NFIELDS (sizeof(k_fields) / sizeof(k_fields[0]))
+
+static inline uint16_t rd16le(const uint8_t* p){ return (uint16_t)(p[0] | (p[1]<<8)); }
+static inline uint32_t rd32le(const uint8_t* p){ return p[0] | (p[1]<<8) | (p[2]<<16) | ((uint32_t)p[3]<<24); }
+static inline void wr16le(uint8_t* p, uint16_t v){ p[0]=v; p[1]=v>>8; }
+static inline void wr32le(uint8_t* p, uint32_t v){ p[0]=v; p[1]=v>>8; p[2]=v>>16; p[3]=v>>24; }
+
+/* CRC32 (IEEE, reflektált), 16 elemes tábla — mint a journal-ban */
+uint32_t cfgb_crc32(const uint8_t* p, size_t n)
+{
+    static const uint32_t T[16] = {
+        0x00000000,0x1DB71064,0x3B6E20C8,0x26D930AC,0x76DC4190,0x6B6B51F4,0x4DB26158,0x5005713C,
+        0xEDB88320,0xF00F9344,0xD6D6A3E8,0xCB61B38C,0x9B64C2B0,0x86D3D2D4,0xA00AE278,0xBDBDF21C };
+    uint32_t crc = ~0u;
+    while (n--) {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ T[crc & 15];
+        crc = (crc >> 4) ^ T[crc & 15];
+    }
+    return ~crc;
+}
+
+/* EspCfg alapértékek; mask=0: a készülékről még nincs adat */
+static void dwm_defaults(cfgb_dwm_t* d)
+{
+    memset(d, 0, sizeof(*d));
+    d->network_id = 1;  d->zone_id = 0x5A31; d->anchor_id = 1;
+    d->hb_ms = 10000;   d->log_level = 1;    d->phy_ch = 9; d->phy_sfdto = 248;
+}
+
+void cfgb_defaults(sys_cfg_t* c)
+{
+    memset(c, 0, sizeof(*c));
+    /* 192.168.0.191/24, gw .1, DNS 1.1.1.1 / 8.8.8.8, uplink: subnet broadcast:12345 */
+    c->ip       = 191u<<24 | 0<<16 | 168<<8 | 192;
+    c->gw       = 1u<<24   | 0<<16 | 168<<8 | 192;
+    c->mask     = 0u<<24   | 255<<16 | 255<<8 | 255;
+    c->dns1     = 1u<<24 | 1<<16 | 1<<8 | 1;
+    c->dns2     = 8u<<24 | 8<<16 | 8<<8 | 8;
+    c->udp_dst  = 255u<<24 | 0<<16 | 168<<8 | 192;
+    c->udp_port = 12345;
+    strcpy(c->anchors, "UWB_ANCHOR_01,UWB_ANCHOR_02,UWB_ANCHOR_03");
+    dwm_defaults(&c->dwm_v1);
+    for (int i = 0; i < CFGB_LINKS; i++) dwm_defaults(&c->dwm[i]);
+}
+
+uint32_t cfgb_link_key(const char* filter)
+{
+    const uint32_t k = cfgb_crc32((const uint8_t*)filter, strlen(filter));
+    return k ? k : 1;                                          /* CRC32("") = 0 */
+}
+
+cfgb_dwm_t* cfgb_link_find(sys_cfg_t* c, uint32_t key)
+{
+    for (int i = 0; key && i < CFGB_LINKS; i++) if (c->dwm[i].key == key) return &c->dwm[i];
+    return NULL;
+}
+
+cfgb_dwm_t* cfgb_link_slot(sys_cfg_t* c, uint32_t key)
+{
+    int i = 0;
+    while (i < CFGB_LINKS - 1 && c->dwm[i].key != key && c->dwm[i].key) i++;
+    cfgb_dwm_t d = c->dwm[i];
+    if (d.key != key) { dwm_defaults(&d); d.key = key; }      /* üres vagy a legrégebbi */
+    memmove(&c->dwm[1], &c->dwm[0], i * sizeof(c->dwm[0]));
+    c->dwm[0] = d;
+    return &c->dwm[0];
+}
+
+/* a lista első eleme úgy, ahogy a ble_start link 0-ként felveszi
+   (vezető szóköz nélkül, max. 31 karakter; üres lista → "") */
+static void first_anchor(const char* list, char out[32])
+{
+    size_t n = 0;
+    for (const char* p = list; *p && !n; ) {
+        while (*p == ',') p++;
+        while (isspace((unsigned char)*p)) p++;
+        while (*p && *p != ',' && n < 31) out[n++] = *p++;
+        while (*p && *p != ',') p++;
+    }
+    out[n] = 0;
+}
+
+size_t cfgb_encode(const sys_cfg_t* c, uint8_t* out, size_t cap)
+{
+    size_t n = CFGB_HDR;
+    for (size_t i = 0; i < NFIELDS; i++) n += k_fields[i].size;
+    if (n + 4 > cap) return 0;
+
+    memcpy(out, CFGB_MAGIC, 4);
+    wr16le(out + 4, CFGB_VER);
+    wr16le(out + 6, (uint16_t)(n - CFGB_HDR));
+    uint8_t* p = out + CFGB_HDR;
+    for (size_t i = 0; i < NFIELDS; i++) {
+        const uint8_t* s = (const uint8_t*)c + k_fields[i].off;
+        switch (k_fields[i].size) {
+        case 1:  *p = *s; break;
+        case 2:  { uint16_t v; memcpy(&v, s, 2); wr16le(p, v); } break;
+        case 4:  { uint32_t v; memcpy(&v, s, 4); wr32le(p, v); } break;
+        default: memcpy(p, s, k_fields[i].size); break;       /* string / bájtok */
+        }
+        p += k_fields[i].size;
+    }
+    wr32le(p, cfgb_crc32(out, n));
+    return n + 4;
+}
+
+/* szemantikai migráció: from = a blob verziója; a hiányzó mezők már alapértéken */
+static void cfgb_migrate(sys_cfg_t* c, uint16_t from)
+{
+    if (from < 2 && c->dwm_v1.mask) {                         /* v1 egy tükre = akkori 0. link */
+        char f[32];
+        first_anchor(c->anchors, f);
+        const uint32_t key = cfgb_link_key(f);
+        cfgb_dwm_t* d = cfgb_link_slot(c, key);
+        *d = c->dwm_v1;
+        d->key = key;
+    }
+}
+
+cfgb_rc_t cfgb_decode(const uint8_t* in, size_t n, sys_cfg_t* c, uint16_t* ver)
+{
+    cfgb_defaults(c);
+    if (n < CFGB_HDR + 4) return CFGB_SHORT;
+    if (memcmp(in, CFGB_MAGIC, 4)) return CFGB_MAGIC_BAD;
+    const uint16_t v = rd16le(in + 4), len = rd16le(in + 6);
+    if ((size_t)CFGB_HDR + len + 4 > n) return CFGB_SHORT;
+    if (cfgb_crc32(in, CFGB_HDR + len) != rd32le(in + CFGB_HDR + len)) return CFGB_CRC;
+    if (ver) *ver = v;
+
+    const uint8_t* p = in + CFGB_HDR;
+    size_t left = len;
+    for (size_t i = 0; i < NFIELDS && k_fields[i].since <= v && left >= k_fields[i].size; i++) {
+        uint8_t* d = (uint8_t*)c + k_fields[i].off;
+        switch (k_fields[i].size) {
+        case 1:  *d = *p; break;
+        case 2:  { uint16_t x = rd16le(p); memcpy(d, &x, 2); } break;
+        case 4:  { uint32_t x = rd32le(p); memcpy(d, &x, 4); } break;
+        default: memcpy(d, p, k_fields[i].size); break;
+        }
+        p += k_fields[i].size; left -= k_fields[i].size;
+    }
+    c->anchors[CFGB_ANCHORS - 1] = 0;
+    if (v < CFGB_VER) cfgb_migrate(c, v);
+    return CFGB_OK;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===== Rendszer konfiguráció bináris blobja (NVS) =====
+ * [0..3] "CFGS", [4..5] séma verzió LE, [6..7] payload hossz LE,
+ * payload: a k_fields mezői sorban, LE, [..+4] CRC32(fejléc+payload).
+ * Séma szabály: mező csak a VÉGÉRE kerülhet (CFGB_VER++), meglévőt nem
+ * törlünk / méretezünk át. Régebbi blob → a hiányzó mezők alapértéken,
+ * újabb blob (downgrade) → az ismeretlen vég eldobva. Szemantikai váltás
+ * (pl. mértékegység) a cfgb_migrate-be. ESP API nélkül: host-on tesztelhető.
+ * v1: egy DWM tükör (a 0. link).
+ * v2: linkenkénti tükrök, az anchor szűrő (név / MAC) CRC32-jével kulcsolva,
+ *     így az anchor lista átrendezése után is a saját anchorához kerül;
+ *     a v1 mezők a 0. link másolatát tartják (downgrade). */
+
+#define CFGB_MAGIC      "CFGS"
+#define CFGB_VER        2
+#define CFGB_HDR        8
+#define CFGB_MAX        384
+#define CFGB_ANCHORS    96       /* BLE anchor szűrő lista (név / MAC, vesszővel) */
+#define CFGB_LINKS      4        /* tükör slot; BLE_MAX_LINKS + 1 tartalék a lecserélt anchornak */
+
+/* DWM config tükör (EspCfg, webserver) */
+typedef struct {
+    uint32_t key;                /* cfgb_link_key(szűrő); 0: üres slot (v1-ben nincs) */
+    uint16_t mask;               /* ismert mezők (CFG_M) */
+    uint16_t network_id, zone_id;
+    uint32_t anchor_id;
+    uint16_t hb_ms;
+    uint8_t  log_level;
+    int32_t  tx_ant_dly, rx_ant_dly, bias_ticks;
+    uint8_t  phy_ch;
+    uint16_t phy_sfdto;
+} cfgb_dwm_t;
+
+typedef struct {
+    /* hálózat (ip4_addr_t.addr, hálózati sorrend) */
+    uint32_t ip, gw, mask, dns1, dns2;
+    uint32_t udp_dst;
+    uint16_t udp_port;
+    /* BLE */
+    char     anchors[CFGB_ANCHORS];
+    /* DWM tükrök */
+    cfgb_dwm_t dwm_v1;           /* v1: a 0. link, kulcs nélkül; v2-től csak downgrade-hez írjuk */
+    cfgb_dwm_t dwm[CFGB_LINKS];  /* v2: legutóbb írt elöl (MRU) */
+} sys_cfg_t;
+
+typedef enum {
+    CFGB_OK = 0,
+    CFGB_SHORT,                  /* fejlécnél / hossznál rövidebb */
+    CFGB_MAGIC_BAD,
+    CFGB_CRC,
+} cfgb_rc_t;
+
+void     cfgb_defaults(sys_cfg_t* c);
+/* visszaad: blob hossz, 0 ha cap kevés */
+size_t   cfgb_encode(const sys_cfg_t* c, uint8_t* out, size_t cap);
+/* c-t előbb alapértékre tölti; *ver = a blob verziója (migráció előtt) */
+cfgb_rc_t cfgb_decode(const uint8_t* in, size_t n, sys_cfg_t* c, uint16_t* ver);
+uint32_t cfgb_crc32(const uint8_t* p, size_t n);
+
+/* link kulcs a szűrő stringből ("" = bármely eszköz), soha nem 0 */
+uint32_t    cfgb_link_key(const char* filter);
+/* NULL, ha nincs ilyen kulcsú slot */
+cfgb_dwm_t* cfgb_link_find(sys_cfg_t* c, uint32_t key);
+/* a kulcs slotja (új: üres, ha nincs üres, a legrégebben írt helyén), az
+   elejére mozgatva; új slot mask=0, a mezők alapértéken */
+cfgb_dwm_t* cfgb_link_slot(sys_cfg_t* c, uint32_t key);
+
+#ifdef __cplusplus
+}
+#endif
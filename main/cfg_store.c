@@ -0,0 +1,130 @@
+// main/cfg_store.c — rendszer konfig NVS-ben, összevont (debounce) írással
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "nvs.h"
+#include "esp_log.h"
+#include "cfg_store.h"
+
+static const char* TAG = "CFGS";
+#define NVS_NS   "syscfg"
+#define NVS_KEY  "cfg"
+
+static portMUX_TYPE      s_mux = portMUX_INITIALIZER_UNLOCKED;
+static SemaphoreHandle_t s_wr;              /* flush: task vs. cfg_store_flush */
+static SemaphoreHandle_t s_upd;             /* cfg_store_update sorosítás */
+static sys_cfg_t         s_cfg;
+static uint32_t          s_saved_crc;       /* utoljára kiírt blob CRC-je */
+static TaskHandle_t      s_task;
+static cfg_store_stats_t s_st;
+
+static esp_err_t save(void)
+{
+    uint8_t b[CFGB_MAX];
+    sys_cfg_t c;
+    portENTER_CRITICAL(&s_mux); c = s_cfg; portEXIT_CRITICAL(&s_mux);
+    const size_t n = cfgb_encode(&c, b, sizeof(b));
+    if (!n) return ESP_ERR_INVALID_SIZE;
+    const uint32_t crc = cfgb_crc32(b, n - 4);
+
+    xSemaphoreTake(s_wr, portMAX_DELAY);
+    esp_err_t er = ESP_OK;
+    if (crc != s_saved_crc) {
+        nvs_handle_t h;
+        er = nvs_open(NVS_NS, NVS_READWRITE, &h);
+        if (er == ESP_OK) {
+            er = nvs_set_blob(h, NVS_KEY, b, n);
+            if (er == ESP_OK) er = nvs_commit(h);
+            nvs_close(h);
+        }
+        portENTER_CRITICAL(&s_mux);
+        if (er == ESP_OK) s_st.writes++; else s_st.write_errors++;
+        portEXIT_CRITICAL(&s_mux);
+        if (er == ESP_OK) s_saved_crc = crc;
+        else ESP_LOGW(TAG, "save: %s", esp_err_to_name(er));
+    }
+    xSemaphoreGive(s_wr);
+    return er;
+}
+
+/* jelzésre vár, utána addig halaszt, amíg jön új változás (max. CFGS_MAX_DELAY_MS) */
+static void store_task(void* arg)
+{
+    (void)arg;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        const TickType_t t0 = xTaskGetTickCount();
+        while (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CFGS_DEBOUNCE_MS)) &&
+               xTaskGetTickCount() - t0 < pdMS_TO_TICKS(CFGS_MAX_DELAY_MS)) { }
+        save();
+    }
+}
+
+esp_err_t cfg_store_init(void)
+{
+    if (s_task) return ESP_OK;
+    s_wr = xSemaphoreCreateMutex();
+    s_upd = xSemaphoreCreateMutex();
+    if (!s_wr || !s_upd) return ESP_ERR_NO_MEM;
+
+    uint8_t b[CFGB_MAX];
+    size_t n = sizeof(b);
+    uint16_t ver = 0;
+    nvs_handle_t h;
+    esp_err_t er = nvs_open(NVS_NS, NVS_READONLY, &h);
+    if (er == ESP_OK) { er = nvs_get_blob(h, NVS_KEY, b, &n); nvs_close(h); }
+    if (er == ESP_OK) {
+        s_st.load_rc = cfgb_decode(b, n, &s_cfg, &ver);
+        if (s_st.load_rc == CFGB_OK) {
+            s_st.loaded_ver = ver;
+            if (ver == CFGB_VER) s_saved_crc = cfgb_crc32(b, n - 4);   /* régi séma: újraírjuk */
+        } else {
+            cfgb_defaults(&s_cfg);
+            ESP_LOGW(TAG, "blob rejected (rc=%d), defaults", (int)s_st.load_rc);
+        }
+    } else {
+        cfgb_defaults(&s_cfg);
+        s_st.load_rc = CFGB_SHORT;
+        ESP_LOGI(TAG, "no stored config (%s), defaults", esp_err_to_name(er));
+    }
+    ESP_LOGI(TAG, "loaded v%u (schema v%u)", (unsigned)ver, (unsigned)CFGB_VER);
+
+    if (xTaskCreate(store_task, "cfg_store", 3072, NULL, 2, &s_task) != pdPASS) return ESP_ERR_NO_MEM;
+    if (ver && ver != CFGB_VER) xTaskNotifyGive(s_task);              /* migrált blob mentése */
+    return ESP_OK;
+}
+
+void cfg_store_get(sys_cfg_t* out)
+{
+    portENTER_CRITICAL(&s_mux); *out = s_cfg; portEXIT_CRITICAL(&s_mux);
+}
+
+void cfg_store_set(const sys_cfg_t* c)
+{
+    portENTER_CRITICAL(&s_mux);
+    const bool changed = memcmp(&s_cfg, c, sizeof(*c)) != 0;
+    if (changed) { s_cfg = *c; s_st.sets++; }
+    portEXIT_CRITICAL(&s_mux);
+    if (changed && s_task) xTaskNotifyGive(s_task);
+}
+
+void cfg_store_update(cfg_store_fn fn, void* arg)
+{
+    sys_cfg_t c;
+    xSemaphoreTake(s_upd, portMAX_DELAY);
+    cfg_store_get(&c);
+    fn(&c, arg);
+    cfg_store_set(&c);
+    xSemaphoreGive(s_upd);
+}
+
+esp_err_t cfg_store_flush(void)
+{
+    return s_wr ? save() : ESP_ERR_INVALID_STATE;
+}
+
+void cfg_store_get_stats(cfg_store_stats_t* out)
+{
+    portENTER_CRITICAL(&s_mux); *out = s_st; portEXIT_CRITICAL(&s_mux);
+}
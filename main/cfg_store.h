@@ -0,0 +1,42 @@
+#pragma once
+#include "esp_err.h"
+#include "cfg_blob.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ===== Rendszer konfig tároló (NVS "syscfg"/"cfg") =====
+ * Bootkor egyszer töltődik (hibás / hiányzó blob → alapértékek), utána
+ * RAM-ból olvasható. A set csak másol és jelez: az NVS írást egy saját
+ * task végzi CFGS_DEBOUNCE_MS csend után (legkésőbb CFGS_MAX_DELAY_MS-mel az
+ * első változás után), azonos tartalmat nem ír újra. Így a HTTP út nem vár
+ * flash-re és a sorozatos módosítások egy írásba olvadnak. */
+
+#define CFGS_DEBOUNCE_MS    2000
+#define CFGS_MAX_DELAY_MS   10000
+
+typedef struct {
+    uint16_t  loaded_ver;        /* 0: nem volt (érvényes) blob */
+    cfgb_rc_t load_rc;
+    uint32_t  sets;              /* cfg_store_set hívások, amik változtattak */
+    uint32_t  writes;            /* NVS írások */
+    uint32_t  write_errors;
+} cfg_store_stats_t;
+
+/* nvs_flash_init után, minden más előtt */
+esp_err_t cfg_store_init(void);
+void      cfg_store_get(sys_cfg_t* out);
+/* változás esetén késleltetett mentés */
+void      cfg_store_set(const sys_cfg_t* c);
+/* get → fn → set egymás után, a többi update-tel sorosítva: két módosító
+   (pl. két anchor tükre) nem írja felül egymás mezőit. fn blokkolhat. */
+typedef void (*cfg_store_fn)(sys_cfg_t* c, void* arg);
+void      cfg_store_update(cfg_store_fn fn, void* arg);
+/* azonnali mentés (pl. újraindítás előtt) */
+esp_err_t cfg_store_flush(void);
+void      cfg_store_get_stats(cfg_store_stats_t* out);
+
+#ifdef __cplusplus
+}
+#endif
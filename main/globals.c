@@ -1,17 +1,22 @@
 #include "globals.h"
 #include "lwip/ip4_addr.h"
+#include "cfg_store.h"
 
 net_config_t NET;
 volatile int eth_up = 0;
 
+/* cfg_store_init után: a hálózati beállítás a tárolt konfigból (alapértékek: cfg_blob.c) */
 void globals_init(void)
 {
-    IP4_ADDR(&NET.ip,   192,168,0,191);
-    IP4_ADDR(&NET.gw,   192,168,0,1);
-    IP4_ADDR(&NET.mask, 255,255,255,0);
-    IP4_ADDR(&NET.dns1, 1,1,1,1);
-    IP4_ADDR(&NET.dns2, 8,8,8,8);
-    NET.udp_port = 12345;
+    sys_cfg_t c;
+    cfg_store_get(&c);
+    NET.ip.addr      = c.ip;
+    NET.gw.addr      = c.gw;
+    NET.mask.addr    = c.mask;
+    NET.dns1.addr    = c.dns1;
+    NET.dns2.addr    = c.dns2;
+    NET.udp_dst.addr = c.udp_dst;
+    NET.udp_port     = c.udp_port;
 }
 
 status_t g_status = { "A1", 1, 0.0f, 0.0f, ST_UNKNOWN };
\ No newline at end of file
@@ -8,6 +8,7 @@ typedef struct {
     ip4_addr_t mask;
     ip4_addr_t dns1;
     ip4_addr_t dns2;
+    ip4_addr_t udp_dst;    // uplink cél (alap: subnet broadcast)
     uint16_t   udp_port;
 } net_config_t;
 
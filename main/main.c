@@ -9,10 +9,14 @@
 #include "esp_log.h"
 #include "globals.h"
 #include "ble.h"
-#include "pretty_print.h"
+#include "blog.h"
+#include "tlv.h"
 // #include "webserver.h"
 #include "esp_spiffs.h"
 #include "webserver.hpp"
+#include "uplink.h"
+#include "cfg_store.h"
+#include "boot.h"
 
 static const char *TAG = "main";
 
@@ -31,80 +35,32 @@ static void fs_mount(void){
 }
 
 
-/* ===== Kisegítő BE olvasók ===== */
-static inline uint16_t rd16be(const uint8_t* v){ return ((uint16_t)v[0]<<8) | v[1]; }
-static inline uint32_t rd32be(const uint8_t* v){ return ((uint32_t)v[0]<<24)|((uint32_t)v[1]<<16)|((uint32_t)v[2]<<8)|v[3]; }
-
-/* ===== BLE NOTIFY parser ===== */
-static void parse_cfg_notify(const uint8_t* p, uint16_t n){
-    const char* TAG="CFG";
-    if (n==6 && p[0]==1 && p[1]==0x81){
-        uint16_t req = rd16be(&p[2]);
-        uint8_t status=p[4], applied=p[5];
-        //ESP_LOGI(TAG, "ACK req=%u status=0x%02X applied=%u", (unsigned)req, status, (unsigned)applied);
-        return;
-    }
-    if (n==17 && p[0]==1 && p[1]==0x90){
-        uint8_t  st    = p[2];
-        uint16_t sync  = rd16be(&p[3]);
-        uint32_t up    = rd32be(&p[5]);
-        uint16_t netid = rd16be(&p[9]);
-        uint16_t zone  = rd16be(&p[11]);
-        uint32_t anc   = rd32be(&p[13]);
-        //ESP_LOGI(TAG,"STATE st=0x%02X sync_ms=%u up=%u net=%u zone=0x%04X anc=0x%08X",
-        //         st, sync, (unsigned)up, (unsigned)netid, (unsigned)zone, (unsigned)anc);
-        return;
-    }
-    // TLV stream: [t,l,val...] egymás után (HB vagy GET snapshot)
-    const uint8_t* q=p; uint16_t r=n;
-    while (r>=2){
-        uint8_t t=q[0], l=q[1]; q+=2; r-=2;
-        if (r<l){ ESP_LOGW(TAG,"TRUNC tlv t=0x%02X need=%u have=%u",t,(unsigned)l,(unsigned)r); break; }
-        switch(t){
-            case 0x00: if(l==1) ESP_LOGI(TAG,"VER=%u", (unsigned)q[0]); break;                 // T_VER
-            case 0x01: if(l==1) ESP_LOGI(TAG,"STATUS=0x%02X", (unsigned)q[0]); break;         // T_STATUS
-            case 0x02: if(l==4) ESP_LOGI(TAG,"UPTIME_MS=%u", (unsigned)rd32be(q)); break;     // T_UPTIME_MS
-            case 0x03: if(l==2) ESP_LOGI(TAG,"SYNC_MS=%u", (unsigned)rd16be(q)); break;       // T_SYNC_MS
-            case 0x10: if(l==2) ESP_LOGI(TAG,"NETWORK_ID=%u", (unsigned)rd16be(q)); break;
-            case 0x11: if(l==2) ESP_LOGI(TAG,"ZONE_ID=0x%04X", (unsigned)rd16be(q)); break;
-            case 0x12: if(l==4) ESP_LOGI(TAG,"ANCHOR_ID=0x%08X", (unsigned)rd32be(q)); break;
-            case 0x13: if(l==4) ESP_LOGI(TAG,"TX_ANT_DLY=%" PRId32, (int32_t)rd32be(q)); break;
-            case 0x14: if(l==4) ESP_LOGI(TAG,"RX_ANT_DLY=%" PRId32, (int32_t)rd32be(q)); break;
-            case 0x16: if(l==4) ESP_LOGI(TAG,"BIAS_TICKS=%" PRId32, (int32_t)rd32be(q)); break;
-            case 0x1F: if(l==1) ESP_LOGI(TAG,"LOG_LEVEL=%u", (unsigned)q[0]); break;
-            case 0x20: if(l==2) ESP_LOGI(TAG,"HB_MS=%u", (unsigned)rd16be(q)); break;
-            case 0x30: if(l==2) ESP_LOGI(TAG,"PPM_MAX=%u", (unsigned)rd16be(q)); break;
-            case 0x31: if(l==2) ESP_LOGI(TAG,"JUMP_PPM=%u", (unsigned)rd16be(q)); break;
-            case 0x32: if(l==2) ESP_LOGI(TAG,"AB_GAP_MS=%u", (unsigned)rd16be(q)); break;
-            case 0x33: if(l==1) ESP_LOGI(TAG,"MS_EWMA_DEN=%u", (unsigned)q[0]); break;
-            case 0x34: if(l==1) ESP_LOGI(TAG,"TK_EWMA_DEN=%u", (unsigned)q[0]); break;
-            case 0x35: if(l==2) ESP_LOGI(TAG,"TK_MIN_MS=%u", (unsigned)rd16be(q)); break;
-            case 0x36: if(l==2) ESP_LOGI(TAG,"TK_MAX_MS=%u", (unsigned)rd16be(q)); break;
-            case 0x37: if(l==2) ESP_LOGI(TAG,"DTTX_MIN_MS=%u", (unsigned)rd16be(q)); break;
-            case 0x38: if(l==2) ESP_LOGI(TAG,"DTTX_MAX_MS=%u", (unsigned)rd16be(q)); break;
-            case 0x39: if(l==1) ESP_LOGI(TAG,"LOCK_NEED=%u", (unsigned)q[0]); break;
-            default:   ESP_LOGI(TAG,"TLV t=0x%02X l=%u", t, (unsigned)l); break;
-        }
-        q+=l; r-=l;
+/* ===== BLE NOTIFY =====
+ * Szöveg helyett bináris napló (blog): a keret nyersen megy a gyűrűbe, a
+ * szöveget a host rakja össze (tools/blog_decode.c). A korábbi kikommentelt
+ * ACK / STATE sorokat a CFG rekord dekódolása adja, az RX sort a BLE csatorna
+ * D szintje kapcsolja (/api/blog). */
+static void on_ble_notify(uint8_t link, const uint8_t* data, uint16_t len, bool from_cfg) {
+    if (blog_enabled(BLF_RX)) {
+        const uint8_t a[3] = { from_cfg, (uint8_t)len, (uint8_t)(len >> 8) };
+        blog_put(BLF_RX, link, a, sizeof(a));
     }
-}
-
-static void on_ble_notify(const uint8_t* data, uint16_t len, bool from_cfg) {
-    //ESP_LOGI("BLE", "[%s] len=%u", from_cfg ? "CFG" : "DATA", (unsigned)len);
     if (from_cfg)
-        pp_log_cfg(data, len, NULL, rd16be, rd32be);
-    else
-        pp_log_data(data, len);
+        blog_put(BLF_CFG, link, data, len);
+    else {
+        blog_put(BLF_DATA, link, data, len);
+        uplink_push_data(data, len);   /* DATA keret saját anchor_id-t hordoz */
+    }
 }
 
 /* ===== SET példa ===== */
-static esp_err_t send_cfg_example(void) {
-    /* NETWORK_ID=2 (T=0x10, l=2), HB_MS=5000 (T=0x20, l=2) */
-    uint8_t tlv[2+2 + 2+2];
-    uint8_t *w = tlv;
-    *w++ = 0x10; *w++ = 2; *w++ = 0x00; *w++ = 0x02;
-    *w++ = 0x20; *w++ = 2; *w++ = 0x13; *w++ = 0x88; // 5000
-    return ble_send_set(2, tlv, sizeof(tlv));
+static esp_err_t send_cfg_example(uint8_t link) {
+    /* NETWORK_ID=2, HB_MS=5000 */
+    uint8_t buf[2+2 + 2+2];
+    tlv_wr_t w; tlv_wr_init(&w, buf, sizeof(buf));
+    tlv_put(&w, T_NETWORK_ID, 2);
+    tlv_put(&w, T_HB_MS, 5000);
+    return ble_send_set(link, 2, buf, w.len);
 }
 
 static void nvs_init_or_erase(void){
@@ -112,28 +68,67 @@ static void nvs_init_or_erase(void){
     if(r==ESP_ERR_NVS_NO_FREE_PAGES || r==ESP_ERR_NVS_NEW_VERSION_FOUND){ nvs_flash_erase(); nvs_flash_init(); }
 }
 
+/* ===== Boot szakaszok =====
+ * NVS → cfg → netif sorban (mindenki ezekre épül), utána párhuzamosan:
+ * Ethernet PHY felfutás, SPIFFS mount, BLE controller init. A webserver és az
+ * uplink csak netif-et igényel; az első GET/SET a valódi BLE készenlétre megy. */
+#define BLE_READY_TIMEOUT_MS  60000
+
+static void eth_task(void* arg){
+    static ethernet_ctx_t eth;
+    (void)arg;
+    if(ethernet_init(&eth)==ESP_OK) boot_mark(BOOT_ETH_INIT);
+    vTaskDelete(NULL);
+}
+static void fs_task(void* arg){
+    (void)arg;
+    fs_mount();
+    boot_mark(BOOT_FS);
+    vTaskDelete(NULL);
+}
+/* az elsőként kész anchor; a ready cb mindig a GATTC taskból jön, a boot_wait
+   event group-ja után a ble_task már a beírt értéket látja */
+static int s_ready_link = -1;
+static void ble_ready(uint8_t link){
+    if(s_ready_link < 0) s_ready_link = link;
+    boot_mark(BOOT_BLE_READY);
+}
+static void ble_task(void* arg){
+    (void)arg;
+    /* BLE: anchor lista (név vagy MAC), vesszővel; üres → első talált (cfg_store) */
+    sys_cfg_t sc;
+    cfg_store_get(&sc);
+    ble_register_ready_cb(ble_ready);
+    if(ble_start(sc.anchors, on_ble_notify)==ESP_OK) boot_mark(BOOT_BLE_INIT);
+
+    // első GET + példa SET arra az anchorra, amelyik elsőként kész (CCC engedélyezve)
+    if(boot_wait(BOOT_BIT(BOOT_BLE_READY), BLE_READY_TIMEOUT_MS)){
+        const uint8_t link = (uint8_t)s_ready_link;
+        if(ble_send_get(link, 1)==ESP_OK) boot_mark(BOOT_FIRST_GET);
+        send_cfg_example(link);
+    } else {
+        ESP_LOGW(TAG, "no BLE anchor ready after %u ms", (unsigned)BLE_READY_TIMEOUT_MS);
+    }
+    vTaskDelete(NULL);
+}
+
 void app_main(void)
 {
-    globals_init();
+    boot_init();
+    blog_start(BLOG_SINK_UART);
     nvs_init_or_erase();
+    boot_mark(BOOT_NVS);
+    ESP_ERROR_CHECK(cfg_store_init());
+    globals_init();
+    boot_mark(BOOT_CFG);
     esp_event_loop_create_default();
     esp_netif_init();
+    boot_mark(BOOT_NETIF);
 
-    ethernet_ctx_t eth = {0};
-    ethernet_init(&eth);
-
-    vTaskDelay(pdMS_TO_TICKS(500));
-    fs_mount();
-    webserver_start();
-
-    /* BLE: opcionális name filter, pl. "UWB_ANCHOR_01" */
-    ble_start("UWB_ANCHOR_01", on_ble_notify);
-
-    // példa GET kérés 600ms után:
-    vTaskDelay(pdMS_TO_TICKS(600));
-    ble_send_get(1);
+    xTaskCreate(eth_task, "boot_eth", 4096, NULL, 5, NULL);
+    xTaskCreate(fs_task,  "boot_fs",  3072, NULL, 4, NULL);
 
-    // példa SET 1s után
-    vTaskDelay(pdMS_TO_TICKS(400));
-    send_cfg_example();
+    if(uplink_start()==ESP_OK) boot_mark(BOOT_UPLINK);
+    xTaskCreate(ble_task, "boot_ble", 4096, NULL, 5, NULL);
+    if(webserver_start()==ESP_OK) boot_mark(BOOT_HTTP);
 }
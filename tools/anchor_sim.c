@@ -0,0 +1,320 @@
+/* anchor_sim — N szimulált UWB anchor (components/ble/anchor_sim.c) host-on, a
+ * gateway ingest láncán át (tools/host/gw_host.h): terheléses / soak teszt rádió nélkül.
+ *
+ * Anchoronként egy asim_t (link = index, anchor_id = 0x51A00000 + index, a tag
+ * id-k minden anchoron azonosak). A DATA / HB / STATE a gw_try_sink-en megy a
+ * notify gyűrűbe; tele gyűrűnél a szimulátor vár (mint a link réteg), ez
+ * stall. --get-ms szerint GET, minden 3. kérés SET (LOG_LEVEL / HB_MS) megy
+ * asim_write-tal; az ACK-ot az rx szálon egy feliratkozó párosítja (RTT).
+ * Végén a szimulátor és a gateway számlálóit összeveti:
+ *   uplink frames == sim DATA, uplink dup == sim dups, ACK == GET + SET,
+ *   tag_track lost ≤ sim lost (a tag utolsó kereteinek vesztése nem látszik).
+ *
+ * Fordítás: tools/host/CMakeLists.txt (anchor_sim target).
+ *
+ * Használat:
+ *   anchor_sim [--anchors N] [--tags N] [--rate HZ] [--seconds S] [--speed X | --max]
+ *              [--loss PPM] [--dup PPM] [--outage MS/EVERY_MS] [--hb MS] [--state MS]
+ *              [--get-ms MS] [--log] [--ncap out.ncap]
+ *   anchor_sim --selftest */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <sched.h>
+#include "anchor_sim.h"
+#include "ncap.h"
+#include "tlv.h"
+#include "tag_track.h"
+#include "gw_host.h"
+
+#define MAX_ANCHORS  32
+#define RTT_SLOTS    256                /* req_id & 0xFF → küldési idő */
+
+typedef struct {
+    unsigned anchors, tags;
+    double   rate_hz, seconds, speed;   /* speed 0: amilyen gyorsan lehet */
+    uint32_t loss_ppm, dup_ppm;
+    uint16_t outage_ms, outage_every_ms, hb_ms, state_ms;
+    unsigned get_ms;
+    const char* ncap;
+} opts_t;
+
+typedef struct {
+    asim_stats_t sim;
+    uint32_t reqs, acks, ack_err, snap_frames;
+    uint64_t tt_lost, tt_frames;
+    int64_t  span_us, wall_us;
+} result_t;
+
+/* ===== ACK párosítás (rx szál) ===== */
+static atomic_llong s_req_t[RTT_SLOTS];
+static atomic_uint  s_acks, s_ack_err, s_snap;
+static samples_t    s_rtt;
+
+static void ack_sub(uint8_t link, const uint8_t* p, uint16_t n, bool from_cfg)
+{
+    (void)link;
+    if (!from_cfg || n < 2) return;
+    if (n == 6 && p[0] == 1 && p[1] == 0x81) {
+        const long long t0 = atomic_exchange(&s_req_t[p[3]], 0);
+        if (t0) smp_add(&s_rtt, gw_now_us() - t0);
+        atomic_fetch_add(&s_acks, 1);
+        if (p[4]) atomic_fetch_add(&s_ack_err, 1);
+    } else if (!(n == 13 && p[0] == 1 && p[1] == 1) && !(n == 17 && p[1] == 0x90)) {
+        atomic_fetch_add(&s_snap, 1);                        /* TLV snapshot keret */
+    }
+}
+
+/* ===== kimenet: gyűrű (+ .ncap) ===== */
+typedef struct { uint8_t* p; size_t n, cap; } buf_t;
+static void buf_put(buf_t* b, const void* p, size_t n)
+{
+    if (b->n + n > b->cap) {
+        b->cap = (b->n + n) * 2;
+        b->p = realloc(b->p, b->cap);
+        if (!b->p) { perror("realloc"); exit(1); }
+    }
+    memcpy(b->p + b->n, p, n);
+    b->n += n;
+}
+
+typedef struct {
+    buf_t*  rec;                        /* NULL: nincs .ncap */
+    int64_t vnow, vlast;                /* virtuális idő */
+} out_ctx_t;
+
+static bool sim_out(void* ctx, uint8_t link, const uint8_t* d, uint16_t n, bool from_cfg)
+{
+    out_ctx_t* o = ctx;
+    if (!gw_try_sink(link, d, n, from_cfg)) return false;
+    if (o->rec) {
+        uint8_t rh[NCAP_REC_HDR];
+        ncap_rec_hdr_encode(rh, (uint32_t)(o->vnow - o->vlast), n, link, from_cfg);
+        buf_put(o->rec, rh, sizeof(rh)); buf_put(o->rec, d, n);
+        o->vlast = o->vnow;
+    }
+    return true;
+}
+
+/* GET, minden 3. kérés SET: LOG_LEVEL + HB_MS (a HB periódust is átállítja) */
+static void send_req(asim_t* a, uint16_t req, const opts_t* o, out_ctx_t* oc)
+{
+    uint8_t pkt[5 + 16] = { 1, 0x02, (uint8_t)(req >> 8), (uint8_t)req, 0 };
+    uint16_t n = 5;
+    if (req % 3 == 2) {
+        tlv_wr_t w;
+        pkt[1] = 0x01; pkt[4] = 0xFF;
+        tlv_wr_init(&w, pkt + 5, sizeof(pkt) - 5);
+        tlv_put(&w, T_LOG_LEVEL, req % 5);
+        tlv_put(&w, T_HB_MS, o->hb_ms ? (req & 4 ? o->hb_ms : o->hb_ms / 2u + 1) : 0);
+        n = (uint16_t)(5 + w.len);
+    }
+    atomic_store(&s_req_t[req & 0xFF], gw_now_us());
+    asim_write(a, pkt, n, oc->vnow, sim_out, oc);
+}
+
+static bool run(const opts_t* o, result_t* r)
+{
+    memset(r, 0, sizeof(*r));
+    static asim_t sim[MAX_ANCHORS];
+    const unsigned na = o->anchors;
+    for (unsigned i = 0; i < na; i++) {
+        const asim_cfg_t c = {
+            .link = (uint8_t)i, .anchor_id = 0x51A00000u + i, .network_id = 0x1234, .tags = (uint16_t)o->tags,
+            .tag_base = 0x7A000000u, .rate_mhz = (uint32_t)(o->rate_hz * 1000.0 + 0.5), .hb_ms = o->hb_ms,
+            .state_ms = o->state_ms, .sync_ms = 100, .loss_ppm = o->loss_ppm, .dup_ppm = o->dup_ppm,
+            .outage_ms = o->outage_ms, .outage_every_ms = o->outage_every_ms, .seed = 0x9E3779B9u * (i + 1),
+        };
+        asim_init(&sim[i], &c, 0);
+    }
+    for (unsigned i = 0; i < RTT_SLOTS; i++) atomic_store(&s_req_t[i], 0);
+    atomic_store(&s_acks, 0); atomic_store(&s_ack_err, 0); atomic_store(&s_snap, 0);
+    s_rtt.n = 0;
+
+    buf_t rec = {0};
+    out_ctx_t oc = { .rec = o->ncap ? &rec : NULL };
+    if (o->ncap) { uint8_t h[NCAP_HDR_LEN]; ncap_hdr_encode(h, 0, 0); buf_put(&rec, h, sizeof(h)); }
+
+    const gw_cfg_t g = { .backpressure = true, .extra = ack_sub };
+    gw_start(&g);
+    const int64_t end = (int64_t)(o->seconds * 1e6), w0 = gw_now_us();
+    const int64_t get_us = (int64_t)o->get_ms * 1000;
+    int64_t next_get = get_us ? get_us : INT64_MAX;
+    uint16_t req = 1;
+    while (oc.vnow <= end) {
+        if (oc.vnow >= next_get) {
+            send_req(&sim[req % na], req, o, &oc);
+            req++; r->reqs++;
+            next_get += get_us;
+        }
+        int64_t due = next_get;
+        uint32_t stalls = 0;
+        for (unsigned i = 0; i < na; i++) {
+            const uint32_t s0 = sim[i].st.stalls;
+            asim_step(&sim[i], oc.vnow, sim_out, &oc);
+            stalls += sim[i].st.stalls - s0;
+            const int64_t t = asim_next_due(&sim[i]);
+            if (t < due) due = t;
+        }
+        if (stalls) { sched_yield(); continue; }             /* tele gyűrű: a fogyasztó jön */
+        if (due == INT64_MAX || due > end) break;
+        if (o->speed > 0) {
+            gw_sleep_us((int64_t)(due / o->speed) - (gw_now_us() - w0));
+            oc.vnow = (int64_t)((gw_now_us() - w0) * o->speed);
+            if (oc.vnow < due) oc.vnow = due;
+        } else {
+            oc.vnow = due;
+        }
+    }
+    /* a sorokban maradt válaszok */
+    for (bool busy = true; busy; ) {
+        busy = false;
+        for (unsigned i = 0; i < na; i++) { asim_step(&sim[i], oc.vnow, sim_out, &oc); busy |= sim[i].qn != 0; }
+        if (busy) sched_yield();
+    }
+    gw_stop();
+    r->wall_us = gw_now_us() - w0;
+    r->span_us = oc.vnow;
+
+    for (unsigned i = 0; i < na; i++) {
+        const asim_stats_t* s = &sim[i].st;
+        r->sim.data += s->data;   r->sim.lost += s->lost;     r->sim.dups += s->dups;
+        r->sim.hb += s->hb;       r->sim.state += s->state;   r->sim.gets += s->gets;
+        r->sim.sets += s->sets;   r->sim.applied += s->applied; r->sim.rejected += s->rejected;
+        r->sim.bad_cmd += s->bad_cmd; r->sim.resp_drop += s->resp_drop; r->sim.stalls += s->stalls;
+    }
+    for (uint32_t i = 0; i < TT_MAX_TAGS; i++) {
+        tt_tag_stats_t t;
+        if (!tt_get(i, &t)) continue;
+        r->tt_lost += t.lost; r->tt_frames += t.frames;
+    }
+    r->acks = atomic_load(&s_acks);
+    r->ack_err = atomic_load(&s_ack_err);
+    r->snap_frames = atomic_load(&s_snap);
+    smp_sort(&s_rtt);
+
+    bool ok = true;
+    if (o->ncap) {
+        FILE* f = fopen(o->ncap, "wb");
+        ok = f && fwrite(rec.p, 1, rec.n, f) == rec.n;
+        if (f) fclose(f);
+        if (!ok) perror(o->ncap);
+    }
+    free(rec.p);
+    return ok;
+}
+
+/* true: a gateway számlálói egyeznek a szimulátoréval */
+static bool check(const result_t* r, bool verbose)
+{
+    const gw_stats_t* g = gw_stats();
+    bool ok = true;
+#define CHK(cond, ...) do { if (!(cond)) { ok = false; if (verbose) { printf("  MISMATCH: "); printf(__VA_ARGS__); puts(""); } } } while (0)
+    CHK(g->dropped == 0, "ring dropped %u", g->dropped);
+    CHK(g->frames_in == r->sim.data, "uplink frames %u != sim data %u", g->frames_in, r->sim.data);
+    CHK(g->frames_dup == r->sim.dups, "uplink dup %u != sim dups %u", g->frames_dup, r->sim.dups);
+    CHK(r->acks == r->sim.gets + r->sim.sets + r->sim.bad_cmd, "acks %u != requests %u", r->acks,
+        r->sim.gets + r->sim.sets + r->sim.bad_cmd);
+    CHK(r->tt_lost <= r->sim.lost, "tag_track lost %llu > sim lost %u", (unsigned long long)r->tt_lost, r->sim.lost);
+    CHK(!r->sim.resp_drop, "sim resp_drop %u", r->sim.resp_drop);
+#undef CHK
+    return ok;
+}
+
+static void report(const opts_t* o, const result_t* r)
+{
+    const double wall = r->wall_us > 0 ? r->wall_us / 1e6 : 1e-9;
+    printf("anchor_sim: anchors=%u tags=%u rate=%.2f Hz span=%.3f s wall=%.3f s (%s)\n", o->anchors, o->tags,
+           o->rate_hz, r->span_us / 1e6, wall, o->speed > 0 ? "paced" : "max");
+    printf("  sim: data=%u lost=%u dups=%u hb=%u state=%u stalls=%u\n", r->sim.data, r->sim.lost, r->sim.dups,
+           r->sim.hb, r->sim.state, r->sim.stalls);
+    printf("  cfg: reqs=%u get=%u set=%u applied=%u rejected=%u acks=%u (err %u) snapshot frames=%u\n", r->reqs,
+           r->sim.gets, r->sim.sets, r->sim.applied, r->sim.rejected, r->acks, r->ack_err, r->snap_frames);
+    printf("  throughput: %.0f notify/s\n", gw_stats()->consumed / wall);
+    printf("  ack rtt us: p50=%u p99=%u max=%u\n", smp_pct(&s_rtt, 50), smp_pct(&s_rtt, 99), smp_max(&s_rtt));
+    gw_print();
+    printf("  tag_track: tags=%u frames=%llu lost=%llu evictions=%u\n", tt_count(),
+           (unsigned long long)r->tt_frames, (unsigned long long)r->tt_lost, tt_evictions());
+    if (o->anchors * o->tags > TT_MAX_TAGS) printf("  WARNING: %u tags > TT_MAX_TAGS %u\n", o->anchors * o->tags, TT_MAX_TAGS);
+}
+
+static int selftest(void)
+{
+    opts_t o = { .anchors = 3, .tags = 50, .rate_hz = 10, .seconds = 2, .speed = 0, .loss_ppm = 10000,
+                 .dup_ppm = 5000, .hb_ms = 250, .state_ms = 500, .get_ms = 100 };
+    result_t r;
+    if (!run(&o, &r) || !check(&r, true)) { puts("selftest: max-speed run"); return 1; }
+    if (r.sim.data + r.sim.lost != 3 * 50 * 10 * 2 + 3) { printf("selftest: events %u\n", r.sim.data + r.sim.lost); return 1; }
+    if (!r.sim.lost || !r.sim.dups || !r.sim.sets || r.sim.rejected || r.snap_frames < r.sim.gets) {
+        puts("selftest: sim counters"); return 1;
+    }
+    o.seconds = 0.5; o.speed = 5; o.loss_ppm = o.dup_ppm = 0;
+    if (!run(&o, &r) || !check(&r, true) || r.tt_lost) { puts("selftest: paced run"); return 1; }
+    if (r.wall_us < 80000) { puts("selftest: pacing too fast"); return 1; }  /* 0.5 s / 5 */
+
+    /* asim: SET visszautasítás (csak olvasható), ismeretlen parancs */
+    asim_t a; const asim_cfg_t c = { .tags = 0, .hb_ms = 0 };
+    asim_init(&a, &c, 0);
+    out_ctx_t oc = {0};
+    gw_start(&(gw_cfg_t){ .backpressure = true, .extra = ack_sub });
+    atomic_store(&s_acks, 0); atomic_store(&s_ack_err, 0);
+    const uint8_t set_ro[] = { 1, 0x01, 0, 7, 0xFF, T_VER, 1, 9 };
+    const uint8_t bad[]    = { 1, 0x33, 0, 8, 0 };
+    asim_write(&a, set_ro, sizeof(set_ro), 0, sim_out, &oc);
+    asim_write(&a, bad, sizeof(bad), 0, sim_out, &oc);
+    gw_stop();
+    if (a.st.rejected != 1 || a.st.bad_cmd != 1 || atomic_load(&s_acks) != 2 || atomic_load(&s_ack_err) != 2 ||
+        asim_reg(&a, T_VER) != 1 || asim_next_due(&a) != INT64_MAX) {
+        puts("selftest: asim set / bad command"); return 1;
+    }
+    free(s_rtt.v);
+    puts("anchor_sim: selftest ok");
+    return 0;
+}
+
+static int usage(void)
+{
+    fputs("usage: anchor_sim [--anchors N] [--tags N] [--rate HZ] [--seconds S] [--speed X | --max]\n"
+          "                  [--loss PPM] [--dup PPM] [--outage MS/EVERY_MS] [--hb MS] [--state MS]\n"
+          "                  [--get-ms MS] [--log] [--ncap out.ncap]\n"
+          "       anchor_sim --selftest\n", stderr);
+    return 2;
+}
+
+int main(int argc, char** argv)
+{
+    opts_t o = { .anchors = 3, .tags = 100, .rate_hz = 10, .seconds = 10, .speed = 1, .hb_ms = 1000,
+                 .state_ms = 5000, .get_ms = 1000 };
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        const char* v = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!strcmp(a, "--selftest")) return selftest();
+        else if (!strcmp(a, "--max"))     o.speed = 0;
+        else if (!strcmp(a, "--log"))     gw_log_print = true;
+        else if (!strcmp(a, "--anchors") && v) { o.anchors = (unsigned)atoi(v); i++; }
+        else if (!strcmp(a, "--tags")    && v) { o.tags = (unsigned)atoi(v); i++; }
+        else if (!strcmp(a, "--rate")    && v) { o.rate_hz = atof(v); i++; }
+        else if (!strcmp(a, "--seconds") && v) { o.seconds = atof(v); i++; }
+        else if (!strcmp(a, "--speed")   && v) { o.speed = atof(v); i++; }
+        else if (!strcmp(a, "--loss")    && v) { o.loss_ppm = (uint32_t)atol(v); i++; }
+        else if (!strcmp(a, "--dup")     && v) { o.dup_ppm = (uint32_t)atol(v); i++; }
+        else if (!strcmp(a, "--hb")      && v) { o.hb_ms = (uint16_t)atoi(v); i++; }
+        else if (!strcmp(a, "--state")   && v) { o.state_ms = (uint16_t)atoi(v); i++; }
+        else if (!strcmp(a, "--get-ms")  && v) { o.get_ms = (unsigned)atoi(v); i++; }
+        else if (!strcmp(a, "--ncap")    && v) { o.ncap = v; i++; }
+        else if (!strcmp(a, "--outage")  && v) {
+            unsigned ms = 0, every = 0;
+            if (sscanf(v, "%u/%u", &ms, &every) != 2 || ms >= every || every > 60000) return usage();
+            o.outage_ms = (uint16_t)ms; o.outage_every_ms = (uint16_t)every; i++;
+        }
+        else return usage();
+    }
+    if (!o.anchors || o.anchors > MAX_ANCHORS || o.tags > ASIM_MAX_TAGS || o.rate_hz < 0 || o.seconds <= 0 ||
+        o.speed < 0 || o.loss_ppm > 1000000 || o.dup_ppm > 1000000) return usage();
+
+    result_t r;
+    if (!run(&o, &r)) return 1;
+    report(&o, &r);
+    return check(&r, true) ? 0 : 1;
+}
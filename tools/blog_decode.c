@@ -0,0 +1,268 @@
+/* blog_decode — a gateway bináris naplójának (components/blog) szöveggé alakítása.
+ *
+ * Bemenet (automatikusan felismerve):
+ *   - .blog fájl: GET /api/blog.bin vagy a SPIFFS /spiffs/blog.bin
+ *   - soros konzol napló (pl. idf.py monitor kimenete): a "#BL ssss:..." sorokat
+ *     dekódolja, a seq résből jelzi az elveszett sorokat; --all a többi
+ *     (ESP_LOG szöveg) sort is átengedi.
+ * Kimenet: "[   12.345678] I (DATA) [0] VER=1 SYNC=..." — a szöveg ugyanaz,
+ * mint a korábbi target oldali ESP_LOGI sorok (pretty_print.c).
+ *
+ * Fordítás: tools/host/CMakeLists.txt (blog_decode target).
+ *
+ * Használat:
+ *   blog_decode [--all] [--stats] [--bin out.blog] (file | -)
+ *   blog_decode --selftest */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include "blog_core.h"
+#include "blog_text.h"
+#include "uwb_frame.h"
+
+static bool     s_quiet;
+static uint64_t s_lines;
+void host_log(char lvl, const char* tag, const char* fmt, ...)
+{
+    s_lines++;
+    if (s_quiet) return;
+    char line[320];
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(line, sizeof(line), fmt, ap);
+    va_end(ap);
+    if (blog_text_link != BLOG_LINK_NONE)
+        printf("[%13.6f] %c (%s) [%u] %s\n", blog_text_ts_us / 1e6, lvl, tag, (unsigned)blog_text_link, line);
+    else
+        printf("[%13.6f] %c (%s) %s\n", blog_text_ts_us / 1e6, lvl, tag, line);
+}
+
+/* ===== statisztika ===== */
+static uint32_t s_cnt[256];
+static uint64_t s_bytes[256];
+static uint32_t s_bad, s_line_gaps, s_lines_in;
+
+static void feed(const uint8_t* p, size_t n, FILE* bin)
+{
+    size_t off = 0; blog_rec_t r; int rc;
+    while ((rc = blog_rec_next(p, n, &off, &r)) == 1) {
+        s_cnt[r.fmt]++;
+        s_bytes[r.fmt] += BLOG_REC_HDR + r.len;
+        if (!blog_text(&r)) s_bad++;
+    }
+    if (rc < 0) { s_bad++; host_log('W', "blog", "truncated record at +%zu", off); }
+    if (bin) fwrite(p, 1, off, bin);
+}
+
+static void print_stats(void)
+{
+    static const char* const k_name[BLF__COUNT] = {
+#define BLOG_X_NAME(id, n, ch, lvl) [n] = #id,
+        BLOG_FMTS(BLOG_X_NAME)
+#undef BLOG_X_NAME
+    };
+    uint64_t recs = 0, bytes = 0;
+    for (int i = 0; i < 256; i++) {
+        if (!s_cnt[i]) continue;
+        printf("  %-10s %9u rec %11llu B\n", i < BLF__COUNT && k_name[i] ? k_name[i] : "?", s_cnt[i],
+               (unsigned long long)s_bytes[i]);
+        recs += s_cnt[i]; bytes += s_bytes[i];
+    }
+    printf("  total      %9llu rec %11llu B binary -> %llu text lines; bad=%u uart lines=%u gaps=%u\n",
+           (unsigned long long)recs, (unsigned long long)bytes, (unsigned long long)s_lines, s_bad, s_lines_in, s_line_gaps);
+}
+
+/* ===== soros konzol napló ===== */
+static void decode_text(FILE* in, bool all, FILE* bin)
+{
+    char line[4096];
+    uint8_t raw[BLOG_LINE_MAX];
+    bool have = false; uint16_t last = 0;
+    while (fgets(line, sizeof(line), in)) {
+        const char* m = strstr(line, "#BL ");
+        uint16_t seq;
+        const int n = m ? blog_line_decode(m, &seq, raw, sizeof(raw)) : -1;
+        if (n < 0) {
+            if (all) fputs(line, stdout);
+            continue;
+        }
+        s_lines_in++;
+        if (have && seq != (uint16_t)(last + 1)) {
+            s_line_gaps++;
+            host_log('W', "blog", "uart: %u line(s) lost", (unsigned)(uint16_t)(seq - last - 1));
+        }
+        have = true; last = seq;
+        feed(raw, (size_t)n, bin);
+    }
+}
+
+/* ===== önteszt ===== */
+#define ST_PROD   4
+#define ST_N      50000
+static blog_ring_t s_ring;
+static atomic_int  s_prod_done;
+
+static void* st_prod(void* arg)
+{
+    const uint8_t id = (uint8_t)(uintptr_t)arg;
+    uint32_t rng = 0x1234567u * (id + 1);
+    uint8_t p[64];
+    for (uint32_t i = 0; i < ST_N; i++) {
+        rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+        const uint16_t n = (uint16_t)(5 + rng % 56);
+        p[0] = id; memcpy(p + 1, &i, 4);
+        for (uint16_t k = 5; k < n; k++) p[k] = (uint8_t)(i + k);
+        /* két darabban: argumentumok + "keret" */
+        blog_ring_put(&s_ring, BLF_HEX, id, i, p, 5, p + 5, (uint16_t)(n - 5));
+        if (!(i & 255)) sched_yield();
+    }
+    atomic_fetch_add(&s_prod_done, 1);
+    return NULL;
+}
+
+static int st_ring(void)
+{
+    static uint8_t buf[4096] __attribute__((aligned(4)));
+    blog_ring_init(&s_ring, buf, sizeof(buf));
+    atomic_store(&s_prod_done, 0);
+    pthread_t th[ST_PROD];
+    for (uintptr_t i = 0; i < ST_PROD; i++) pthread_create(&th[i], NULL, st_prod, (void*)i);
+
+    int64_t last[ST_PROD]; uint32_t got = 0;
+    for (int i = 0; i < ST_PROD; i++) last[i] = -1;
+    for (;;) {
+        const bool done = atomic_load(&s_prod_done) == ST_PROD;     /* ezután még egy teljes ürítés */
+        uint16_t n; const uint8_t* p;
+        while ((p = blog_ring_peek(&s_ring, &n)) != NULL) {
+            const uint8_t* d = p + BLOG_REC_HDR;
+            uint32_t i;
+            memcpy(&i, d + 1, 4);
+            if (n != BLOG_REC_HDR + p[0] || p[1] != BLF_HEX || d[0] >= ST_PROD || p[2] != d[0] || (int64_t)i <= last[d[0]]) {
+                printf("selftest: ring record order / header (prod %u seq %u)\n", d[0], i); return 1;
+            }
+            for (uint16_t k = 5; k < p[0]; k++) if (d[k] != (uint8_t)(i + k)) { puts("selftest: ring payload"); return 1; }
+            last[d[0]] = i; got++;
+            blog_ring_release(&s_ring);
+        }
+        if (done) break;
+        sched_yield();
+    }
+    for (int i = 0; i < ST_PROD; i++) pthread_join(th[i], NULL);
+    const uint32_t drop = atomic_load(&s_ring.dropped);
+    if (got + drop != ST_PROD * ST_N || blog_ring_used(&s_ring) || got != atomic_load(&s_ring.written)) {
+        printf("selftest: ring got=%u dropped=%u used=%u\n", got, drop, blog_ring_used(&s_ring)); return 1;
+    }
+    printf("  ring: %u records, %u dropped (4 KB ring, %d producers)\n", got, drop, ST_PROD);
+    return 0;
+}
+
+static int selftest(void)
+{
+    if (st_ring()) return 1;
+
+    /* UART sor: kódolás / dekódolás minden hosszra */
+    uint8_t raw[BLOG_REC_HDR + BLOG_PAYLOAD_MAX], back[sizeof(raw)];
+    char line[BLOG_LINE_MAX];
+    for (size_t n = 1; n <= sizeof(raw); n++) {
+        for (size_t k = 0; k < n; k++) raw[k] = (uint8_t)(k * 37 + n);
+        const size_t len = blog_line_encode(line, (uint16_t)n, raw, n);
+        uint16_t seq;
+        if (len >= sizeof(line) || line[len - 1] != '\n' ||
+            blog_line_decode(line, &seq, back, sizeof(back)) != (int)n || seq != n || memcmp(raw, back, n)) {
+            printf("selftest: line codec n=%zu\n", n); return 1;
+        }
+    }
+    if (blog_line_decode("I (123) main: #BX 0001:AAAA", &(uint16_t){0}, back, sizeof(back)) != -1) { puts("selftest: non-blog line"); return 1; }
+
+    /* stream + szöveg: CLOCK, DATA, CFG (HB), HEX, RX (kikapcsolt szint: nem keletkezik, de dekódolható) */
+    uint8_t st[512]; size_t n = 0;
+    blog_hdr_encode(st); n += BLOG_HDR_LEN;
+    const uint64_t t0 = 0x1FFFFFF00ull;                                      /* 32 bites ts átfordul */
+    uint8_t v[8]; for (int i = 0; i < 8; i++) v[i] = (uint8_t)(t0 >> (8 * i));
+    blog_rec_encode(st + n, BLF_CLOCK, BLOG_LINK_NONE, (uint32_t)t0, v, 8); n += BLOG_REC_HDR + 8;
+    const uint8_t data[UWB_DATA_LEN] = { UWB_DATA_HDR, 1, 7, 9, 1, 0, 0, 0xA0, 2, 0x10, 0, 0, 0x44, 0x33, 0x22, 0x11, 0x05 };
+    blog_rec_encode(st + n, BLF_DATA, 1, (uint32_t)(t0 + 0x200), data, sizeof(data)); n += BLOG_REC_HDR + sizeof(data);
+    const uint8_t hb[13] = { 0x01, 0x01, 0x03, 0x02, 0x04, 0, 0, 0x10, 0, 0x03, 0x02, 0, 0x64 };
+    blog_rec_encode(st + n, BLF_CFG, 0, (uint32_t)t0, hb, sizeof(hb)); n += BLOG_REC_HDR + sizeof(hb);
+    blog_rec_encode(st + n, BLF_HEX, 0, (uint32_t)t0, hb, sizeof(hb)); n += BLOG_REC_HDR + sizeof(hb);
+    const uint8_t rx[3] = { 0, 20, 0 };
+    blog_rec_encode(st + n, BLF_RX, 2, (uint32_t)t0, rx, sizeof(rx)); n += BLOG_REC_HDR + sizeof(rx);
+    if (!blog_hdr_check(st, n)) { puts("selftest: header"); return 1; }
+
+    s_quiet = true;
+    s_lines = 0;
+    blog_text_reset();
+    size_t off = BLOG_HDR_LEN; blog_rec_t r; int rc, recs = 0;
+    uint64_t data_ts = 0;
+    while ((rc = blog_rec_next(st, n, &off, &r)) == 1) {
+        recs++;
+        if (!blog_text(&r)) { puts("selftest: render"); return 1; }
+        if (r.fmt == BLF_DATA) data_ts = blog_text_ts_us;
+    }
+    if (rc || recs != 5 || s_lines != 4 || data_ts != t0 + 0x200) {
+        printf("selftest: stream recs=%d lines=%llu rc=%d ts=%llx\n", recs, (unsigned long long)s_lines, rc,
+               (unsigned long long)data_ts);
+        return 1;
+    }
+    off = BLOG_HDR_LEN;
+    while ((rc = blog_rec_next(st, n - 2, &off, &r)) == 1) { }
+    if (rc != -1) { puts("selftest: truncation not detected"); return 1; }
+    s_quiet = false;
+    puts("blog_decode: selftest ok");
+    return 0;
+}
+
+static int usage(void)
+{
+    fputs("usage: blog_decode [--all] [--stats] [--bin out.blog] (file | -)\n"
+          "       blog_decode --selftest\n", stderr);
+    return 2;
+}
+
+int main(int argc, char** argv)
+{
+    bool all = false, stats = false;
+    const char* file = NULL; const char* bin_out = NULL;
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        if (!strcmp(a, "--selftest")) return selftest();
+        else if (!strcmp(a, "--all"))   all = true;
+        else if (!strcmp(a, "--stats")) stats = true;
+        else if (!strcmp(a, "--bin") && i + 1 < argc) bin_out = argv[++i];
+        else if (!file && (a[0] != '-' || !a[1])) file = a;
+        else return usage();
+    }
+    if (!file) return usage();
+    FILE* in = strcmp(file, "-") ? fopen(file, "rb") : stdin;
+    if (!in) { perror(file); return 1; }
+    FILE* bin = NULL;
+    if (bin_out) {
+        if (!(bin = fopen(bin_out, "wb"))) { perror(bin_out); return 1; }
+        uint8_t h[BLOG_HDR_LEN]; blog_hdr_encode(h); fwrite(h, 1, sizeof(h), bin);
+    }
+    blog_text_link = BLOG_LINK_NONE;
+
+    size_t cap = 1 << 20, n = 0, r;
+    uint8_t* p = malloc(cap);
+    while (p && (r = fread(p + n, 1, cap - n, in)) > 0) {
+        n += r;
+        if (n == cap) p = realloc(p, cap *= 2);
+    }
+    if (!p) { perror("malloc"); return 1; }
+    if (blog_hdr_check(p, n))
+        feed(p + p[5], n - p[5], bin);
+    else {
+        FILE* txt = fmemopen(p, n, "r");
+        if (txt) { decode_text(txt, all, bin); fclose(txt); }
+    }
+    free(p);
+    if (in != stdin) fclose(in);
+    if (bin) fclose(bin);
+    if (stats) print_stats();
+    return s_bad ? 1 : 0;
+}
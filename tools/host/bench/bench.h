@@ -0,0 +1,66 @@
+#pragma once
+/* bench.h — közös mérő a host benchekhez (tools/host/bench).
+ * bench_run: a függvényt körönként `batch`-szer hívja, amíg el nem telik a
+ * mérési idő; eredmény ns/op. --quick: rövid futás (ctest füstteszt, a
+ * számok ott nem mérvadók). */
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static unsigned bench_ms = 300;                 /* mérési idő / eset */
+static volatile uint32_t bench_sink;            /* az eredmény ne optimalizálódjon ki */
+
+static inline int64_t bench_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* --quick: 20 ms / eset; visszaad: true ha quick */
+static inline bool bench_args(int argc, char** argv)
+{
+    for (int i = 1; i < argc; i++)
+        if (!strcmp(argv[i], "--quick")) { bench_ms = 20; return true; }
+    return false;
+}
+
+typedef void (*bench_fn_t)(void* ctx, uint32_t iters);
+
+/* ns / iteráció; fn egy hívásban `iters` iterációt végez */
+static inline double bench_run(bench_fn_t fn, void* ctx)
+{
+    fn(ctx, 16);                                /* bemelegítés */
+    uint32_t iters = 64;
+    int64_t t, t0;
+    for (;;) {                                  /* kör méretezése ~10 ms-ra */
+        t0 = bench_ns(); fn(ctx, iters); t = bench_ns() - t0;
+        if (t > 10000000 || iters >= (1u << 28)) break;
+        iters *= 4;
+    }
+    uint64_t n = 0; int64_t sum = 0;
+    const int64_t end = bench_ns() + (int64_t)bench_ms * 1000000;
+    do {
+        t0 = bench_ns(); fn(ctx, iters); sum += bench_ns() - t0;
+        n += iters;
+    } while (bench_ns() < end);
+    return (double)sum / (double)n;
+}
+
+/* "név   123.4 ns/frame   8.10 M frame/s" */
+static inline void bench_print(const char* name, double ns, const char* unit)
+{
+    const double per_s = ns > 0 ? 1e9 / ns : 0;
+    if (per_s >= 1e6) printf("  %-40s %10.1f ns/%-7s %8.2f M %s/s\n", name, ns, unit, per_s / 1e6, unit);
+    else              printf("  %-40s %10.1f ns/%-7s %8.1f k %s/s\n", name, ns, unit, per_s / 1e3, unit);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,123 @@
+/* bench_http — hitelesítés és config handlerek kérés / s host-on.
+ * A webserver egységei (auth, http_json, json_in/out, cfg_json, session_store)
+ * változatlanul, az esp_http_server shim-en át; socket és TLS nélkül, tehát a
+ * handler saját CPU költsége látszik.
+ *
+ * Esetek:
+ *   GET /api/config, SID cookie     role_from_auth (sess_lookup) + cfg_json_write
+ *   GET /api/config, Basic (cache)  ellenőrzött fejléc a cred cache-ben
+ *   GET /api/config, Basic (miss)   base64 + felhasználó ellenőrzés minden kérésnél
+ *   GET /api/config, nincs auth     401
+ *   POST /auth/login                recv_json + check_user + sess_put + Set-Cookie
+ *   POST /api/config body           recv_json a k_cfg_json táblával (128 B darabok)
+ *
+ * Használat: bench_http [--quick] */
+#include <cstdio>
+#include <cstring>
+#include "bench.h"
+#include "auth.hpp"
+#include "session_store.hpp"
+#include "http_json.hpp"
+#include "cfg_json.hpp"
+
+static const char kSid[] = "0123456789abcdef0123456789abcdef";
+static char s_cookie_hdr[96];
+static EspCfg s_cfg;
+
+/* a GET /api/config handler a webserver.cpp-ből (g_cfg helyett s_cfg) */
+static esp_err_t config_get(httpd_req_t* req){
+    if(!require_role(req, ROLE_BLE)) return ESP_FAIL;
+    JsonW w; json_begin(req,w);
+    cfg_json_write(w,s_cfg);
+    return json_end(req,w);
+}
+
+struct Ctx { const char* method_uri; const char* hdrs; const char* body; bool reset; int want; };
+
+static uint32_t one(const Ctx& c, httpd_handler_t fn, int method){
+    httpd_req_t r{}; host_req_t h{};
+    host_req_init(&r,&h,method,c.method_uri,c.hdrs,c.body);
+    fn(&r);
+    return (uint32_t)h.status + h.resp_bytes;
+}
+
+static void b_get(void* p, uint32_t it){
+    const Ctx& c=*(const Ctx*)p; uint32_t acc=0;
+    for(uint32_t i=0;i<it;i++){
+        if(c.reset) auth_reset();
+        acc+=one(c,config_get,HTTP_GET);
+    }
+    bench_sink=acc;
+}
+static void b_login(void* p, uint32_t it){
+    const Ctx& c=*(const Ctx*)p; uint32_t acc=0;
+    for(uint32_t i=0;i<it;i++) acc+=one(c,auth_login_post,HTTP_POST);
+    bench_sink=acc;
+}
+static void b_cfg_body(void* p, uint32_t it){
+    const Ctx& c=*(const Ctx*)p; uint32_t acc=0;
+    for(uint32_t i=0;i<it;i++){
+        httpd_req_t r{}; host_req_t h{};
+        host_req_init(&r,&h,HTTP_POST,c.method_uri,c.hdrs,c.body);
+        EspCfg want=s_cfg; JsonR jr;
+        if(recv_json(&r,jr,k_cfg_json,k_cfg_json_n,&want)==ESP_OK) acc+=jr.set;
+    }
+    bench_sink=acc;
+}
+
+/* egy kérés a várt státusszal? (a mérés előtt) */
+static bool check(const char* name, const Ctx& c, httpd_handler_t fn, int method){
+    if(c.reset) auth_reset();
+    httpd_req_t r{}; host_req_t h{};
+    host_req_init(&r,&h,method,c.method_uri,c.hdrs,c.body);
+    fn(&r);
+    if(h.status!=c.want){ fprintf(stderr,"bench_http: %s: status %d, want %d\n",name,h.status,c.want); return false; }
+    return true;
+}
+
+static void fill_sessions(){
+    auth_reset();
+    char sid[SESS_SID_LEN+1];
+    for(unsigned i=0;i+1<SESS_CAP;i++){                       // tele tábla, a mért SID a legrégebbi
+        snprintf(sid,sizeof(sid),"%032x",i+1);
+        sess_put(sid,ROLE_DIAG,0x7FFFFFFF,0);
+    }
+    sess_put(kSid,ROLE_BLE,0x7FFFFFFF,0);
+}
+
+int main(int argc, char** argv){
+    bench_args(argc,argv);
+    snprintf(s_cookie_hdr,sizeof(s_cookie_hdr),"Cookie: lang=hu; SID=%s\n",kSid);
+    const char* basic="Authorization: Basic YWRtaW46YWRtaW4=\n";       // admin:admin
+    const Ctx cookie   {"/api/config",s_cookie_hdr,nullptr,false,200};
+    const Ctx basic_hit{"/api/config",basic,nullptr,false,200};
+    const Ctx basic_mis{"/api/config",basic,nullptr,true,200};
+    const Ctx noauth   {"/api/config",nullptr,nullptr,false,401};
+    const Ctx login    {"/auth/login",nullptr,"{\"user\":\"admin\",\"pass\":\"admin\"}",false,200};
+    const Ctx cfg_body {"/api/config",nullptr,
+        "{\"NETWORK_ID\":4660,\"ZONE_ID\":23089,\"HB_MS\":5000,\"LOG_LEVEL\":2,"
+        "\"TX_ANT_DLY\":16385,\"RX_ANT_DLY\":16385,\"BIAS_TICKS\":-12,\"PHY_CH\":5,\"PHY_SFDTO\":129}",false,0};
+
+    fill_sessions();
+    if(!check("cookie",cookie,config_get,HTTP_GET) || !check("basic",basic_hit,config_get,HTTP_GET) ||
+       !check("noauth",noauth,config_get,HTTP_GET) || !check("login",login,auth_login_post,HTTP_POST)) return 1;
+    {
+        httpd_req_t r{}; host_req_t h{};
+        host_req_init(&r,&h,HTTP_POST,cfg_body.method_uri,nullptr,cfg_body.body);
+        EspCfg want=s_cfg; JsonR jr;
+        if(recv_json(&r,jr,k_cfg_json,k_cfg_json_n,&want)!=ESP_OK || jr.set!=0x3FB){
+            fprintf(stderr,"bench_http: config body: set=0x%X\n",(unsigned)jr.set); return 1;
+        }
+    }
+    printf("bench_http: SESS_CAP %u, CRED_CACHE %u\n",(unsigned)SESS_CAP,(unsigned)CRED_CACHE);
+
+    fill_sessions();
+    bench_print("GET /api/config, SID cookie",bench_run(b_get,(void*)&cookie),"req");
+    auth_reset();
+    bench_print("GET /api/config, Basic (cache hit)",bench_run(b_get,(void*)&basic_hit),"req");
+    bench_print("GET /api/config, Basic (cache miss)",bench_run(b_get,(void*)&basic_mis),"req");
+    bench_print("GET /api/config, no auth (401)",bench_run(b_get,(void*)&noauth),"req");
+    bench_print("POST /auth/login",bench_run(b_login,(void*)&login),"req");
+    bench_print("POST /api/config body (recv_json)",bench_run(b_cfg_body,(void*)&cfg_body),"req");
+    return 0;
+}
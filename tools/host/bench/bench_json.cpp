@@ -0,0 +1,226 @@
+/* bench_json — streaming JSON író (json_out) a régi snprintf / std::string
+ * válaszépítéssel szemben (0ea999b webserver.cpp, httpd_resp_send nélkül).
+ *
+ * Esetek:
+ *   /api/config      json_cfg_print (snprintf) ↔ cfg_json_write (JsonW)
+ *   /api/dwm_get     TLV mezők + RAW_HEX + FRAMES: régi char json[2048] +
+ *                    std::string hex / frames ↔ JsonW (tlv_next, jw_hex)
+ *                    anchor_sim GET snapshot, ill. ≥600 B-ra bővítve (a régi
+ *                    RAW_HEX ~340 B fölött csonkol, a sorban jelezzük; a régi
+ *                    csak a név szerint ismert tageket írja, az új mindet)
+ *   RAW_HEX 1 KB     csak a hex kódolás (snprintf("%02X ") + string ↔ jw_hex)
+ * A JsonW sink csak számol (httpd-n httpd_resp_send_chunk).
+ *
+ * Használat: bench_json [--quick] */
+#include <cstdio>
+#include <cstring>
+#include <cinttypes>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "json_out.hpp"
+#include "cfg_json.hpp"
+#include "tlv.h"
+#include "anchor_sim.h"
+
+struct Frame { bool from_cfg; uint16_t len; };
+
+static std::vector<uint8_t> s_bytes;            // GET snapshot (összefűzött TLV)
+static std::vector<Frame>   s_frames;
+static std::vector<uint8_t> s_big;              // ≥600 B-ra bővített snapshot
+static uint8_t s_kb[1024];
+
+/* ===== régi (0ea999b) ===== */
+static inline uint16_t rd16be(const uint8_t* p){ return (uint16_t)(p[0]<<8 | p[1]); }
+static inline uint32_t rd32be(const uint8_t* p){ return (uint32_t)p[0]<<24 | p[1]<<16 | p[2]<<8 | p[3]; }
+
+static void json_cfg_print(char* buf, size_t sz, const EspCfg& c){
+    snprintf(buf, sz,
+      "{"
+      "\"NETWORK_ID\":%u,"
+      "\"ZONE_ID\":\"0x%04X\","
+      "\"ANCHOR_ID\":\"0x%08X\","
+      "\"HB_MS\":%u,"
+      "\"LOG_LEVEL\":%u,"
+      "\"TX_ANT_DLY\":%d,"
+      "\"RX_ANT_DLY\":%d,"
+      "\"BIAS_TICKS\":%d,"
+      "\"PHY_CH\":%u,"
+      "\"PHY_SFDTO\":%u"
+      "}\n",
+      (unsigned)c.NETWORK_ID,(unsigned)c.ZONE_ID,(unsigned)c.ANCHOR_ID,
+      (unsigned)c.HB_MS,(unsigned)c.LOG_LEVEL,
+      (int)c.TX_ANT_DLY,(int)c.RX_ANT_DLY,(int)c.BIAS_TICKS,
+      (unsigned)c.PHY_CH,(unsigned)c.PHY_SFDTO);
+}
+
+/* api_dwm_get válaszépítése (a várakozás és a küldés nélkül); visszaad: hossz */
+static size_t legacy_dwm(const std::vector<uint8_t>& s_bytes, const std::vector<Frame>& s_frames, char* json){
+    size_t wp=0; bool first=true;
+    auto add=[&](const char* k, const char* v){ wp+=snprintf(json+wp,2048-wp,"%s\"%s\":%s",first?"":",",k,v); first=false; };
+    wp+=snprintf(json+wp,2048-wp,"{");
+
+    size_t off=0, alen=s_bytes.size();
+    if(alen>=2 && s_bytes[0]==0x00){ uint8_t l=s_bytes[1]; if(alen>=2+l) off=2+l; } // VER skip
+
+    auto name_of=[](uint8_t t)->const char*{
+        switch(t){
+            case 0x10: return "NETWORK_ID"; case 0x11: return "ZONE_ID";
+            case 0x12: return "ANCHOR_ID";  case 0x13: return "TX_ANT_DLY";
+            case 0x14: return "RX_ANT_DLY"; case 0x16: return "BIAS_TICKS";
+            case 0x1F: return "LOG_LEVEL";  case 0x20: return "HB_MS";
+            case 0x40: return "PHY_CH";     case 0x49: return "PHY_SFDTO";
+            default:   return nullptr;
+        }
+    };
+
+    while(off+2<=alen){
+        uint8_t t=s_bytes[off], l=s_bytes[off+1]; off+=2;
+        if(off+l>alen) break;
+        const uint8_t* v=&s_bytes[off]; off+=l;
+        const char* nm=name_of(t); if(!nm) continue;
+        char vb[32];
+        if(l==1) snprintf(vb,sizeof(vb),"%u",(unsigned)v[0]);
+        else if(l==2) snprintf(vb,sizeof(vb),"%u",(unsigned)rd16be(v));
+        else if(l==4) snprintf(vb,sizeof(vb),"\"0x%08" PRIX32 "\"", rd32be(v));
+        else continue;
+        add(nm,vb);
+    }
+
+    // RAW_HEX
+    {
+        std::string hex; hex.reserve(alen*3);
+        for(size_t i=0;i<alen;i++){ char b[4]; snprintf(b,sizeof(b),"%02X ",s_bytes[i]); hex+=b; }
+        if(!hex.empty()) hex.pop_back();
+        char b[1024]; snprintf(b,sizeof(b),"\"%s\"",hex.c_str());
+        add("RAW_HEX",b);
+    }
+    // FRAMES
+    {
+        std::string fr="[";
+        for(size_t i=0;i<s_frames.size();i++){
+            char b[32]; snprintf(b,sizeof(b),"%s[\"%s\",%u]",i?",":"",s_frames[i].from_cfg?"CFG":"DATA",(unsigned)s_frames[i].len);
+            fr+=b;
+        }
+        fr+="]";
+        add("FRAMES",fr.c_str());
+    }
+
+    wp+=snprintf(json+wp,2048-wp,"}\n");
+    return wp;
+}
+
+/* ===== új: a webserver.cpp api_dwm_get törzse (snapshot fejléc mezők nélkül) ===== */
+static void count_sink(void* ctx, const char* s, size_t n){ (void)s; *(uint32_t*)ctx+=(uint32_t)n; }
+
+static uint32_t new_dwm(const std::vector<uint8_t>& bytes, const std::vector<Frame>& frames){
+    uint32_t n=0;
+    JsonW w; jw_init(w,count_sink,&n);
+    jw_obj(w);
+    tlv_cur_t cur; tlv_t t;
+    tlv_cur_init(&cur, bytes.data(), (uint16_t)bytes.size());
+    while(tlv_next(&cur,&t)==TLV_ITEM){
+        if(t.tag==T_VER || !tlv_width_ok(&t)) continue;
+        jw_key(w,t.d->name);
+        if(t.len>4)                       jw_hex(w,t.val,t.len);
+        else if(t.d->fmt==TLV_FMT_DEC)    jw_u32(w,tlv_u32(&t));
+        else if(t.d->fmt==TLV_FMT_SDEC)   jw_i32(w,tlv_i32(&t));
+        else if(t.d->fmt==TLV_FMT_HEX)    jw_hex_u32(w,tlv_u32(&t),t.len*2);
+        else                              jw_hex(w,t.val,t.len);
+    }
+    jw_key(w,"RAW_HEX"); jw_hex(w,bytes.data(),bytes.size());
+    jw_key(w,"FRAMES");  jw_arr(w);
+    for(const Frame& f: frames){
+        jw_arr(w); jw_str(w,f.from_cfg?"CFG":"DATA"); jw_u32(w,f.len); jw_arr_end(w);
+    }
+    jw_arr_end(w);
+    jw_obj_end(w);
+    return jw_finish(w);
+}
+
+/* ===== mérések ===== */
+static EspCfg s_cfg;
+
+static void b_cfg_legacy(void*, uint32_t it){
+    char b[256]; uint32_t acc=0;
+    for(uint32_t i=0;i<it;i++){ s_cfg.HB_MS=(uint16_t)i; json_cfg_print(b,sizeof(b),s_cfg); acc+=(uint8_t)b[40]; }
+    bench_sink=acc;
+}
+static void b_cfg_new(void*, uint32_t it){
+    uint32_t acc=0;
+    for(uint32_t i=0;i<it;i++){
+        uint32_t n=0; JsonW w; jw_init(w,count_sink,&n);
+        s_cfg.HB_MS=(uint16_t)i; cfg_json_write(w,s_cfg); acc+=jw_finish(w);
+    }
+    bench_sink=acc;
+}
+
+struct DwmIn { const std::vector<uint8_t>* bytes; };
+static void b_dwm_legacy(void* p, uint32_t it){
+    const DwmIn& d=*(const DwmIn*)p; static char json[2048]; uint32_t acc=0;
+    for(uint32_t i=0;i<it;i++) acc+=(uint32_t)legacy_dwm(*d.bytes,s_frames,json);
+    bench_sink=acc;
+}
+static void b_dwm_new(void* p, uint32_t it){
+    const DwmIn& d=*(const DwmIn*)p; uint32_t acc=0;
+    for(uint32_t i=0;i<it;i++) acc+=new_dwm(*d.bytes,s_frames);
+    bench_sink=acc;
+}
+
+static void b_hex_legacy(void*, uint32_t it){
+    uint32_t acc=0;
+    for(uint32_t i=0;i<it;i++){
+        std::string hex; hex.reserve(sizeof(s_kb)*3);
+        for(size_t k=0;k<sizeof(s_kb);k++){ char b[4]; snprintf(b,sizeof(b),"%02X ",s_kb[k]); hex+=b; }
+        acc+=(uint32_t)hex.size();
+    }
+    bench_sink=acc;
+}
+static void b_hex_new(void*, uint32_t it){
+    uint32_t acc=0;
+    for(uint32_t i=0;i<it;i++){
+        uint32_t n=0; JsonW w; jw_init(w,count_sink,&n);
+        jw_hex(w,s_kb,sizeof(s_kb)); acc+=jw_flush(w);
+    }
+    bench_sink=acc;
+}
+
+static bool collect(void*, uint8_t, const uint8_t* d, uint16_t n, bool from_cfg){
+    static bool ack_seen;
+    if(!ack_seen){ ack_seen=true; return true; }       // [0] = ACK
+    s_bytes.insert(s_bytes.end(),d,d+n);
+    s_frames.push_back({from_cfg,n});
+    return true;
+}
+
+int main(int argc, char** argv){
+    bench_args(argc,argv);
+    asim_cfg_t c{}; c.anchor_id=0x51A00001u; c.network_id=0x1234; c.frame_max=ASIM_FRAME_MAX; c.seed=1;
+    asim_t a; asim_init(&a,&c,0);
+    const uint8_t get[5]={1,0x02,0x00,0x01,0};
+    asim_write(&a,get,sizeof(get),1000000,collect,nullptr);
+    if(s_bytes.empty()){ fprintf(stderr,"bench_json: no snapshot from anchor_sim\n"); return 1; }
+
+    s_big=s_bytes;                                     // ismeretlen, hosszú tagokkal legalább 600 B-ig
+    for(uint8_t t=0xE0; s_big.size()<600; t++){ s_big.push_back(t); s_big.push_back(32); for(int k=0;k<32;k++) s_big.push_back((uint8_t)(t+k)); }
+    for(size_t i=0;i<sizeof(s_kb);i++) s_kb[i]=(uint8_t)(i*7);
+
+    static char json[2048];
+    const size_t ls=legacy_dwm(s_bytes,s_frames,json), lb=legacy_dwm(s_big,s_frames,json);
+    const uint32_t ns=new_dwm(s_bytes,s_frames), nb=new_dwm(s_big,s_frames);
+    printf("bench_json: snapshot %zu B / %zu frame(s); válasz régi %zu B, új %u B\n",
+           s_bytes.size(),s_frames.size(),ls,(unsigned)ns);
+    printf("bench_json: snapshot %zu B; válasz régi %zu B (RAW_HEX csonkolva: %s), új %u B\n",
+           s_big.size(),lb,s_big.size()*3>1021?"igen":"nem",(unsigned)nb);
+
+    bench_print("/api/config, snprintf (régi)",bench_run(b_cfg_legacy,nullptr),"resp");
+    bench_print("/api/config, JsonW",bench_run(b_cfg_new,nullptr),"resp");
+    DwmIn small{&s_bytes}, big{&s_big};
+    bench_print("/api/dwm_get snapshot, régi",bench_run(b_dwm_legacy,&small),"resp");
+    bench_print("/api/dwm_get snapshot, JsonW",bench_run(b_dwm_new,&small),"resp");
+    bench_print("/api/dwm_get >=600 B, régi (csonkol)",bench_run(b_dwm_legacy,&big),"resp");
+    bench_print("/api/dwm_get >=600 B, JsonW",bench_run(b_dwm_new,&big),"resp");
+    bench_print("RAW_HEX 1 KB, snprintf + string",bench_run(b_hex_legacy,nullptr),"KB");
+    bench_print("RAW_HEX 1 KB, jw_hex",bench_run(b_hex_new,nullptr),"KB");
+    return 0;
+}
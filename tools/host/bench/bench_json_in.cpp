@@ -0,0 +1,194 @@
+/* bench_json_in — streaming body olvasó (json_in) a régi strstr-es
+ * feldolgozással szemben (0ea999b webserver.cpp: auth_login_post getstr,
+ * api_config_post find_key / parse_*), httpd nélkül.
+ *
+ * A body mindkét oldalon "recv"-ből jön: a régi egy heap std::vector-ba
+ * másolja egyben (a legjobb esete), az új 128 B-os darabokban eteti, ahogy
+ * a recv_json.
+ * A régi kód kétféle strstr-rel fut: a host glibc-jével (SIMD, 16 B / lépés)
+ * és bájtonkénti naiv strstr-rel, ami a newlib -Os alakja; a targeten
+ * (Xtensa LX6) nincs SIMD út, ott ez a mérvadó.
+ *
+ * Esetek:
+ *   login            {"user","pass"} ~30 B
+ *   config 10 kulcs  a UI teljes űrlapja ~170 B
+ *   config 1 KB      ugyanez 1 KB fölé töltve, az ismeretlen kulcsok elöl (a
+ *                    régi kulcsonként újra végigolvassa: O(kulcs × body))
+ * Ellenőrzés a mérés előtt: a két parser ugyanazt az EspCfg-t adja; egy
+ * string értéken belüli kulcsot a régi elfogad, az új nem.
+ *
+ * Használat: bench_json_in [--quick] */
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "json_in.hpp"
+#include "cfg_json.hpp"
+
+/* ===== régi (0ea999b), a strstr sablon paraméter ===== */
+typedef const char* (*strstr_fn)(const char*, const char*);
+static const char* libc_strstr(const char* h, const char* n){ return strstr(h,n); }
+static const char* naive_strstr(const char* h, const char* n){          // newlib -Os
+    for(;*h;h++){
+        size_t i=0;
+        while(n[i] && h[i]==n[i]) i++;
+        if(!n[i]) return h;
+    }
+    return nullptr;
+}
+
+template<strstr_fn strstr>
+static bool find_key(const char* body, const char* key, const char** val_start){
+    const char* p=strstr(body,key); if(!p) return false;
+    p=strchr(p,':'); if(!p) return false; p++;
+    while(*p==' '||*p=='\"'){ if(*p=='\"'){ *val_start=p; return true; } ++p; }
+    *val_start=p; return true;
+}
+template<strstr_fn SS>
+static bool parse_u32(const char* body, const char* key, uint32_t& out){
+    const char* v=nullptr; if(!find_key<SS>(body,key,&v)) return false; char* end=nullptr;
+    if(*v=='\"') out=strtoul(v+1,&end,16); else out=strtoul(v,&end,10); return true;
+}
+template<strstr_fn SS>
+static bool parse_i32(const char* body, const char* key, int32_t& out){
+    const char* v=nullptr; if(!find_key<SS>(body,key,&v)) return false; char* end=nullptr;
+    if(*v=='\"') out=(int32_t)strtol(v+1,&end,16); else out=(int32_t)strtol(v,&end,10); return true;
+}
+template<strstr_fn SS>
+static bool parse_u16(const char* body, const char* key, uint16_t& out){ uint32_t t; if(!parse_u32<SS>(body,key,t)) return false; out=(uint16_t)t; return true; }
+template<strstr_fn SS>
+static bool parse_u8 (const char* body, const char* key, uint8_t&  out){ uint32_t t; if(!parse_u32<SS>(body,key,t)) return false; out=(uint8_t)t;  return true; }
+
+template<strstr_fn SS>
+static void legacy_config(const char* src, int len, EspCfg& g_cfg){
+    if(len<=0) return;
+    std::vector<char> body(len+1,0);
+    memcpy(body.data(),src,len);
+    parse_u16<SS>(body.data(),"\"NETWORK_ID\"",g_cfg.NETWORK_ID);
+    parse_u16<SS>(body.data(),"\"ZONE_ID\""   ,g_cfg.ZONE_ID);
+    { uint32_t t; if(parse_u32<SS>(body.data(),"\"ANCHOR_ID\"",t)) g_cfg.ANCHOR_ID=t; }
+    parse_u16<SS>(body.data(),"\"HB_MS\""     ,g_cfg.HB_MS);
+    parse_u8<SS>(body.data(),"\"LOG_LEVEL\"" ,g_cfg.LOG_LEVEL);
+    parse_i32<SS>(body.data(),"\"TX_ANT_DLY\"",g_cfg.TX_ANT_DLY);
+    parse_i32<SS>(body.data(),"\"RX_ANT_DLY\"",g_cfg.RX_ANT_DLY);
+    parse_i32<SS>(body.data(),"\"BIAS_TICKS\"",g_cfg.BIAS_TICKS);
+    parse_u8<SS>(body.data(),"\"PHY_CH\""    ,g_cfg.PHY_CH);
+    parse_u16<SS>(body.data(),"\"PHY_SFDTO\"" ,g_cfg.PHY_SFDTO);
+}
+
+template<strstr_fn strstr>
+static size_t legacy_login(const char* src, int len){
+    if(len<=0) return 0;
+    std::vector<char> body(len+1,0);
+    memcpy(body.data(),src,len);
+    auto getstr=[&](const char* key)->std::string{
+        const char* k=strstr(body.data(),key); if(!k) return {};
+        k=strchr(k,':'); if(!k) return {}; k++;
+        while(*k==' '||*k=='\"') ++k;
+        const char* e=k; while(*e && *e!='\"' && *e!=',' && *e!='}') ++e;
+        return std::string(k,e-k);
+    };
+    std::string u=getstr("\"user\""); std::string p=getstr("\"pass\"");
+    return u.size()+p.size();
+}
+
+/* ===== új ===== */
+struct LoginBody { char pass[64]; char user[32]; };
+static const JrField k_login_json[] = { JR_STR(LoginBody, pass, 0), JR_STR(LoginBody, user, 1) };
+
+/* recv_json darabolása, httpd nélkül */
+static bool jr_body(JsonR& r, const JrField* tab, uint8_t ntab, void* dst, const char* src, int len){
+    jr_init(r,tab,ntab,dst);
+    char b[128];
+    for(int off=0;off<len;){
+        const int k=len-off<(int)sizeof(b)?len-off:(int)sizeof(b);
+        memcpy(b,src+off,k); off+=k;
+        if(!jr_feed(r,b,k)) break;
+    }
+    return jr_end(r) && !r.bad;
+}
+
+struct Body { const char* s; int n; };
+
+/* mezőnként: az EspCfg padding bájtjai inicializálatlanok, memcmp nem jó */
+static bool cfg_same(const EspCfg& a, const EspCfg& b){
+    for(uint8_t f=0;f<CFG_NFIELDS;f++) if(cfg_get(a,f)!=cfg_get(b,f)) return false;
+    return true;
+}
+
+template<strstr_fn SS>
+static void b_legacy_cfg(void* p, uint32_t it){
+    const Body& b=*(const Body*)p; uint32_t acc=0;
+    for(uint32_t i=0;i<it;i++){ EspCfg c; legacy_config<SS>(b.s,b.n,c); acc+=c.PHY_SFDTO; }
+    bench_sink=acc;
+}
+static void b_jr_cfg(void* p, uint32_t it){
+    const Body& b=*(const Body*)p; uint32_t acc=0;
+    for(uint32_t i=0;i<it;i++){ EspCfg c; JsonR r; acc+=jr_body(r,k_cfg_json,k_cfg_json_n,&c,b.s,b.n)+c.PHY_SFDTO; }
+    bench_sink=acc;
+}
+template<strstr_fn SS>
+static void b_legacy_login(void* p, uint32_t it){
+    const Body& b=*(const Body*)p; uint32_t acc=0;
+    for(uint32_t i=0;i<it;i++) acc+=(uint32_t)legacy_login<SS>(b.s,b.n);
+    bench_sink=acc;
+}
+static void b_jr_login(void* p, uint32_t it){
+    const Body& b=*(const Body*)p; uint32_t acc=0;
+    for(uint32_t i=0;i<it;i++){ LoginBody lb{}; JsonR r; acc+=jr_body(r,k_login_json,2,&lb,b.s,b.n)+lb.user[0]; }
+    bench_sink=acc;
+}
+
+static const char kLogin[] = "{\"user\":\"admin\",\"pass\":\"admin\"}";
+static const char kCfg[] =
+    "{\"NETWORK_ID\":4660,\"ZONE_ID\":\"0x5A31\",\"ANCHOR_ID\":\"0x00000017\",\"HB_MS\":5000,\"LOG_LEVEL\":2,"
+    "\"TX_ANT_DLY\":16385,\"RX_ANT_DLY\":16385,\"BIAS_TICKS\":-12,\"PHY_CH\":5,\"PHY_SFDTO\":129}";
+
+static void row(const char* name, bench_fn_t legacy, bench_fn_t naive, bench_fn_t jr, const Body& b){
+    char t[64];
+    snprintf(t,sizeof(t),"%s, legacy glibc strstr",name); bench_print(t,bench_run(legacy,(void*)&b),"req");
+    snprintf(t,sizeof(t),"%s, legacy naive strstr",name); bench_print(t,bench_run(naive,(void*)&b),"req");
+    snprintf(t,sizeof(t),"%s, jr_feed",name);             bench_print(t,bench_run(jr,(void*)&b),"req");
+}
+
+int main(int argc, char** argv){
+    bench_args(argc,argv);
+
+    /* 1 KB: ismeretlen kulcsok, utánuk a 10 ismert */
+    std::string big("{");
+    for(int i=0;big.size()<1024-sizeof(kCfg);i++){ char t[48]; snprintf(t,sizeof(t),"\"ui_field_%02d\":\"value %d\",",i,i*37); big+=t; }
+    big+=kCfg+1;
+    const Body login{kLogin,(int)sizeof(kLogin)-1}, cfg{kCfg,(int)sizeof(kCfg)-1}, cfg1k{big.c_str(),(int)big.size()};
+
+    /* ellenőrzés: azonos eredmény; string értéken belüli kulcs */
+    for(const Body* b: {&cfg,&cfg1k}){
+        EspCfg a, a2, n; JsonR r;
+        legacy_config<libc_strstr>(b->s,b->n,a);
+        legacy_config<naive_strstr>(b->s,b->n,a2);
+        if(!jr_body(r,k_cfg_json,k_cfg_json_n,&n,b->s,b->n) || r.set!=0x3FF || !cfg_same(a,n) || !cfg_same(a2,n)){
+            fprintf(stderr,"bench_json_in: config %d B: set=0x%X, eltér a régitől\n",b->n,(unsigned)r.set); return 1;
+        }
+    }
+    {
+        LoginBody lb{}; JsonR r;
+        if(!jr_body(r,k_login_json,2,&lb,login.s,login.n) || strcmp(lb.user,"admin") || strcmp(lb.pass,"admin")
+           || legacy_login<libc_strstr>(login.s,login.n)!=10 || legacy_login<naive_strstr>(login.s,login.n)!=10){
+            fprintf(stderr,"bench_json_in: login\n"); return 1;
+        }
+        static const char trap[]="{\"label\":\"PHY_CH\",\"HB_MS\":7}";
+        EspCfg a, n;
+        legacy_config<libc_strstr>(trap,sizeof(trap)-1,a);
+        if(!jr_body(r,k_cfg_json,k_cfg_json_n,&n,trap,sizeof(trap)-1) || r.set!=CFG_M(CFG_F_HB_MS) || n.PHY_CH!=9){
+            fprintf(stderr,"bench_json_in: kulcs string értékben\n"); return 1;
+        }
+        printf("bench_json_in: %s → régi PHY_CH=%u, új PHY_CH=%u (érintetlen)\n",trap,(unsigned)a.PHY_CH,(unsigned)n.PHY_CH);
+    }
+
+    printf("bench_json_in: body → struktúra (login %d B, config %d B / %d B)\n",login.n,cfg.n,cfg1k.n);
+    row("login",b_legacy_login<libc_strstr>,b_legacy_login<naive_strstr>,b_jr_login,login);
+    row("config 10 keys",b_legacy_cfg<libc_strstr>,b_legacy_cfg<naive_strstr>,b_jr_cfg,cfg);
+    row("config 1 KB",b_legacy_cfg<libc_strstr>,b_legacy_cfg<naive_strstr>,b_jr_cfg,cfg1k);
+    return 0;
+}
@@ -0,0 +1,123 @@
+/* bench_proto — DATA / CFG dekódolás keret / s host-on (a target kódja, shimmel).
+ *
+ * Esetek:
+ *   DATA decode      uwb_data_decode, 20 B 0xAB keret
+ *   DATA pp_log      pp_log_data: dekódolás + ESP_LOGI formázás (kiírás nélkül)
+ *   CFG HB/ACK       uwb_cfg_decode fast-path
+ *   CFG TLV walk     tlv_next + tlv_u32 egy teljes GET snapshoton (anchor_sim)
+ *   CFG pp_log       pp_log_cfg ugyanazon (formázás, kiírás nélkül)
+ *
+ * Használat: bench_proto [--quick] */
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include "bench.h"
+#include "uwb_frame.h"
+#include "tlv.h"
+#include "pretty_print.h"
+#include "anchor_sim.h"
+
+/* ESP_LOGx: csak formázás (a UART költsége nélkül), mint a targeten a vsnprintf */
+static char     s_line[256];
+static uint32_t s_lines;
+void host_log(char lvl, const char* tag, const char* fmt, ...)
+{
+    (void)lvl; (void)tag;
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(s_line, sizeof(s_line), fmt, ap);
+    va_end(ap);
+    s_lines++;
+}
+
+/* ===== bemenetek ===== */
+#define MAX_FRAMES 16
+typedef struct { uint8_t d[ASIM_FRAME_MAX]; uint16_t n; } frame_t;
+static frame_t  s_snap[MAX_FRAMES];            /* GET válasz: ACK + TLV keretek */
+static unsigned s_nsnap;
+static uint8_t  s_data[64][UWB_DATA_LEN];
+
+static bool collect(void* ctx, uint8_t link, const uint8_t* d, uint16_t n, bool from_cfg)
+{
+    (void)ctx; (void)link; (void)from_cfg;
+    if (s_nsnap < MAX_FRAMES) { memcpy(s_snap[s_nsnap].d, d, n); s_snap[s_nsnap++].n = n; }
+    return true;
+}
+
+static void make_inputs(void)
+{
+    const asim_cfg_t c = { .anchor_id = 0x51A00001u, .network_id = 0x1234, .frame_max = ASIM_FRAME_MAX, .seed = 1 };
+    asim_t a;
+    asim_init(&a, &c, 0);
+    const uint8_t get[5] = { 1, 0x02, 0x00, 0x01, 0 };
+    asim_write(&a, get, sizeof(get), 1000000, collect, NULL);
+    for (unsigned i = 0; i < 64; i++) {
+        uint8_t* f = s_data[i];
+        const uint32_t tag = 0x7A000000u + i % 8;
+        const uint64_t ts = 0xFF00000000ULL + i * 6389800000ULL;
+        f[0] = UWB_DATA_HDR; f[1] = 1; f[2] = (uint8_t)(i / 8); f[3] = (uint8_t)i;
+        for (int k = 0; k < 4; k++) { f[4 + k] = (uint8_t)(0x51A00001u >> 8 * k); f[8 + k] = (uint8_t)(tag >> 8 * k); }
+        for (int k = 0; k < 5; k++) f[12 + k] = (uint8_t)(ts >> 8 * k);
+        f[17] = f[18] = f[19] = 0;
+    }
+}
+
+/* ===== esetek ===== */
+static void b_data_decode(void* ctx, uint32_t it)
+{
+    (void)ctx; uwb_data_t f; uint32_t acc = 0;
+    for (uint32_t i = 0; i < it; i++) { uwb_data_decode(s_data[i & 63], UWB_DATA_LEN, &f); acc += f.tag_seq; }
+    bench_sink = acc;
+}
+static void b_data_log(void* ctx, uint32_t it)
+{
+    (void)ctx;
+    for (uint32_t i = 0; i < it; i++) pp_log_data(s_data[i & 63], UWB_DATA_LEN);
+}
+static void b_cfg_fast(void* ctx, uint32_t it)
+{
+    (void)ctx; uwb_cfg_t c; uint32_t acc = 0;
+    static const uint8_t hb[13] = { 1, 1, 1, 2, 4, 0, 0, 0x10, 0, 3, 2, 0, 100 };
+    static const uint8_t ack[6] = { 1, 0x81, 0, 1, 0, 3 };
+    for (uint32_t i = 0; i < it; i++) acc += (uint32_t)uwb_cfg_decode(i & 1 ? ack : hb, i & 1 ? 6 : 13, &c);
+    bench_sink = acc;
+}
+static void b_tlv_walk(void* ctx, uint32_t it)
+{
+    (void)ctx; uint32_t acc = 0;
+    for (uint32_t i = 0; i < it; i++)
+        for (unsigned k = 1; k < s_nsnap; k++) {               /* [0] = ACK */
+            tlv_cur_t cur; tlv_t t;
+            tlv_cur_init(&cur, s_snap[k].d, s_snap[k].n);
+            while (tlv_next(&cur, &t) == TLV_ITEM) if (tlv_width_ok(&t)) acc += tlv_u32(&t);
+        }
+    bench_sink = acc;
+}
+static void b_cfg_log(void* ctx, uint32_t it)
+{
+    (void)ctx;
+    for (uint32_t i = 0; i < it; i++)
+        for (unsigned k = 1; k < s_nsnap; k++) pp_log_cfg(s_snap[k].d, s_snap[k].n);
+}
+
+int main(int argc, char** argv)
+{
+    bench_args(argc, argv);
+    make_inputs();
+    if (s_nsnap < 2) { fprintf(stderr, "bench_proto: no snapshot from anchor_sim\n"); return 1; }
+    unsigned items = 0, bytes = 0;
+    for (unsigned k = 1; k < s_nsnap; k++) {
+        tlv_cur_t cur; tlv_t t;
+        tlv_cur_init(&cur, s_snap[k].d, s_snap[k].n);
+        while (tlv_next(&cur, &t) == TLV_ITEM) items++;
+        bytes += s_snap[k].n;
+    }
+    printf("bench_proto: GET snapshot %u frame(s), %u TLV, %u B\n", s_nsnap - 1, items, bytes);
+
+    bench_print("DATA decode (uwb_data_decode)", bench_run(b_data_decode, NULL), "frame");
+    bench_print("DATA pp_log_data (format)", bench_run(b_data_log, NULL), "frame");
+    bench_print("CFG HB/ACK (uwb_cfg_decode)", bench_run(b_cfg_fast, NULL), "frame");
+    bench_print("CFG TLV walk, full snapshot", bench_run(b_tlv_walk, NULL), "snap");
+    bench_print("CFG pp_log_cfg, full snapshot", bench_run(b_cfg_log, NULL), "snap");
+    return s_lines ? 0 : 1;
+}
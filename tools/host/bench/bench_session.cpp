@@ -0,0 +1,104 @@
+/* bench_session — session_store lookup költsége tele táblánál, SESS_CAP
+ * szerint (bench_session_8 / _64 / _256: ugyanez a forrás más SESS_CAP-pal).
+ * Összevetés: a 0ea999b-s g_sess[] lineáris strcmp keresése ugyanennyi
+ * bejegyzéssel.
+ *
+ * Esetek:
+ *   lookup hit           véletlen sorrendű meglévő SID (LRU mozgatással)
+ *   lookup miss          nem létező SID (teljes próbalánc)
+ *   put, tele tábla      LRU kilakoltatás + beszúrás
+ *   legacy linear hit    for(g_sess) strcmp + exp
+ *   legacy linear miss
+ *
+ * A hash út fix költsége a 32 B FNV + konstans idejű összevetés; a régi strcmp
+ * az első eltérő bájtnál kilép (időzítés szivárog), 8 bejegyzésnél ezért gyorsabb.
+ *
+ * Használat: bench_session_<N> [--quick] */
+#include <cstdio>
+#include <cstring>
+#include "bench.h"
+#include "session_store.hpp"
+
+#define NQ 1024                                 // lekérdezés minta (2 hatványa)
+
+static char s_sid[SESS_CAP][SESS_SID_LEN+1];
+static char s_miss[NQ][SESS_SID_LEN+1];
+static uint16_t s_q[NQ];                        // hit sorrend: s_sid index
+
+/* régi tábla (webserver.cpp, 0ea999b), SESS_CAP méretre */
+struct LegacySess { char sid[33]; user_role_t role; uint32_t exp_s; };
+static LegacySess s_legacy[SESS_CAP];
+
+static user_role_t legacy_lookup(const char* sid, uint32_t now){
+    for(auto& s: s_legacy) if(s.sid[0] && strcmp(s.sid,sid)==0 && s.exp_s>now) return s.role;
+    return ROLE_NONE;
+}
+
+static uint32_t s_rng=0x12345678u;
+static uint32_t rnd(){ s_rng^=s_rng<<13; s_rng^=s_rng>>17; s_rng^=s_rng<<5; return s_rng; }
+
+static void mk_sid(char* out){ for(int i=0;i<SESS_SID_LEN;i+=8) snprintf(out+i,9,"%08x",rnd()); }
+
+static void fill(){
+    sess_reset();
+    for(unsigned i=0;i<SESS_CAP;i++){
+        sess_put(s_sid[i],(user_role_t)(1+i%3),0x7FFFFFFF,0);
+        memcpy(s_legacy[i].sid,s_sid[i],sizeof(s_legacy[i].sid));
+        s_legacy[i].role=(user_role_t)(1+i%3); s_legacy[i].exp_s=0x7FFFFFFF;
+    }
+}
+
+static void b_hit(void*, uint32_t it){
+    uint32_t acc=0;
+    for(uint32_t i=0;i<it;i++) acc+=sess_lookup(s_sid[s_q[i&(NQ-1)]],1);
+    bench_sink=acc;
+}
+static void b_miss(void*, uint32_t it){
+    uint32_t acc=0;
+    for(uint32_t i=0;i<it;i++) acc+=sess_lookup(s_miss[i&(NQ-1)],1);
+    bench_sink=acc;
+}
+static void b_put(void*, uint32_t it){
+    uint32_t acc=0;
+    for(uint32_t i=0;i<it;i++){
+        char* sid=s_miss[i&(NQ-1)];
+        sid[0]=(char)('g'+(i>>10)%20);            // mindig új SID (a 'g'.. nem hex)
+        acc+=sess_put(sid,ROLE_DIAG,0x7FFFFFFF,1);
+    }
+    bench_sink=acc;
+}
+static void b_legacy_hit(void*, uint32_t it){
+    uint32_t acc=0;
+    for(uint32_t i=0;i<it;i++) acc+=legacy_lookup(s_sid[s_q[i&(NQ-1)]],1);
+    bench_sink=acc;
+}
+static void b_legacy_miss(void*, uint32_t it){
+    uint32_t acc=0;
+    for(uint32_t i=0;i<it;i++) acc+=legacy_lookup(s_miss[i&(NQ-1)],1);
+    bench_sink=acc;
+}
+
+int main(int argc, char** argv){
+    bench_args(argc,argv);
+    for(unsigned i=0;i<SESS_CAP;i++) mk_sid(s_sid[i]);
+    for(unsigned i=0;i<NQ;i++){ mk_sid(s_miss[i]); s_q[i]=(uint16_t)(rnd()%SESS_CAP); }
+
+    /* ellenőrzés: minden SID megvan, a miss-ek nincsenek, a régi tábla ugyanazt adja */
+    fill();
+    if(sess_count()!=SESS_CAP){ fprintf(stderr,"bench_session: count %u\n",(unsigned)sess_count()); return 1; }
+    for(unsigned i=0;i<SESS_CAP;i++)
+        if(sess_lookup(s_sid[i],1)!=legacy_lookup(s_sid[i],1) || sess_lookup(s_sid[i],1)==ROLE_NONE){
+            fprintf(stderr,"bench_session: lookup %u\n",i); return 1;
+        }
+    for(unsigned i=0;i<NQ;i++)
+        if(sess_lookup(s_miss[i],1)!=ROLE_NONE){ fprintf(stderr,"bench_session: false hit %u\n",i); return 1; }
+
+    printf("bench_session: SESS_CAP %u (tele tábla)\n",(unsigned)SESS_CAP);
+    bench_print("sess_lookup hit",bench_run(b_hit,nullptr),"op");
+    bench_print("sess_lookup miss",bench_run(b_miss,nullptr),"op");
+    bench_print("legacy linear strcmp hit",bench_run(b_legacy_hit,nullptr),"op");
+    bench_print("legacy linear strcmp miss",bench_run(b_legacy_miss,nullptr),"op");
+    bench_print("sess_put (LRU evict)",bench_run(b_put,nullptr),"op");
+    if(sess_count()!=SESS_CAP){ fprintf(stderr,"bench_session: count %u after put\n",(unsigned)sess_count()); return 1; }
+    return 0;
+}
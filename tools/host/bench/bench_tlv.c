@@ -0,0 +1,119 @@
+/* bench_tlv — CFG TLV dekódolás ns / keret: a régi switch-es parserek (0ea999b,
+ * tlv_legacy.c) és a táblavezérelt kodek (components/ble/tlv.c).
+ *
+ * Bemenet: anchor_sim GET snapshot (35 TLV, ebből 11 változó hosszú PHY tag),
+ * és egy 6 TLV-s SET válasz-szerű keret.
+ * Esetek:
+ *   decode   legacy_walk (switch, érték kiolvasás)  ↔  tlv_next + tlv_width_ok + tlv_u32/i32
+ *   format   legacy_pp_log_cfg                      ↔  pp_log_cfg (ESP_LOGI → vsnprintf)
+ * A régi parserek a 0x40.. PHY tageket nem ismerték (nyers / "TLV t=.." ág),
+ * ezért a format sorban nem ugyanazt a szöveget állítják elő.
+ *
+ * Használat: bench_tlv [--quick] */
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include "bench.h"
+#include "tlv.h"
+#include "pretty_print.h"
+#include "anchor_sim.h"
+#include "tlv_legacy.h"
+
+static char     s_line[256];
+static uint32_t s_lines;
+void host_log(char lvl, const char* tag, const char* fmt, ...)
+{
+    (void)lvl; (void)tag;
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(s_line, sizeof(s_line), fmt, ap);
+    va_end(ap);
+    s_lines++;
+}
+
+typedef struct { uint8_t d[ASIM_FRAME_MAX]; uint16_t n; } frame_t;
+static frame_t s_snap, s_small;
+
+static bool collect(void* ctx, uint8_t link, const uint8_t* d, uint16_t n, bool from_cfg)
+{
+    (void)ctx; (void)link; (void)from_cfg;
+    if (n > 6 && !s_snap.n) { memcpy(s_snap.d, d, n); s_snap.n = n; }     /* [0] = ACK */
+    return true;
+}
+
+static void make_inputs(void)
+{
+    const asim_cfg_t c = { .anchor_id = 0x51A00001u, .network_id = 0x1234, .frame_max = ASIM_FRAME_MAX, .seed = 1 };
+    asim_t a;
+    asim_init(&a, &c, 0);
+    const uint8_t get[5] = { 1, 0x02, 0x00, 0x01, 0 };
+    asim_write(&a, get, sizeof(get), 1000000, collect, NULL);
+
+    tlv_wr_t w;
+    tlv_wr_init(&w, s_small.d, sizeof(s_small.d));
+    tlv_put(&w, T_NETWORK_ID, 0x1234); tlv_put(&w, T_HB_MS, 5000);
+    tlv_put(&w, T_TX_ANT_DLY, 16385);  tlv_put(&w, T_BIAS_TICKS, (uint32_t)-12);
+    tlv_put(&w, T_LOG_LEVEL, 2);       tlv_put(&w, T_ANCHOR_ID, 0x51A00001u);
+    s_small.n = w.len;
+}
+
+static unsigned new_walk(const uint8_t* p, uint16_t n, uint32_t* sum)
+{
+    tlv_cur_t cur; tlv_t t; unsigned items = 0; uint32_t s = 0;
+    tlv_cur_init(&cur, p, n);
+    while (tlv_next(&cur, &t) == TLV_ITEM) {
+        if (tlv_width_ok(&t)) s += t.d->fmt == TLV_FMT_SDEC ? (uint32_t)tlv_i32(&t) : tlv_u32(&t);
+        else s += t.len;
+        items++;
+    }
+    *sum = s;
+    return items;
+}
+
+static void b_legacy(void* p, uint32_t it)
+{
+    const frame_t* f = p; uint32_t acc = 0, s;
+    for (uint32_t i = 0; i < it; i++) { acc += legacy_walk(f->d, f->n, &s); acc += s; }
+    bench_sink = acc;
+}
+static void b_new(void* p, uint32_t it)
+{
+    const frame_t* f = p; uint32_t acc = 0, s;
+    for (uint32_t i = 0; i < it; i++) { acc += new_walk(f->d, f->n, &s); acc += s; }
+    bench_sink = acc;
+}
+static void b_legacy_log(void* p, uint32_t it)
+{
+    const frame_t* f = p;
+    for (uint32_t i = 0; i < it; i++) legacy_pp_log_cfg(f->d, f->n);
+}
+static void b_new_log(void* p, uint32_t it)
+{
+    const frame_t* f = p;
+    for (uint32_t i = 0; i < it; i++) pp_log_cfg(f->d, f->n);
+}
+
+static void pair(const char* what, frame_t* f, bench_fn_t old_fn, bench_fn_t new_fn)
+{
+    char n[64];
+    const double a = bench_run(old_fn, f), b = bench_run(new_fn, f);
+    snprintf(n, sizeof(n), "%s, before (switch)", what); bench_print(n, a, "frame");
+    snprintf(n, sizeof(n), "%s, after (tlv.c)", what);   bench_print(n, b, "frame");
+    printf("  %-40s %10.2fx\n", "", a / b);
+}
+
+int main(int argc, char** argv)
+{
+    bench_args(argc, argv);
+    make_inputs();
+    uint32_t s0, s1;
+    const unsigned n0 = legacy_walk(s_snap.d, s_snap.n, &s0), n1 = new_walk(s_snap.d, s_snap.n, &s1);
+    if (!s_snap.n || n0 != n1 || n0 < 30) { fprintf(stderr, "bench_tlv: snapshot items %u / %u\n", n0, n1); return 1; }
+    printf("bench_tlv: snapshot %u B / %u TLV, small %u B\n", s_snap.n, n1, s_small.n);
+
+    pair("decode snapshot", &s_snap, b_legacy, b_new);
+    pair("decode 6 TLV", &s_small, b_legacy, b_new);
+    pair("format snapshot", &s_snap, b_legacy_log, b_new_log);
+    pair("format 6 TLV", &s_small, b_legacy_log, b_new_log);
+    return s_lines ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+/* bench_uplink — UDP uplink csomagolás (components/uplink) keret / s host-on.
+ *
+ * Esetek (mtu 1400, mint az uplink alapértéke):
+ *   pack, N keret / datagram   uplink_rec_encode + uplink_batch_add + finish
+ *   tt_process + pack          a forwarder teljes CPU útja (tag_track is)
+ * A datagram / s a kernel send költsége nélkül értendő; a végén a drótra kerülő
+ * bájt / keret (IP+UDP 28 B fejléccel) mutatja, mit nyer a kötegelés.
+ *
+ * Használat: bench_uplink [--quick] */
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+#include "uplink_pack.h"
+#include "tag_track.h"
+
+#define MTU     1400
+#define NFRAMES 256
+#define NTAGS   32
+
+static uint8_t s_frames[NFRAMES][UPLINK_FRAME_LEN];
+static uint8_t s_buf[MTU];
+
+static void make_frames(void)
+{
+    for (unsigned i = 0; i < NFRAMES; i++) {
+        uint8_t* f = s_frames[i];
+        const uint32_t tag = 0x7A000000u + i % NTAGS, seq = i / NTAGS;
+        const uint64_t ts = seq * 6389800000ULL + (i % NTAGS) * 1000;
+        memset(f, 0, UPLINK_FRAME_LEN);
+        f[0] = 0xAB; f[1] = 1; f[2] = (uint8_t)seq; f[3] = (uint8_t)seq;
+        for (int k = 0; k < 4; k++) { f[4 + k] = (uint8_t)(1u >> 8 * k); f[8 + k] = (uint8_t)(tag >> 8 * k); }
+        for (int k = 0; k < 5; k++) f[12 + k] = (uint8_t)(ts >> 8 * k);
+    }
+}
+
+typedef struct { uint8_t max_frames; bool track; uint32_t dgrams; } run_t;
+
+/* iters = keretek száma */
+static void b_pack(void* p, uint32_t it)
+{
+    run_t* r = (run_t*)p;
+    uplink_batch_t b;
+    uint8_t rec[UPLINK_REC_LEN];
+    tt_out_t t;
+    memset(&t, 0, sizeof(t));
+    uint32_t seq = 0, acc = 0;
+    int64_t now = 0;
+    uplink_batch_begin(&b, s_buf, MTU, r->max_frames);
+    for (uint32_t i = 0; i < it; i++) {
+        const uint8_t* f = s_frames[i & (NFRAMES - 1)];
+        if (r->track) tt_process(f, UPLINK_FRAME_LEN, now += 100, &t);
+        uplink_rec_encode(rec, f, &t);
+        uplink_batch_add(&b, rec);
+        if (uplink_batch_full(&b)) {
+            acc += uplink_batch_finish(&b, 0x6A7E0001u, seq++);
+            uplink_batch_begin(&b, s_buf, MTU, r->max_frames);
+        }
+    }
+    r->dgrams += seq;
+    bench_sink = acc;
+}
+
+static void report(const char* name, run_t* r)
+{
+    r->dgrams = 0;
+    const double ns = bench_run(b_pack, r);
+    const unsigned per = r->max_frames < (MTU - UPLINK_HDR_LEN) / UPLINK_REC_LEN ? r->max_frames
+                                                                              : (MTU - UPLINK_HDR_LEN) / UPLINK_REC_LEN;
+    char n[64];
+    snprintf(n, sizeof(n), "%s, %3u frame/dgram", name, per);
+    bench_print(n, ns, "frame");
+    printf("  %-40s %10.1f B/frame on wire, %8.2f M dgram/s\n", "",
+           (28.0 + UPLINK_HDR_LEN) / per + UPLINK_REC_LEN, 1e3 / (ns * per));
+}
+
+int main(int argc, char** argv)
+{
+    bench_args(argc, argv);
+    make_frames();
+    tt_reset();
+    static const uint8_t k_sizes[] = { 1, 8, 64 };
+    for (unsigned i = 0; i < sizeof(k_sizes); i++) {
+        run_t r = { .max_frames = k_sizes[i], .track = false };
+        report("pack", &r);
+    }
+    for (unsigned i = 0; i < sizeof(k_sizes); i++) {
+        run_t r = { .max_frames = k_sizes[i], .track = true };
+        report("tt_process + pack", &r);
+    }
+    return 0;
+}
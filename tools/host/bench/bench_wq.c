@@ -0,0 +1,137 @@
+/* bench_wq — GATT írási sor (components/ble/write_queue) host-on.
+ *
+ * 1) CPU: egy írás teljes útja a sorban (push → next → complete), 20 B SET;
+ *    összevetésül a régi ble_send_set malloc + memcpy + free költsége.
+ * 2) Link modell: a valódi wq_t-t egy egyszerű kapcsolati esemény szimuláció
+ *    hajtja, írás / s a kért ablakkal. Feltevések (nem mérés, modell):
+ *      - CI kapcsolati intervallum, eseményenként legfeljebb PKT_PER_CI csomag,
+ *      - ATT: egyszerre egy kérés (Write Request / Prepare / Execute), a
+ *        válasz a következő eseményben jön,
+ *      - Write Command (NR) válasz nélkül, az elküldés eseményében zárul,
+ *      - a completion → alkalmazás → új írás átfutás miatt a completion után
+ *        átadott írás leghamarabb a következő eseményben megy ki.
+ *    Ablak 1 = a régi működés (minden írás megvárja az előzőt).
+ *
+ * Használat: bench_wq [--quick] */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "write_queue.h"
+
+#define SET_LEN     20
+#define PKT_PER_CI  4
+#define NWRITES     2000u
+
+static uint8_t s_set[SET_LEN];
+
+/* ---- 1) CPU ---- */
+static void b_queue(void* p, uint32_t it)
+{
+    wq_t* q = p;
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < it; i++) {
+        wq_slot_t* s = wq_push(q, WQ_CHAR, false, 0x2A, s_set, 3, s_set + 3, SET_LEN - 3, i);
+        s = wq_next(q, 4, 244);
+        acc += s->len;
+        wq_complete(q, true, NULL);
+    }
+    bench_sink = acc;
+}
+
+static void b_legacy_malloc(void* p, uint32_t it)
+{
+    (void)p;
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < it; i++) {
+        uint8_t* b = malloc(SET_LEN);
+        memcpy(b, s_set, 3); memcpy(b + 3, s_set + 3, SET_LEN - 3);
+        acc += b[i % SET_LEN];
+        free(b);
+    }
+    bench_sink = acc;
+}
+
+/* ---- 2) link modell ---- */
+typedef struct {
+    uint8_t  window;
+    bool     no_rsp;
+    uint16_t len, mtu;
+} sim_t;
+
+/* a stacknél lévő (SENT) slotok a kiadás sorrendjében; ready = ettől az eseménytől küldhető */
+typedef struct { wq_slot_t* s; uint32_t ready; } air_t;
+
+static air_t    s_air[WQ_SLOTS];
+static unsigned s_nair;
+
+static void air_pop(wq_t* q)
+{
+    wq_complete(q, true, NULL);
+    memmove(s_air, s_air + 1, --s_nair * sizeof(s_air[0]));
+}
+
+/* NWRITES írás, visszaad: kapcsolati események száma */
+static uint32_t simulate(const sim_t* c)
+{
+    static uint8_t val[WQ_VAL_MAX];
+    wq_t q;
+    wq_init(&q);
+    s_nair = 0;
+    uint32_t pushed = 0, ev = 0;
+    bool req_out = false, req_prep = false;       /* ATT kérés válaszra vár; Prepare volt-e */
+
+    for (; q.st.done < NWRITES; ev++) {
+        /* 1) válasz az előző eseményben küldött kérésre */
+        if (req_out) {
+            req_out = false;
+            if (req_prep) { s_air[0].s->off += s_air[0].s->chunk; s_air[0].ready = ev + 1; }
+            else          air_pop(&q);
+        }
+        /* 2) alkalmazás: tölti a sort; a stack annyit kap, amennyit az ablak enged */
+        while (pushed < NWRITES && wq_push(&q, WQ_CHAR, c->no_rsp, 0x2A, NULL, 0, val, c->len, ev)) pushed++;
+        wq_slot_t* s;
+        while ((s = wq_next(&q, c->window, c->mtu - 3))) s_air[s_nair++] = (air_t){ s, ev + 1 };
+        /* 3) adás FIFO-ban, eseményenként PKT_PER_CI csomag, egy függő ATT kérés */
+        for (unsigned pkt = 0; pkt < PKT_PER_CI && s_nair && !req_out && s_air[0].ready <= ev; pkt++) {
+            wq_slot_t* h = s_air[0].s;
+            if (h->no_rsp) { air_pop(&q); continue; }
+            req_prep = h->is_long && h->off < h->len;
+            if (req_prep) {
+                const uint16_t n = h->len - h->off;
+                h->chunk = n > c->mtu - 5 ? c->mtu - 5 : n;
+            }
+            req_out = true;
+        }
+    }
+    return ev;
+}
+
+static void report(const char* name, const sim_t* c, double ci_ms)
+{
+    const uint32_t ev = simulate(c);
+    const double s = ev * ci_ms / 1000.0;
+    printf("  %-40s %10.2f CI/write   %8.1f write/s @ CI %.1f ms\n", name, (double)ev / NWRITES, NWRITES / s, ci_ms);
+}
+
+int main(int argc, char** argv)
+{
+    bench_args(argc, argv);
+    for (unsigned i = 0; i < SET_LEN; i++) s_set[i] = (uint8_t)(i * 7);
+
+    static wq_t q;
+    wq_init(&q);
+    printf("bench_wq: CPU / írás (%u B SET)\n", SET_LEN);
+    bench_print("wq push + next + complete", bench_run(b_queue, &q), "write");
+    bench_print("legacy malloc + memcpy + free", bench_run(b_legacy_malloc, NULL), "write");
+
+    printf("bench_wq: link modell, %u írás, %u csomag / CI\n", NWRITES, PKT_PER_CI);
+    const double ci = 7.5;
+    report("RSP, window 1 (régi)",            &(sim_t){ 1, false, SET_LEN, 247 }, ci);
+    report("RSP, window 4",                   &(sim_t){ 4, false, SET_LEN, 247 }, ci);
+    report("RSP, window 8",                   &(sim_t){ 8, false, SET_LEN, 247 }, ci);
+    report("NR,  window 8",                   &(sim_t){ 8, true,  SET_LEN, 247 }, ci);
+    report("200 B, MTU 23 (prepared)",        &(sim_t){ 4, false, 200, 23 }, ci);
+    report("200 B, MTU 247",                  &(sim_t){ 4, false, 200, 247 }, ci);
+    return 0;
+}
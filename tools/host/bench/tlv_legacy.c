@@ -0,0 +1,153 @@
+/* tlv_legacy.c — lásd tlv_legacy.h. A függvénytörzsek a 0ea999b állapotból. */
+#include <stdio.h>
+#include <inttypes.h>
+#include "esp_log.h"
+#include "tlv_legacy.h"
+
+static inline uint16_t rd16be(const uint8_t* v){ return ((uint16_t)v[0]<<8) | v[1]; }
+static inline uint32_t rd32be(const uint8_t* v){ return ((uint32_t)v[0]<<24)|((uint32_t)v[1]<<16)|((uint32_t)v[2]<<8)|v[3]; }
+
+/* ===== components/ble/pretty_print.c ===== */
+void legacy_pp_log_cfg(const uint8_t* d, uint16_t n)
+{
+    const char* (*tlv_name)(uint8_t) = NULL;
+    // HB fast-path: [01 01 <st>] [02 04 <up:BE32>] [03 02 <sync_ms:BE16>]  => 13 B
+    if (n == 13 && d[0]==0x01 && d[1]==0x01 && d[3]==0x02 && d[4]==0x04 && d[9]==0x03 && d[10]==0x02) {
+        uint8_t  st   = d[2];
+        uint32_t up   = rd32be(&d[5]);
+        uint16_t sync = rd16be(&d[11]);
+        ESP_LOGI("CFG", "HB st=0x%02X up=%" PRIu32 " sync_ms=%u", st, up, (unsigned)sync);
+        return;
+    }
+
+    // ACK
+    if(n==6 && d[0]==1 && d[1]==0x81){
+        ESP_LOGI("CFG","ACK req=%u status=0x%02X applied=%u",
+                 (unsigned)rd16be(&d[2]), d[4], d[5]);
+        return;
+    }
+    // STATE
+    if(n==17 && d[0]==1 && d[1]==0x90){
+        ESP_LOGI("CFG","STATE st=0x%02X sync_ms=%u up=%" PRIu32 " net=%u zone=0x%04X anc=0x%08" PRIX32,
+                 d[2], (unsigned)rd16be(&d[3]), (uint32_t)rd32be(&d[5]),
+                 (unsigned)rd16be(&d[9]), (unsigned)rd16be(&d[11]),
+                 (uint32_t)rd32be(&d[13]));
+        return;
+    }
+
+    // TLV stream
+    uint16_t i=0;
+    while(i+2<=n){
+        uint8_t t=d[i++], l=d[i++];
+        if(i+l>n){ ESP_LOGW("CFG","TLV overflow t=0x%02X l=%u",t,(unsigned)l); break; }
+        const uint8_t* v=&d[i];
+        const char* nm = tlv_name? tlv_name(t):"TLV";
+
+        switch (t) {
+          case 0x00: if(l==1) ESP_LOGI("CFG","%s=%u", nm, v[0]); break;
+          case 0x01: if(l==1) ESP_LOGI("CFG","%s=0x%02X", nm, v[0]); break;
+          case 0x02: if(l==4) ESP_LOGI("CFG","%s=%" PRIu32, nm, (uint32_t)rd32be(v)); break;
+          case 0x03: if(l==2) ESP_LOGI("CFG","%s=%u", nm, (unsigned)rd16be(v)); break;
+          case 0x10: if(l==2) ESP_LOGI("CFG","%s=%u", nm, (unsigned)rd16be(v)); break;
+          case 0x11: if(l==2) ESP_LOGI("CFG","%s=0x%04X", nm, (unsigned)rd16be(v)); break;
+          case 0x12: if(l==4) ESP_LOGI("CFG","%s=0x%08" PRIX32, nm, (uint32_t)rd32be(v)); break;
+          case 0x13: if(l==4) ESP_LOGI("CFG","%s=%" PRId32, nm, (int32_t) rd32be(v)); break;
+          case 0x14: if(l==4) ESP_LOGI("CFG","%s=%" PRId32, nm, (int32_t) rd32be(v)); break;
+          case 0x16: if(l==4) ESP_LOGI("CFG","%s=%" PRId32, nm, (int32_t) rd32be(v)); break; // BIAS_TICKS
+          case 0x1F: if(l==1) ESP_LOGI("CFG","%s=%u", nm, v[0]); break;
+          case 0x20: if(l==2) ESP_LOGI("CFG","%s=%u", nm, (unsigned)rd16be(v)); break;
+          case 0x30: if(l==2) ESP_LOGI("CFG","%s=%u", nm, (unsigned)rd16be(v)); break;
+          case 0x31: if(l==2) ESP_LOGI("CFG","%s=%u", nm, (unsigned)rd16be(v)); break;
+          case 0x32: if(l==2) ESP_LOGI("CFG","%s=%u", nm, (unsigned)rd16be(v)); break;
+          case 0x33: if(l==1) ESP_LOGI("CFG","%s=%u", nm, v[0]); break;
+          case 0x34: if(l==1) ESP_LOGI("CFG","%s=%u", nm, v[0]); break;
+          case 0x35: if(l==2) ESP_LOGI("CFG","%s=%u", nm, (unsigned)rd16be(v)); break;
+          case 0x36: if(l==2) ESP_LOGI("CFG","%s=%u", nm, (unsigned)rd16be(v)); break;
+          case 0x37: if(l==2) ESP_LOGI("CFG","%s=%u", nm, (unsigned)rd16be(v)); break;
+          case 0x38: if(l==2) ESP_LOGI("CFG","%s=%u", nm, (unsigned)rd16be(v)); break;
+          case 0x39: if(l==1) ESP_LOGI("CFG","%s=%u", nm, v[0]); break;
+          default: {
+            char hex[128]; size_t o=0;
+            for(uint8_t k=0;k<l && o+3<sizeof(hex);k++) o += snprintf(hex+o,sizeof(hex)-o,"%02X ",v[k]);
+            if(o) hex[o-1]=0;
+            ESP_LOGI("CFG","%s[len=%u]: %s", nm, (unsigned)l, hex);
+          } break;
+        }
+        i+=l;
+    }
+}
+
+/* ===== main/main.c ===== */
+void legacy_parse_cfg_notify(const uint8_t* p, uint16_t n){
+    const char* TAG="CFG";
+    if (n==6 && p[0]==1 && p[1]==0x81){
+        uint16_t req = rd16be(&p[2]);
+        uint8_t status=p[4], applied=p[5];
+        //ESP_LOGI(TAG, "ACK req=%u status=0x%02X applied=%u", (unsigned)req, status, (unsigned)applied);
+        return;
+    }
+    if (n==17 && p[0]==1 && p[1]==0x90){
+        uint8_t  st    = p[2];
+        uint16_t sync  = rd16be(&p[3]);
+        uint32_t up    = rd32be(&p[5]);
+        uint16_t netid = rd16be(&p[9]);
+        uint16_t zone  = rd16be(&p[11]);
+        uint32_t anc   = rd32be(&p[13]);
+        //ESP_LOGI(TAG,"STATE st=0x%02X sync_ms=%u up=%u net=%u zone=0x%04X anc=0x%08X",
+        //         st, sync, (unsigned)up, (unsigned)netid, (unsigned)zone, (unsigned)anc);
+        return;
+    }
+    // TLV stream: [t,l,val...] egymás után (HB vagy GET snapshot)
+    const uint8_t* q=p; uint16_t r=n;
+    while (r>=2){
+        uint8_t t=q[0], l=q[1]; q+=2; r-=2;
+        if (r<l){ ESP_LOGW(TAG,"TRUNC tlv t=0x%02X need=%u have=%u",t,(unsigned)l,(unsigned)r); break; }
+        switch(t){
+            case 0x00: if(l==1) ESP_LOGI(TAG,"VER=%u", (unsigned)q[0]); break;                 // T_VER
+            case 0x01: if(l==1) ESP_LOGI(TAG,"STATUS=0x%02X", (unsigned)q[0]); break;         // T_STATUS
+            case 0x02: if(l==4) ESP_LOGI(TAG,"UPTIME_MS=%u", (unsigned)rd32be(q)); break;     // T_UPTIME_MS
+            case 0x03: if(l==2) ESP_LOGI(TAG,"SYNC_MS=%u", (unsigned)rd16be(q)); break;       // T_SYNC_MS
+            case 0x10: if(l==2) ESP_LOGI(TAG,"NETWORK_ID=%u", (unsigned)rd16be(q)); break;
+            case 0x11: if(l==2) ESP_LOGI(TAG,"ZONE_ID=0x%04X", (unsigned)rd16be(q)); break;
+            case 0x12: if(l==4) ESP_LOGI(TAG,"ANCHOR_ID=0x%08X", (unsigned)rd32be(q)); break;
+            case 0x13: if(l==4) ESP_LOGI(TAG,"TX_ANT_DLY=%" PRId32, (int32_t)rd32be(q)); break;
+            case 0x14: if(l==4) ESP_LOGI(TAG,"RX_ANT_DLY=%" PRId32, (int32_t)rd32be(q)); break;
+            case 0x16: if(l==4) ESP_LOGI(TAG,"BIAS_TICKS=%" PRId32, (int32_t)rd32be(q)); break;
+            case 0x1F: if(l==1) ESP_LOGI(TAG,"LOG_LEVEL=%u", (unsigned)q[0]); break;
+            case 0x20: if(l==2) ESP_LOGI(TAG,"HB_MS=%u", (unsigned)rd16be(q)); break;
+            case 0x30: if(l==2) ESP_LOGI(TAG,"PPM_MAX=%u", (unsigned)rd16be(q)); break;
+            case 0x31: if(l==2) ESP_LOGI(TAG,"JUMP_PPM=%u", (unsigned)rd16be(q)); break;
+            case 0x32: if(l==2) ESP_LOGI(TAG,"AB_GAP_MS=%u", (unsigned)rd16be(q)); break;
+            case 0x33: if(l==1) ESP_LOGI(TAG,"MS_EWMA_DEN=%u", (unsigned)q[0]); break;
+            case 0x34: if(l==1) ESP_LOGI(TAG,"TK_EWMA_DEN=%u", (unsigned)q[0]); break;
+            case 0x35: if(l==2) ESP_LOGI(TAG,"TK_MIN_MS=%u", (unsigned)rd16be(q)); break;
+            case 0x36: if(l==2) ESP_LOGI(TAG,"TK_MAX_MS=%u", (unsigned)rd16be(q)); break;
+            case 0x37: if(l==2) ESP_LOGI(TAG,"DTTX_MIN_MS=%u", (unsigned)rd16be(q)); break;
+            case 0x38: if(l==2) ESP_LOGI(TAG,"DTTX_MAX_MS=%u", (unsigned)rd16be(q)); break;
+            case 0x39: if(l==1) ESP_LOGI(TAG,"LOCK_NEED=%u", (unsigned)q[0]); break;
+            default:   ESP_LOGI(TAG,"TLV t=0x%02X l=%u", t, (unsigned)l); break;
+        }
+        q+=l; r-=l;
+    }
+}
+
+/* ===== dekódolás naplózás nélkül (parse_cfg_notify switch-e, ESP_LOGI → összeg) ===== */
+unsigned legacy_walk(const uint8_t* p, uint16_t n, uint32_t* sum)
+{
+    const uint8_t* q=p; uint16_t r=n; unsigned items=0; uint32_t s=0;
+    while (r>=2){
+        uint8_t t=q[0], l=q[1]; q+=2; r-=2;
+        if (r<l) break;
+        switch(t){
+            case 0x00: case 0x01: case 0x1F: case 0x33: case 0x34: case 0x39: if(l==1) s+=q[0]; break;
+            case 0x02: case 0x12: if(l==4) s+=rd32be(q); break;
+            case 0x13: case 0x14: case 0x16: if(l==4) s+=(uint32_t)(int32_t)rd32be(q); break;
+            case 0x03: case 0x10: case 0x11: case 0x20: case 0x30: case 0x31:
+            case 0x32: case 0x35: case 0x36: case 0x37: case 0x38: if(l==2) s+=rd16be(q); break;
+            default: s+=l; break;
+        }
+        q+=l; r-=l; items++;
+    }
+    *sum=s;
+    return items;
+}
@@ -0,0 +1,20 @@
+#pragma once
+/* tlv_legacy — a user-003 előtti CFG TLV parserek (0ea999b) változatlan másolata,
+ * összehasonlító mérésre (bench_tlv) és differenciális fuzzra (fuzz_tlv). */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* pretty_print.c pp_log_cfg (tlv_name = NULL, mint a main.c hívásban) */
+void legacy_pp_log_cfg(const uint8_t* d, uint16_t n);
+/* main.c parse_cfg_notify */
+void legacy_parse_cfg_notify(const uint8_t* p, uint16_t n);
+/* ugyanaz a switch, ESP_LOG nélkül: a régi dekódolás önmagában.
+ * Visszaad: teljes TLV elemek száma; *sum: az ismert értékek összege */
+unsigned legacy_walk(const uint8_t* p, uint16_t n, uint32_t* sum);
+
+#ifdef __cplusplus
+}
+#endif
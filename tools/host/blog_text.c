@@ -0,0 +1,57 @@
+/* blog_text.c — bináris napló rekord → szöveg (lásd blog_text.h) */
+#include <stdio.h>
+#include "esp_log.h"
+#include "pretty_print.h"
+#include "blog_text.h"
+
+uint64_t blog_text_ts_us;
+uint8_t  blog_text_link;
+static uint64_t s_clock;
+static uint32_t s_drop, s_sup;
+
+static uint32_t rd32le(const uint8_t* p){ return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24; }
+
+void blog_text_reset(void)
+{
+    blog_text_ts_us = s_clock = 0;
+    s_drop = s_sup = 0;
+}
+
+bool blog_text(const blog_rec_t* r)
+{
+    /* 32 bites ts a legutóbbi CLOCK-hoz képest (előjeles különbség: kicsit korábbi rekord is jó) */
+    blog_text_ts_us = s_clock + (int64_t)(int32_t)(r->ts_us - (uint32_t)s_clock);
+    blog_text_link  = r->link;
+    switch (r->fmt) {
+    case BLF_CLOCK:
+        if (r->len >= 8) s_clock = blog_text_ts_us = (uint64_t)rd32le(r->p) | (uint64_t)rd32le(r->p + 4) << 32;
+        return true;
+    case BLF_LOST:
+        if (r->len >= 8) {
+            const uint32_t d = rd32le(r->p), s = rd32le(r->p + 4);
+            ESP_LOGW("blog", "lost: ring full +%u, rate limit +%u", (unsigned)(d - s_drop), (unsigned)(s - s_sup));
+            s_drop = d; s_sup = s;
+        }
+        return true;
+    case BLF_DATA:
+        pp_log_data(r->p, r->len);
+        return true;
+    case BLF_CFG:
+        pp_log_cfg(r->p, r->len);
+        return true;
+    case BLF_HEX: {
+        char line[192]; int wp = 0;
+        wp += snprintf(line + wp, sizeof(line) - wp, "[%u][CFG] len=%u: ", (unsigned)r->link, (unsigned)r->len);
+        for (int i = 0; i < r->len && wp < (int)sizeof(line) - 3; i++) wp += snprintf(line + wp, sizeof(line) - wp, "%02X ", r->p[i]);
+        ESP_LOGI("WEB", "%s", line);
+        return true;
+    }
+    case BLF_RX:
+        if (r->len >= 3)
+            ESP_LOGD("BLE", "[%u][%s] len=%u", (unsigned)r->link, r->p[0] ? "CFG" : "DATA", (unsigned)(r->p[1] | r->p[2] << 8));
+        return true;
+    default:
+        ESP_LOGW("blog", "unknown fmt %u len=%u", (unsigned)r->fmt, (unsigned)r->len);
+        return false;
+    }
+}
@@ -0,0 +1,14 @@
+/* blog_text — bináris napló rekord → szöveg (host). A sorok a host_log-on
+ * (tools/host/shim/esp_log.h) mennek ki, ugyanazzal a tag-gel és szöveggel, mint
+ * a korábbi target oldali ESP_LOGI; a DATA / CFG keretet a pretty_print.c
+ * formázza. Az aktuális rekord ideje és linkje a host_log-ból olvasható. */
+#pragma once
+#include <stdint.h>
+#include "blog_core.h"
+
+extern uint64_t blog_text_ts_us;            /* kiterjesztett idő (CLOCK rekordokból) */
+extern uint8_t  blog_text_link;
+
+void blog_text_reset(void);
+/* CLOCK: csak az órát állítja; false: ismeretlen formátum */
+bool blog_text(const blog_rec_t* r);
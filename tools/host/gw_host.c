@@ -0,0 +1,247 @@
+/* gw_host.c — gateway NOTIFY ingest lánc host-on (lásd gw_host.h) */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <sched.h>
+#include "notify_ring.h"
+#include "blog_core.h"
+#include "blog_text.h"
+#include "tag_track.h"
+#include "uplink_pack.h"
+#include "gw_host.h"
+
+/* ===== óra ===== */
+int64_t gw_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+void gw_sleep_us(int64_t us)
+{
+    if (us <= 0) return;
+    struct timespec ts = { (time_t)(us / 1000000), (long)(us % 1000000) * 1000 };
+    nanosleep(&ts, NULL);
+}
+
+bool gw_log_print;
+
+/* ===== minták ===== */
+void smp_add(samples_t* s, int64_t us)
+{
+    if (s->n == s->cap) {
+        s->cap = s->cap ? s->cap * 2 : 4096;
+        s->v = realloc(s->v, s->cap * sizeof(*s->v));
+        if (!s->v) { perror("realloc"); exit(1); }
+    }
+    s->v[s->n++] = us < 0 ? 0 : (uint32_t)us;
+}
+static int cmp_u32(const void* a, const void* b)
+{
+    const uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+void smp_sort(samples_t* s) { if (s->n) qsort(s->v, s->n, sizeof(uint32_t), cmp_u32); }
+uint32_t smp_pct(const samples_t* s, double p)
+{
+    if (!s->n) return 0;
+    size_t k = (size_t)(p / 100.0 * s->n + 0.999999);
+    if (k < 1) k = 1;
+    if (k > s->n) k = s->n;
+    return s->v[k - 1];
+}
+uint32_t smp_max(const samples_t* s) { return s->n ? s->v[s->n - 1] : 0; }
+
+/* ===== gateway feliratkozók ===== */
+#define GW_MTU         1400
+#define GW_MAX_FRAMES  64
+
+static uint8_t        s_dg[GW_MTU];
+static uplink_batch_t s_batch;
+static gw_stats_t     s_st;
+static gw_cfg_t       s_cfg;
+static uint32_t       s_drop0;                               /* M_BLE_RX_DROP a futás elején */
+
+/* uplink_push_data + forwarder batch, socket nélkül */
+static void gw_uplink(const uint8_t* frame, uint16_t len, int64_t now)
+{
+    if (len != UPLINK_FRAME_LEN || frame[0] != 0xAB) return;
+    tt_out_t t;
+    if (!tt_process(frame, len, now, &t)) return;
+    if (t.flags & TT_F_DUP) { s_st.frames_dup++; return; }
+    uint8_t rec[UPLINK_REC_LEN];
+    uplink_rec_encode(rec, frame, &t);
+    s_st.frames_in++;
+    if (!uplink_batch_add(&s_batch, rec)) {
+        uplink_batch_finish(&s_batch, 1, s_st.datagrams++);
+        uplink_batch_begin(&s_batch, s_dg, GW_MTU, GW_MAX_FRAMES);
+        uplink_batch_add(&s_batch, rec);
+    }
+}
+
+/* ===== bináris napló (components/blog tükre: alapszintek, DATA rátalimit, 50 ms-os drain) ===== */
+#define GW_BLOG_RING   (16 * 1024)
+#define GW_BLOG_MS     50
+#define GW_DATA_RATE   200
+
+static uint8_t     s_blog_buf[GW_BLOG_RING] __attribute__((aligned(4)));
+static blog_ring_t s_blog;
+static uint32_t    s_rate_win, s_rate_cnt;                      /* csak az rx szál írja */
+static pthread_t   s_drain_th;
+static atomic_bool s_drain_stop;
+
+static void gw_blog(uint8_t fmt, uint8_t link, const uint8_t* p, uint16_t n)
+{
+    if (fmt == BLF_DATA) {
+        const uint32_t sec = (uint32_t)(gw_now_us() / 1000000);
+        if (sec != s_rate_win) { s_rate_win = sec; s_rate_cnt = 0; }
+        if (s_rate_cnt++ >= GW_DATA_RATE) { s_st.log_suppressed++; return; }
+    }
+    blog_ring_put(&s_blog, fmt, link, (uint32_t)gw_now_us(), p, n, NULL, 0);
+}
+
+/* UART kimenet: "#BL" sorok (csak a bájtszám számít), --log: szöveg a host_log-on */
+static void drain_once(void)
+{
+    static uint8_t raw[BLOG_REC_HDR + BLOG_PAYLOAD_MAX];
+    static char    line[BLOG_LINE_MAX];
+    static uint16_t seq;
+    size_t rn = 0;
+    uint16_t n; const uint8_t* p;
+    while ((p = blog_ring_peek(&s_blog, &n)) != NULL) {
+        if (gw_log_print) {
+            size_t off = 0; blog_rec_t r;
+            if (blog_rec_next(p, n, &off, &r) == 1) blog_text(&r);
+        }
+        if (rn + n > BLOG_LINE_RAW && rn) { s_st.uart_bytes += blog_line_encode(line, seq++, raw, rn); s_st.uart_lines++; rn = 0; }
+        memcpy(raw + rn, p, n); rn += n;
+        s_st.log_records++;
+        blog_ring_release(&s_blog);
+    }
+    if (rn) { s_st.uart_bytes += blog_line_encode(line, seq++, raw, rn); s_st.uart_lines++; }
+}
+
+static void* drain_thread(void* arg)
+{
+    (void)arg;
+    while (!atomic_load(&s_drain_stop)) {
+        gw_sleep_us(GW_BLOG_MS * 1000);
+        drain_once();
+    }
+    drain_once();
+    return NULL;
+}
+
+static void main_on_notify(uint8_t link, const uint8_t* data, uint16_t len, bool from_cfg)
+{
+    if (from_cfg)
+        gw_blog(BLF_CFG, link, data, len);
+    else {
+        gw_blog(BLF_DATA, link, data, len);
+        gw_uplink(data, len, gw_now_us());
+    }
+}
+
+static void web_on_notify(uint8_t link, const uint8_t* p, uint16_t n, bool from_cfg)
+{
+    if (!p || n == 0 || !from_cfg) return;
+    gw_blog(BLF_HEX, link, p, n);
+}
+
+/* ===== notify gyűrű + rx szál (ble.c rx_task tükre) ===== */
+static notify_ring_t s_ring;
+static sem_t         s_rx_sem;
+static atomic_bool   s_rx_stop;
+static pthread_t     s_rx_th;
+
+static void* rx_thread(void* arg)
+{
+    (void)arg;
+    for (;;) {
+        sem_wait(&s_rx_sem);
+        const notify_frame_t* f;
+        while ((f = notify_ring_peek(&s_ring)) != NULL) {
+            const int64_t t = gw_now_us();
+            smp_add(&s_st.q_lat, t - f->ts_us);
+            main_on_notify(f->link, f->data, f->len, f->from_cfg);
+            web_on_notify(f->link, f->data, f->len, f->from_cfg);
+            if (s_cfg.extra) s_cfg.extra(f->link, f->data, f->len, f->from_cfg);
+            smp_add(&s_st.sub_us, gw_now_us() - t);
+            s_st.consumed++;
+            notify_ring_release(&s_ring);
+        }
+        if (atomic_load(&s_rx_stop)) return NULL;
+    }
+}
+
+void gw_start(const gw_cfg_t* c)
+{
+    s_cfg = *c;
+    samples_t q = s_st.q_lat, s = s_st.sub_us;                  /* pufferek újrahasznosítva */
+    memset(&s_st, 0, sizeof(s_st));
+    q.n = s.n = 0;
+    s_st.q_lat = q; s_st.sub_us = s;
+    notify_ring_init(&s_ring);
+    tt_reset();
+    uplink_batch_begin(&s_batch, s_dg, GW_MTU, GW_MAX_FRAMES);
+    s_drop0 = metric_get(M_BLE_RX_DROP);
+    blog_ring_init(&s_blog, s_blog_buf, sizeof(s_blog_buf));
+    blog_text_reset();
+    s_rate_win = s_rate_cnt = 0;
+    atomic_store(&s_drain_stop, false);
+    pthread_create(&s_drain_th, NULL, drain_thread, NULL);
+    sem_init(&s_rx_sem, 0, 0);
+    atomic_store(&s_rx_stop, false);
+    pthread_create(&s_rx_th, NULL, rx_thread, NULL);
+}
+
+bool gw_try_sink(uint8_t link, const uint8_t* data, uint16_t len, bool from_cfg)
+{
+    const bool ok = notify_ring_push(&s_ring, link, gw_now_us(), data, len, from_cfg);
+    sem_post(&s_rx_sem);
+    return ok;
+}
+
+/* gattc_cb NOTIFY helyett. Tele gyűrűnél eldob (mint a targeten), vagy
+ * backpressure módban megvárja a fogyasztót: a lánc áteresztőképessége. */
+void gw_sink(uint8_t link, const uint8_t* data, uint16_t len, bool from_cfg)
+{
+    while (!gw_try_sink(link, data, len, from_cfg)) {
+        if (!s_cfg.backpressure) { metric_inc(M_BLE_RX_DROP); return; }
+        s_st.stalls++;
+        sched_yield();
+    }
+}
+
+void gw_stop(void)
+{
+    atomic_store(&s_rx_stop, true);
+    sem_post(&s_rx_sem);
+    pthread_join(s_rx_th, NULL);
+    sem_destroy(&s_rx_sem);
+    atomic_store(&s_drain_stop, true);
+    pthread_join(s_drain_th, NULL);
+    s_st.log_dropped = atomic_load(&s_blog.dropped);
+    if (s_batch.count) uplink_batch_finish(&s_batch, 1, s_st.datagrams++);
+    s_st.dropped = metric_get(M_BLE_RX_DROP) - s_drop0;
+    smp_sort(&s_st.q_lat);
+    smp_sort(&s_st.sub_us);
+}
+
+const gw_stats_t* gw_stats(void) { return &s_st; }
+
+void gw_print(void)
+{
+    const gw_stats_t* s = &s_st;
+    printf("  ring: consumed=%u dropped=%u stalls=%u (full notify ring)\n", s->consumed, s->dropped, s->stalls);
+    printf("  ring latency us: p50=%u p99=%u max=%u\n", smp_pct(&s->q_lat, 50), smp_pct(&s->q_lat, 99), smp_max(&s->q_lat));
+    printf("  subscribers us:  p50=%u p99=%u max=%u\n", smp_pct(&s->sub_us, 50), smp_pct(&s->sub_us, 99), smp_max(&s->sub_us));
+    printf("  uplink: frames=%u dup=%u datagrams=%u\n", s->frames_in, s->frames_dup, s->datagrams);
+    printf("  blog: records=%u dropped=%u rate-limited=%u uart=%llu B in %u lines\n", s->log_records, s->log_dropped,
+           s->log_suppressed, (unsigned long long)s->uart_bytes, s->uart_lines);
+}
@@ -0,0 +1,53 @@
+/* gw_host — a gateway NOTIFY ingest láncának host tükre (ncap_replay, anchor_sim).
+ *
+ * gw_sink (gattc_cb NOTIFY helyett) → notify_ring → rx szál (ble.c rx_task
+ * tükre) → feliratkozók:
+ *   main.c on_ble_notify:      CFG / DATA rekord a bináris naplóba + az
+ *                              uplink_push_data lánca (tag tábla, rekord kódolás, batch)
+ *   webserver on_ble_notify:   HEX rekord (dwm_cache / cfg_engine FreeRTOS-t
+ *                              igényel, host-on kimarad)
+ *   + egy opcionális eszköz-feliratkozó (gw_cfg_t.extra).
+ * A napló gyűrűt egy drain szál üríti 50 ms-onként "#BL" sorokba (mint a
+ * components/blog UART kimenete). A log és a metrikák a host shim-en / a valódi
+ * metrics.c-n mennek (tools/host/CMakeLists.txt). */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "metrics.h"
+
+typedef void (*gw_sub_t)(uint8_t link, const uint8_t* data, uint16_t len, bool from_cfg);
+
+/* ===== óra, log ===== */
+int64_t  gw_now_us(void);
+void     gw_sleep_us(int64_t us);
+extern bool     gw_log_print;                   /* napló rekordok szövegként stdout-ra */
+
+/* ===== minták (µs) ===== */
+typedef struct { uint32_t* v; size_t n, cap; } samples_t;
+void     smp_add(samples_t* s, int64_t us);
+void     smp_sort(samples_t* s);
+uint32_t smp_pct(const samples_t* s, double p);  /* nearest-rank, smp_sort után */
+uint32_t smp_max(const samples_t* s);
+
+/* ===== lánc ===== */
+typedef struct {
+    bool     backpressure;                      /* tele gyűrű: vár (true) / eldob (false, mint a target) */
+    gw_sub_t extra;                             /* a gateway feliratkozók után, rx szálon */
+} gw_cfg_t;
+
+typedef struct {
+    uint32_t consumed, dropped, stalls;
+    uint32_t frames_in, frames_dup, datagrams;  /* uplink */
+    uint32_t log_records, log_dropped, log_suppressed, uart_lines;
+    uint64_t uart_bytes;                        /* bináris napló, "#BL" sorok */
+    samples_t q_lat, sub_us;                    /* push → rx, feliratkozói idő */
+} gw_stats_t;
+
+void gw_start(const gw_cfg_t* c);
+void gw_sink(uint8_t link, const uint8_t* data, uint16_t len, bool from_cfg);
+/* nem blokkol: false, ha tele a gyűrű (dropped++); a hívó újrapróbál */
+bool gw_try_sink(uint8_t link, const uint8_t* data, uint16_t len, bool from_cfg);
+void gw_stop(void);                             /* kiüríti a gyűrűt, lezárja a batch-et */
+const gw_stats_t* gw_stats(void);
+void gw_print(void);                            /* gyűrű / feliratkozó / uplink sorok */
@@ -0,0 +1,89 @@
+#pragma once
+/* Host shim: az esp_http_server kérés / válasz API-jának az a része, amit a
+ * host-on fordított webserver egységek (auth, http_json) hívnak. Socket nincs:
+ * a kérést egy host_req_t írja le (fejlécek, query, body darabolva), a válasz
+ * státusza, hossza és (opcionálisan) tartalma ugyanott gyűlik. */
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <sys/types.h>
+#include "esp_err.h"
+
+#define ESP_ERR_HTTPD_BASE          0xb000
+#define ESP_ERR_HTTPD_INVALID_REQ   (ESP_ERR_HTTPD_BASE + 3)
+#define ESP_ERR_HTTPD_RESULT_TRUNC  (ESP_ERR_HTTPD_BASE + 4)
+
+#define HTTPD_MAX_URI_LEN       512
+#define HTTPD_RESP_USE_STRLEN   -1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void* httpd_handle_t;
+enum { HTTP_DELETE = 0, HTTP_GET = 1, HTTP_HEAD = 2, HTTP_POST = 3, HTTP_PUT = 4 };
+
+/* a shim-ben a kód = HTTP státusz */
+typedef enum {
+    HTTPD_400_BAD_REQUEST           = 400,
+    HTTPD_401_UNAUTHORIZED          = 401,
+    HTTPD_403_FORBIDDEN             = 403,
+    HTTPD_404_NOT_FOUND             = 404,
+    HTTPD_408_REQ_TIMEOUT           = 408,
+    HTTPD_500_INTERNAL_SERVER_ERROR = 500,
+} httpd_err_code_t;
+
+typedef struct httpd_req {
+    httpd_handle_t handle;
+    int            method;
+    const char     uri[HTTPD_MAX_URI_LEN + 1];
+    size_t         content_len;
+    void*          aux;                 /* host_req_t */
+    void*          user_ctx;
+    void*          sess_ctx;
+} httpd_req_t;
+
+typedef esp_err_t (*httpd_handler_t)(httpd_req_t* r);
+
+/* ===== host kérés ===== */
+typedef void (*host_resp_sink_t)(void* ctx, const char* s, size_t n);
+
+typedef struct {
+    const char* hdrs;                   /* "Name: value\n..." (NULL: nincs) */
+    const char* body;                   /* NULL: nincs */
+    size_t      body_len, body_off;
+    size_t      recv_max;               /* httpd_req_recv darabméret, 0: korlátlan */
+    /* válasz */
+    int         status;                 /* 200, ha a handler nem állított */
+    const char* type;
+    uint32_t    resp_bytes, chunks, hdrs_set;
+    bool        done;                   /* teljes válasz / záró chunk elküldve */
+    host_resp_sink_t sink;              /* válasz tartalma (NULL: eldobva) */
+    void*       sink_ctx;
+} host_req_t;
+
+/* uri: "/api/config?anchor=1"; body hossza strlen(body) */
+void host_req_init(httpd_req_t* r, host_req_t* h, int method, const char* uri,
+                   const char* hdrs, const char* body);
+
+/* ===== kérés ===== */
+esp_err_t httpd_req_get_hdr_value_str(httpd_req_t* r, const char* field, char* val, size_t val_size);
+esp_err_t httpd_req_get_url_query_str(httpd_req_t* r, char* buf, size_t buf_len);
+esp_err_t httpd_query_key_value(const char* qry, const char* key, char* val, size_t val_size);
+int       httpd_req_recv(httpd_req_t* r, char* buf, size_t buf_len);
+
+/* ===== válasz ===== */
+esp_err_t httpd_resp_set_status(httpd_req_t* r, const char* status);
+esp_err_t httpd_resp_set_type(httpd_req_t* r, const char* type);
+esp_err_t httpd_resp_set_hdr(httpd_req_t* r, const char* field, const char* value);
+esp_err_t httpd_resp_send(httpd_req_t* r, const char* buf, ssize_t buf_len);
+esp_err_t httpd_resp_send_chunk(httpd_req_t* r, const char* buf, ssize_t buf_len);
+esp_err_t httpd_resp_send_err(httpd_req_t* r, httpd_err_code_t error, const char* msg);
+static inline esp_err_t httpd_resp_sendstr(httpd_req_t* r, const char* s)
+{ return httpd_resp_send(r, s, s ? HTTPD_RESP_USE_STRLEN : 0); }
+static inline esp_err_t httpd_resp_sendstr_chunk(httpd_req_t* r, const char* s)
+{ return httpd_resp_send_chunk(r, s, s ? HTTPD_RESP_USE_STRLEN : 0); }
+
+#ifdef __cplusplus
+}
+#endif
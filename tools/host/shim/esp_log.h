@@ -0,0 +1,21 @@
+#pragma once
+/* Host shim: ESP_LOGx → host_log(). Alapértelmezés a host_shim.c-ben (stdout),
+ * a program felülírhatja (erős szimbólum). A formázás ugyanúgy lefut, mint a
+ * targeten, így a költsége mérhető. */
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void host_log(char lvl, const char* tag, const char* fmt, ...) __attribute__((format(printf, 3, 4)));
+
+#define ESP_LOGE(tag, fmt, ...) host_log('E', tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) host_log('W', tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) host_log('I', tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...) host_log('D', tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGV(tag, fmt, ...) host_log('V', tag, fmt, ##__VA_ARGS__)
+
+#ifdef __cplusplus
+}
+#endif
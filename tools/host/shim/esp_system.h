@@ -0,0 +1,14 @@
+#pragma once
+/* Host shim: esp_random (nem kriptográfiai: csak SID generáláshoz a benchben) */
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint32_t esp_random(void);
+
+#ifdef __cplusplus
+}
+#endif
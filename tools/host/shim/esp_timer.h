@@ -0,0 +1,14 @@
+#pragma once
+/* Host shim: csak az óra (CLOCK_MONOTONIC, µs); időzítők a host-on nincsenek */
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int64_t esp_timer_get_time(void);
+
+#ifdef __cplusplus
+}
+#endif
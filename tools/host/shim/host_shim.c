@@ -0,0 +1,81 @@
+/* host_shim.c — esp_timer / esp_err / esp_random / mbedtls base64 / log host-on */
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_system.h"
+#include "mbedtls/base64.h"
+
+int64_t esp_timer_get_time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+const char* esp_err_to_name(esp_err_t code)
+{
+    switch (code) {
+    case ESP_OK:                return "ESP_OK";
+    case ESP_FAIL:              return "ESP_FAIL";
+    case ESP_ERR_NO_MEM:        return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG:   return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_INVALID_SIZE:  return "ESP_ERR_INVALID_SIZE";
+    case ESP_ERR_NOT_FOUND:     return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_NOT_SUPPORTED: return "ESP_ERR_NOT_SUPPORTED";
+    case ESP_ERR_TIMEOUT:       return "ESP_ERR_TIMEOUT";
+    case ESP_ERR_INVALID_CRC:   return "ESP_ERR_INVALID_CRC";
+    default:                    return "UNKNOWN ERROR";
+    }
+}
+
+/* xorshift32: determinisztikus, a mérések megismételhetők */
+uint32_t esp_random(void)
+{
+    static uint32_t s = 0x2545F491u;
+    s ^= s << 13; s ^= s >> 17; s ^= s << 5;
+    return s;
+}
+
+/* alapértelmezett log: stdout; a program saját host_log-ja felülírja */
+__attribute__((weak)) void host_log(char lvl, const char* tag, const char* fmt, ...)
+{
+    char line[256];
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(line, sizeof(line), fmt, ap);
+    va_end(ap);
+    printf("%c (%s) %s\n", lvl, tag, line);
+}
+
+int mbedtls_base64_decode(unsigned char* dst, size_t dlen, size_t* olen, const unsigned char* src, size_t slen)
+{
+    size_t n = 0, pad = 0;
+    uint32_t acc = 0; unsigned bits = 0;
+    for (size_t i = 0; i < slen; i++) {
+        const unsigned char c = src[i];
+        int v;
+        if      (c >= 'A' && c <= 'Z') v = c - 'A';
+        else if (c >= 'a' && c <= 'z') v = c - 'a' + 26;
+        else if (c >= '0' && c <= '9') v = c - '0' + 52;
+        else if (c == '+') v = 62;
+        else if (c == '/') v = 63;
+        else if (c == '=') { pad++; continue; }
+        else if (c == '\r' || c == '\n' || c == ' ') continue;
+        else return MBEDTLS_ERR_BASE64_INVALID_CHARACTER;
+        if (pad) return MBEDTLS_ERR_BASE64_INVALID_CHARACTER;      /* '=' után adat */
+        acc = acc << 6 | (uint32_t)v; bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            if (dst && n < dlen) dst[n] = (unsigned char)(acc >> bits);
+            n++;
+        }
+    }
+    if (pad > 2) return MBEDTLS_ERR_BASE64_INVALID_CHARACTER;
+    *olen = n;
+    return (!dst || n > dlen) ? MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL : 0;
+}
@@ -0,0 +1,126 @@
+/* httpd_shim.c — esp_http_server kérés / válasz API host-on (lásd esp_http_server.h) */
+#include <string.h>
+#include <strings.h>
+#include <stdlib.h>
+#include "esp_http_server.h"
+
+#define H(r) ((host_req_t*)(r)->aux)
+
+void host_req_init(httpd_req_t* r, host_req_t* h, int method, const char* uri,
+                   const char* hdrs, const char* body)
+{
+    memset(r, 0, sizeof(*r));
+    const host_resp_sink_t sink = h->sink; void* sctx = h->sink_ctx;
+    const size_t rmax = h->recv_max;
+    memset(h, 0, sizeof(*h));
+    h->sink = sink; h->sink_ctx = sctx; h->recv_max = rmax;
+    h->hdrs = hdrs; h->body = body; h->body_len = body ? strlen(body) : 0;
+    h->status = 200;
+    r->method = method;
+    strncpy((char*)r->uri, uri, HTTPD_MAX_URI_LEN);
+    r->content_len = h->body_len;
+    r->aux = h;
+}
+
+/* ===== kérés ===== */
+static esp_err_t copy_out(const char* s, size_t n, char* buf, size_t cap)
+{
+    if (!cap) return ESP_ERR_INVALID_ARG;
+    const size_t k = n < cap ? n : cap - 1;
+    memcpy(buf, s, k); buf[k] = 0;
+    return n < cap ? ESP_OK : ESP_ERR_HTTPD_RESULT_TRUNC;
+}
+
+esp_err_t httpd_req_get_hdr_value_str(httpd_req_t* r, const char* field, char* val, size_t val_size)
+{
+    const size_t fl = strlen(field);
+    for (const char* p = H(r)->hdrs; p && *p; ) {
+        const char* e = strchr(p, '\n');
+        const size_t ll = e ? (size_t)(e - p) : strlen(p);
+        if (ll > fl && p[fl] == ':' && strncasecmp(p, field, fl) == 0) {
+            const char* v = p + fl + 1;
+            while (*v == ' ') v++;
+            return copy_out(v, (size_t)(p + ll - v), val, val_size);
+        }
+        p = e ? e + 1 : p + ll;
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t httpd_req_get_url_query_str(httpd_req_t* r, char* buf, size_t buf_len)
+{
+    const char* q = strchr(r->uri, '?');
+    if (!q) return ESP_ERR_NOT_FOUND;
+    return copy_out(q + 1, strlen(q + 1), buf, buf_len);
+}
+
+esp_err_t httpd_query_key_value(const char* qry, const char* key, char* val, size_t val_size)
+{
+    const size_t kl = strlen(key);
+    for (const char* p = qry; p && *p; ) {
+        const char* e = strchr(p, '&');
+        const size_t pl = e ? (size_t)(e - p) : strlen(p);
+        if (pl >= kl && strncmp(p, key, kl) == 0 && (pl == kl || p[kl] == '=')) {
+            const char* v = pl > kl ? p + kl + 1 : p + kl;
+            return copy_out(v, (size_t)(p + pl - v), val, val_size);
+        }
+        p = e ? e + 1 : NULL;
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+int httpd_req_recv(httpd_req_t* r, char* buf, size_t buf_len)
+{
+    host_req_t* h = H(r);
+    size_t k = h->body_len - h->body_off;
+    if (k > buf_len) k = buf_len;
+    if (h->recv_max && k > h->recv_max) k = h->recv_max;
+    memcpy(buf, h->body + h->body_off, k);
+    h->body_off += k;
+    return (int)k;
+}
+
+/* ===== válasz ===== */
+esp_err_t httpd_resp_set_status(httpd_req_t* r, const char* status)
+{
+    H(r)->status = atoi(status);
+    return ESP_OK;
+}
+esp_err_t httpd_resp_set_type(httpd_req_t* r, const char* type) { H(r)->type = type; return ESP_OK; }
+esp_err_t httpd_resp_set_hdr(httpd_req_t* r, const char* field, const char* value)
+{
+    (void)field; (void)value;
+    H(r)->hdrs_set++;
+    return ESP_OK;
+}
+
+static void out(host_req_t* h, const char* s, size_t n)
+{
+    h->resp_bytes += (uint32_t)n;
+    if (h->sink && n) h->sink(h->sink_ctx, s, n);
+}
+
+esp_err_t httpd_resp_send(httpd_req_t* r, const char* buf, ssize_t buf_len)
+{
+    host_req_t* h = H(r);
+    if (h->done) return ESP_ERR_HTTPD_INVALID_REQ;
+    out(h, buf, buf_len == HTTPD_RESP_USE_STRLEN ? strlen(buf) : (size_t)buf_len);
+    h->done = true;
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send_chunk(httpd_req_t* r, const char* buf, ssize_t buf_len)
+{
+    host_req_t* h = H(r);
+    if (h->done) return ESP_ERR_HTTPD_INVALID_REQ;
+    if (!buf || !buf_len) { h->done = true; return ESP_OK; }        /* záró chunk */
+    out(h, buf, buf_len == HTTPD_RESP_USE_STRLEN ? strlen(buf) : (size_t)buf_len);
+    h->chunks++;
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send_err(httpd_req_t* r, httpd_err_code_t error, const char* msg)
+{
+    H(r)->status = (int)error;
+    return httpd_resp_send(r, msg ? msg : "", HTTPD_RESP_USE_STRLEN);
+}
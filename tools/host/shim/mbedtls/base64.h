@@ -0,0 +1,16 @@
+#pragma once
+/* Host shim: az mbedtls_base64_decode szerződése (dlen, *olen, hibakódok) */
+#include <stddef.h>
+
+#define MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL  -0x002A
+#define MBEDTLS_ERR_BASE64_INVALID_CHARACTER -0x002C
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int mbedtls_base64_decode(unsigned char* dst, size_t dlen, size_t* olen, const unsigned char* src, size_t slen);
+
+#ifdef __cplusplus
+}
+#endif
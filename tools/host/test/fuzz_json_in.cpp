@@ -0,0 +1,286 @@
+/* fuzz_json_in — streaming body olvasó (components/webserver/json_in) fuzz /
+ * invariáns teszt, minden típusú mezőt tartalmazó kulcstáblával.
+ *
+ * Bemenetenként:
+ *   - darabolás: egyben, bájtonként és két (a bemenetből számolt) vágással
+ *     etetve ugyanaz az eredmény (jr_feed / jr_end, st, err, set, bad, pos,
+ *     cél struktúra);
+ *   - a set-ben nem szereplő mezők érintetlenek (kanári), a beállított
+ *     számmező a tartományban, a string NUL-lezárt a kapacitáson belül;
+ *   - hibátlan body: a beállított mezők JsonW-vel kiírva és visszaolvasva
+ *     ugyanazt adják.
+ * Előtte rögzített esetek: tört / exponens → JR_RANGE, \u → ASCII vagy
+ * JR_CHAR, hibás szám alak → syntax, string értékben álló kulcs.
+ *
+ * libFuzzer-rel: -DFUZZ_LIBFUZZER, clang -fsanitize=fuzzer (LLVMFuzzerTestOneInput).
+ * Enélkül saját determinisztikus mutátor a korpuszon:
+ *   fuzz_json_in [--iters N] [--seed S] korpusz_könyvtár|fájl ... */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include "json_in.hpp"
+#include "json_out.hpp"
+
+#define MAX_IN    1024
+
+struct Dst {
+    char     a_str[8];
+    bool     b_bool;
+    int32_t  c_i32;
+    uint16_t d_u16;
+    uint32_t e_u32;
+    uint8_t  f_u8;
+    char     name[24];
+    uint16_t port;
+};
+static const JrField k_tab[] = {                 // strcmp sorrend
+    JR_STR(Dst, a_str, 0),
+    JR_NUM(Dst, b_bool, JF_BOOL, 1, 0, 1),
+    JR_NUM(Dst, c_i32,  JF_I32,  2, INT32_MIN, INT32_MAX),
+    JR_NUM(Dst, d_u16,  JF_U16,  3, 0, 0xFFFF),
+    JR_NUM(Dst, e_u32,  JF_U32,  4, 0, 0xFFFFFFFF),
+    JR_NUM(Dst, f_u8,   JF_U8,   5, 5, 9),
+    JR_STR(Dst, name, 6),
+    JR_NUM(Dst, port,   JF_U16,  7, 1, 0xFFFF),
+};
+#define NTAB  (uint8_t)(sizeof(k_tab)/sizeof(k_tab[0]))
+
+struct Res { bool ok; uint8_t st, err; uint32_t set, bad, pos; Dst d; };
+
+static void fail(const char* what, const uint8_t* d, size_t n)
+{
+    fprintf(stderr, "fuzz_json_in: %s, input (%zu B): ", what, n);
+    fwrite(d, 1, n < 200 ? n : 200, stderr);
+    fputc('\n', stderr);
+    abort();
+}
+
+/* cuts: növekvő vágáspontok (0 db: egyben); bytewise: bájtonként */
+static Res run(const uint8_t* d, size_t n, const size_t* cuts, unsigned ncut, bool bytewise)
+{
+    Res o;
+    memset(&o, 0, sizeof(o));
+    memset(&o.d, 0xA5, sizeof(o.d));
+    JsonR r;
+    jr_init(r, k_tab, NTAB, &o.d);
+    bool fed = true;
+    if (bytewise) {
+        for (size_t i = 0; i < n && fed; i++) fed = jr_feed(r, (const char*)d + i, 1);
+    } else {
+        size_t prev = 0;
+        for (unsigned k = 0; k <= ncut && fed; k++) {
+            const size_t to = k < ncut ? cuts[k] : n;
+            fed = jr_feed(r, (const char*)d + prev, to - prev);
+            prev = to;
+        }
+    }
+    o.ok = fed && jr_end(r);
+    o.st = r.st; o.err = r.err; o.set = r.set; o.bad = r.bad; o.pos = r.pos;
+    return o;
+}
+
+static bool same(const Res& a, const Res& b)
+{
+    return a.ok == b.ok && a.st == b.st && a.err == b.err && a.set == b.set && a.bad == b.bad && a.pos == b.pos
+        && !memcmp(&a.d, &b.d, sizeof(a.d));
+}
+
+static void check_fields(const Res& o, const uint8_t* d, size_t n)
+{
+    static const Dst canary = [] { Dst c; memset(&c, 0xA5, sizeof(c)); return c; }();
+    for (const JrField& f : k_tab) {
+        const uint8_t* p = (const uint8_t*)&o.d + f.off;
+        const size_t sz = f.type == JF_STR ? f.cap : f.type == JF_U8 || f.type == JF_BOOL ? 1 : f.type == JF_U16 ? 2 : 4;
+        if (!(o.set & 1u << f.bit)) {
+            if (memcmp(p, (const uint8_t*)&canary + f.off, sz)) fail("unset field written", d, n);
+            continue;
+        }
+        int64_t v = 0;
+        switch (f.type) {
+        case JF_STR:  if (!memchr(p, 0, f.cap)) fail("string not terminated", d, n); continue;
+        case JF_BOOL: if (*p > 1) fail("bool value", d, n); continue;
+        case JF_U8:   v = *p; break;
+        case JF_U16:  { uint16_t x; memcpy(&x, p, 2); v = x; } break;
+        case JF_U32:  { uint32_t x; memcpy(&x, p, 4); v = x; } break;
+        default:      { int32_t  x; memcpy(&x, p, 4); v = x; } break;
+        }
+        if (v < f.min || v > f.max) fail("number out of range", d, n);
+    }
+}
+
+/* a beállított mezők JsonW-vel, majd vissza */
+static char   s_out[1024];
+static size_t s_nout;
+static void sink(void*, const char* s, size_t k)
+{
+    if (s_nout + k <= sizeof(s_out)) memcpy(s_out + s_nout, s, k);
+    s_nout += k;
+}
+
+static void round_trip(const Res& o, const uint8_t* d, size_t n)
+{
+    JsonW w;
+    s_nout = 0;
+    jw_init(w, sink, nullptr);
+    jw_obj(w);
+    for (const JrField& f : k_tab) {
+        if (!(o.set & 1u << f.bit)) continue;
+        const uint8_t* p = (const uint8_t*)&o.d + f.off;
+        jw_key(w, f.key);
+        switch (f.type) {
+        case JF_STR:  jw_str(w, (const char*)p); break;
+        case JF_BOOL: jw_bool(w, *p != 0); break;
+        case JF_U8:   jw_u32(w, *p); break;
+        case JF_U16:  { uint16_t x; memcpy(&x, p, 2); jw_u32(w, x); } break;
+        case JF_U32:  { uint32_t x; memcpy(&x, p, 4); jw_u32(w, x); } break;
+        default:      { int32_t  x; memcpy(&x, p, 4); jw_i32(w, x); } break;
+        }
+    }
+    jw_obj_end(w);
+    jw_flush(w);
+    if (s_nout > sizeof(s_out)) fail("round trip output size", d, n);
+    const Res b = run((const uint8_t*)s_out, s_nout, nullptr, 0, false);
+    if (!b.ok || b.bad || b.set != o.set || memcmp(&b.d, &o.d, sizeof(o.d))) fail("round trip", d, n);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* d, size_t n)
+{
+    if (n > MAX_IN) return 0;
+    const Res a = run(d, n, nullptr, 0, false);
+    if (!same(a, run(d, n, nullptr, 0, true))) fail("bytewise feed differs", d, n);
+    if (n > 1) {
+        uint32_t h = 2166136261u;
+        for (size_t i = 0; i < n; i++) h = (h ^ d[i]) * 16777619u;
+        size_t c[2] = { h % n, (h >> 16) % n };
+        if (c[0] > c[1]) { const size_t t = c[0]; c[0] = c[1]; c[1] = t; }
+        if (!same(a, run(d, n, c, 2, false))) fail("split feed differs", d, n);
+    }
+    if (a.set & ~((1u << NTAB) - 1) || a.bad & ~((1u << NTAB) - 1)) fail("mask bits", d, n);
+    if (a.bad && !a.err) fail("bad without err", d, n);
+    check_fields(a, d, n);
+    if (a.ok && !a.bad) round_trip(a, d, n);
+    return 0;
+}
+
+#ifndef FUZZ_LIBFUZZER
+/* ===== rögzített esetek ===== */
+struct Case { const char* in; bool ok; uint32_t set, bad; uint8_t err; };
+static const Case k_cases[] = {
+    { "{\"d_u16\":1.5}",                 true,  0,      1u<<3, JR_RANGE },   // tört
+    { "{\"d_u16\":1e3}",                 true,  0,      1u<<3, JR_RANGE },   // exponens, egész értékű is
+    { "{\"c_i32\":-2.0E+1}",             true,  0,      1u<<2, JR_RANGE },
+    { "{\"x\":1.25e-3,\"d_u16\":7}",     true,  1u<<3,  0,     JR_OK    },   // ismeretlen kulcs: mindegy
+    { "{\"d_u16\":1-2}",                 false, 0,      0,     JR_SYNTAX },
+    { "{\"d_u16\":1.}",                  false, 0,      0,     JR_SYNTAX },
+    { "{\"d_u16\":-}",                   false, 0,      0,     JR_SYNTAX },
+    { "{\"e_u32\":4294967296}",          true,  0,      1u<<4, JR_RANGE },
+    { "{\"name\":\"a\\u0041\\u0009\"}",  true,  1u<<6,  0,     JR_OK    },   // ASCII \u
+    { "{\"name\":\"caf\\u00e9\"}",       true,  0,      1u<<6, JR_CHAR  },
+    { "{\"name\":\"\\u0000\"}",          true,  0,      1u<<6, JR_CHAR  },
+    { "{\"x\":\"\\u2603\",\"port\":80}", true,  1u<<7,  0,     JR_OK    },   // ismeretlen kulcs: mindegy
+    { "{\"name\":\"\\u12G4\"}",          false, 0,      0,     JR_SYNTAX },
+    { "{\"name\":\"port\",\"f_u8\":7}",  true,  1u<<5 | 1u<<6, 0, JR_OK },   // kulcs string értékben
+    { "{\"f_u8\":\"0x09\",\"d_u16\":\"FFFF\"}", true, 1u<<3 | 1u<<5, 0, JR_OK },
+    { "{\"a_str\":\"12345678\"}",        true,  0,      1u<<0, JR_TRUNC },
+    { "{\"b_bool\":true,\"n\":{\"d_u16\":[1,{\"x\":\"}\"}]}}", true, 1u<<1, 0, JR_OK },
+};
+
+static bool run_cases(void)
+{
+    bool ok = true;
+    for (const Case& c : k_cases) {
+        const Res r = run((const uint8_t*)c.in, strlen(c.in), nullptr, 0, false);
+        if (r.ok != c.ok || (c.ok && (r.set != c.set || r.bad != c.bad || r.err != c.err)) || (!c.ok && r.err != c.err)) {
+            fprintf(stderr, "fuzz_json_in: %s: ok %d set 0x%X bad 0x%X err %s\n", c.in, r.ok, (unsigned)r.set,
+                    (unsigned)r.bad, jr_err_str(r.err));
+            ok = false;
+        }
+    }
+    const Res r = run((const uint8_t*)k_cases[8].in, strlen(k_cases[8].in), nullptr, 0, false);
+    if (strcmp(r.d.name, "aA\t")) { fprintf(stderr, "fuzz_json_in: \\u decode: \"%s\"\n", r.d.name); ok = false; }
+    return ok;
+}
+
+/* ===== önálló futtatás: korpusz + mutátor ===== */
+struct Input { uint8_t d[MAX_IN]; uint16_t n; };
+static Input*   s_corp;
+static unsigned s_ncorp, s_capcorp;
+static uint32_t s_rng = 0x2545F491u;
+
+static uint32_t rnd(void) { s_rng ^= s_rng << 13; s_rng ^= s_rng >> 17; s_rng ^= s_rng << 5; return s_rng; }
+
+static void add_file(const char* path)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f) return;
+    if (s_ncorp == s_capcorp) s_corp = (Input*)realloc(s_corp, (s_capcorp = s_capcorp ? 2 * s_capcorp : 32) * sizeof(Input));
+    Input* in = &s_corp[s_ncorp];
+    in->n = (uint16_t)fread(in->d, 1, MAX_IN, f);
+    fclose(f);
+    s_ncorp++;
+}
+
+static void add_path(const char* p)
+{
+    DIR* dir = opendir(p);
+    if (!dir) { add_file(p); return; }
+    struct dirent* e;
+    char buf[1024];
+    while ((e = readdir(dir)))
+        if (e->d_name[0] != '.') { snprintf(buf, sizeof(buf), "%s/%s", p, e->d_name); add_file(buf); }
+    closedir(dir);
+}
+
+/* a JSON szerkezeti karakterei gyakrabban, mint a véletlen bájtok */
+static const char k_tok[] = "{}[]\":,\\ 0123456789-.eE+tfnu\"x";
+
+static void mutate(Input* m)
+{
+    const unsigned ops = 1 + rnd() % 4;
+    for (unsigned k = 0; k < ops; k++) {
+        const unsigned pos = m->n ? rnd() % m->n : 0;
+        switch (rnd() % 7) {
+        case 0: if (m->n) m->d[pos] ^= (uint8_t)(1u << rnd() % 8); break;                    /* bit flip */
+        case 1: if (m->n) m->d[pos] = (uint8_t)rnd(); break;                                 /* bájt */
+        case 2: if (m->n) m->d[pos] = (uint8_t)k_tok[rnd() % (sizeof(k_tok) - 1)]; break;    /* token */
+        case 3: m->n = (uint16_t)(m->n ? rnd() % m->n : 0); break;                           /* levágás */
+        case 4: if (m->n < MAX_IN) {                                                         /* beszúrás */
+                    memmove(m->d + pos + 1, m->d + pos, m->n - pos);
+                    m->d[pos] = (uint8_t)k_tok[rnd() % (sizeof(k_tok) - 1)]; m->n++;
+                } break;
+        case 5: if (m->n) { memmove(m->d + pos, m->d + pos + 1, m->n - pos - 1); m->n--; } break;   /* törlés */
+        default: {                                                                           /* splice */
+            const Input* o = &s_corp[rnd() % s_ncorp];
+            const unsigned take = o->n ? rnd() % o->n : 0;
+            const unsigned room = MAX_IN - pos;
+            const unsigned c = take < room ? take : room;
+            memcpy(m->d + pos, o->d, c);
+            if (pos + c > m->n) m->n = (uint16_t)(pos + c);
+        }
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    unsigned long iters = 200000;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--iters") && i + 1 < argc) iters = strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) s_rng = (uint32_t)strtoul(argv[++i], NULL, 0) | 1;
+        else add_path(argv[i]);
+    }
+    if (!s_ncorp) { fputs("usage: fuzz_json_in [--iters N] [--seed S] corpus_dir|file ...\n", stderr); return 2; }
+    if (!run_cases()) return 1;
+    for (unsigned i = 0; i < s_ncorp; i++) LLVMFuzzerTestOneInput(s_corp[i].d, s_corp[i].n);
+    Input m;
+    for (unsigned long i = 0; i < iters; i++) {
+        m = s_corp[rnd() % s_ncorp];
+        mutate(&m);
+        LLVMFuzzerTestOneInput(m.d, m.n);
+    }
+    printf("fuzz_json_in: %u corpus + %lu mutated inputs ok\n", s_ncorp, iters);
+    free(s_corp);
+    return 0;
+}
+#endif
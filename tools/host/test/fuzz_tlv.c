@@ -0,0 +1,197 @@
+/* fuzz_tlv — CFG TLV kodek (components/ble/tlv.c) fuzz / invariáns teszt.
+ *
+ * Bemenetenként:
+ *   - cursor: az elemek a pufferen belül, off szigorúan nő, END-nél off == n
+ *     vagy egy maradék bájt, TRUNC-nál a csonka elem fejléce a helyén;
+ *   - differenciális: a teljes elemek száma == a régi switch-es parseré (tlv_legacy.c);
+ *   - újrakódolás: tlv_put_raw az elemekből bájtra ugyanazt adja;
+ *   - tlv_format_value 0..16 és 128 B pufferrel: NUL-lezárt, strlen == visszatérés;
+ *   - pp_log_cfg szövege soronként == a "%s=%s" + tlv_format_value alak
+ *     (a számok közvetlen formázása nem változtathat a kimeneten);
+ *   - uwb_cfg_decode, legacy_pp_log_cfg, legacy_parse_cfg_notify: nem olvas ki (ASan).
+ *
+ * libFuzzer-rel: -DFUZZ_LIBFUZZER, clang -fsanitize=fuzzer (LLVMFuzzerTestOneInput).
+ * Enélkül saját determinisztikus mutátor a korpuszon:
+ *   fuzz_tlv [--iters N] [--seed S] korpusz_könyvtár|fájl ... */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <dirent.h>
+#include "tlv.h"
+#include "uwb_frame.h"
+#include "pretty_print.h"
+#include "tlv_legacy.h"
+
+#define MAX_IN    512
+#define MAX_LINES 300
+
+static char     s_lines[MAX_LINES][160];
+static unsigned s_nlines;
+static bool     s_capture;
+
+void host_log(char lvl, const char* tag, const char* fmt, ...)
+{
+    (void)lvl; (void)tag;
+    char tmp[160];
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(s_capture && s_nlines < MAX_LINES ? s_lines[s_nlines++] : tmp, sizeof(tmp), fmt, ap);
+    va_end(ap);
+}
+
+static void fail(const char* what, const uint8_t* d, size_t n)
+{
+    fprintf(stderr, "fuzz_tlv: %s, input (%zu B):", what, n);
+    for (size_t i = 0; i < n && i < 64; i++) fprintf(stderr, " %02X", d[i]);
+    fputc('\n', stderr);
+    abort();
+}
+
+static void check_format(const tlv_t* t, const uint8_t* d, size_t n)
+{
+    char b[129];
+    for (size_t sz = 0; sz <= 17; sz++) {
+        memset(b, 0x7F, sizeof(b));
+        const int k = tlv_format_value(t, b, sz);
+        if (sz == 0 ? k != 0 : (k < 0 || (size_t)k >= sz || strlen(b) != (size_t)k)) fail("format short buffer", d, n);
+        if (b[sz] != 0x7F) fail("format wrote past buffer", d, n);
+    }
+    const int k = tlv_format_value(t, b, 128);
+    if (k < 0 || strlen(b) != (size_t)k) fail("format", d, n);
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t* d, size_t size)
+{
+    if (size > 0xFFFF) return 0;
+    const uint16_t n = (uint16_t)size;
+
+    /* cursor + újrakódolás */
+    static uint8_t s_re[0x10000];
+    tlv_wr_t w; tlv_wr_init(&w, s_re, sizeof(s_re) - 1);
+    tlv_cur_t cur; tlv_t t; tlv_rc_t rc;
+    unsigned items = 0, prev = 0;
+    tlv_cur_init(&cur, d, n);
+    while ((rc = tlv_next(&cur, &t)) == TLV_ITEM) {
+        if (t.val != d + prev + 2 || cur.off != prev + 2 + t.len || cur.off > n) fail("cursor bounds", d, n);
+        if (t.d != tlv_desc(t.tag)) fail("descriptor", d, n);
+        if (tlv_width_ok(&t) && (!t.d->name || t.len < 1 || t.len > 4 || (t.d->width && t.len != t.d->width)))
+            fail("width_ok", d, n);
+        if (tlv_width_ok(&t) && (uint32_t)tlv_i32(&t) << (32 - 8 * t.len) != tlv_u32(&t) << (32 - 8 * t.len))
+            fail("i32 / u32 low bits", d, n);
+        check_format(&t, d, n);
+        if (!tlv_put_raw(&w, t.tag, t.val, t.len)) fail("re-encode capacity", d, n);
+        prev = cur.off;
+        items++;
+    }
+    if (rc == TLV_END && n - prev > 1) fail("END with >1 byte left", d, n);
+    if (rc == TLV_TRUNC && (cur.off != n || t.tag != d[prev] || t.len != d[prev + 1] || prev + 2 + t.len <= n))
+        fail("TRUNC state", d, n);
+    if (w.len != prev || memcmp(s_re, d, prev)) fail("re-encode bytes", d, n);
+
+    uint32_t sum;
+    if (legacy_walk(d, n, &sum) != items) fail("item count differs from legacy parser", d, n);
+
+    /* pp_log_cfg szöveg: közvetlen számformázás == tlv_format_value alak */
+    uwb_cfg_t c;
+    if (uwb_cfg_decode(d, n, &c) == UWB_CFG_TLV && items < MAX_LINES) {
+        s_nlines = 0; s_capture = true;
+        pp_log_cfg(d, n);
+        s_capture = false;
+        unsigned li = 0;
+        tlv_cur_init(&cur, d, n);
+        while (tlv_next(&cur, &t) == TLV_ITEM) {
+            char vb[128], want[160];
+            tlv_format_value(&t, vb, sizeof(vb));
+            if (tlv_width_ok(&t)) snprintf(want, sizeof(want), "%s=%s", t.d->name, vb);
+            else snprintf(want, sizeof(want), "%s(0x%02X)[len=%u]: %s", t.d->name ? t.d->name : "TLV", t.tag, (unsigned)t.len, vb);
+            if (li >= s_nlines || strcmp(s_lines[li], want)) fail("pp_log_cfg text", d, n);
+            li++;
+        }
+        if (s_nlines != li + (rc == TLV_TRUNC)) fail("pp_log_cfg line count", d, n);
+    } else {
+        pp_log_cfg(d, n);
+    }
+    legacy_pp_log_cfg(d, n);
+    legacy_parse_cfg_notify(d, n);
+    return 0;
+}
+
+#ifndef FUZZ_LIBFUZZER
+/* ===== önálló futtatás: korpusz + mutátor ===== */
+typedef struct { uint8_t d[MAX_IN]; uint16_t n; } input_t;
+static input_t* s_corp;
+static unsigned s_ncorp, s_capcorp;
+static uint32_t s_rng = 0x2545F491u;
+
+static uint32_t rnd(void) { s_rng ^= s_rng << 13; s_rng ^= s_rng >> 17; s_rng ^= s_rng << 5; return s_rng; }
+
+static void add_file(const char* path)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f) return;
+    if (s_ncorp == s_capcorp) s_corp = realloc(s_corp, (s_capcorp = s_capcorp ? 2 * s_capcorp : 32) * sizeof(input_t));
+    input_t* in = &s_corp[s_ncorp];
+    in->n = (uint16_t)fread(in->d, 1, MAX_IN, f);
+    fclose(f);
+    s_ncorp++;
+}
+
+static void add_path(const char* p)
+{
+    DIR* dir = opendir(p);
+    if (!dir) { add_file(p); return; }
+    struct dirent* e;
+    char buf[1024];
+    while ((e = readdir(dir)))
+        if (e->d_name[0] != '.') { snprintf(buf, sizeof(buf), "%s/%s", p, e->d_name); add_file(buf); }
+    closedir(dir);
+}
+
+static void mutate(input_t* m)
+{
+    const unsigned ops = 1 + rnd() % 4;
+    for (unsigned k = 0; k < ops; k++) {
+        const unsigned pos = m->n ? rnd() % m->n : 0;
+        switch (rnd() % 7) {
+        case 0: if (m->n) m->d[pos] ^= (uint8_t)(1u << rnd() % 8); break;             /* bit flip */
+        case 1: if (m->n) m->d[pos] = (uint8_t)rnd(); break;                          /* bájt */
+        case 2: if (m->n) m->d[pos] = (uint8_t)(m->d[pos] + (rnd() % 5) - 2); break;  /* ±2 (hossz mezők) */
+        case 3: m->n = (uint16_t)(m->n ? rnd() % m->n : 0); break;                    /* levágás */
+        case 4: if (m->n < MAX_IN) {                                                  /* beszúrás */
+                    memmove(m->d + pos + 1, m->d + pos, m->n - pos); m->d[pos] = (uint8_t)rnd(); m->n++;
+                } break;
+        case 5: if (m->n) { memmove(m->d + pos, m->d + pos + 1, m->n - pos - 1); m->n--; } break;   /* törlés */
+        default: {                                                                    /* splice */
+            const input_t* o = &s_corp[rnd() % s_ncorp];
+            const unsigned take = o->n ? rnd() % o->n : 0;
+            const unsigned room = MAX_IN - pos;
+            const unsigned c = take < room ? take : room;
+            memcpy(m->d + pos, o->d, c);
+            if (pos + c > m->n) m->n = (uint16_t)(pos + c);
+        }
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    unsigned long iters = 200000;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--iters") && i + 1 < argc) iters = strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) s_rng = (uint32_t)strtoul(argv[++i], NULL, 0) | 1;
+        else add_path(argv[i]);
+    }
+    if (!s_ncorp) { fputs("usage: fuzz_tlv [--iters N] [--seed S] corpus_dir|file ...\n", stderr); return 2; }
+    for (unsigned i = 0; i < s_ncorp; i++) LLVMFuzzerTestOneInput(s_corp[i].d, s_corp[i].n);
+    input_t m;
+    for (unsigned long i = 0; i < iters; i++) {
+        m = s_corp[rnd() % s_ncorp];
+        mutate(&m);
+        LLVMFuzzerTestOneInput(m.d, m.n);
+    }
+    printf("fuzz_tlv: %u corpus + %lu mutated inputs ok\n", s_ncorp, iters);
+    free(s_corp);
+    return 0;
+}
+#endif
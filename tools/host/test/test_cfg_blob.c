@@ -0,0 +1,200 @@
+/* test_cfg_blob — rendszer konfig blob (main/cfg_blob) kódolás / migráció.
+ *
+ * A v1 blobot kézzel rakjuk össze (a v1 mezősorrend szerint, nem a mai
+ * enkóderrel), így a teszt a régi firmware által írt NVS tartalmat látja.
+ * Elvárás:
+ *   - v2 round trip: minden mező, a linkenkénti tükrök is,
+ *   - v1 → v2: a v1 egy tükre a v1 lista első anchorának kulcsára kerül,
+ *     a többi slot üres; újrakódolva v2, ugyanazzal a tartalommal,
+ *   - v1 ismeretlen tükörrel (mask=0) nem foglal slotot,
+ *   - újabb blob (v3, ismeretlen vég): a v2 mezők megjönnek,
+ *   - rövid / rossz magic / CRC hiba → alapértékek,
+ *   - cfgb_link_slot: meglévő kulcs az értékeivel előre, tele → a legrégebbi megy. */
+#include <stdio.h>
+#include <string.h>
+#include "cfg_blob.h"
+
+static int s_errors;
+
+#define CHECK(c, ...) do { if (!(c)) { if (s_errors++ < 20) { printf("FAIL %s:%d: ", __func__, __LINE__); printf(__VA_ARGS__); putchar('\n'); } } } while (0)
+
+static bool dwm_eq(const cfgb_dwm_t* a, const cfgb_dwm_t* b)
+{
+    return a->key == b->key && a->mask == b->mask && a->network_id == b->network_id && a->zone_id == b->zone_id &&
+           a->anchor_id == b->anchor_id && a->hb_ms == b->hb_ms && a->log_level == b->log_level &&
+           a->tx_ant_dly == b->tx_ant_dly && a->rx_ant_dly == b->rx_ant_dly && a->bias_ticks == b->bias_ticks &&
+           a->phy_ch == b->phy_ch && a->phy_sfdto == b->phy_sfdto;
+}
+
+static bool cfg_eq(const sys_cfg_t* a, const sys_cfg_t* b)
+{
+    if (a->ip != b->ip || a->gw != b->gw || a->mask != b->mask || a->dns1 != b->dns1 || a->dns2 != b->dns2 ||
+        a->udp_dst != b->udp_dst || a->udp_port != b->udp_port || strcmp(a->anchors, b->anchors))
+        return false;
+    cfgb_dwm_t v1a = a->dwm_v1, v1b = b->dwm_v1;
+    v1a.key = v1b.key = 0;                                    /* v1 tükör kulcsa nem kerül a blobba */
+    if (!dwm_eq(&v1a, &v1b)) return false;
+    for (int i = 0; i < CFGB_LINKS; i++) if (!dwm_eq(&a->dwm[i], &b->dwm[i])) return false;
+    return true;
+}
+
+static void fill_dwm(cfgb_dwm_t* d, uint32_t seed)
+{
+    d->mask = 0x3FF;
+    d->network_id = (uint16_t)(0x1000 + seed); d->zone_id = (uint16_t)(0x5A00 + seed);
+    d->anchor_id = 0xA0000000u + seed;         d->hb_ms = (uint16_t)(1000 + seed);
+    d->log_level = (uint8_t)(seed & 3);
+    d->tx_ant_dly = 16385 + (int32_t)seed;     d->rx_ant_dly = 16400 - (int32_t)seed;
+    d->bias_ticks = -7 * (int32_t)seed;
+    d->phy_ch = seed & 1 ? 5 : 9;              d->phy_sfdto = (uint16_t)(129 + seed);
+}
+
+/* ===== kézi v1 blob ===== */
+typedef struct { uint8_t b[CFGB_MAX]; size_t n; } blob_t;
+
+static void put(blob_t* o, uint32_t v, int size) { for (int k = 0; k < size; k++) o->b[o->n++] = (uint8_t)(v >> 8 * k); }
+
+static void seal(blob_t* o, uint16_t ver)
+{
+    memcpy(o->b, CFGB_MAGIC, 4);
+    o->b[4] = (uint8_t)ver; o->b[5] = (uint8_t)(ver >> 8);
+    const size_t len = o->n - CFGB_HDR;
+    o->b[6] = (uint8_t)len; o->b[7] = (uint8_t)(len >> 8);
+    put(o, cfgb_crc32(o->b, o->n), 4);
+}
+
+static void v1_blob(blob_t* o, const char* anchors, const cfgb_dwm_t* d)
+{
+    o->n = CFGB_HDR;
+    put(o, 0x0A00A8C0, 4); put(o, 0x0100A8C0, 4); put(o, 0x00FFFFFF, 4);         /* ip, gw, mask */
+    put(o, 0x01010101, 4); put(o, 0x08080808, 4); put(o, 0xFF00A8C0, 4);         /* dns1, dns2, udp_dst */
+    put(o, 4242, 2);
+    char a[CFGB_ANCHORS] = { 0 };
+    strncpy(a, anchors, sizeof(a) - 1);
+    memcpy(o->b + o->n, a, sizeof(a)); o->n += sizeof(a);
+    put(o, d->mask, 2); put(o, d->network_id, 2); put(o, d->zone_id, 2); put(o, d->anchor_id, 4);
+    put(o, d->hb_ms, 2); put(o, d->log_level, 1);
+    put(o, (uint32_t)d->tx_ant_dly, 4); put(o, (uint32_t)d->rx_ant_dly, 4); put(o, (uint32_t)d->bias_ticks, 4);
+    put(o, d->phy_ch, 1); put(o, d->phy_sfdto, 2);
+    seal(o, 1);
+}
+
+static void t_roundtrip(void)
+{
+    sys_cfg_t c, r;
+    cfgb_defaults(&c);
+    c.ip = 0x11223344; c.udp_port = 999;
+    strcpy(c.anchors, "A,B,CC:DD:EE:FF:00:11");
+    for (uint32_t i = 0; i < 3; i++) fill_dwm(cfgb_link_slot(&c, 100 + i), i + 1);
+    c.dwm_v1 = c.dwm[0];
+
+    uint8_t b[CFGB_MAX];
+    const size_t n = cfgb_encode(&c, b, sizeof(b));
+    uint16_t ver = 0;
+    CHECK(n > 0 && n <= CFGB_MAX, "encode %zu", n);
+    CHECK(cfgb_decode(b, n, &r, &ver) == CFGB_OK && ver == CFGB_VER, "decode ver %u", ver);
+    CHECK(cfg_eq(&c, &r), "round trip differs");
+    CHECK(cfgb_encode(&c, b, n - 1) == 0, "encode into short buffer");
+}
+
+static void t_migrate_v1(void)
+{
+    cfgb_dwm_t d;
+    memset(&d, 0, sizeof(d));
+    fill_dwm(&d, 7);
+    blob_t o;
+    v1_blob(&o, ",, ANCH_X ,ANCH_Y", &d);                     /* ble_start: üres elem kimarad, vezető szóköz le */
+
+    sys_cfg_t c, dflt;
+    cfgb_defaults(&dflt);
+    uint16_t ver = 0;
+    CHECK(cfgb_decode(o.b, o.n, &c, &ver) == CFGB_OK && ver == 1, "decode v1 ver %u", ver);
+    CHECK(c.ip == 0x0A00A8C0 && c.udp_port == 4242 && !strcmp(c.anchors, ",, ANCH_X ,ANCH_Y"), "v1 net fields");
+    const uint32_t kx = cfgb_link_key("ANCH_X ");
+    cfgb_dwm_t want = d;
+    want.key = kx;
+    const cfgb_dwm_t* x = cfgb_link_find(&c, kx);
+    CHECK(x && dwm_eq(x, &want), "v1 mirror not on link 0 key");
+    CHECK(!cfgb_link_find(&c, cfgb_link_key("ANCH_Y")), "link 1 got a mirror");
+    for (int i = 1; i < CFGB_LINKS; i++) CHECK(dwm_eq(&c.dwm[i], &dflt.dwm[i]), "slot %d not default", i);
+    CHECK(c.dwm_v1.mask == d.mask && c.dwm_v1.anchor_id == d.anchor_id, "v1 copy kept");
+
+    /* mentés (cfg_store: migrált blob újraírva) → v2, ugyanaz */
+    uint8_t b[CFGB_MAX];
+    sys_cfg_t r;
+    const size_t n = cfgb_encode(&c, b, sizeof(b));
+    CHECK(cfgb_decode(b, n, &r, &ver) == CFGB_OK && ver == CFGB_VER && cfg_eq(&c, &r), "re-encoded v%u differs", ver);
+
+    /* ismeretlen tükör: nincs slot; üres lista → a "bármely eszköz" link kulcsa */
+    d.mask = 0;
+    v1_blob(&o, "ANCH_X", &d);
+    CHECK(cfgb_decode(o.b, o.n, &c, &ver) == CFGB_OK && !cfgb_link_find(&c, kx), "mask 0 migrated");
+    d.mask = 0x21;
+    v1_blob(&o, "", &d);
+    CHECK(cfgb_decode(o.b, o.n, &c, &ver) == CFGB_OK && cfgb_link_find(&c, cfgb_link_key("")), "empty list");
+    CHECK(cfgb_link_key("") != 0, "key 0 reserved");
+}
+
+/* v3 (downgrade): a v2 mezők után ismeretlen vég */
+static void t_newer(void)
+{
+    sys_cfg_t c, r;
+    cfgb_defaults(&c);
+    fill_dwm(cfgb_link_slot(&c, 55), 3);
+    blob_t o;
+    o.n = cfgb_encode(&c, o.b, sizeof(o.b)) - 4;
+    for (int i = 0; i < 20; i++) o.b[o.n++] = (uint8_t)(0xA0 + i);
+    seal(&o, CFGB_VER + 1);
+    uint16_t ver = 0;
+    CHECK(cfgb_decode(o.b, o.n, &r, &ver) == CFGB_OK && ver == CFGB_VER + 1 && cfg_eq(&c, &r), "v%u tail", ver);
+}
+
+static void t_reject(void)
+{
+    sys_cfg_t c, dflt;
+    cfgb_defaults(&c);
+    cfgb_defaults(&dflt);
+    c.udp_port = 1;
+    uint8_t b[CFGB_MAX];
+    const size_t n = cfgb_encode(&c, b, sizeof(b));
+    sys_cfg_t r;
+    CHECK(cfgb_decode(b, CFGB_HDR, &r, NULL) == CFGB_SHORT, "header only");
+    CHECK(cfgb_decode(b, n - 1, &r, NULL) == CFGB_SHORT && cfg_eq(&r, &dflt), "truncated");
+    b[0] ^= 1;
+    CHECK(cfgb_decode(b, n, &r, NULL) == CFGB_MAGIC_BAD, "magic");
+    b[0] ^= 1;
+    b[CFGB_HDR + 3] ^= 0x10;
+    CHECK(cfgb_decode(b, n, &r, NULL) == CFGB_CRC && cfg_eq(&r, &dflt), "crc");
+}
+
+static void t_slots(void)
+{
+    sys_cfg_t c;
+    cfgb_defaults(&c);
+    for (uint32_t k = 1; k <= CFGB_LINKS; k++) fill_dwm(cfgb_link_slot(&c, k), k);
+    CHECK(c.dwm[0].key == CFGB_LINKS && c.dwm[CFGB_LINKS - 1].key == 1, "MRU order");
+
+    cfgb_dwm_t* d = cfgb_link_slot(&c, 2);                     /* meglévő: előre, értékeivel */
+    CHECK(d == &c.dwm[0] && d->key == 2 && d->network_id == 0x1002 && d->mask == 0x3FF, "existing slot");
+
+    d = cfgb_link_slot(&c, 99);                                /* tele: 1 (a legrégebbi) kiesik */
+    CHECK(d->key == 99 && d->mask == 0 && d->network_id == 1, "new slot not default");
+    CHECK(!cfgb_link_find(&c, 1), "oldest not evicted");
+    for (uint32_t k = 2; k <= CFGB_LINKS; k++) {
+        const cfgb_dwm_t* f = cfgb_link_find(&c, k);
+        CHECK(f && f->network_id == 0x1000 + k, "key %u lost", k);
+    }
+    CHECK(!cfgb_link_find(&c, 0), "find 0");
+}
+
+int main(void)
+{
+    t_roundtrip();
+    t_migrate_v1();
+    t_newer();
+    t_reject();
+    t_slots();
+    if (s_errors) { printf("test_cfg_blob: %d hiba\n", s_errors); return 1; }
+    printf("test_cfg_blob: ok\n");
+    return 0;
+}
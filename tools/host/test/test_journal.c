@@ -0,0 +1,208 @@
+/* test_journal — journal (components/uplink) fájl-alapú flash-en.
+ *
+ * A jr_flash_t egy ideiglenes fájl NOR szemantikával: write = régi & új
+ * (csak 1→0; 0→1 kísérletet számolunk, hibának vesszük), erase = 0xFF.
+ * Újraindítás = a journal_t eldobása és jr_mount ugyanarra a fájlra.
+ * Elvárás:
+ *   - üres partíció, majd append → remount → sorrendhelyes, ép visszajátszás,
+ *   - félig visszajátszott napló remount után ott folytatja (done jel),
+ *   - tele gyűrű: a legrégebbi szektor elveszik, appended == replayed + dropped,
+ *   - félbeszakadt payload (CRC hiba) kimarad, a következő rekord megjön,
+ *   - szemét az író pozíción: a szektor lezárt, a következő append új szektorba. */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "journal.h"
+
+#define SEC     4096u
+#define NSEC    4u
+
+typedef struct { FILE* fp; uint32_t nor_viol; } fflash_t;
+
+static int s_errors;
+
+#define CHECK(c, ...) do { if (!(c)) { if (s_errors++ < 20) { printf("FAIL %s:%d: ", __func__, __LINE__); printf(__VA_ARGS__); putchar('\n'); } } } while (0)
+
+static int f_read(void* ctx, uint32_t off, void* buf, uint32_t len)
+{
+    fflash_t* f = ctx;
+    if (fseek(f->fp, off, SEEK_SET) || fread(buf, 1, len, f->fp) != len) return -1;
+    return 0;
+}
+
+static int f_write(void* ctx, uint32_t off, const void* buf, uint32_t len)
+{
+    fflash_t* f = ctx;
+    uint8_t old[JR_MAX_REC + JR_REC_HDR];
+    if (len > sizeof(old) || f_read(ctx, off, old, len)) return -1;
+    const uint8_t* b = buf;
+    for (uint32_t i = 0; i < len; i++) {
+        if (b[i] & ~old[i]) f->nor_viol++;            /* 0→1 NOR-on nem megy */
+        old[i] &= b[i];
+    }
+    if (fseek(f->fp, off, SEEK_SET) || fwrite(old, 1, len, f->fp) != len) return -1;
+    return fflush(f->fp);
+}
+
+static int f_erase(void* ctx, uint32_t off, uint32_t len)
+{
+    fflash_t* f = ctx;
+    if (off % SEC || len % SEC) return -1;
+    uint8_t ff[SEC];
+    memset(ff, 0xFF, sizeof(ff));
+    if (fseek(f->fp, off, SEEK_SET)) return -1;
+    for (uint32_t n = 0; n < len; n += SEC) if (fwrite(ff, 1, SEC, f->fp) != SEC) return -1;
+    return fflush(f->fp);
+}
+
+static fflash_t s_ff;
+static const jr_flash_t s_fl = { f_read, f_write, f_erase, &s_ff, SEC * NSEC, SEC };
+
+/* gyári állapot: egyszer törölt flash */
+static void flash_blank(void)
+{
+    if (s_ff.fp) fclose(s_ff.fp);
+    s_ff.fp = tmpfile();
+    s_ff.nor_viol = 0;
+    if (!s_ff.fp || f_erase(&s_ff, 0, SEC * NSEC)) { printf("test_journal: tmpfile\n"); exit(1); }
+}
+
+/* nyers bájt felülírás (áramszünet szimuláció, a NOR szabályt megkerülve) */
+static void poke(uint32_t off, const void* b, uint32_t n)
+{
+    fseek(s_ff.fp, off, SEEK_SET);
+    fwrite(b, 1, n, s_ff.fp);
+    fflush(s_ff.fp);
+}
+
+/* rekord: [seq LE32] + seq-ből számolt minta, hossz 20..299 */
+static uint16_t rec_len(uint32_t seq) { return (uint16_t)(20 + (seq * 37u) % 280); }
+
+static uint16_t mk_rec(uint8_t* b, uint32_t seq)
+{
+    const uint16_t n = rec_len(seq);
+    for (int k = 0; k < 4; k++) b[k] = (uint8_t)(seq >> 8 * k);
+    for (unsigned i = 4; i < n; i++) b[i] = (uint8_t)(seq * 13u + i);
+    return n;
+}
+
+static void append(journal_t* j, uint32_t seq)
+{
+    uint8_t b[JR_MAX_REC];
+    const uint16_t n = mk_rec(b, seq);
+    CHECK(jr_append(j, b, n) == 0, "append %u", seq);
+}
+
+/* következő függő rekord == seq? és pop */
+static bool replay_one(journal_t* j, uint32_t want)
+{
+    uint8_t b[JR_MAX_REC], e[JR_MAX_REC];
+    uint16_t n = 0;
+    const int r = jr_peek(j, b, sizeof(b), &n);
+    if (r != 0) { CHECK(0, "peek rc %d, want seq %u", r, want); return false; }
+    const uint16_t en = mk_rec(e, want);
+    if (n != en || memcmp(b, e, n)) {
+        uint32_t got = 0;
+        for (int k = 0; k < 4; k++) got |= (uint32_t)b[k] << 8 * k;
+        CHECK(0, "record seq %u len %u, want seq %u len %u", got, n, want, en);
+        return false;
+    }
+    CHECK(jr_pop(j) == 0, "pop %u", want);
+    return true;
+}
+
+static void t_basic_remount(void)
+{
+    flash_blank();
+    journal_t j;
+    uint8_t b[16]; uint16_t n;
+    CHECK(jr_mount(&j, &s_fl) == 0 && jr_pending(&j) == 0, "blank mount");
+    CHECK(jr_peek(&j, b, sizeof(b), &n) == 1, "blank peek");
+
+    for (uint32_t s = 0; s < 20; s++) append(&j, s);
+    CHECK(jr_pending(&j) == 20, "pending %u", jr_pending(&j));
+
+    CHECK(jr_mount(&j, &s_fl) == 0 && jr_pending(&j) == 20, "remount pending %u", jr_pending(&j));
+    for (uint32_t s = 0; s < 8; s++) if (!replay_one(&j, s)) return;
+
+    /* újraindulás félig visszajátszva: a done jel megmaradt */
+    CHECK(jr_mount(&j, &s_fl) == 0 && jr_pending(&j) == 12, "remount after pop pending %u", jr_pending(&j));
+    for (uint32_t s = 20; s < 25; s++) append(&j, s);      /* utána írt rekordok is sorban */
+    for (uint32_t s = 8; s < 25; s++) if (!replay_one(&j, s)) return;
+    CHECK(jr_peek(&j, b, sizeof(b), &n) == 1 && jr_pending(&j) == 0, "drained");
+    CHECK(jr_mount(&j, &s_fl) == 0 && jr_pending(&j) == 0, "remount drained pending %u", jr_pending(&j));
+    CHECK(s_ff.nor_viol == 0, "NOR violations %u", s_ff.nor_viol);
+}
+
+/* több gyűrűnyi írás visszajátszás nélkül: csak a legújabb szektorok maradnak */
+static void t_wrap_drop(void)
+{
+    flash_blank();
+    journal_t j;
+    CHECK(jr_mount(&j, &s_fl) == 0, "mount");
+    const uint32_t N = 200;                                   /* ~32 KB payload a 16 KB-os gyűrűbe */
+    for (uint32_t s = 0; s < N; s++) append(&j, s);
+    const jr_stats_t st = j.st;
+    CHECK(st.dropped > 0 && st.appended == N && st.pending + st.dropped == N,
+          "pending %u dropped %u", st.pending, st.dropped);
+    CHECK(st.erases >= NSEC + 1, "erases %u", st.erases);
+
+    /* remount: ugyanannyi függő, a legrégebbi túlélőtől sorban */
+    CHECK(jr_mount(&j, &s_fl) == 0 && jr_pending(&j) == st.pending, "remount pending %u want %u", jr_pending(&j), st.pending);
+    for (uint32_t s = st.dropped; s < N; s++) if (!replay_one(&j, s)) return;
+    CHECK(jr_pending(&j) == 0 && j.st.corrupt == 0, "pending %u corrupt %u", jr_pending(&j), j.st.corrupt);
+    CHECK(s_ff.nor_viol == 0, "NOR violations %u", s_ff.nor_viol);
+}
+
+/* félbeszakadt payload: a fejléc kész, a payload vége még törölt (0xFF) */
+static void t_torn_payload(void)
+{
+    flash_blank();
+    journal_t j;
+    CHECK(jr_mount(&j, &s_fl) == 0, "mount");
+    for (uint32_t s = 0; s < 3; s++) append(&j, s);
+    /* 1. rekord: szektor 0, offszet 8 + rekord(0) */
+    const uint32_t off1 = JR_SECTOR_HDR + JR_REC_HDR + ((rec_len(0) + 3u) & ~3u);
+    uint8_t ff[8];
+    memset(ff, 0xFF, sizeof(ff));
+    poke(off1 + JR_REC_HDR + rec_len(1) - sizeof(ff), ff, sizeof(ff));
+
+    CHECK(jr_mount(&j, &s_fl) == 0 && jr_pending(&j) == 3, "remount pending %u", jr_pending(&j));
+    if (!replay_one(&j, 0) || !replay_one(&j, 2)) return;     /* 1 kimarad */
+    CHECK(j.st.corrupt == 1 && jr_pending(&j) == 0, "corrupt %u pending %u", j.st.corrupt, jr_pending(&j));
+    CHECK(jr_mount(&j, &s_fl) == 0 && jr_pending(&j) == 0, "corrupt record marked done");
+}
+
+/* szemét az író pozíción (félbeszakadt fejléc): a szektor lezárt */
+static void t_torn_header(void)
+{
+    flash_blank();
+    journal_t j;
+    CHECK(jr_mount(&j, &s_fl) == 0, "mount");
+    for (uint32_t s = 0; s < 2; s++) append(&j, s);
+    const uint32_t w = j.w_off;
+    const uint8_t junk[4] = { 0x12, 0xFF, 0x00, 0x00 };       /* nem REC_MAGIC */
+    poke(w, junk, sizeof(junk));
+
+    CHECK(jr_mount(&j, &s_fl) == 0 && jr_pending(&j) == 2 && j.st.corrupt == 1, "remount pending %u corrupt %u",
+          jr_pending(&j), j.st.corrupt);
+    CHECK(j.w_off == SEC, "writer not sealed: w_off %u", j.w_off);
+    const uint32_t sec0 = j.w_sec;
+    append(&j, 2);
+    CHECK(j.w_sec != sec0, "append stayed in the torn sector");
+    for (uint32_t s = 0; s < 3; s++) if (!replay_one(&j, s)) return;
+    CHECK(jr_mount(&j, &s_fl) == 0 && jr_pending(&j) == 0, "remount drained pending %u", jr_pending(&j));
+    CHECK(s_ff.nor_viol == 0, "NOR violations %u", s_ff.nor_viol);
+}
+
+int main(void)
+{
+    t_basic_remount();
+    t_wrap_drop();
+    t_torn_payload();
+    t_torn_header();
+    if (s_ff.fp) fclose(s_ff.fp);
+    if (s_errors) { printf("test_journal: %d hiba\n", s_errors); return 1; }
+    printf("test_journal: ok\n");
+    return 0;
+}
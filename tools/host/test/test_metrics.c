@@ -0,0 +1,90 @@
+/* test_metrics — Prometheus szöveg export (components/metrics) formátuma.
+ *
+ * A metrics_render kimenete és a webserver /api/metrics saját sorai közül a
+ * leghosszabbak (metrics_emit_value) egy pufferbe; soronként ellenőrizzük:
+ *   - minden sor "\n"-re végződik, nincs két sor egybe ragadva,
+ *   - "# HELP uwbgw_x ..." után "# TYPE uwbgw_x counter|gauge|histogram",
+ *   - utána legalább egy minta az adott családból: "uwbgw_x[_suffix][{..}] <szám>". */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "metrics.h"
+
+static int s_errors;
+
+#define CHECK(c, ...) do { if (!(c)) { if (s_errors++ < 20) { printf("FAIL %s:%d: ", __func__, __LINE__); printf(__VA_ARGS__); putchar('\n'); } } } while (0)
+
+static char   s_out[32768];
+static size_t s_n;
+
+static void emit(void* ctx, const char* s, size_t n)
+{
+    (void)ctx;
+    CHECK(s_n + n < sizeof(s_out), "output buffer");
+    if (s_n + n >= sizeof(s_out)) return;
+    memcpy(s_out + s_n, s, n);
+    s_n += n;
+}
+
+/* "uwbgw_" + [a-z0-9_]+ hossza, 0 ha nem ilyen */
+static size_t name_len(const char* p)
+{
+    if (strncmp(p, "uwbgw_", 6)) return 0;
+    size_t n = 6;
+    while ((p[n] >= 'a' && p[n] <= 'z') || (p[n] >= '0' && p[n] <= '9') || p[n] == '_') n++;
+    return n > 6 ? n : 0;
+}
+
+static void check_exposition(void)
+{
+    CHECK(s_n && s_out[s_n - 1] == '\n', "no trailing newline");
+    s_out[s_n] = 0;
+    char fam[96] = "";
+    int state = 0, families = 0;                         /* 0: HELP jön, 1: TYPE jön, 2: minták */
+    for (char* l = s_out; *l; ) {
+        char* e = strchr(l, '\n');
+        if (!e) break;
+        *e = 0;
+        if (!strncmp(l, "# HELP ", 7)) {
+            CHECK(state != 1, "HELP after HELP: %s", l);
+            const size_t n = name_len(l + 7);
+            CHECK(n && n < sizeof(fam) && l[7 + n] == ' ' && l[8 + n], "bad HELP: %s", l);
+            CHECK(strstr(l + 7, "# ") == NULL, "glued line: %s", l);
+            snprintf(fam, sizeof(fam), "%.*s", (int)n, l + 7);
+            state = 1; families++;
+        } else if (!strncmp(l, "# TYPE ", 7)) {
+            const size_t n = strlen(fam);
+            const char* t = l + 8 + n;
+            CHECK(state == 1 && !strncmp(l + 7, fam, n) && l[7 + n] == ' ' &&
+                  (!strcmp(t, "counter") || !strcmp(t, "gauge") || !strcmp(t, "histogram")), "bad TYPE: %s", l);
+            state = 2;
+        } else {
+            const size_t n = name_len(l), f = strlen(fam);
+            CHECK(state >= 2 && n >= f && !strncmp(l, fam, f), "sample outside family %s: %s", fam, l);
+            const char* v = l + n;
+            if (*v == '{') { v = strchr(v, '}'); CHECK(v, "labels: %s", l); if (!v) v = l + n; else v++; }
+            char* end;
+            CHECK(*v == ' ' && (strtol(v + 1, &end, 10), end != v + 1 && !*end), "bad sample: %s", l);
+            state = 3;
+        }
+        l = e + 1;
+    }
+    CHECK(state == 3, "last family %s without sample", fam);
+    CHECK(families == M__COUNT + G__COUNT + H__COUNT + 3, "families %d", families);
+}
+
+int main(void)
+{
+    metric_add(M_BLE_NOTIFY, 1234567);
+    metric_gauge_set(G_LIVE_CLIENTS, -1);
+    metric_observe(H_HTTP_MS, 7);
+    metrics_render(emit, NULL);
+    /* a webserver leghosszabb saját sorai (/api/metrics) */
+    metrics_emit_value(emit, NULL, "uplink_frames_dropped_total", "counter", "DATA frames dropped, uplink queue full", 4294967295u);
+    metrics_emit_value(emit, NULL, "journal_appended_bytes_total", "counter", "Datagram bytes written to the journal", 4294967295u);
+    metrics_emit_value(emit, NULL, "journal_flash_bytes_total", "counter", "Bytes programmed into the journal partition", 4294967295u);
+    check_exposition();
+    if (s_errors) { printf("test_metrics: %d hiba\n", s_errors); return 1; }
+    printf("test_metrics: ok\n");
+    return 0;
+}
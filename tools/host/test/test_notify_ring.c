@@ -0,0 +1,131 @@
+/* test_notify_ring — notify_ring (components/ble) termelő / fogyasztó stresszteszt.
+ *
+ * Termelő szálak (1 és 2, a target BTC task + injektor esete) keretenként
+ * [pid, seq:LE32, minta...] változó hosszal tolnak; tele gyűrűnél a push
+ * false, a termelő ezt számolja és megy tovább. A fogyasztó szál peek / ellenőriz
+ * / release. Elvárás:
+ *   - termelőnként szigorúan növő seq (sorrend, nincs duplikátum),
+ *   - a seq rések összege == a termelő sikertelen push-ai (nincs csendes vesztés),
+ *   - hossz, link, from_cfg, ts és tartalom ép (nincs félig írt slot),
+ *   - pushed == popped, dropped == a sikertelen push-ok összege.
+ * Egy szálon: túlhosszú keret levágása, üres gyűrű, high_water.
+ * TSan alatt is fut (GW_SANITIZE=thread). */
+#include <stdio.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include "notify_ring.h"
+
+#define FRAMES_PER_PROD  200000u
+#define MAX_PROD         2
+
+static notify_ring_t s_ring;
+static atomic_uint   s_live;                        /* futó termelők */
+static uint32_t      s_fail[MAX_PROD];              /* sikertelen push termelőnként */
+static int           s_errors;
+
+#define FAIL(...) do { if (s_errors++ < 10) { printf("FAIL: "); printf(__VA_ARGS__); putchar('\n'); } } while (0)
+
+static uint16_t frame_len(uint32_t seq) { return (uint16_t)(5 + seq % (NOTIFY_FRAME_MAX - 4)); }
+static uint8_t  pattern(uint8_t pid, uint32_t seq, unsigned i) { return (uint8_t)(seq * 31u + i * 7u + pid); }
+
+static void* producer(void* arg)
+{
+    const uint8_t pid = (uint8_t)(uintptr_t)arg;
+    uint8_t b[NOTIFY_FRAME_MAX];
+    for (uint32_t seq = 0; seq < FRAMES_PER_PROD; seq++) {
+        const uint16_t n = frame_len(seq);
+        b[0] = pid;
+        for (int k = 0; k < 4; k++) b[1 + k] = (uint8_t)(seq >> 8 * k);
+        for (unsigned i = 5; i < n; i++) b[i] = pattern(pid, seq, i);
+        if (!notify_ring_push(&s_ring, pid, (int64_t)seq * 3 + pid, b, n, seq & 1)) s_fail[pid]++;
+        if ((seq & 63) == 0) sched_yield();         /* változó fogyasztó / termelő tempó */
+    }
+    atomic_fetch_sub(&s_live, 1);
+    return NULL;
+}
+
+typedef struct { uint32_t got[MAX_PROD], gaps[MAX_PROD]; int64_t next[MAX_PROD]; } cons_t;
+
+static void check_frame(cons_t* c, const notify_frame_t* f)
+{
+    const uint8_t pid = f->data[0];
+    if (f->len < 5 || pid >= MAX_PROD || f->link != pid) { FAIL("bad header len=%u pid=%u link=%u", f->len, pid, f->link); return; }
+    uint32_t seq = 0;
+    for (int k = 0; k < 4; k++) seq |= (uint32_t)f->data[1 + k] << 8 * k;
+    if ((int64_t)seq < c->next[pid]) { FAIL("pid %u: seq %u after %lld (order / dup)", pid, seq, (long long)c->next[pid] - 1); return; }
+    c->gaps[pid] += (uint32_t)(seq - c->next[pid]);
+    c->next[pid] = (int64_t)seq + 1;
+    c->got[pid]++;
+    if (f->len != frame_len(seq) || f->from_cfg != (seq & 1) || f->ts_us != (int64_t)seq * 3 + pid) {
+        FAIL("pid %u seq %u: meta len=%u", pid, seq, f->len); return;
+    }
+    for (unsigned i = 5; i < f->len; i++)
+        if (f->data[i] != pattern(pid, seq, i)) { FAIL("pid %u seq %u: byte %u torn", pid, seq, i); return; }
+}
+
+static int stress(unsigned nprod)
+{
+    notify_ring_init(&s_ring);
+    memset(s_fail, 0, sizeof(s_fail));
+    atomic_store(&s_live, nprod);
+    pthread_t th[MAX_PROD];
+    for (unsigned p = 0; p < nprod; p++) pthread_create(&th[p], NULL, producer, (void*)(uintptr_t)p);
+
+    cons_t c;
+    memset(&c, 0, sizeof(c));
+    for (;;) {
+        const notify_frame_t* f = notify_ring_peek(&s_ring);
+        if (f) { check_frame(&c, f); notify_ring_release(&s_ring); continue; }
+        if (!atomic_load(&s_live)) {                /* termelők kész: utolsó ürítés */
+            if (!notify_ring_peek(&s_ring)) break;
+            continue;
+        }
+        sched_yield();
+    }
+    for (unsigned p = 0; p < nprod; p++) pthread_join(th[p], NULL);
+
+    notify_ring_stats_t st;
+    notify_ring_get_stats(&s_ring, &st);
+    uint32_t fails = 0, got = 0;
+    for (unsigned p = 0; p < nprod; p++) {
+        const uint32_t tail = FRAMES_PER_PROD - (uint32_t)c.next[p];   /* a végén elveszett keretek */
+        if (c.gaps[p] + tail != s_fail[p]) FAIL("pid %u: gaps %u + tail %u != failed push %u", p, c.gaps[p], tail, s_fail[p]);
+        if (c.got[p] + s_fail[p] != FRAMES_PER_PROD) FAIL("pid %u: got %u + failed %u", p, c.got[p], s_fail[p]);
+        fails += s_fail[p]; got += c.got[p];
+    }
+    if (st.pushed != got || st.popped != got || st.dropped != fails || st.truncated)
+        FAIL("stats pushed=%u popped=%u dropped=%u truncated=%u (got %u, failed %u)",
+             st.pushed, st.popped, st.dropped, st.truncated, got, fails);
+    if (st.high_water > NOTIFY_RING_SLOTS) FAIL("high_water %u", st.high_water);
+    printf("  %u producer(s): %u frames, %u dropped, high_water %u\n", nprod, got, fails, st.high_water);
+    return s_errors;
+}
+
+static int single(void)
+{
+    notify_ring_init(&s_ring);
+    if (notify_ring_peek(&s_ring)) FAIL("empty ring peek");
+    uint8_t big[NOTIFY_FRAME_MAX + 16];
+    memset(big, 0x5A, sizeof(big));
+    for (unsigned i = 0; i < NOTIFY_RING_SLOTS; i++)
+        if (!notify_ring_push(&s_ring, 0, i, big, i ? 10 : sizeof(big), false)) FAIL("push %u", i);
+    if (notify_ring_push(&s_ring, 0, 0, big, 1, false)) FAIL("push into full ring");
+    const notify_frame_t* f = notify_ring_peek(&s_ring);
+    if (!f || f->len != NOTIFY_FRAME_MAX) FAIL("truncated len");
+    notify_ring_release(&s_ring);
+    if (!notify_ring_push(&s_ring, 0, 0, big, 1, false)) FAIL("push after release");
+    notify_ring_stats_t st;
+    notify_ring_get_stats(&s_ring, &st);
+    if (st.truncated != 1 || st.dropped != 1 || st.high_water != NOTIFY_RING_SLOTS || st.pushed != NOTIFY_RING_SLOTS + 1)
+        FAIL("single stats truncated=%u dropped=%u hw=%u pushed=%u", st.truncated, st.dropped, st.high_water, st.pushed);
+    return s_errors;
+}
+
+int main(void)
+{
+    if (single() || stress(1) || stress(2)) return 1;
+    puts("test_notify_ring: ok");
+    return 0;
+}
@@ -0,0 +1,247 @@
+/* test_tag_track — tag_track (components/uplink) szintetikus DATA sorozatokkal.
+ *
+ * Az anchor órát a teszt vezeti (64 bites igaz idő, a keretbe mod 2^40 kerül),
+ * az érkezési idő (now_us) ebből számolt + jitter. Elvárás:
+ *   - ts40 átfordulás: ts64 == igaz idő, TT_F_WRAP / wraps a határnál,
+ *   - több átfordulásnyi csend után is helyes ts64 és wraps,
+ *   - óra-reset (nagy visszalépés): TT_F_RESET, ts64 nem lép vissza,
+ *   - kis időbeli visszalépés előrébb lévő seq-kel: TT_F_REORDER,
+ *   - tag_seq rések (lost), 255→0 (TT_F_SEQ_ROLL), késve megjött keret
+ *     visszaadja a rést; sync_seq rések (sync_lost). 128-nál nagyobb
+ *     előrelépés a 8 bites seq-ben visszalépésnek számít (nem teszteljük résként),
+ *   - duplikátum a 32-es ablakban: TT_F_DUP, a statisztika nem változik; a
+ *     reset küszöbnél régebbi, de ablakon belüli keret sem óra-reset,
+ *   - tétlen tag kiöregszik (tt_expire), tele táblánál a LRU vége esik ki,
+ *     törlés után a hash lánc többi tagja megmarad,
+ *   - keretráta EWMA (rate_mhz). */
+#include <stdio.h>
+#include <string.h>
+#include "tag_track.h"
+
+#define ANCHOR        0x0A000001u
+
+static int s_errors;
+
+#define CHECK(c, ...) do { if (!(c)) { if (s_errors++ < 20) { printf("FAIL %s:%d: ", __func__, __LINE__); printf(__VA_ARGS__); putchar('\n'); } } } while (0)
+
+static uint64_t us2t(int64_t us) { return (uint64_t)us * 638976ULL / 10ULL; }
+
+static void mk(uint8_t f[20], uint32_t tag, uint8_t sync_seq, uint8_t tag_seq, uint64_t ts)
+{
+    memset(f, 0, 20);
+    f[0] = 0xAB; f[1] = 1; f[2] = sync_seq; f[3] = tag_seq;
+    for (int k = 0; k < 4; k++) { f[4 + k] = (uint8_t)(ANCHOR >> 8 * k); f[8 + k] = (uint8_t)(tag >> 8 * k); }
+    for (int k = 0; k < 5; k++) f[12 + k] = (uint8_t)(ts >> 8 * k);
+}
+
+static tt_out_t feed(uint32_t tag, uint8_t sync_seq, uint8_t tag_seq, uint64_t ts, int64_t now_us)
+{
+    uint8_t f[20];
+    tt_out_t o;
+    mk(f, tag, sync_seq, tag_seq, ts);
+    if (!tt_process(f, sizeof(f), now_us, &o)) { CHECK(0, "tt_process false"); memset(&o, 0, sizeof(o)); }
+    return o;
+}
+
+static bool stats(uint32_t tag, tt_tag_stats_t* st)
+{
+    for (uint32_t i = 0; i < TT_MAX_TAGS; i++)
+        if (tt_get(i, st) && st->anchor_id == ANCHOR && st->tag_id == tag) return true;
+    return false;
+}
+
+/* 10 Hz a 2^40 határon át: ts64 pontosan az igaz idő */
+static void t_wrap(void)
+{
+    tt_reset();
+    const uint64_t t0 = TT_WRAP - us2t(550000);          /* 5.5 keret a határig */
+    const uint64_t step = us2t(100000);
+    int wrap_at = -1;
+    for (int i = 0; i < 20; i++) {
+        const uint64_t ts = t0 + (uint64_t)i * step;
+        const int64_t now = 1000000 + (int64_t)i * 100000 + (i % 3) * 700;   /* ±ms jitter */
+        const tt_out_t o = feed(1, (uint8_t)i, (uint8_t)i, ts & (TT_WRAP - 1), now);
+        CHECK(o.ts64 == ts, "i=%d ts64=%llu want %llu", i, (unsigned long long)o.ts64, (unsigned long long)ts);
+        if (o.flags & TT_F_WRAP) { CHECK(wrap_at < 0, "second wrap at %d", i); wrap_at = i; }
+        CHECK(o.lost == 0 && o.sync_lost == 0, "i=%d lost=%u sync_lost=%u", i, o.lost, o.sync_lost);
+    }
+    CHECK(wrap_at == 6, "wrap at %d, want 6", wrap_at);
+    tt_tag_stats_t st;
+    CHECK(stats(1, &st) && st.wraps == 1 && st.frames == 20 && st.lost == 0, "wraps=%u frames=%u", st.wraps, st.frames);
+}
+
+/* 40 s csend (2.3 átfordulás), a nyers különbség önmagában kevés lenne */
+static void t_silence(void)
+{
+    tt_reset();
+    const uint64_t t0 = 123456789ULL;
+    feed(2, 0, 0, t0, 5000000);
+    const int64_t gap_us[] = { 40000000, 17500000, 34400000 };    /* 2.3, 1.02, 2.0 átfordulás */
+    uint64_t ts = t0;
+    int64_t now = 5000000;
+    uint32_t want_wraps = 0;
+    for (int i = 0; i < 3; i++) {
+        const uint64_t prev = ts;
+        ts += us2t(gap_us[i]);
+        now += gap_us[i] + 2500;                           /* érkezési késés */
+        want_wraps += (uint32_t)((ts >> 40) - (prev >> 40));
+        const tt_out_t o = feed(2, (uint8_t)(1 + i), (uint8_t)(1 + i), ts & (TT_WRAP - 1), now);
+        CHECK(o.ts64 == ts, "gap %d: ts64=%llu want %llu", i, (unsigned long long)o.ts64, (unsigned long long)ts);
+        CHECK(!!(o.flags & TT_F_WRAP) == ((ts >> 40) != (prev >> 40)), "gap %d: flags 0x%x", i, o.flags);
+    }
+    tt_tag_stats_t st;
+    CHECK(stats(2, &st) && st.wraps == want_wraps, "wraps=%u want %u", st.wraps, want_wraps);
+}
+
+/* anchor óra újraindul (nagy visszalépés), majd kis visszalépés előrébb lévő seq-kel */
+static void t_reset_reorder(void)
+{
+    tt_reset();
+    uint64_t ts = us2t(8000000);
+    int64_t now = 2000000;
+    tt_out_t o = feed(3, 0, 0, ts, now);
+    for (int i = 1; i <= 3; i++) o = feed(3, 0, (uint8_t)i, ts + (uint64_t)i * us2t(100000), now + i * 100000);
+    const uint64_t before = o.ts64;
+
+    o = feed(3, 0, 4, us2t(1000), now + 400000);            /* reset: ~8 s vissza */
+    CHECK(o.flags & TT_F_RESET, "flags 0x%x, want RESET", o.flags);
+    CHECK(o.ts64 > before, "ts64 %llu <= %llu after reset", (unsigned long long)o.ts64, (unsigned long long)before);
+    const uint64_t base = o.ts64;
+    o = feed(3, 0, 5, us2t(1000) + us2t(100000), now + 500000);
+    CHECK(o.ts64 == base + us2t(100000), "after reset ts64 %llu want %llu",
+          (unsigned long long)o.ts64, (unsigned long long)(base + us2t(100000)));
+
+    /* 5 ms-mal korábbi időbélyeg, de tag_seq 6: csere, az állapot ideje nem lép vissza */
+    o = feed(3, 0, 6, us2t(1000) + us2t(95000), now + 600000);
+    CHECK((o.flags & TT_F_REORDER) && !(o.flags & TT_F_RESET), "flags 0x%x, want REORDER", o.flags);
+    CHECK(o.ts64 == base + us2t(95000), "reorder ts64");
+    o = feed(3, 0, 7, us2t(1000) + us2t(300000), now + 800000);
+    CHECK(o.ts64 == base + us2t(300000) && !(o.flags & TT_F_REORDER), "next ts64 / flags 0x%x", o.flags);
+
+    tt_tag_stats_t st;
+    CHECK(stats(3, &st) && st.resets == 1 && st.reorders == 1 && st.lost == 0,
+          "resets=%u reorders=%u lost=%u", st.resets, st.reorders, st.lost);
+}
+
+/* tag_seq / sync_seq rések */
+static void t_gaps(void)
+{
+    tt_reset();
+    const uint64_t step = us2t(50000);
+    int64_t now = 1000000;
+    uint64_t ts = 1000;
+    static const struct { uint8_t sync, seq; uint16_t lost; uint8_t sync_lost; uint8_t flags; } k[] = {
+        {  10,   0, 0, 0, TT_F_FIRST },
+        {  10,   1, 0, 0, 0 },
+        {  11,   4, 2, 0, 0 },                       /* 2, 3 hiányzik */
+        {  14,   5, 0, 2, 0 },                       /* sync 12, 13 hiányzik */
+        {  14, 100, 94, 0, 0 },
+        {  15, 200, 99, 0, 0 },
+        {  15, 254, 53, 0, 0 },
+        {  16,   1, 2, 0, TT_F_SEQ_ROLL },           /* 255, 0 hiányzik */
+        { 120,   2, 0, 103, 0 },
+        { 200,   3, 0, 79, 0 },
+        {   1,   4, 0, 56, 0 },                      /* sync 200→1 átfordul */
+    };
+    for (unsigned i = 0; i < sizeof(k) / sizeof(k[0]); i++, now += 50000, ts += step) {
+        const tt_out_t o = feed(4, k[i].sync, k[i].seq, ts, now);
+        CHECK(o.lost == k[i].lost && o.sync_lost == k[i].sync_lost && o.flags == k[i].flags,
+              "row %u: lost=%u sync_lost=%u flags=0x%x", i, o.lost, o.sync_lost, o.flags);
+    }
+    tt_tag_stats_t st;
+    CHECK(stats(4, &st) && st.lost == 250 && st.sync_lost == 240 && st.seq_rolls == 1,
+          "lost=%u sync_lost=%u rolls=%u", st.lost, st.sync_lost, st.seq_rolls);
+
+    /* a hiányzó 0 mégis megjön, 50 ms késéssel (< TT_REORDER_TICKS): REORDER, a rés csökken */
+    const tt_out_t o = feed(4, 1, 0, ts - 2 * step, now);
+    CHECK(o.flags == TT_F_REORDER, "late flags 0x%x", o.flags);
+    CHECK(stats(4, &st) && st.lost == 249 && st.reorders == 1 && st.frames == 12, "late: lost=%u frames=%u", st.lost, st.frames);
+}
+
+/* duplikátum: azonnal, és néhány kerettel később is (ablakon belül) */
+static void t_dup(void)
+{
+    tt_reset();
+    const uint64_t step = us2t(100000);
+    for (int i = 0; i < 10; i++) feed(5, 0, (uint8_t)i, (uint64_t)i * step, 1000000 + i * 100000);
+    tt_out_t o = feed(5, 0, 9, 9 * step, 1000000 + 9 * 100000 + 300);
+    CHECK(o.flags == TT_F_DUP, "dup flags 0x%x", o.flags);
+    o = feed(5, 0, 3, 3 * step, 1000000 + 9 * 100000 + 600);        /* 6 kerettel régebbi */
+    CHECK(o.flags == TT_F_DUP, "old dup flags 0x%x", o.flags);
+    o = feed(5, 0, 10, 10 * step, 1000000 + 10 * 100000);
+    CHECK(o.flags == 0 && o.lost == 0 && o.ts64 == 10 * step, "after dup flags 0x%x lost %u", o.flags, o.lost);
+    /* 11 kimarad, 400 ms-mal később jön meg: REORDER (nem óra-reset), a rés visszajön */
+    for (int i = 12; i <= 15; i++) feed(5, 0, (uint8_t)i, (uint64_t)i * step, 1000000 + i * 100000);
+    o = feed(5, 0, 11, 11 * step, 1000000 + 15 * 100000 + 500);
+    CHECK(o.flags == TT_F_REORDER && o.ts64 == 11 * step, "late flags 0x%x", o.flags);
+    tt_tag_stats_t st;
+    CHECK(stats(5, &st) && st.dups == 2 && st.frames == 16 && st.lost == 0 && st.reorders == 1 && st.resets == 0,
+          "dups=%u frames=%u lost=%u resets=%u", st.dups, st.frames, st.lost, st.resets);
+}
+
+/* tétlenség: TT_IDLE_US után tt_expire törli, az aktív marad */
+static void t_aging(void)
+{
+    tt_reset();
+    for (uint32_t t = 0; t < 8; t++) feed(100 + t, 0, 0, 1000, 1000000);
+    feed(100, 0, 1, 1000 + us2t(TT_IDLE_US), 1000000 + TT_IDLE_US);  /* csak a 100-as él */
+    CHECK(tt_expire(1000000 + TT_IDLE_US) == 0, "expire at exactly TT_IDLE_US");
+    CHECK(tt_expire(1000000 + TT_IDLE_US + 1) == 7, "expire count");
+    CHECK(tt_count() == 1 && tt_expired() == 7, "count=%u expired=%u", tt_count(), tt_expired());
+    tt_tag_stats_t st;
+    CHECK(stats(100, &st) && st.frames == 2, "live tag lost");
+    CHECK(!stats(101, &st), "expired tag still present");
+    /* visszatérő tag új állapottal indul */
+    const tt_out_t o = feed(101, 0, 50, 5000, 2000000 + TT_IDLE_US);
+    CHECK(o.flags == TT_F_FIRST && tt_count() == 2, "return flags 0x%x", o.flags);
+}
+
+/* tele tábla: a legrégebben látott esik ki; a frissen érintett marad */
+static void t_evict(void)
+{
+    tt_reset();
+    int64_t now = 1000000;
+    for (uint32_t t = 0; t < TT_MAX_TAGS; t++, now += 10) feed(1000 + t, 0, 0, 1000, now);
+    CHECK(tt_count() == TT_MAX_TAGS && tt_evictions() == 0, "fill count=%u", tt_count());
+    feed(1000, 0, 1, 2000, now);                      /* a legrégebbi most friss */
+    for (uint32_t t = 0; t < 10; t++, now += 10) feed(5000 + t, 0, 0, 1000, now);
+    CHECK(tt_count() == TT_MAX_TAGS && tt_evictions() == 10, "count=%u evictions=%u", tt_count(), tt_evictions());
+    tt_tag_stats_t st;
+    CHECK(stats(1000, &st) && st.frames == 2, "touched tag evicted");
+    for (uint32_t t = 1; t <= 10; t++) CHECK(!stats(1000 + t, &st), "tag %u not evicted", 1000 + t);
+    CHECK(stats(1011, &st) && stats(5009, &st), "survivors missing");
+
+    /* törlések után minden megmaradt tag megtalálható (backward-shift lánc ép) */
+    uint32_t found = 0;
+    for (uint32_t i = 0; i < TT_MAX_TAGS; i++) {
+        if (!tt_get(i, &st)) continue;
+        const tt_out_t o = feed(st.tag_id, 0, 2, 3000, now);
+        if (o.flags & TT_F_FIRST) CHECK(0, "tag %u lost from hash", st.tag_id);
+        found++;
+    }
+    CHECK(found == TT_MAX_TAGS && tt_count() == TT_MAX_TAGS, "found=%u", found);
+}
+
+/* 20 Hz egyenletes: rate_mhz → 20000 */
+static void t_rate(void)
+{
+    tt_reset();
+    tt_tag_stats_t st;
+    for (int i = 0; i < 64; i++) feed(7, 0, (uint8_t)i, (uint64_t)i * us2t(50000), 1000000 + i * 50000);
+    CHECK(stats(7, &st) && st.rate_mhz == 20000, "rate_mhz=%u", st.rate_mhz);
+}
+
+int main(void)
+{
+    t_wrap();
+    t_silence();
+    t_reset_reorder();
+    t_gaps();
+    t_dup();
+    t_aging();
+    t_evict();
+    t_rate();
+    if (s_errors) { printf("test_tag_track: %d hiba\n", s_errors); return 1; }
+    printf("test_tag_track: ok\n");
+    return 0;
+}
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""/api/status késleltetés mérése párhuzamos /api/dwm_get terhelés alatt.
+
+Bejelentkezik (/auth/login, SID cookie), majd egy szálon folyamatosan
+/api/status-t kér, közben N szál /api/dwm_get-et (max_age=0: mindig BLE
+GET). Kiírja a status p50/p90/p99/max értékét ms-ben, a dwm_get válaszok
+státuszkód-eloszlását (200 / 503 busy / 504 timeout) és a Retry-After-t.
+
+Használat:
+    http_load.py --host 192.168.1.50 [--user admin --pass admin]
+                 [--dwm 3] [--seconds 20] [--anchor 0]
+    http_load.py --selftest
+"""
+import argparse
+import http.client
+import http.server
+import json
+import math
+import sys
+import threading
+import time
+
+
+def login(host, port, user, pw):
+    c = http.client.HTTPConnection(host, port, timeout=10)
+    c.request("POST", "/auth/login", json.dumps({"user": user, "pass": pw}),
+              {"Content-Type": "application/json"})
+    r = c.getresponse()
+    r.read()
+    if r.status != 200:
+        raise SystemExit(f"login: HTTP {r.status}")
+    ck = r.getheader("Set-Cookie", "")
+    c.close()
+    return ck.split(";", 1)[0]
+
+
+def pct(xs, p):
+    if not xs:
+        return float("nan")
+    s = sorted(xs)
+    k = min(len(s) - 1, max(0, math.ceil(p / 100.0 * len(s)) - 1))      # nearest-rank
+    return s[k]
+
+
+def _get(host, port, path, cookie):
+    c = http.client.HTTPConnection(host, port, timeout=10)
+    t0 = time.perf_counter()
+    try:
+        c.request("GET", path, headers={"Cookie": cookie} if cookie else {})
+        r = c.getresponse()
+        r.read()
+        return r.status, (time.perf_counter() - t0) * 1000.0, r.getheader("Retry-After")
+    except OSError:
+        return 0, (time.perf_counter() - t0) * 1000.0, None
+    finally:
+        c.close()
+
+
+def run(host, port, cookie, n_dwm, seconds, anchor):
+    stop = time.monotonic() + seconds
+    lat, codes, retry = [], {}, set()
+    lock = threading.Lock()
+
+    def dwm():
+        while time.monotonic() < stop:
+            st, _, ra = _get(host, port, f"/api/dwm_get?anchor={anchor}&max_age=0", cookie)
+            with lock:
+                codes[st] = codes.get(st, 0) + 1
+                if ra:
+                    retry.add(ra)
+            if st == 503:
+                time.sleep(float(ra or 1))
+
+    ths = [threading.Thread(target=dwm, daemon=True) for _ in range(n_dwm)]
+    for t in ths:
+        t.start()
+    while time.monotonic() < stop:
+        st, ms, _ = _get(host, port, "/api/status", cookie)
+        if st == 200:
+            lat.append(ms)
+        time.sleep(0.05)
+    for t in ths:
+        t.join(15)
+    return lat, codes, retry
+
+
+def report(lat, codes, retry, n_dwm):
+    print(f"dwm_get clients: {n_dwm}")
+    print(f"/api/status n={len(lat)} p50={pct(lat, 50):.1f} p90={pct(lat, 90):.1f} "
+          f"p99={pct(lat, 99):.1f} max={max(lat) if lat else float('nan'):.1f} ms")
+    print("dwm_get codes: " + ", ".join(f"{k}:{v}" for k, v in sorted(codes.items())))
+    if retry:
+        print("Retry-After: " + ",".join(sorted(retry)))
+
+
+def selftest():
+    assert pct([5, 1, 3, 2, 4], 50) == 3
+    assert pct(list(range(1, 101)), 99) == 99
+    assert pct([7], 99) == 7
+
+    class H(http.server.BaseHTTPRequestHandler):
+        def log_message(self, *a):
+            pass
+
+        def do_GET(self):
+            if self.path.startswith("/api/dwm_get"):
+                time.sleep(0.2)
+                self.send_response(503)
+                self.send_header("Retry-After", "1")
+            else:
+                self.send_response(200)
+            self.send_header("Content-Length", "2")
+            self.end_headers()
+            self.wfile.write(b"{}")
+
+    srv = http.server.ThreadingHTTPServer(("127.0.0.1", 0), H)
+    threading.Thread(target=srv.serve_forever, daemon=True).start()
+    lat, codes, retry = run("127.0.0.1", srv.server_address[1], "", 2, 1.0, 0)
+    srv.shutdown()
+    assert lat and codes.get(503) and retry == {"1"}
+    print("http_load: selftest ok")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--host")
+    ap.add_argument("--port", type=int, default=80)
+    ap.add_argument("--user", default="admin")
+    ap.add_argument("--pass", dest="pw", default="admin")
+    ap.add_argument("--dwm", type=int, default=3, help="parallel /api/dwm_get clients")
+    ap.add_argument("--seconds", type=float, default=20)
+    ap.add_argument("--anchor", type=int, default=0)
+    ap.add_argument("--selftest", action="store_true")
+    a = ap.parse_args()
+    if a.selftest:
+        selftest()
+        return 0
+    if not a.host:
+        ap.error("--host required")
+    cookie = login(a.host, a.port, a.user, a.pw)
+    lat, codes, retry = run(a.host, a.port, cookie, a.dwm, a.seconds, a.anchor)
+    report(lat, codes, retry, a.dwm)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
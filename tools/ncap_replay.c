@@ -0,0 +1,186 @@
+/* ncap_replay — .ncap NOTIFY felvétel visszajátszása host-on, a gateway ingest láncán át.
+ *
+ * A rekordok ugyanazon az úton mennek, mint a targeten: sink (gattc_cb NOTIFY
+ * helyett) → notify_ring → rx szál → feliratkozók (tools/host/gw_host.h).
+ * Kiírja: rekord / s, notify gyűrű késleltetés (push → rx) és feliratkozói idő
+ * p50/p99/max, gyűrű eldobások, uplink datagramok.
+ *
+ * Fordítás: tools/host/CMakeLists.txt (ncap_replay target).
+ *
+ * Használat:
+ *   ncap_replay [--speed X | --max] [--loops N] [--log] notify.ncap
+ *   ncap_replay --synth out.ncap [--tags N] [--rate HZ] [--seconds S]
+ *   ncap_replay --selftest
+ * (notify.ncap: GET /api/capture.bin) */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ncap.h"
+#include "uwb_frame.h"
+#include "tag_track.h"
+#include "gw_host.h"
+
+typedef struct {
+    ncap_replay_stats_t st;
+    uint32_t dropped;
+} run_out_t;
+
+static bool run(const uint8_t* p, size_t n, double speed, unsigned loops, run_out_t* out)
+{
+    memset(out, 0, sizeof(*out));
+    const gw_cfg_t g = { .backpressure = speed == 0 };
+    gw_start(&g);
+
+    const ncap_replay_cfg_t c = { .speed = speed, .sink = gw_sink, .now_us = gw_now_us, .sleep_us = gw_sleep_us };
+    bool ok = true;
+    for (unsigned i = 0; i < loops && ok; i++) {
+        ncap_replay_stats_t st;
+        ok = ncap_replay(p, n, &c, &st);
+        out->st.records += st.records; out->st.data += st.data; out->st.cfg += st.cfg;
+        out->st.bytes   += st.bytes;   out->st.span_us += st.span_us; out->st.wall_us += st.wall_us;
+        if (st.late_max_us > out->st.late_max_us) out->st.late_max_us = st.late_max_us;
+        out->st.truncated |= st.truncated;
+    }
+    gw_stop();
+    out->dropped = gw_stats()->dropped;
+    return ok;
+}
+
+static void report(const run_out_t* o, double speed)
+{
+    const double wall = o->st.wall_us > 0 ? o->st.wall_us / 1e6 : 1e-9;
+    printf("replay: records=%u (data %u, cfg %u) bytes=%llu span=%.3f s wall=%.3f s\n",
+           o->st.records, o->st.data, o->st.cfg, (unsigned long long)o->st.bytes, o->st.span_us / 1e6, wall);
+    if (speed > 0) printf("  speed=%.2fx late_max=%.3f ms\n", speed, o->st.late_max_us / 1000.0);
+    else           printf("  speed=max\n");
+    printf("  throughput: %.0f rec/s, %.0f B/s\n", o->st.records / wall, o->st.bytes / wall);
+    gw_print();
+    if (o->st.truncated) printf("  WARNING: truncated record, replay stopped early\n");
+}
+
+/* ===== szintetikus felvétel: N tag DATA + anchoronként 1 s-os HB ===== */
+typedef struct { uint8_t* p; size_t n, cap; } buf_t;
+static void buf_put(buf_t* b, const void* p, size_t n)
+{
+    if (b->n + n > b->cap) {
+        b->cap = (b->n + n) * 2;
+        b->p = realloc(b->p, b->cap);
+        if (!b->p) { perror("realloc"); exit(1); }
+    }
+    memcpy(b->p + b->n, p, n);
+    b->n += n;
+}
+static void wr32le(uint8_t* p, uint32_t v){ p[0]=(uint8_t)v; p[1]=(uint8_t)(v>>8); p[2]=(uint8_t)(v>>16); p[3]=(uint8_t)(v>>24); }
+
+static void synth(buf_t* b, unsigned tags, double rate_hz, double seconds)
+{
+    uint8_t h[NCAP_HDR_LEN];
+    ncap_hdr_encode(h, 1000000, 0);
+    buf_put(b, h, sizeof(h));
+    const int64_t step = (int64_t)(1e6 / (rate_hz * tags));   /* tagok egyenletesen elosztva */
+    const int64_t end  = (int64_t)(seconds * 1e6);
+    int64_t t = 0, last = 0, next_hb = 0;
+    uint8_t seq[4096] = {0};
+    for (unsigned k = 0; t < end; k++, t += step) {
+        if (t >= next_hb) {
+            const uint8_t hb[13] = { 0x01,0x01,0x03, 0x02,0x04,(uint8_t)(t>>24),(uint8_t)(t>>16),(uint8_t)(t>>8),(uint8_t)t,
+                                     0x03,0x02,0x00,0x64 };
+            uint8_t rh[NCAP_REC_HDR];
+            ncap_rec_hdr_encode(rh, (uint32_t)(t - last), sizeof(hb), 0, true);
+            buf_put(b, rh, sizeof(rh)); buf_put(b, hb, sizeof(hb));
+            last = t; next_hb += 1000000;
+        }
+        const unsigned tag = k % tags;
+        uint8_t f[UWB_DATA_LEN] = { UWB_DATA_HDR, 1, (uint8_t)(t / 100000), seq[tag % sizeof(seq)]++ };
+        wr32le(&f[4], 0xA0000001u);
+        wr32le(&f[8], 0x1000u + tag);
+        const uint64_t ts40 = (uint64_t)t * 63898 & (TT_WRAP - 1);    /* ~63.9 GHz DW tick */
+        wr32le(&f[12], (uint32_t)ts40);
+        f[16] = (uint8_t)(ts40 >> 32);
+        uint8_t rh[NCAP_REC_HDR];
+        ncap_rec_hdr_encode(rh, (uint32_t)(t - last), sizeof(f), 0, false);
+        buf_put(b, rh, sizeof(rh)); buf_put(b, f, sizeof(f));
+        last = t;
+    }
+}
+
+static int selftest(void)
+{
+    buf_t b = {0};
+    synth(&b, 50, 10.0, 2.0);                                   /* 1000 DATA + 2 HB */
+    ncap_rd_t r; ncap_rec_t rec; unsigned n = 0, cfg = 0; int rc;
+    if (!ncap_rd_init(&r, b.p, b.n)) { puts("selftest: bad header"); return 1; }
+    while ((rc = ncap_rd_next(&r, &rec)) == 1) { n++; cfg += rec.from_cfg; }
+    if (rc != 0 || n != 1002 || cfg != 2) { printf("selftest: reader n=%u cfg=%u rc=%d\n", n, cfg, rc); return 1; }
+    ncap_rd_init(&r, b.p, b.n - 3);
+    while ((rc = ncap_rd_next(&r, &rec)) == 1) { }
+    if (rc != -1) { puts("selftest: truncation not detected"); return 1; }
+
+    run_out_t o;
+    if (!run(b.p, b.n, 0, 1, &o) || o.st.records != 1002) { puts("selftest: max-speed run"); return 1; }
+    if (gw_stats()->consumed != 1002 || o.dropped || gw_stats()->frames_in != 1000) { puts("selftest: max-speed accounting"); return 1; }
+    /* paced: eldobós gyűrű, mint a targeten; ütemezési késés eldobhat → csak az elszámolás */
+    if (!run(b.p, b.n, 10.0, 1, &o) || o.st.records != 1002) { puts("selftest: paced run"); return 1; }
+    const gw_stats_t* g = gw_stats();
+    if (g->consumed + o.dropped != 1002 || g->frames_in > 1000 || g->frames_in + o.dropped < 1000) {
+        printf("selftest: paced accounting consumed=%u dropped=%u frames_in=%u\n", g->consumed, o.dropped, g->frames_in);
+        return 1;
+    }
+    if (o.st.wall_us < 150000) { puts("selftest: pacing too fast"); return 1; }  /* 2 s / 10 */
+    free(b.p);
+    puts("ncap_replay: selftest ok");
+    return 0;
+}
+
+static int usage(void)
+{
+    fputs("usage: ncap_replay [--speed X | --max] [--loops N] [--log] file.ncap\n"
+          "       ncap_replay --synth out.ncap [--tags N] [--rate HZ] [--seconds S]\n"
+          "       ncap_replay --selftest\n", stderr);
+    return 2;
+}
+
+int main(int argc, char** argv)
+{
+    double speed = 1.0, rate = 10.0, seconds = 10.0;
+    unsigned loops = 1, tags = 100;
+    const char* file = NULL; const char* synth_out = NULL;
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        const char* v = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!strcmp(a, "--selftest")) return selftest();
+        else if (!strcmp(a, "--max"))  speed = 0;
+        else if (!strcmp(a, "--log"))  gw_log_print = true;
+        else if (!strcmp(a, "--speed")   && v) { speed = atof(v); i++; }
+        else if (!strcmp(a, "--loops")   && v) { loops = (unsigned)atoi(v); i++; }
+        else if (!strcmp(a, "--synth")   && v) { synth_out = v; i++; }
+        else if (!strcmp(a, "--tags")    && v) { tags = (unsigned)atoi(v); i++; }
+        else if (!strcmp(a, "--rate")    && v) { rate = atof(v); i++; }
+        else if (!strcmp(a, "--seconds") && v) { seconds = atof(v); i++; }
+        else if (a[0] != '-' && !file) file = a;
+        else return usage();
+    }
+    if (synth_out) {
+        if (!tags || rate <= 0 || seconds <= 0) return usage();
+        buf_t b = {0};
+        synth(&b, tags, rate, seconds);
+        FILE* f = fopen(synth_out, "wb");
+        if (!f || fwrite(b.p, 1, b.n, f) != b.n) { perror(synth_out); return 1; }
+        fclose(f);
+        printf("%s: %zu B\n", synth_out, b.n);
+        return 0;
+    }
+    if (!file || speed < 0 || !loops) return usage();
+
+    FILE* f = fopen(file, "rb");
+    if (!f) { perror(file); return 1; }
+    buf_t b = {0};
+    uint8_t chunk[65536]; size_t k;
+    while ((k = fread(chunk, 1, sizeof(chunk), f)) > 0) buf_put(&b, chunk, k);
+    fclose(f);
+
+    run_out_t o;
+    if (!run(b.p, b.n, speed, loops, &o)) { fprintf(stderr, "%s: not an .ncap v%u file\n", file, NCAP_VERSION); return 1; }
+    report(&o, speed);
+    return o.st.truncated ? 1 : 0;
+}
@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""Statikus web assetek csomagolása a webserver komponenshez.
+
+Minden fájlt gzip-pel tömörít (determinisztikusan, mtime=0), ETag-et számol
+(SHA-256 első 8 hex jegye), és egyetlen táblát ír, amit a firmware
+target_add_binary_data-val beágyaz és másolás nélkül szolgál ki.
+
+Formátum (little-endian), lásd components/webserver/assets.hpp:
+    hdr:   magic "WAST", u16 version, u16 count
+    entry: char path[24], char mime[24], char etag[12],
+           u32 off, u32 len, u32 raw_len, u32 flags      (76 B)
+    data:  4 bájtra igazítva
+
+Használat:
+    pack_assets.py -o assets.bin [--verify] file...
+    pack_assets.py --selftest
+"""
+import argparse
+import gzip
+import hashlib
+import os
+import struct
+import sys
+import tempfile
+
+MAGIC = b"WAST"
+VERSION = 1
+HDR = struct.Struct("<4sHH")
+ENT = struct.Struct("<24s24s12sIIII")
+F_GZIP = 1
+
+MIME = {
+    ".html": "text/html", ".htm": "text/html", ".js": "application/javascript",
+    ".css": "text/css", ".json": "application/json", ".svg": "image/svg+xml",
+    ".png": "image/png", ".ico": "image/x-icon", ".txt": "text/plain",
+}
+
+
+def _cstr(s, n):
+    b = s.encode()
+    if len(b) >= n:
+        raise ValueError(f"'{s}' too long (max {n - 1})")
+    return b.ljust(n, b"\0")
+
+
+def _etag(raw):
+    return '"%s"' % hashlib.sha256(raw).hexdigest()[:8]
+
+
+def pack(files):
+    ents, blobs, off = [], [], HDR.size + ENT.size * len(files)
+    off = (off + 3) & ~3
+    for path in files:
+        with open(path, "rb") as f:
+            raw = f.read()
+        name = "/" + os.path.basename(path)
+        mime = MIME.get(os.path.splitext(name)[1].lower(), "application/octet-stream")
+        gz = gzip.compress(raw, 9, mtime=0)
+        data, flags = (gz, F_GZIP) if len(gz) < len(raw) else (raw, 0)
+        ents.append(ENT.pack(_cstr(name, 24), _cstr(mime, 24), _cstr(_etag(raw), 12),
+                             off, len(data), len(raw), flags))
+        pad = (-len(data)) & 3
+        blobs.append(data + b"\0" * pad)
+        off += len(data) + pad
+    head = HDR.pack(MAGIC, VERSION, len(files)) + b"".join(ents)
+    head += b"\0" * ((-len(head)) & 3)
+    return head + b"".join(blobs)
+
+
+def unpack(blob):
+    magic, ver, count = HDR.unpack_from(blob, 0)
+    if magic != MAGIC or ver != VERSION:
+        raise ValueError("bad header")
+    out = {}
+    for i in range(count):
+        name, mime, etag, off, ln, raw_len, flags = ENT.unpack_from(blob, HDR.size + i * ENT.size)
+        data = blob[off:off + ln]
+        if len(data) != ln:
+            raise ValueError("entry out of range")
+        raw = gzip.decompress(data) if flags & F_GZIP else data
+        if len(raw) != raw_len:
+            raise ValueError("raw_len mismatch")
+        out[name.rstrip(b"\0").decode()] = (mime.rstrip(b"\0").decode(), etag.rstrip(b"\0").decode(), raw)
+    return out
+
+
+def verify(blob, files):
+    """Round-trip: a tábla visszafejtve bájtra egyezik a forrásokkal."""
+    tab = unpack(blob)
+    if len(tab) != len(files):
+        raise ValueError("count mismatch")
+    for path in files:
+        with open(path, "rb") as f:
+            raw = f.read()
+        _, etag, got = tab["/" + os.path.basename(path)]
+        if got != raw or etag != _etag(raw):
+            raise ValueError(f"round-trip mismatch: {path}")
+
+
+def selftest():
+    with tempfile.TemporaryDirectory() as d:
+        files = []
+        for name, body in (("a.html", b"<html>" + b"x" * 500 + b"</html>"),
+                           ("empty.html", b""), ("b.js", os.urandom(37))):
+            p = os.path.join(d, name)
+            with open(p, "wb") as f:
+                f.write(body)
+            files.append(p)
+        blob = pack(files)
+        verify(blob, files)
+        if pack(files) != blob:
+            raise ValueError("output not deterministic")
+        tab = unpack(blob)
+        assert tab["/a.html"][0] == "text/html"
+        assert tab["/empty.html"][2] == b""
+    print("pack_assets: selftest ok")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("-o", "--out")
+    ap.add_argument("--verify", action="store_true", help="round-trip check after packing")
+    ap.add_argument("--selftest", action="store_true")
+    ap.add_argument("files", nargs="*")
+    a = ap.parse_args()
+    if a.selftest:
+        selftest()
+        return 0
+    if not a.out or not a.files:
+        ap.error("-o and at least one file required")
+    files = sorted(a.files, key=os.path.basename)
+    blob = pack(files)
+    if a.verify:
+        verify(blob, files)
+    with open(a.out, "wb") as f:
+        f.write(blob)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())